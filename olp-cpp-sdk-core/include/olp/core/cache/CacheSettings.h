@@ -116,6 +116,18 @@ struct CORE_API CacheSettings {
    */
   size_t max_memory_cache_size = 1024u * 1024u;
 
+  /**
+   * @brief Sets the number of independently locked segments of the memory
+   * cache.
+   *
+   * With more than one segment, reads that hit the memory cache do not wait
+   * for the disk operations of other threads. Their LRU promotions are
+   * buffered and applied before the mutable cache eviction. Each segment holds
+   * an equal part of `#max_memory_cache_size`, so a single value cannot be
+   * larger than this part. The default value is 1.
+   */
+  size_t memory_cache_shards = 1u;
+
   /**
    * @brief Sets the disk cache open options.
    */
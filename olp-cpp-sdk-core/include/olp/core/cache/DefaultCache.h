@@ -271,6 +271,22 @@ class CORE_API DefaultCache : public KeyValueCache {
    */
   OperationOutcome<ValueTypePtr> Read(const std::string& key) override;
 
+  /**
+   * @brief Gets a read-only view of the binary data from the cache.
+   *
+   * The view of a value read from the disk cache points to the storage blocks
+   * of the database and is not added to the memory cache. While any such view
+   * exists, the database stays open even if the cache is closed. Such a cache
+   * is not cleared, and it is not opened again until the views are released,
+   * so release the views before you close the cache.
+   *
+   * @param key The key that is used to look for the binary data.
+   *
+   * @return The view of the binary data or an error if the data could not be
+   * retrieved from the cache.
+   */
+  OperationOutcome<ValueView> ReadView(const std::string& key) override;
+
   /**
    * @brief Stores the raw binary data as a value in the cache.
    *
@@ -302,6 +318,32 @@ class CORE_API DefaultCache : public KeyValueCache {
    */
   OperationOutcomeEmpty DeleteByPrefix(const std::string& prefix) override;
 
+  /**
+   * @brief Stores the list of key-value pairs in the cache.
+   *
+   * All the pairs are written to the disk cache in one batch.
+   *
+   * @param items The list of keys and the binary data to be stored.
+   * @param expiry The expiry time (in seconds) of all the key-value pairs.
+   *
+   * @return An error if the data could not be written to the cache.
+   */
+  OperationOutcomeEmpty WriteBatch(const KeyValueListType& items,
+                                   time_t expiry) override;
+
+  /**
+   * @brief Gets the binary data of the list of keys from the cache.
+   *
+   * The keys missing in the memory cache are read from the disk cache with
+   * one iterator.
+   *
+   * @param keys The keys that are used to look for the binary data.
+   *
+   * @return The list of values in the order of the keys, with `nullptr` for
+   * the keys that are not found, or an error if the cache is closed.
+   */
+  OperationOutcome<ValueListType> ReadBatch(const KeyListType& keys) override;
+
   /**
    * @brief Gets size of the corresponding cache.
    *
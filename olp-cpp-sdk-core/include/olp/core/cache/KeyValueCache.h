@@ -24,9 +24,11 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <olp/core/CoreApi.h>
+#include <olp/core/cache/ValueView.h>
 #include <olp/core/client/ApiError.h>
 #include <olp/core/client/ApiNoResult.h>
 #include <olp/core/client/ApiResponse.h>
@@ -62,6 +64,12 @@ class CORE_API KeyValueCache {
   /// An alias for the list of keys to be protected or released.
   using KeyListType = std::vector<std::string>;
 
+  /// An alias for the list of key-value pairs to be written at once.
+  using KeyValueListType = std::vector<std::pair<std::string, ValueTypePtr>>;
+
+  /// An alias for the list of values read at once.
+  using ValueListType = std::vector<ValueTypePtr>;
+
   virtual ~KeyValueCache() = default;
 
   /**
@@ -244,6 +252,67 @@ class CORE_API KeyValueCache {
     OLP_SDK_CORE_UNUSED(prefix);
     return client::ApiError(client::ErrorCode::Unknown, "Not implemented");
   }
+
+  /**
+   * @brief Gets a read-only view of the binary data from the cache.
+   *
+   * The view keeps the data valid without copying it out of the cache
+   * storage, if the cache supports it. The default implementation views the
+   * result of `Read`.
+   *
+   * @param key The key that is used to look for the binary data.
+   *
+   * @return The view of the binary data or an error if the data could not be
+   * retrieved from the cache.
+   */
+  virtual OperationOutcome<ValueView> ReadView(const std::string& key) {
+    auto result = Read(key);
+    if (!result) {
+      return result.GetError();
+    }
+    return ValueView(result.MoveResult());
+  }
+
+  /**
+   * @brief Stores the list of key-value pairs in the cache.
+   *
+   * The default implementation calls `Write` for every pair.
+   *
+   * @param items The list of keys and the binary data to be stored.
+   * @param expiry The expiry time (in seconds) of all the key-value pairs.
+   *
+   * @return An error if the data could not be written to the cache.
+   */
+  virtual OperationOutcomeEmpty WriteBatch(const KeyValueListType& items,
+                                           time_t expiry = kDefaultExpiry) {
+    for (const auto& item : items) {
+      auto result = Write(item.first, item.second, expiry);
+      if (!result) {
+        return result;
+      }
+    }
+    return client::ApiNoResult{};
+  }
+
+  /**
+   * @brief Gets the binary data of the list of keys from the cache.
+   *
+   * The default implementation calls `Read` for every key.
+   *
+   * @param keys The keys that are used to look for the binary data.
+   *
+   * @return The list of values in the order of the keys, with `nullptr` for
+   * the keys that are not found, or an error if the cache could not be read.
+   */
+  virtual OperationOutcome<ValueListType> ReadBatch(const KeyListType& keys) {
+    ValueListType values;
+    values.reserve(keys.size());
+    for (const auto& key : keys) {
+      auto result = Read(key);
+      values.emplace_back(result ? result.MoveResult() : nullptr);
+    }
+    return values;
+  }
 };
 
 }  // namespace cache
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace olp {
+namespace cache {
+
+/**
+ * @brief A read-only view of a cached value.
+ *
+ * The view does not own the data. It holds a reference-counted owner that
+ * keeps the data valid as long as any copy of the view exists, so large
+ * values can be passed around without being copied. The views of the cached
+ * values should not outlive the cache, see `DefaultCache::ReadView`.
+ */
+class ValueView {
+ public:
+  /// The owner of the viewed data.
+  using OwnerType = std::shared_ptr<const void>;
+
+  /// Creates an empty view.
+  ValueView() = default;
+
+  /**
+   * @brief Creates a view of the data that is kept alive by the owner.
+   *
+   * @param data The pointer to the first byte of the data.
+   * @param size The size of the data.
+   * @param owner The object that keeps the data valid.
+   */
+  ValueView(const unsigned char* data, size_t size, OwnerType owner)
+      : data_(data), size_(size), owner_(std::move(owner)) {}
+
+  /**
+   * @brief Creates a view of the whole vector that shares its ownership.
+   *
+   * @param value The value to view.
+   */
+  explicit ValueView(std::shared_ptr<const std::vector<unsigned char>> value)
+      : data_(value ? value->data() : nullptr),
+        size_(value ? value->size() : 0u),
+        owner_(std::move(value)) {}
+
+  /// Returns the pointer to the first byte of the data.
+  const unsigned char* data() const { return data_; }
+
+  /// Returns the size of the data.
+  size_t size() const { return size_; }
+
+  /// Checks whether the view has no data.
+  bool empty() const { return size_ == 0u; }
+
+  /// Returns the iterator to the first byte of the data.
+  const unsigned char* begin() const { return data_; }
+
+  /// Returns the iterator past the last byte of the data.
+  const unsigned char* end() const { return data_ + size_; }
+
+  /// Copies the data into a new vector.
+  std::vector<unsigned char> ToVector() const { return {begin(), end()}; }
+
+ private:
+  const unsigned char* data_{nullptr};
+  size_t size_{0u};
+  OwnerType owner_;
+};
+
+}  // namespace cache
+}  // namespace olp
@@ -123,6 +123,21 @@ class CORE_API HttpResponse {
         response_(std::move(response)),
         headers_(std::move(headers)) {}
 
+  /**
+   * @brief Creates the `HttpResponse` instance with the response body in a
+   * contiguous buffer.
+   *
+   * @param status The HTTP status.
+   * @param response The response body.
+   * @param headers Response headers.
+   */
+  HttpResponse(int status, std::vector<unsigned char>&& response,
+               http::Headers headers)
+      : status_(status),
+        headers_(std::move(headers)),
+        response_bytes_(std::move(response)),
+        has_response_bytes_(true) {}
+
   /**
    * @brief A copy constructor.
    *
@@ -134,7 +149,13 @@ class CORE_API HttpResponse {
   HttpResponse(const HttpResponse& other)
       : status_(other.status_),
         headers_(other.headers_),
-        network_statistics_(other.network_statistics_) {
+        network_statistics_(other.network_statistics_),
+        response_bytes_(other.response_bytes_),
+        has_response_bytes_(other.has_response_bytes_) {
+    if (has_response_bytes_) {
+      return;
+    }
+
     response_ << other.response_.rdbuf();
     if (!response_.good()) {
       // Depending on the users handling of the stringstream it might be that
@@ -157,9 +178,13 @@ class CORE_API HttpResponse {
     if (this != &other) {
       status_ = other.status_;
       response_ = std::stringstream{};
-      response_ << other.response_.rdbuf();
+      if (!other.has_response_bytes_) {
+        response_ << other.response_.rdbuf();
+      }
       headers_ = other.headers_;
       network_statistics_ = other.network_statistics_;
+      response_bytes_ = other.response_bytes_;
+      has_response_bytes_ = other.has_response_bytes_;
     }
 
     return *this;
@@ -177,6 +202,11 @@ class CORE_API HttpResponse {
    * @param output Reference to a vector.
    */
   void GetResponse(std::vector<unsigned char>& output) {
+    if (has_response_bytes_) {
+      output = response_bytes_;
+      return;
+    }
+
     response_.seekg(0, std::ios::end);
     const auto pos = response_.tellg();
     if (pos > 0) {
@@ -192,7 +222,13 @@ class CORE_API HttpResponse {
    *
    * @param output Reference to a string.
    */
-  void GetResponse(std::string& output) const { output = response_.str(); }
+  void GetResponse(std::string& output) const {
+    if (has_response_bytes_) {
+      output.assign(response_bytes_.begin(), response_bytes_.end());
+    } else {
+      output = response_.str();
+    }
+  }
 
   /**
    * @brief Get the response body as a vector of unsigned chars.
@@ -205,6 +241,26 @@ class CORE_API HttpResponse {
     return bytes;
   }
 
+  /**
+   * @brief Moves the response body out as a vector of unsigned chars.
+   *
+   * The body received into a contiguous buffer is moved without copying. The
+   * response body is empty after the call.
+   *
+   * @return The response body as a vector of unsigned chars.
+   */
+  std::vector<unsigned char> MoveResponseAsBytes() {
+    std::vector<unsigned char> bytes;
+    if (has_response_bytes_) {
+      bytes.swap(response_bytes_);
+      return bytes;
+    }
+
+    GetResponse(bytes);
+    response_ = std::stringstream{};
+    return bytes;
+  }
+
   /**
    * @brief Renders `HttpResponse` content to a string.
    *
@@ -221,7 +277,16 @@ class CORE_API HttpResponse {
    *
    * @return The reference to the response object.
    */
-  std::stringstream& GetRawResponse() { return response_; }
+  std::stringstream& GetRawResponse() {
+    if (has_response_bytes_) {
+      // The stream is requested for parsing, copy the buffer into it once
+      response_.write(reinterpret_cast<const char*>(response_bytes_.data()),
+                      response_bytes_.size());
+      response_bytes_ = std::vector<unsigned char>{};
+      has_response_bytes_ = false;
+    }
+    return response_;
+  }
 
   /**
    * @brief Return the const reference to the response headers.
@@ -263,6 +328,8 @@ class CORE_API HttpResponse {
   std::stringstream response_;
   http::Headers headers_;
   NetworkStatistics network_statistics_;
+  std::vector<unsigned char> response_bytes_;
+  bool has_response_bytes_{false};
 };
 
 }  // namespace client
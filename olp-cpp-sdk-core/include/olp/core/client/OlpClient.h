@@ -152,10 +152,44 @@ class CORE_API OlpClient {
                        RequestBodyType post_body, std::string content_type,
                        CancellationContext context) const;
 
+  /**
+   * @brief Executes the HTTP request through the network stack. The response
+   * content is consumed via data callback.
+   *
+   * The data callback is called by the network as the content is received,
+   * so the calling thread is free while the response is downloaded. The
+   * retried request passes the content again from the zero offset. The
+   * request is not merged with the same pending requests.
+   *
+   * @param path The path that is appended to the base URL.
+   * @param method Select one of the following methods: `GET`, `POST`, `DELETE`,
+   * or `PUT`.
+   * @param query_params The parameters that are appended to the URL path.
+   * @param header_params The headers used to customize the request.
+   * @param data_callback The network data callback to retrieve content.
+   * @param post_body For the `POST` request, populate `post_body`. This data
+   * must not be modified until the request is completed.
+   * @param content_type The content type for the `post_body`.
+   * @param callback The function callback used to receive the `HttpResponse`
+   * instance without the content.
+   *
+   * @return The method used to cancel the request.
+   */
+  CancellationToken CallApiStreamAsync(
+      const std::string& path, const std::string& method,
+      const ParametersType& query_params, const ParametersType& header_params,
+      http::Network::DataCallback data_callback,
+      const RequestBodyType& post_body, const std::string& content_type,
+      const NetworkAsyncCallback& callback) const;
+
   /**
    * @brief Executes the HTTP request through the network stack in a blocking
    * way. The response content is consumed via data callback.
    *
+   * The retried `GET` request without a `Range` header continues the body
+   * from the received offset. It is not retried once the body of a failed
+   * response is passed to the data callback.
+   *
    * @param path The path that is appended to the base URL.
    * @param method Select one of the following methods: `GET`, `POST`, `DELETE`,
    * or `PUT`.
@@ -179,6 +213,33 @@ class CORE_API OlpClient {
                              std::string content_type,
                              CancellationContext context) const;
 
+  /**
+   * @brief Executes the HTTP request through the network stack in a blocking
+   * way. The response body is received into a contiguous buffer.
+   *
+   * The buffer is pre-allocated from the `Content-Length` response header, and
+   * `HttpResponse::MoveResponseAsBytes` moves it out without copying. Use this
+   * method for the binary data, like blobs, that is not parsed as a stream.
+   *
+   * @param path The path that is appended to the base URL.
+   * @param method Select one of the following methods: `GET`, `POST`, `DELETE`,
+   * or `PUT`.
+   * @param query_params The parameters that are appended to the URL path.
+   * @param header_params The headers used to customize the request.
+   * @param post_body For the `POST` request, populate `post_body`. This data
+   * must not be modified until the request is completed.
+   * @param content_type The content type for the `post_body`.
+   * @param context The `CancellationContext` instance that is used to cancel
+   * the request.
+   *
+   * @return The `HttpResponse` instance.
+   */
+  HttpResponse CallApiBytes(std::string path, std::string method,
+                            ParametersType query_params,
+                            ParametersType header_params,
+                            RequestBodyType post_body, std::string content_type,
+                            CancellationContext context) const;
+
  private:
   class OlpClientImpl;
   std::shared_ptr<OlpClientImpl> impl_;
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -174,6 +175,33 @@ struct CORE_API ApiLookupSettings {
   CatalogEndpointProvider catalog_endpoint_provider = nullptr;
 };
 
+/**
+ * @brief Settings to download the large blobs with concurrent range requests.
+ *
+ * The blob is split into parts that are downloaded concurrently on the
+ * `TaskScheduler` instance and assembled into one buffer. Only the blobs with
+ * the data size known from the partition metadata are split.
+ */
+struct CORE_API ParallelDownloadSettings {
+  /**
+   * @brief The minimal blob size in bytes that is downloaded in parts.
+   *
+   * Set to 0 to disable the parallel download. By default, the parallel
+   * download is disabled.
+   */
+  std::uint64_t min_blob_size = 0u;
+
+  /**
+   * @brief The maximal number of the concurrent range requests for one blob.
+   */
+  std::size_t max_requests = 4u;
+
+  /**
+   * @brief The minimal size in bytes of one range request.
+   */
+  std::uint64_t min_range_size = 8u * 1024u * 1024u;
+};
+
 /**
  * @brief Configures the behavior of the `OlpClient` class.
  */
@@ -246,6 +274,27 @@ struct CORE_API OlpClientSettings {
    * By default, this setting is set to `false`.
    */
   bool propagate_all_cache_errors = false;
+
+  /**
+   * @brief The parallel download settings of the large blobs.
+   *
+   * The parallel download requires the `task_scheduler` to be set.
+   */
+  ParallelDownloadSettings parallel_download_settings;
+
+  /**
+   * @brief The flag to enable or disable the integrity verification of the
+   * partition data.
+   *
+   * When set to `true`, the CRC-32C checksum of the data is computed while it
+   * is downloaded or read from the cache and compared to the partition `crc`.
+   * The data that does not match is never written to the cache, and its
+   * download is retried up to `RetrySettings::max_attempts` times. The
+   * partitions without `crc` are not verified. The data downloaded with
+   * parallel range requests is always verified.
+   * By default, this setting is set to `false`.
+   */
+  bool verify_data_integrity = false;
 };
 
 }  // namespace client
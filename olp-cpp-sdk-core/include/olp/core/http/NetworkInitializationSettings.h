@@ -38,6 +38,27 @@ struct CORE_API NetworkInitializationSettings {
    * @brief The custom certificate settings.
    */
   CertificateSettings certificate_settings;
+
+  /**
+   * @brief Enables HTTP/2 with the multiplexing of the concurrent requests.
+   *
+   * The concurrent requests to the same host share a few connections instead
+   * of opening a connection per request, so `max_requests_count` can be set
+   * to hundreds of requests. HTTP/2 is negotiated during the TLS handshake,
+   * and the servers that do not support it are used with HTTP/1.1. The plain
+   * HTTP requests always use HTTP/1.1.
+   *
+   * @note Ignored when the network implementation does not support HTTP/2.
+   */
+  bool http2_multiplexing = false;
+
+  /**
+   * @brief The maximum number of connections to one host.
+   *
+   * With `http2_multiplexing`, the requests above the limit wait for a free
+   * stream on the existing connections. Zero means no limit.
+   */
+  size_t max_host_connections = 0u;
 };
 
 }  // namespace http
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <memory>
+
+#include <olp/core/thread/TaskScheduler.h>
+
+namespace olp {
+namespace thread {
+
+/**
+ * @brief An implementation of the `TaskScheduler` instance that uses a thread
+ * pool with work stealing.
+ *
+ * Every thread owns a lock-free task deque per priority band (`HIGH`,
+ * `NORMAL`, and `LOW`). Tasks scheduled from the pool threads go to the deque
+ * of the current thread, tasks scheduled from other threads are distributed
+ * between the threads. Idle threads steal tasks from the other threads.
+ *
+ * Use this scheduler when a lot of small tasks are scheduled concurrently,
+ * e.g. for the prefetch, as there is no single queue that all the threads
+ * contend on.
+ *
+ * @note Tasks are executed by priority band, and not by the exact priority.
+ * Tasks within the same band keep the order only when they are scheduled
+ * from the same thread and executed by one thread.
+ */
+class CORE_API WorkStealingTaskScheduler final : public TaskScheduler {
+ public:
+  /**
+   * @brief Creates the `WorkStealingTaskScheduler` object with one thread.
+   *
+   * @param thread_count The number of threads initialized in the thread pool.
+   * At least one thread is created.
+   */
+  explicit WorkStealingTaskScheduler(size_t thread_count = 1u);
+
+  /**
+   * @brief Stops and joins threads. The tasks that are not started yet are
+   * discarded.
+   */
+  ~WorkStealingTaskScheduler() override;
+
+  /// Non-copyable, non-movable
+  WorkStealingTaskScheduler(const WorkStealingTaskScheduler&) = delete;
+  /// Non-copyable, non-movable
+  WorkStealingTaskScheduler& operator=(const WorkStealingTaskScheduler&) =
+      delete;
+  /// Non-copyable, non-movable
+  WorkStealingTaskScheduler(WorkStealingTaskScheduler&&) = delete;
+  /// Non-copyable, non-movable
+  WorkStealingTaskScheduler& operator=(WorkStealingTaskScheduler&&) = delete;
+
+ protected:
+  /**
+   * @brief Overrides the base class method to enqueue tasks and execute them on
+   * the next free thread from the thread pool.
+   *
+   * @note Tasks added with this method has Priority::NORMAL priority.
+   *
+   * @param func The rvalue reference of the task that should be enqueued.
+   * Move this task into your queue. No internal references are
+   * kept. Once this method is called, you own the task.
+   */
+  void EnqueueTask(TaskScheduler::CallFuncType&& func) override;
+
+  /**
+   * @brief Overrides the base class method to enqueue tasks and execute them on
+   * the next free thread from the thread pool.
+   *
+   * @param func The rvalue reference of the task that should be enqueued.
+   * Move this task into your queue. No internal references are
+   * kept. Once this method is called, you own the task.
+   * @param priority The priority of the task. Tasks with higher priority band
+   * executes earlier.
+   */
+  void EnqueueTask(TaskScheduler::CallFuncType&& func,
+                   uint32_t priority) override;
+
+ private:
+  class Impl;
+
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace thread
+}  // namespace olp
@@ -0,0 +1,675 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <olp/core/utils/LruCache.h>
+
+namespace olp {
+namespace utils {
+
+/**
+ * @brief A generic key-value LRU cache with O(1) operations.
+ *
+ * This cache has the same interface and eviction behavior as `LruCache`, but
+ * stores elements in an open-addressing hash table instead of a sorted map.
+ * The elements are allocated from a pool and linked in the LRU order with
+ * pointers, so find, promote, insert, and evict do not compare keys more than
+ * a few times and do not allocate memory per element.
+ *
+ * Prefer it over `LruCache` for a large number of keys, like long string
+ * keys of the disk cache. Unlike `LruCache`, it does not require the keys to
+ * be ordered and does not support a custom allocator.
+ *
+ * @tparam Key The `HashLruCache` key type.
+ * @tparam Value The `HashLruCache` value type.
+ * @tparam CacheCostFunc The cache cost functor.
+ * The specializations should return a non-zero value for any given object.
+ * The default implementation returns "1" as the size for each object.
+ * @tparam Hash The hash function for the keys.
+ * @tparam KeyEqual The function that compares the keys for equality.
+ */
+template <typename Key, typename Value,
+          typename CacheCostFunc = CacheCost<Value>,
+          typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class HashLruCache {
+  struct Node;
+
+ public:
+  /// An alias for the eviction function.
+  using EvictionFunction = std::function<void(const Key&, Value&&)>;
+
+  /**
+   * @brief A type of objects to be stored.
+   *
+   * Each object is defined by a key-value pair.
+   */
+  class ValueType {
+   public:
+    /**
+     * @brief Gets the key of the `ValueType` object.
+     *
+     * @return The key of the `ValueType` object.
+     */
+    const Key& key() const { return node_->Get().key; }
+
+    /**
+     * @brief Gets the value of the `ValueType` object.
+     *
+     * @return The value of the `ValueType` object.
+     */
+    const Value& value() const { return node_->Get().value; }
+
+   protected:
+    /// The node of the element, `nullptr` for the end iterator.
+    const Node* node_{nullptr};
+  };
+
+  /// A constant iterator of the `HashLruCache` object.
+  class const_iterator : public ValueType {
+   public:
+    /// A typedef for the iterator category.
+    typedef std::bidirectional_iterator_tag iterator_category;
+    /// A typedef for the difference type.
+    typedef std::ptrdiff_t difference_type;
+    /// A typedef for the `ValueType` type.
+    typedef ValueType value_type;
+    /// A typedef for the `ValueType` constant reference.
+    typedef const value_type& reference;
+    /// A typedef for the `ValueType` constant pointer.
+    typedef const value_type* pointer;
+
+    /// Creates a constant iterator object.
+    const_iterator() = default;
+
+    /**
+     * @brief Checks whether both iterators point to the same element.
+     *
+     * @param other The `const_iterator` instance.
+     *
+     * @return True if the iterators are the same; false otherwise.
+     */
+    bool operator==(const const_iterator& other) const {
+      return this->node_ == other.node_;
+    }
+
+    /**
+     * @brief Checks whether the iterators point to different elements.
+     *
+     * @param other The `const_iterator` instance.
+     *
+     * @return True if the iterators are not the same; false otherwise.
+     */
+    bool operator!=(const const_iterator& other) const {
+      return !operator==(other);
+    }
+
+    /// Iterates to the next, less recently used, element.
+    const_iterator& operator++() {
+      this->node_ = this->node_->next;
+      return *this;
+    }
+
+    /// Iterates to the next, less recently used, element.
+    const_iterator operator++(int) {
+      auto old_value = *this;
+      ++(*this);
+      return old_value;
+    }
+
+    /// Iterates to the previous, more recently used, element.
+    const_iterator& operator--() {
+      this->node_ = this->node_->previous;
+      return *this;
+    }
+
+    /// Iterates to the previous, more recently used, element.
+    const_iterator operator--(int) {
+      auto old_value = *this;
+      --(*this);
+      return old_value;
+    }
+
+    /// Gets a reference to this object.
+    reference operator*() const { return *this; }
+
+    /// Gets a pointer to this object.
+    pointer operator->() const { return this; }
+
+   private:
+    friend class HashLruCache;
+
+    explicit const_iterator(const Node* node) { this->node_ = node; }
+  };
+
+  /**
+   * @brief Creates an `HashLruCache` instance.
+   *
+   * Creates an invalid `HashLruCache` with the maximum size of `0`
+   * that caches nothing.
+   */
+  HashLruCache() = default;
+
+  /**
+   * @brief Creates an `HashLruCache` instance.
+   *
+   * @param max_size The maximum size of values this cache can keep.
+   * @param cache_cost_func The function this cache uses to compute the
+   *        caching cost of each cached value.
+   * @param hash The hash function for the keys.
+   * @param key_equal The function that compares the keys for equality.
+   */
+  explicit HashLruCache(std::size_t max_size,
+                        CacheCostFunc cache_cost_func = CacheCostFunc(),
+                        Hash hash = Hash(), KeyEqual key_equal = KeyEqual())
+      : cache_cost_func_(std::move(cache_cost_func)),
+        hash_(std::move(hash)),
+        key_equal_(std::move(key_equal)),
+        max_size_(max_size) {}
+
+  ~HashLruCache() { DestroyAll(); }
+
+  /// The deleted copy constructor.
+  HashLruCache(const HashLruCache&) = delete;
+
+  /// The deleted assignment operator.
+  HashLruCache& operator=(const HashLruCache&) = delete;
+
+  /// The move constructor. The nodes are not moved, iterators stay valid.
+  HashLruCache(HashLruCache&& other) noexcept { Swap(other); }
+
+  /// The move assignment operator.
+  HashLruCache& operator=(HashLruCache&& other) noexcept {
+    if (this != &other) {
+      HashLruCache(std::move(other)).Swap(*this);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Inserts a key-value pair in the cache.
+   *
+   * @note If the key already exists in the cache, it is promoted in the
+   * LRU, but its value and cost are not updated. To update or insert existing
+   * values, use `InsertOrAssign` instead.
+   *
+   * @param key The key to add.
+   * @param value The value to add.
+   *
+   * @return A pair of bool and an iterator, the same as `LruCache::Insert`.
+   */
+  template <typename _Key, typename _Value>
+  std::pair<const_iterator, bool> Insert(_Key&& key, _Value&& value) {
+    Key new_key(std::forward<_Key>(key));
+    const auto hash = hash_(new_key);
+    if (auto node = FindNode(new_key, hash)) {
+      Promote(node);
+      return std::make_pair(const_iterator{node}, false);
+    }
+
+    Value new_value(std::forward<_Value>(value));
+    const auto cost = cache_cost_func_(new_value);
+    if (cost > max_size_) {
+      return std::make_pair(end(), false);
+    }
+
+    auto node = AddNode(std::move(new_key), std::move(new_value), hash, cost);
+    return std::make_pair(const_iterator{node}, true);
+  }
+
+  /**
+   * @brief Inserts a key-value pair in the cache or updates an existing
+   * key-value pair.
+   *
+   * @note If the key already exists in the cache, its value and cost are
+   * updated. Not to update the existing key-value pair, use `Insert` instead.
+   *
+   * @param key The key to add.
+   * @param value The value to add.
+   *
+   * @return A pair of bool and an iterator, the same as
+   * `LruCache::InsertOrAssign`.
+   */
+  template <typename _Value>
+  std::pair<const_iterator, bool> InsertOrAssign(Key key, _Value&& value) {
+    const auto hash = hash_(key);
+    if (auto node = FindNode(key, hash)) {
+      const auto old_cost = cache_cost_func_(node->Get().value);
+      node->Get().value = std::forward<_Value>(value);
+      const auto new_cost = cache_cost_func_(node->Get().value);
+      size_ += new_cost - old_cost;
+      Promote(node);
+      Evict();
+      return std::make_pair(const_iterator{node}, false);
+    }
+
+    Value new_value(std::forward<_Value>(value));
+    const auto cost = cache_cost_func_(new_value);
+    if (cost > max_size_) {
+      return std::make_pair(end(), false);
+    }
+
+    auto node = AddNode(std::move(key), std::move(new_value), hash, cost);
+    return std::make_pair(const_iterator{node}, true);
+  }
+
+  /**
+   * @brief Removes a key from the cache.
+   *
+   * @param key The key to remove.
+   *
+   * @return True if the key exists and is removed from the cache; false
+   * otherwise.
+   */
+  bool Erase(const Key& key) {
+    auto node = FindNode(key, hash_(key));
+    if (!node) {
+      return false;
+    }
+
+    RemoveNode(node, false);
+    return true;
+  }
+
+  /**
+   * @brief Removes a key from the cache.
+   *
+   * @param it The iterator of the key that should be removed.
+   *
+   * @return The iterator to the next element.
+   */
+  const_iterator Erase(const_iterator& it) {
+    auto node = const_cast<Node*>(it.node_);
+    ++it;
+    RemoveNode(node, false);
+    return it;
+  }
+
+  /**
+   * @brief Gets the current size of the cache.
+   *
+   * @return The current cache size.
+   */
+  std::size_t Size() const { return size_; }
+
+  /**
+   * @brief Gets the maximum size of the cache.
+   *
+   * @return The maximum cache size.
+   */
+  std::size_t GetMaxSize() const { return max_size_; }
+
+  /**
+   * @brief Sets the new maximum size of the cache.
+   *
+   * If the new maximum size is smaller than the current size, items are evicted
+   * until the cache shrinks to less than or equal to the new maximum size.
+   *
+   * @param max_size The new maximum size of the cache.
+   */
+  void Resize(std::size_t max_size) {
+    max_size_ = max_size;
+    Evict();
+  }
+
+  /**
+   * @brief Finds a value in the cache.
+   *
+   * @note This function promotes the item pointed to by a key if found.
+   *
+   * @param key The key to find.
+   *
+   * @return If found, the iterator to the value; the iterator pointing
+   * to `end()` otherwise.
+   */
+  const_iterator Find(const Key& key) {
+    auto node = FindNode(key, hash_(key));
+    if (node) {
+      Promote(node);
+    }
+    return const_iterator{node};
+  }
+
+  /**
+   * @brief Finds a value in the cache.
+   *
+   * @note This function does NOT promote the item pointed to by a key if found.
+   *
+   * @param key The key to find.
+   *
+   * @return If found, the iterator to the value; the iterator pointing
+   * to `end()` otherwise.
+   */
+  const_iterator FindNoPromote(const Key& key) const {
+    return const_iterator{FindNode(key, hash_(key))};
+  }
+
+  /**
+   * @brief Finds a value in the cache.
+   *
+   * @note This function promotes the item pointed to by a key if found.
+   *
+   * @param key The key to find.
+   * @param null_value The value to return if the key-value pair is not in the
+   * cache
+   * @return If found, a constant reference to the value; `null_value`
+   * otherwise.
+   */
+  const Value& Find(const Key& key, const Value& null_value) {
+    auto it = Find(key);
+    return it == end() ? null_value : it.value();
+  }
+
+  /// Returns a constant iterator to the most recently used element.
+  const_iterator begin() const { return const_iterator{first_}; }
+
+  /// Returns a constant iterator to the end.
+  const_iterator end() const { return const_iterator{}; }
+
+  /// Returns a reverse constant iterator to the least recently used element.
+  const_iterator rbegin() const { return const_iterator{last_}; }
+
+  /// Returns a reverse constant iterator to the end.
+  const_iterator rend() const { return const_iterator{}; }
+
+  /**
+   * @brief Removes all items from the cache.
+   *
+   * Removes all content but does not reset the eviction callback
+   * or maximum size.
+   */
+  void Clear() {
+    DestroyAll();
+    slots_.clear();
+    chunks_.clear();
+    chunk_sizes_.clear();
+    free_ = first_ = last_ = nullptr;
+    count_ = size_ = 0u;
+  }
+
+  /**
+   * @brief Sets a function that is invoked when a value is
+   * evicted from the cache.
+   *
+   * @note The function must not modify the cache in the
+   * callback. The value can be safely moved. If not, it is destroyed when
+   * the function returns.
+   *
+   * To reset the eviction callback, pass `nullptr`.
+   *
+   * @param func The function to be called on eviction.
+   */
+  void SetEvictionCallback(EvictionFunction func) {
+    eviction_callback_ = std::move(func);
+  }
+
+ private:
+  struct Entry {
+    Key key;
+    Value value;
+  };
+
+  // The pooled node, the data is constructed only while the node is in use.
+  struct Node {
+    Entry& Get() { return *reinterpret_cast<Entry*>(&storage); }
+    const Entry& Get() const {
+      return *reinterpret_cast<const Entry*>(&storage);
+    }
+
+    typename std::aligned_storage<sizeof(Entry), alignof(Entry)>::type storage;
+    std::size_t hash;
+    // The LRU order links, `next` is also used for the free list
+    Node* previous;
+    Node* next;
+  };
+
+  static constexpr std::size_t kFirstChunkSize = 16u;
+  static constexpr std::size_t kMaxChunkSize = 4096u;
+  static constexpr std::size_t kMinSlotsCount = 16u;
+
+  Node* FindNode(const Key& key, std::size_t hash) const {
+    if (slots_.empty()) {
+      return nullptr;
+    }
+
+    const auto mask = slots_.size() - 1u;
+    for (auto index = hash & mask; slots_[index];
+         index = (index + 1u) & mask) {
+      const auto node = slots_[index];
+      if (node->hash == hash && key_equal_(node->Get().key, key)) {
+        return node;
+      }
+    }
+    return nullptr;
+  }
+
+  Node* AddNode(Key&& key, Value&& value, std::size_t hash, std::size_t cost) {
+    // Keep the load factor below 3/4
+    if ((count_ + 1u) * 4u > slots_.size() * 3u) {
+      Rehash(std::max(kMinSlotsCount, slots_.size() * 2u));
+    }
+
+    auto node = AllocateNode();
+    new (&node->storage) Entry{std::move(key), std::move(value)};
+    node->hash = hash;
+    node->previous = nullptr;
+    node->next = first_;
+    if (first_) {
+      first_->previous = node;
+    } else {
+      last_ = node;
+    }
+    first_ = node;
+
+    InsertSlot(node);
+    ++count_;
+    size_ += cost;
+    Evict();
+    return node;
+  }
+
+  void RemoveNode(Node* node, bool do_eviction_callback) {
+    const auto cost = cache_cost_func_(node->Get().value);
+
+    if (node->next) {
+      node->next->previous = node->previous;
+    } else {
+      last_ = node->previous;
+    }
+
+    if (node->previous) {
+      node->previous->next = node->next;
+    } else {
+      first_ = node->next;
+    }
+
+    EraseSlot(node);
+
+    if (do_eviction_callback && eviction_callback_) {
+      eviction_callback_(node->Get().key, std::move(node->Get().value));
+    }
+
+    node->Get().~Entry();
+    node->next = free_;
+    free_ = node;
+
+    --count_;
+    size_ -= cost;
+  }
+
+  void Promote(Node* node) {
+    if (node == first_) {
+      return;
+    }
+
+    // Not the first, so has the previous node
+    node->previous->next = node->next;
+    if (node->next) {
+      node->next->previous = node->previous;
+    } else {
+      last_ = node->previous;
+    }
+
+    node->previous = nullptr;
+    node->next = first_;
+    first_->previous = node;
+    first_ = node;
+  }
+
+  void Evict() {
+    while (size_ > max_size_) {
+      assert(last_ != nullptr);
+      RemoveNode(last_, true);
+    }
+  }
+
+  Node* AllocateNode() {
+    if (!free_) {
+      // The chunks grow, so the small caches don't reserve a lot of memory
+      const auto chunk_size =
+          chunks_.empty()
+              ? kFirstChunkSize
+              : std::min(kMaxChunkSize, chunk_sizes_.back() * 2u);
+      chunks_.emplace_back(new Node[chunk_size]);
+      chunk_sizes_.push_back(chunk_size);
+
+      auto chunk = chunks_.back().get();
+      for (std::size_t i = 0u; i < chunk_size; ++i) {
+        chunk[i].next = free_;
+        free_ = &chunk[i];
+      }
+    }
+
+    auto node = free_;
+    free_ = node->next;
+    return node;
+  }
+
+  void InsertSlot(Node* node) {
+    const auto mask = slots_.size() - 1u;
+    auto index = node->hash & mask;
+    while (slots_[index]) {
+      index = (index + 1u) & mask;
+    }
+    slots_[index] = node;
+  }
+
+  // Removes the slot with the backward shift, so there are no tombstones
+  void EraseSlot(Node* node) {
+    const auto mask = slots_.size() - 1u;
+    auto index = node->hash & mask;
+    while (slots_[index] != node) {
+      index = (index + 1u) & mask;
+    }
+
+    auto next = index;
+    for (;;) {
+      next = (next + 1u) & mask;
+      if (!slots_[next]) {
+        break;
+      }
+
+      // Skip the nodes that are still reachable from their home slot
+      const auto home = slots_[next]->hash & mask;
+      const bool reachable = index <= next ? (index < home && home <= next)
+                                           : (index < home || home <= next);
+      if (reachable) {
+        continue;
+      }
+
+      slots_[index] = slots_[next];
+      index = next;
+    }
+    slots_[index] = nullptr;
+  }
+
+  void Rehash(std::size_t slots_count) {
+    std::vector<Node*> slots(slots_count, nullptr);
+    slots_.swap(slots);
+    for (auto node = first_; node; node = node->next) {
+      InsertSlot(node);
+    }
+  }
+
+  void DestroyAll() {
+    for (auto node = first_; node; node = node->next) {
+      node->Get().~Entry();
+    }
+  }
+
+  void Swap(HashLruCache& other) {
+    std::swap(eviction_callback_, other.eviction_callback_);
+    std::swap(cache_cost_func_, other.cache_cost_func_);
+    std::swap(hash_, other.hash_);
+    std::swap(key_equal_, other.key_equal_);
+    slots_.swap(other.slots_);
+    chunks_.swap(other.chunks_);
+    chunk_sizes_.swap(other.chunk_sizes_);
+    std::swap(free_, other.free_);
+    std::swap(first_, other.first_);
+    std::swap(last_, other.last_);
+    std::swap(count_, other.count_);
+    std::swap(max_size_, other.max_size_);
+    std::swap(size_, other.size_);
+  }
+
+  EvictionFunction eviction_callback_;
+  CacheCostFunc cache_cost_func_;
+  Hash hash_;
+  KeyEqual key_equal_;
+  std::vector<Node*> slots_;
+  std::vector<std::unique_ptr<Node[]>> chunks_;
+  std::vector<std::size_t> chunk_sizes_;
+  Node* free_{nullptr};
+  Node* first_{nullptr};
+  Node* last_{nullptr};
+  std::size_t count_{0u};
+  std::size_t max_size_{0u};
+  std::size_t size_{0u};
+};
+
+template <typename Key, typename Value, typename CacheCostFunc, typename Hash,
+          typename KeyEqual>
+constexpr std::size_t
+    HashLruCache<Key, Value, CacheCostFunc, Hash, KeyEqual>::kFirstChunkSize;
+
+template <typename Key, typename Value, typename CacheCostFunc, typename Hash,
+          typename KeyEqual>
+constexpr std::size_t
+    HashLruCache<Key, Value, CacheCostFunc, Hash, KeyEqual>::kMaxChunkSize;
+
+template <typename Key, typename Value, typename CacheCostFunc, typename Hash,
+          typename KeyEqual>
+constexpr std::size_t
+    HashLruCache<Key, Value, CacheCostFunc, Hash, KeyEqual>::kMinSlotsCount;
+
+}  // namespace utils
+}  // namespace olp
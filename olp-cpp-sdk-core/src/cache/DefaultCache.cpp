@@ -95,6 +95,10 @@ OperationOutcome<KeyValueCache::ValueTypePtr> DefaultCache::Read(
   return impl_->Read(key);
 }
 
+OperationOutcome<ValueView> DefaultCache::ReadView(const std::string& key) {
+  return impl_->ReadView(key);
+}
+
 OperationOutcomeEmpty DefaultCache::Write(
     const std::string& key, const KeyValueCache::ValueTypePtr& value,
     time_t expiry) {
@@ -109,5 +113,15 @@ OperationOutcomeEmpty DefaultCache::DeleteByPrefix(const std::string& prefix) {
   return impl_->DeleteByPrefix(prefix);
 }
 
+OperationOutcomeEmpty DefaultCache::WriteBatch(const KeyValueListType& items,
+                                               time_t expiry) {
+  return impl_->WriteBatch(items, expiry);
+}
+
+OperationOutcome<KeyValueCache::ValueListType> DefaultCache::ReadBatch(
+    const KeyListType& keys) {
+  return impl_->ReadBatch(keys);
+}
+
 }  // namespace cache
 }  // namespace olp
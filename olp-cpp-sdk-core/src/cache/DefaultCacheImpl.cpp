@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
@@ -39,10 +40,17 @@ constexpr auto kLogTag = "DefaultCache";
 constexpr auto kExpirySuffix = "::expiry";
 constexpr auto kProtectedKeys = "internal::protected::protected_data";
 constexpr auto kInternalKeysPrefix = "internal::";
+constexpr auto kLruMetadataKeysPrefix = "internal::lru::";
+constexpr auto kLruMetadataPrefix = "internal::lru::meta::";
+constexpr auto kLruMetadataVersionKey = "internal::lru::version";
+constexpr auto kLruMetadataVersion = "1";
+constexpr auto kLruMetadataValueSize = 3u * sizeof(uint64_t);
+constexpr auto kLruMetadataBatchSize = 10000u;
 constexpr auto kMaxDiskSize = std::uint64_t(-1);
 constexpr auto kMinDiskUsedThreshold = 0.85f;
 constexpr auto kMaxDiskUsedThreshold = 0.9f;
 constexpr auto kEvictionPortion = 1024u * 1024u;  // 1 MB
+constexpr auto kPromotionBufferSize = 1024u;
 
 // current epoch time contains 10 digits.
 constexpr auto kExpiryValueSize = 10;
@@ -60,19 +68,40 @@ bool IsExpiryValid(time_t expiry) {
   return expiry < olp::cache::KeyValueCache::kDefaultExpiry;
 }
 
+time_t GetRemainingExpiryTime(
+    const olp::cache::KeyValueCache::ValueTypePtr& expiry_value) {
+  if (!expiry_value) {
+    return olp::cache::KeyValueCache::kDefaultExpiry;
+  }
+
+  std::string expiry_string(expiry_value->begin(), expiry_value->end());
+  return std::stoll(expiry_string) -
+         olp::cache::InMemoryCache::DefaultTimeProvider()();
+}
+
 time_t GetRemainingExpiryTime(const std::string& key,
                               olp::cache::DiskCache& disk_cache) {
   auto expiry_key = CreateExpiryKey(key);
-  auto expiry = olp::cache::KeyValueCache::kDefaultExpiry;
   auto expiry_result = disk_cache.Get(expiry_key);
   if (expiry_result) {
-    std::string expiry_value(expiry_result.GetResult()->begin(),
-                             expiry_result.GetResult()->end());
-    expiry = std::stoll(expiry_value);
-    expiry -= olp::cache::InMemoryCache::DefaultTimeProvider()();
+    return GetRemainingExpiryTime(expiry_result.GetResult());
   }
 
-  return expiry;
+  return olp::cache::KeyValueCache::kDefaultExpiry;
+}
+
+// Creates the list of the keys and their expiry keys for DiskCache::GetBatch,
+// the value is followed by its expiry.
+olp::cache::KeyValueCache::KeyListType CreateLookupKeys(
+    const olp::cache::KeyValueCache::KeyListType& keys,
+    const std::vector<size_t>& indexes) {
+  olp::cache::KeyValueCache::KeyListType lookup_keys;
+  lookup_keys.reserve(2u * indexes.size());
+  for (const auto index : indexes) {
+    lookup_keys.push_back(keys[index]);
+    lookup_keys.push_back(CreateExpiryKey(keys[index]));
+  }
+  return lookup_keys;
 }
 
 olp::cache::OperationOutcomeEmpty PurgeDiskItem(
@@ -137,6 +166,74 @@ bool IsInternalKey(const std::string& key) {
   return key.find(kInternalKeysPrefix) == 0u;
 }
 
+bool IsReadOnly(const olp::cache::CacheSettings& settings) {
+  return (settings.openOptions & olp::cache::OpenOptions::ReadOnly) ==
+         olp::cache::OpenOptions::ReadOnly;
+}
+
+std::string CreateLruMetadataKey(const std::string& key) {
+  return kLruMetadataPrefix + key;
+}
+
+bool IsLruMetadataKey(const leveldb::Slice& key) {
+  return key.starts_with(kLruMetadataKeysPrefix);
+}
+
+// The size of the metadata record of the key, counted in the cache size
+uint64_t GetLruMetadataSize(const std::string& key) {
+  return strlen(kLruMetadataPrefix) + key.size() + kLruMetadataValueSize;
+}
+
+void EncodeFixed64(char* buffer, uint64_t value) {
+  for (auto i = 0u; i < sizeof(uint64_t); ++i) {
+    buffer[i] = static_cast<char>((value >> (8u * i)) & 0xffu);
+  }
+}
+
+uint64_t DecodeFixed64(const char* buffer) {
+  uint64_t value = 0u;
+  for (auto i = 0u; i < sizeof(uint64_t); ++i) {
+    value |= static_cast<uint64_t>(static_cast<unsigned char>(buffer[i]))
+             << (8u * i);
+  }
+  return value;
+}
+
+// The metadata value is the value size, the absolute expiry and the LRU tick,
+// each encoded as a little endian 64 bit integer.
+void PutLruMetadata(leveldb::WriteBatch& batch, const std::string& key,
+                    size_t size, time_t expiry, uint64_t tick) {
+  char buffer[kLruMetadataValueSize];
+  EncodeFixed64(buffer, size);
+  EncodeFixed64(buffer + sizeof(uint64_t), static_cast<uint64_t>(expiry));
+  EncodeFixed64(buffer + 2u * sizeof(uint64_t), tick);
+  batch.Put(CreateLruMetadataKey(key),
+            leveldb::Slice(buffer, kLruMetadataValueSize));
+}
+
+bool DecodeLruMetadata(const leveldb::Slice& value, size_t& size,
+                       time_t& expiry, uint64_t& tick) {
+  if (value.size() != kLruMetadataValueSize) {
+    return false;
+  }
+
+  size = static_cast<size_t>(DecodeFixed64(value.data()));
+  expiry = static_cast<time_t>(DecodeFixed64(value.data() + sizeof(uint64_t)));
+  tick = DecodeFixed64(value.data() + 2u * sizeof(uint64_t));
+  return true;
+}
+
+// Returns the size the key occupies in the mutable cache, the same way a full
+// scan counts it: the key, the value and the optional expiry key.
+uint64_t GetStoredSize(const std::string& key, size_t size, time_t expiry) {
+  uint64_t stored_size = key.size() + size;
+  if (IsExpiryValid(expiry)) {
+    stored_size +=
+        key.size() + kExpirySuffixLength + std::to_string(expiry).size();
+  }
+  return stored_size;
+}
+
 olp::cache::DefaultCache::StorageOpenResult ToStorageOpenResult(
     olp::cache::OpenResult input) {
   switch (input) {
@@ -166,7 +263,20 @@ DefaultCacheImpl::DefaultCacheImpl(CacheSettings settings)
       mutable_cache_lru_(nullptr),
       protected_cache_(nullptr),
       mutable_cache_data_size_(0),
-      eviction_portion_(kEvictionPortion) {}
+      lru_tick_(0),
+      eviction_portion_(kEvictionPortion) {
+  // The memory cache lives as long as this instance, so that the memory cache
+  // segments can be read without the cache lock.
+  if (settings_.max_memory_cache_size > 0) {
+    memory_cache_ = std::make_unique<ShardedInMemoryCache>(
+        settings_.max_memory_cache_size, settings_.memory_cache_shards);
+
+    if (memory_cache_->ShardsCount() > 1u) {
+      promotion_buffers_ =
+          std::vector<PromotionBuffer>(memory_cache_->ShardsCount());
+    }
+  }
+}
 
 DefaultCache::StorageOpenResult DefaultCacheImpl::Open() {
   std::lock_guard<std::mutex> lock(cache_lock_);
@@ -225,7 +335,10 @@ void DefaultCacheImpl::Close() {
     return;
   }
 
-  memory_cache_.reset();
+  if (memory_cache_) {
+    memory_cache_->Clear();
+  }
+
   DestroyCache(DefaultCache::CacheType::kMutable);
   DestroyCache(DefaultCache::CacheType::kProtected);
   is_open_ = false;
@@ -248,6 +361,13 @@ bool DefaultCacheImpl::Clear() {
     return false;
   }
 
+  // The files of the database can't be removed while it is open
+  if (mutable_cache_ && mutable_cache_->GetSharedDatabase().use_count() > 1) {
+    OLP_SDK_LOG_ERROR(kLogTag,
+                      "Clear: the mutable cache is used by value views");
+    return false;
+  }
+
   if (memory_cache_) {
     memory_cache_->Clear();
   }
@@ -281,16 +401,7 @@ bool DefaultCacheImpl::Put(const std::string& key, const boost::any& value,
   }
 
   auto encoded_item = encoder();
-  if (memory_cache_) {
-    const auto size = encoded_item.size();
-    const bool result = memory_cache_->Put(
-        key, value, GetExpiryForMemoryCache(key, expiry), size);
-    if (!result && size > settings_.max_memory_cache_size && !mutable_cache_) {
-      OLP_SDK_LOG_INFO_F(kLogTag,
-                         "Failed to store value in memory cache %s, size %d",
-                         key.c_str(), static_cast<int>(size));
-    }
-  }
+  PutMemoryCache(key, value, expiry, encoded_item.size());
 
   return PutMutableCache(key, encoded_item, expiry).IsSuccessful();
 }
@@ -303,12 +414,19 @@ bool DefaultCacheImpl::Put(const std::string& key,
 
 boost::any DefaultCacheImpl::Get(const std::string& key,
                                  const Decoder& decoder) {
+  if (!promotion_buffers_.empty()) {
+    auto value = GetFromMemoryCacheUnlocked(key);
+    if (!value.empty()) {
+      return value;
+    }
+  }
+
   std::lock_guard<std::mutex> lock(cache_lock_);
   if (!is_open_) {
     return boost::any();
   }
 
-  if (memory_cache_) {
+  if (memory_cache_ && promotion_buffers_.empty()) {
     auto value = memory_cache_->Get(key);
     if (!value.empty()) {
       PromoteKeyLru(key);
@@ -427,26 +545,247 @@ void DefaultCacheImpl::InitializeLru() {
   OLP_SDK_LOG_INFO_F(kLogTag, "Initializing mutable LRU cache");
 
   mutable_cache_data_size_ = 0;
+  lru_tick_ = 0;
 
   mutable_cache_lru_ =
       std::make_unique<DiskLruCache>(settings_.max_disk_storage);
 
   const auto start = std::chrono::steady_clock::now();
+
+  if (InitializeLruFromMetadata()) {
+    OLP_SDK_LOG_INFO_F(kLogTag,
+                       "LRU cache restored from metadata, items=%zu, "
+                       "time=%" PRId64 "us",
+                       mutable_cache_lru_->Size(), GetElapsedTime(start));
+    return;
+  }
+
+  mutable_cache_data_size_ = 0;
+  mutable_cache_lru_->Clear();
+
+  // Protected keys are not part of the LRU, but their metadata is still
+  // needed to restore the cache size on the next open.
+  const bool store_metadata = !IsReadOnly(settings_);
+  std::map<std::string, ValueProperties> protected_properties;
+
   auto it = mutable_cache_->NewIterator(leveldb::ReadOptions());
 
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    // Here we count expiry keys, regular keys and the metadata records, the
+    // latter are subtracted again when StoreLruMetadata replaces them
+    if (IsLruMetadataKey(it->key())) {
+      if (it->key().starts_with(kLruMetadataPrefix)) {
+        mutable_cache_data_size_ += it->key().size() + it->value().size();
+      }
+      continue;
+    }
+
     auto key = it->key().ToString();
     const auto& value = it->value();
 
-    // Here we count both expiry keys and regular keys
     mutable_cache_data_size_ += key.size() + value.size();
 
-    AddKeyLru(key, value);
+    if (!store_metadata || IsInternalKey(key) ||
+        !protected_keys_.IsProtected(key)) {
+      AddKeyLru(key, value);
+      continue;
+    }
+
+    const bool expiration_key = IsExpiryKey(key);
+    if (expiration_key) {
+      key.resize(key.size() - kExpirySuffixLength);
+    }
+
+    auto& props = protected_properties[key];
+    if (expiration_key) {
+      props.expiry = std::stoll(value.ToString());
+    } else {
+      props.size = value.size();
+    }
   }
 
   OLP_SDK_LOG_INFO_F(kLogTag,
                      "LRU cache initialized, items=%zu, time=%" PRId64 "us",
                      mutable_cache_lru_->Size(), GetElapsedTime(start));
+
+  if (store_metadata) {
+    StoreLruMetadata(protected_properties);
+  }
+}
+
+bool DefaultCacheImpl::InitializeLruFromMetadata() {
+  auto version = mutable_cache_->Get(kLruMetadataVersionKey);
+  if (!version) {
+    return false;
+  }
+
+  const auto& version_value = version.GetResult();
+  if (std::string(version_value->begin(), version_value->end()) !=
+      kLruMetadataVersion) {
+    OLP_SDK_LOG_WARNING(kLogTag, "Unsupported LRU metadata version");
+    return false;
+  }
+
+  struct Entry {
+    std::string key;
+    ValueProperties props;
+  };
+  std::vector<Entry> entries;
+
+  leveldb::ReadOptions options;
+  options.fill_cache = false;
+  auto it = mutable_cache_->NewIterator(options);
+  const leveldb::Slice prefix(kLruMetadataPrefix);
+
+  for (it->Seek(prefix); it->Valid() && it->key().starts_with(prefix);
+       it->Next()) {
+    Entry entry;
+    if (!DecodeLruMetadata(it->value(), entry.props.size, entry.props.expiry,
+                           entry.props.tick)) {
+      OLP_SDK_LOG_WARNING_F(kLogTag, "Broken LRU metadata, key='%s'",
+                            it->key().ToString().c_str());
+      return false;
+    }
+
+    auto key = it->key();
+    key.remove_prefix(prefix.size());
+    entry.key = key.ToString();
+
+    mutable_cache_data_size_ +=
+        GetStoredSize(entry.key, entry.props.size, entry.props.expiry) +
+        GetLruMetadataSize(entry.key);
+    lru_tick_ = std::max(lru_tick_, entry.props.tick);
+
+    // Same as for the full scan, protected and internal keys are not evicted
+    if (protected_keys_.IsProtected(entry.key) || IsInternalKey(entry.key)) {
+      continue;
+    }
+
+    entries.push_back(std::move(entry));
+  }
+
+  if (!it->status().ok()) {
+    return false;
+  }
+
+  mutable_cache_data_size_ += protected_keys_.Size();
+
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry& lhs, const Entry& rhs) {
+              return lhs.props.tick < rhs.props.tick;
+            });
+
+  // Most recently used key is inserted last and ends up on top of the LRU
+  for (auto& entry : entries) {
+    mutable_cache_lru_->InsertOrAssign(std::move(entry.key), entry.props);
+  }
+
+  return true;
+}
+
+void DefaultCacheImpl::StoreLruMetadata(
+    const std::map<std::string, ValueProperties>& protected_properties) {
+  const auto start = std::chrono::steady_clock::now();
+
+  // Drop stale metadata left by a cache opened without LRU
+  uint64_t removed_data_size = 0u;
+  mutable_cache_->RemoveKeysWithPrefix(kLruMetadataPrefix, removed_data_size);
+  mutable_cache_data_size_ -= removed_data_size;
+
+  auto batch = std::make_unique<leveldb::WriteBatch>();
+  auto batch_size = 0u;
+  auto result = true;
+
+  const auto put_metadata = [&](const std::string& key,
+                                const ValueProperties& props) {
+    PutLruMetadata(*batch, key, props.size, props.expiry, props.tick);
+    mutable_cache_data_size_ += GetLruMetadataSize(key);
+    if (++batch_size < kLruMetadataBatchSize) {
+      return;
+    }
+
+    result = result && mutable_cache_->ApplyBatch(std::move(batch));
+    batch = std::make_unique<leveldb::WriteBatch>();
+    batch_size = 0u;
+  };
+
+  // The LRU has to be rebuilt, as the ticks can't be updated in place
+  std::vector<std::pair<std::string, ValueProperties>> entries;
+  entries.reserve(mutable_cache_lru_->Size());
+  for (const auto& entry : *mutable_cache_lru_) {
+    entries.emplace_back(entry.key(), entry.value());
+  }
+  mutable_cache_lru_->Clear();
+
+  for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+    it->second.tick = ++lru_tick_;
+    put_metadata(it->first, it->second);
+    mutable_cache_lru_->InsertOrAssign(std::move(it->first), it->second);
+  }
+
+  for (const auto& entry : protected_properties) {
+    put_metadata(entry.first, entry.second);
+  }
+
+  batch->Put(kLruMetadataVersionKey, kLruMetadataVersion);
+  result = result && mutable_cache_->ApplyBatch(std::move(batch));
+
+  OLP_SDK_LOG_INFO_F(kLogTag,
+                     "LRU metadata stored, result=%s, items=%zu, "
+                     "time=%" PRId64 "us",
+                     result ? "true" : "false", entries.size(),
+                     GetElapsedTime(start));
+}
+
+void DefaultCacheImpl::StoreLruOrder() {
+  if (!mutable_cache_ || !mutable_cache_lru_ || IsReadOnly(settings_)) {
+    return;
+  }
+
+  // Keys promoted by reads break the ascending order of ticks from the least
+  // to the most recently used key, only those get a new tick.
+  auto batch = std::make_unique<leveldb::WriteBatch>();
+  auto batch_size = 0u;
+  auto count = 0u;
+  uint64_t max_tick = 0u;
+
+  for (auto it = mutable_cache_lru_->rbegin(); it != mutable_cache_lru_->rend();
+       --it) {
+    const auto& props = it->value();
+    if (props.tick > max_tick) {
+      max_tick = props.tick;
+      continue;
+    }
+
+    max_tick = ++lru_tick_;
+    PutLruMetadata(*batch, it->key(), props.size, props.expiry, max_tick);
+    ++count;
+
+    if (++batch_size >= kLruMetadataBatchSize) {
+      mutable_cache_->ApplyBatch(std::move(batch));
+      batch = std::make_unique<leveldb::WriteBatch>();
+      batch_size = 0u;
+    }
+  }
+
+  if (batch_size > 0u) {
+    mutable_cache_->ApplyBatch(std::move(batch));
+  }
+
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "LRU order stored, promoted items=%u", count);
+}
+
+void DefaultCacheImpl::RemoveKeyMetadata(const std::string& key) {
+  if (!mutable_cache_ || !mutable_cache_lru_) {
+    return;
+  }
+
+  uint64_t removed_data_size = 0u;
+  if (!mutable_cache_->Remove(CreateLruMetadataKey(key), removed_data_size)) {
+    OLP_SDK_LOG_WARNING_F(kLogTag, "Failed to remove LRU metadata, key='%s'",
+                          key.c_str());
+  }
+  mutable_cache_data_size_ -= removed_data_size;
 }
 
 bool DefaultCacheImpl::RemoveKeyLru(const std::string& key) {
@@ -483,6 +822,51 @@ bool DefaultCacheImpl::PromoteKeyLru(const std::string& key) {
   return true;
 }
 
+boost::any DefaultCacheImpl::GetFromMemoryCacheUnlocked(
+    const std::string& key) {
+  if (!is_open_) {
+    return boost::any();
+  }
+
+  auto value = memory_cache_->Get(key);
+  if (value.empty()) {
+    return value;
+  }
+
+  auto& buffer = promotion_buffers_[memory_cache_->ShardIndex(key)];
+  bool is_full = false;
+  {
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.keys.push_back(key);
+    is_full = buffer.keys.size() >= kPromotionBufferSize;
+  }
+
+  if (is_full) {
+    std::lock_guard<std::mutex> lock(cache_lock_);
+    ApplyPendingPromotions();
+  }
+
+  return value;
+}
+
+void DefaultCacheImpl::ApplyPendingPromotions() {
+  for (auto& buffer : promotion_buffers_) {
+    std::vector<std::string> keys;
+    {
+      std::lock_guard<std::mutex> lock(buffer.mutex);
+      keys.swap(buffer.keys);
+    }
+
+    if (!mutable_cache_lru_) {
+      continue;
+    }
+
+    for (const auto& key : keys) {
+      mutable_cache_lru_->Find(key);
+    }
+  }
+}
+
 uint64_t DefaultCacheImpl::MaybeEvictData() {
   if (!mutable_cache_ || !mutable_cache_lru_) {
     return 0;
@@ -493,6 +877,9 @@ uint64_t DefaultCacheImpl::MaybeEvictData() {
     return 0;
   }
 
+  // The memory cache hits must be in the LRU order before it is evicted.
+  ApplyPendingPromotions();
+
   const auto start = std::chrono::steady_clock::now();
   int64_t left_to_evict =
       mutable_cache_data_size_ -
@@ -585,6 +972,9 @@ DefaultCacheImpl::EvictionResult DefaultCacheImpl::EvictExpiredDataPortion(
     batch.Delete(expiry_key);
     evicted += expiry_key.size() + kExpiryValueSize;
 
+    batch.Delete(CreateLruMetadataKey(key));
+    evicted += GetLruMetadataSize(key);
+
     ++count;
 
     if (memory_cache_) {
@@ -624,6 +1014,9 @@ DefaultCacheImpl::EvictionResult DefaultCacheImpl::EvictDataPortion(
       batch.Delete(expiry_key);
     }
 
+    batch.Delete(CreateLruMetadataKey(key));
+    evicted += GetLruMetadataSize(key);
+
     ++count;
 
     if (memory_cache_) {
@@ -644,50 +1037,74 @@ DefaultCacheImpl::EvictionResult DefaultCacheImpl::EvictDataPortion(
 
 int64_t DefaultCacheImpl::MaybeUpdatedProtectedKeys(
     leveldb::WriteBatch& batch) {
-  if (protected_keys_.IsDirty()) {
-    auto prev_size = protected_keys_.Size();
-    auto value = protected_keys_.Serialize();
-    // calculate key size, as it is be written for the first time
-    auto key_size = (prev_size > 0 ? 0 : strlen(kProtectedKeys));
-    if (value->size() > 0) {
-      leveldb::Slice slice(reinterpret_cast<const char*>(value->data()),
-                           value->size());
-      batch.Put(kProtectedKeys, slice);
-      return (key_size + protected_keys_.Size() - prev_size);
-    } else if (prev_size > 0) {
-      // delete key, as protected list is empty
-      batch.Delete(kProtectedKeys);
-      return -1 * static_cast<int64_t>((prev_size + strlen(kProtectedKeys)));
+  if (!protected_keys_.IsDirty()) {
+    return 0;
+  }
+
+  // every protected key is stored as a separate entry, so only the changed
+  // keys are written
+  const auto prev_size = protected_keys_.Size();
+  for (const auto& change : protected_keys_.TakeChanges()) {
+    const auto key = ProtectedKeyList::StorageKey(change.first);
+    if (change.second) {
+      batch.Put(key, leveldb::Slice());
+    } else {
+      batch.Delete(key);
     }
   }
 
-  return 0;
+  return static_cast<int64_t>(protected_keys_.Size()) -
+         static_cast<int64_t>(prev_size);
 }
 
 OperationOutcomeEmpty DefaultCacheImpl::PutMutableCache(
     const std::string& key, const leveldb::Slice& value, time_t expiry) {
+  return PutMutableCache({MutableCacheItem(key, value)}, expiry);
+}
+
+OperationOutcomeEmpty DefaultCacheImpl::PutMutableCache(
+    const std::vector<MutableCacheItem>& items, time_t expiry) {
   if (!mutable_cache_) {
     return NoError();
   }
 
   // can't put new item if cache is full and eviction disabled
-  const auto item_size = value.size();
-  const auto expected_size = mutable_cache_data_size_ + item_size + key.size() +
-                             key.size() + kExpirySuffixLength +
-                             kExpiryValueSize;
+  auto expected_size = mutable_cache_data_size_;
+  for (const auto& item : items) {
+    expected_size += item.second.size() + item.first.size() +
+                     item.first.size() + kExpirySuffixLength +
+                     kExpiryValueSize;
+  }
   if (!mutable_cache_lru_ && expected_size > settings_.max_disk_storage) {
     // FIXME: This error is not correct
     return client::ApiError::CacheIO("Cache is full and eviction is disabled");
   }
 
+  const auto has_expiry = IsExpiryValid(expiry);
+  if (has_expiry) {
+    expiry += olp::cache::InMemoryCache::DefaultTimeProvider()();
+  }
+
   uint64_t added_data_size = 0u;
   auto batch = std::make_unique<leveldb::WriteBatch>();
-  batch->Put(key, value);
-  added_data_size += key.size() + item_size;
+  const auto first_tick = lru_tick_ + 1u;
 
-  if (IsExpiryValid(expiry)) {
-    expiry += olp::cache::InMemoryCache::DefaultTimeProvider()();
-    added_data_size += StoreExpiry(key, *batch, expiry);
+  for (const auto& item : items) {
+    const auto& key = item.first;
+    batch->Put(key, item.second);
+    added_data_size += key.size() + item.second.size();
+
+    if (has_expiry) {
+      added_data_size += StoreExpiry(key, *batch, expiry);
+    }
+
+    // Metadata is stored for protected keys as well to restore the size on
+    // open
+    const auto tick = ++lru_tick_;
+    if (mutable_cache_lru_) {
+      PutLruMetadata(*batch, key, item.second.size(), expiry, tick);
+      added_data_size += GetLruMetadataSize(key);
+    }
   }
 
   auto removed_data_size = MaybeEvictData();
@@ -701,11 +1118,23 @@ OperationOutcomeEmpty DefaultCacheImpl::PutMutableCache(
   mutable_cache_data_size_ -= removed_data_size;
   mutable_cache_data_size_ += updated_data_size;
 
-  // do not add protected keys to lru
-  if (mutable_cache_lru_ && !protected_keys_.IsProtected(key)) {
+  if (!mutable_cache_lru_) {
+    return NoError();
+  }
+
+  auto tick = first_tick;
+  for (const auto& item : items) {
+    const auto& key = item.first;
     ValueProperties props;
-    props.size = item_size;
+    props.size = item.second.size();
     props.expiry = expiry;
+    props.tick = tick++;
+
+    // do not add protected keys to lru
+    if (protected_keys_.IsProtected(key)) {
+      continue;
+    }
+
     const auto result = mutable_cache_lru_->InsertOrAssign(key, props);
     if (result.first == mutable_cache_lru_->end() && !result.second) {
       OLP_SDK_LOG_WARNING_F(
@@ -719,20 +1148,36 @@ OperationOutcomeEmpty DefaultCacheImpl::PutMutableCache(
   return NoError();
 }
 
+void DefaultCacheImpl::PutMemoryCache(const std::string& key,
+                                      const boost::any& value, time_t expiry,
+                                      size_t size) {
+  if (!memory_cache_) {
+    return;
+  }
+
+  const bool result = memory_cache_->Put(
+      key, value, GetExpiryForMemoryCache(key, expiry), size);
+  if (!result && size > settings_.max_memory_cache_size && !mutable_cache_) {
+    OLP_SDK_LOG_INFO_F(kLogTag,
+                       "Failed to store value in memory cache %s, size %d",
+                       key.c_str(), static_cast<int>(size));
+  }
+}
+
 DefaultCache::StorageOpenResult DefaultCacheImpl::SetupStorage() {
   auto result = DefaultCache::Success;
 
-  memory_cache_.reset();
-  mutable_cache_.reset();
+  if (memory_cache_) {
+    memory_cache_->Clear();
+  }
+
+  ApplyPendingPromotions();
+  CloseDiskCache(mutable_cache_, closed_mutable_database_);
   mutable_cache_lru_.reset();
-  protected_cache_.reset();
+  CloseDiskCache(protected_cache_, closed_protected_database_);
   protected_keys_ = ProtectedKeyList();
   mutable_cache_data_size_ = 0;
 
-  if (settings_.max_memory_cache_size > 0) {
-    memory_cache_.reset(new InMemoryCache(settings_.max_memory_cache_size));
-  }
-
   if (settings_.disk_path_mutable) {
     result = SetupMutableCache();
   }
@@ -749,6 +1194,14 @@ DefaultCache::StorageOpenResult DefaultCacheImpl::SetupStorage() {
 }
 
 DefaultCache::StorageOpenResult DefaultCacheImpl::SetupProtectedCache() {
+  if (!closed_protected_database_.expired()) {
+    OLP_SDK_LOG_ERROR_F(kLogTag,
+                        "Failed to open protected cache %s - the closed cache "
+                        "is used by value views",
+                        settings_.disk_path_protected.get().c_str());
+    return StorageOpenResult::OpenDiskPathFailure;
+  }
+
   protected_cache_ = std::make_unique<DiskCache>(settings_.extend_permissions);
 
   // Storage settings for protected cache are different. We want to specify the
@@ -802,6 +1255,14 @@ DefaultCache::StorageOpenResult DefaultCacheImpl::SetupProtectedCache() {
 }
 
 DefaultCache::StorageOpenResult DefaultCacheImpl::SetupMutableCache() {
+  if (!closed_mutable_database_.expired()) {
+    OLP_SDK_LOG_ERROR_F(kLogTag,
+                        "Failed to open the mutable cache %s - the closed "
+                        "cache is used by value views",
+                        settings_.disk_path_mutable.get().c_str());
+    return StorageOpenResult::OpenDiskPathFailure;
+  }
+
   auto storage_settings = CreateStorageSettings(settings_);
 
   mutable_cache_ = std::make_unique<DiskCache>(settings_.extend_permissions);
@@ -818,28 +1279,69 @@ DefaultCache::StorageOpenResult DefaultCacheImpl::SetupMutableCache() {
     return StorageOpenResult::OpenDiskPathFailure;
   }
 
-  // read protected keys
-  auto result = mutable_cache_->Get(kProtectedKeys);
-  if (result) {
-    auto value = result.MoveResult();
-    if (!protected_keys_.Deserialize(value)) {
-      OLP_SDK_LOG_WARNING(kLogTag, "Deserialize protected keys failed");
-    }
-  }
+  LoadProtectedKeys();
 
   if (settings_.max_disk_storage != kMaxDiskSize &&
       settings_.eviction_policy == EvictionPolicy::kLeastRecentlyUsed) {
     InitializeLru();
   } else {
     mutable_cache_data_size_ = mutable_cache_->Size();
+
+    // Keys written without LRU have no metadata, so the next open with LRU
+    // must do a full scan.
+    uint64_t removed_data_size = 0u;
+    if (!IsReadOnly(settings_) &&
+        mutable_cache_->Contains(kLruMetadataVersionKey)) {
+      mutable_cache_->Remove(kLruMetadataVersionKey, removed_data_size);
+    }
   }
 
   return DefaultCache::Success;
 }
 
+void DefaultCacheImpl::LoadProtectedKeys() {
+  leveldb::ReadOptions options;
+  options.fill_cache = false;
+  auto it = mutable_cache_->NewIterator(options);
+  const leveldb::Slice prefix(ProtectedKeyList::kStorageKeyPrefix);
+
+  for (it->Seek(prefix); it->Valid() && it->key().starts_with(prefix);
+       it->Next()) {
+    auto key = it->key();
+    key.remove_prefix(prefix.size());
+    protected_keys_.Load(key.ToString());
+  }
+
+  // Older SDK versions store the whole list as one value, it is moved to the
+  // separate entries.
+  auto result = mutable_cache_->Get(kProtectedKeys);
+  if (!result) {
+    return;
+  }
+
+  if (!protected_keys_.Deserialize(result.MoveResult())) {
+    OLP_SDK_LOG_WARNING(kLogTag, "Deserialize protected keys failed");
+    return;
+  }
+
+  if (IsReadOnly(settings_)) {
+    return;
+  }
+
+  auto batch = std::make_unique<leveldb::WriteBatch>();
+  MaybeUpdatedProtectedKeys(*batch);
+  batch->Delete(kProtectedKeys);
+  auto apply_result = mutable_cache_->ApplyBatch(std::move(batch));
+  OLP_SDK_LOG_INFO_F(kLogTag,
+                     "Migrated the list of protected keys, count=%" PRIu64
+                     ", result=%s",
+                     protected_keys_.Count(),
+                     apply_result.IsSuccessful() ? "true" : "false");
+}
+
 void DefaultCacheImpl::DestroyCache(DefaultCache::CacheType type) {
   if (type == DefaultCache::CacheType::kMutable) {
-    if (mutable_cache_ && protected_keys_.IsDirty()) {
+    if (mutable_cache_ && protected_keys_.IsDirty() && !IsReadOnly(settings_)) {
       auto batch = std::make_unique<leveldb::WriteBatch>();
       MaybeUpdatedProtectedKeys(*batch);
       auto result = mutable_cache_->ApplyBatch(std::move(batch));
@@ -848,12 +1350,23 @@ void DefaultCacheImpl::DestroyCache(DefaultCache::CacheType type) {
                          result.IsSuccessful() ? "true" : "false");
     }
 
-    mutable_cache_.reset();
+    ApplyPendingPromotions();
+    StoreLruOrder();
+
+    CloseDiskCache(mutable_cache_, closed_mutable_database_);
     mutable_cache_lru_.reset();
     protected_keys_ = ProtectedKeyList();
     mutable_cache_data_size_ = 0;
   } else {
-    protected_cache_.reset();
+    CloseDiskCache(protected_cache_, closed_protected_database_);
+  }
+}
+
+void DefaultCacheImpl::CloseDiskCache(std::unique_ptr<DiskCache>& disk_cache,
+                                      std::weak_ptr<void>& closed_database) {
+  if (disk_cache) {
+    closed_database = disk_cache->GetSharedDatabase();
+    disk_cache.reset();
   }
 }
 
@@ -862,17 +1375,28 @@ OperationOutcomeEmpty DefaultCacheImpl::GetFromDiskCache(
     time_t& expiry) {
   // Make sure we do not get a dirty entry
   value = nullptr;
+
+  return GetFromDiskCache(
+      key,
+      [&](DiskCache& disk_cache) -> OperationOutcomeEmpty {
+        auto result = disk_cache.Get(key);
+        if (!result) {
+          return result.GetError();
+        }
+        value = result.MoveResult();
+        return NoError();
+      },
+      expiry);
+}
+
+OperationOutcomeEmpty DefaultCacheImpl::GetFromDiskCache(
+    const std::string& key, const DiskCacheReader& reader, time_t& expiry) {
   expiry = KeyValueCache::kDefaultExpiry;
 
   if (protected_cache_) {
-    auto result = protected_cache_->Get(key);
-    if (result) {
-      value = result.MoveResult();
-      expiry = GetRemainingExpiryTime(key, *protected_cache_);
-      if (expiry > 0) {
-        return NoError();
-      }
-      value = nullptr;
+    expiry = GetRemainingExpiryTime(key, *protected_cache_);
+    if (expiry > 0 && reader(*protected_cache_)) {
+      return NoError();
     }
   }
 
@@ -890,16 +1414,11 @@ OperationOutcomeEmpty DefaultCacheImpl::GetFromDiskCache(
         return client::ApiError::NotFound();
       }
 
-      auto result = mutable_cache_->Get(key);
-      if (!result) {
-        return result.GetError();
-      }
-
-      value = result.MoveResult();
-      return NoError();
+      return reader(*mutable_cache_);
     }
 
     // Data expired in cache -> remove, but not protected keys
+    RemoveKeyMetadata(key);
     uint64_t removed_data_size = 0u;
     if (!PurgeDiskItem(key, *mutable_cache_, removed_data_size)) {
       OLP_SDK_LOG_ERROR_F(
@@ -913,6 +1432,69 @@ OperationOutcomeEmpty DefaultCacheImpl::GetFromDiskCache(
   return client::ApiError::NotFound();
 }
 
+void DefaultCacheImpl::GetFromDiskCache(const KeyValueCache::KeyListType& keys,
+                                        std::vector<size_t> indexes,
+                                        KeyValueCache::ValueListType& values) {
+  if (protected_cache_ && !indexes.empty()) {
+    auto result = protected_cache_->GetBatch(CreateLookupKeys(keys, indexes));
+    if (result) {
+      const auto& lookup_values = result.GetResult();
+      std::vector<size_t> not_found;
+
+      for (size_t i = 0u; i < indexes.size(); ++i) {
+        const auto index = indexes[i];
+        const auto& value = lookup_values[2u * i];
+        const auto expiry = GetRemainingExpiryTime(lookup_values[2u * i + 1u]);
+        if (!value || expiry <= 0) {
+          not_found.push_back(index);
+          continue;
+        }
+
+        values[index] = value;
+        PutMemoryCache(keys[index], value, expiry, value->size());
+      }
+
+      indexes.swap(not_found);
+    }
+  }
+
+  if (!mutable_cache_ || indexes.empty()) {
+    return;
+  }
+
+  auto result = mutable_cache_->GetBatch(CreateLookupKeys(keys, indexes));
+  if (!result) {
+    return;
+  }
+
+  const auto& lookup_values = result.GetResult();
+  for (size_t i = 0u; i < indexes.size(); ++i) {
+    const auto& key = keys[indexes[i]];
+    const auto& value = lookup_values[2u * i];
+    const auto expiry = GetRemainingExpiryTime(lookup_values[2u * i + 1u]);
+
+    if (expiry > 0 || protected_keys_.IsProtected(key)) {
+      // If not found in LRU or not protected the value is not valid
+      if (value && PromoteKeyLru(key)) {
+        values[indexes[i]] = value;
+        PutMemoryCache(key, value, expiry, value->size());
+      }
+      continue;
+    }
+
+    // Data expired in cache -> remove, but not protected keys
+    RemoveKeyMetadata(key);
+    uint64_t removed_data_size = 0u;
+    if (!PurgeDiskItem(key, *mutable_cache_, removed_data_size)) {
+      OLP_SDK_LOG_ERROR_F(
+          kLogTag, "GetFromDiskCache failed to purge an expired item, key='%s'",
+          key.c_str());
+    }
+    mutable_cache_data_size_ -= removed_data_size;
+    RemoveKeyLru(key);
+  }
+}
+
 boost::optional<std::pair<std::string, time_t>>
 DefaultCacheImpl::GetFromDiscCache(const std::string& key) {
   KeyValueCache::ValueTypePtr value = nullptr;
@@ -1052,6 +1634,7 @@ uint64_t DefaultCacheImpl::Size(uint64_t new_size) {
 
 void DefaultCacheImpl::Promote(const std::string& key) {
   std::lock_guard<std::mutex> lock(cache_lock_);
+  ApplyPendingPromotions();
   if (mutable_cache_lru_) {
     mutable_cache_lru_->Find(key);
   }
@@ -1059,12 +1642,19 @@ void DefaultCacheImpl::Promote(const std::string& key) {
 
 OperationOutcome<KeyValueCache::ValueTypePtr> DefaultCacheImpl::Read(
     const std::string& key) {
+  if (!promotion_buffers_.empty()) {
+    auto value = GetFromMemoryCacheUnlocked(key);
+    if (!value.empty()) {
+      return boost::any_cast<KeyValueCache::ValueTypePtr>(value);
+    }
+  }
+
   std::lock_guard<std::mutex> lock(cache_lock_);
   if (!is_open_) {
     return client::ApiError::PreconditionFailed();
   }
 
-  if (memory_cache_) {
+  if (memory_cache_ && promotion_buffers_.empty()) {
     auto value = memory_cache_->Get(key);
     if (!value.empty()) {
       PromoteKeyLru(key);
@@ -1087,6 +1677,50 @@ OperationOutcome<KeyValueCache::ValueTypePtr> DefaultCacheImpl::Read(
   return client::ApiError::NotFound();
 }
 
+OperationOutcome<ValueView> DefaultCacheImpl::ReadView(
+    const std::string& key) {
+  if (!promotion_buffers_.empty()) {
+    auto value = GetFromMemoryCacheUnlocked(key);
+    if (!value.empty()) {
+      return ValueView(boost::any_cast<KeyValueCache::ValueTypePtr>(value));
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(cache_lock_);
+  if (!is_open_) {
+    return client::ApiError::PreconditionFailed();
+  }
+
+  if (memory_cache_ && promotion_buffers_.empty()) {
+    auto value = memory_cache_->Get(key);
+    if (!value.empty()) {
+      PromoteKeyLru(key);
+      return ValueView(boost::any_cast<KeyValueCache::ValueTypePtr>(value));
+    }
+  }
+
+  // The view points to the database blocks, it is not put to the memory cache
+  // as this would copy the value.
+  ValueView view;
+  time_t expiry = KeyValueCache::kDefaultExpiry;
+
+  auto result = GetFromDiskCache(
+      key,
+      [&](DiskCache& disk_cache) -> OperationOutcomeEmpty {
+        auto result = disk_cache.GetView(key);
+        if (!result) {
+          return result.GetError();
+        }
+        view = result.MoveResult();
+        return NoError();
+      },
+      expiry);
+  if (result && !view.empty()) {
+    return view;
+  }
+  return client::ApiError::NotFound();
+}
+
 OperationOutcomeEmpty DefaultCacheImpl::Write(
     const std::string& key, const KeyValueCache::ValueTypePtr& value,
     time_t expiry) {
@@ -1099,22 +1733,67 @@ OperationOutcomeEmpty DefaultCacheImpl::Write(
     return client::ApiError::PreconditionFailed();
   }
 
-  if (memory_cache_) {
-    const auto size = value->size();
-    const bool result = memory_cache_->Put(
-        key, value, GetExpiryForMemoryCache(key, expiry), size);
-    if (!result && size > settings_.max_memory_cache_size && !mutable_cache_) {
-      OLP_SDK_LOG_INFO_F(kLogTag,
-                         "Failed to store value in memory cache %s, size %d",
-                         key.c_str(), static_cast<int>(size));
-    }
-  }
+  PutMemoryCache(key, value, expiry, value->size());
 
   leveldb::Slice slice(reinterpret_cast<const char*>(value->data()),
                        value->size());
   return PutMutableCache(key, slice, expiry);
 }
 
+OperationOutcomeEmpty DefaultCacheImpl::WriteBatch(
+    const KeyValueCache::KeyValueListType& items, time_t expiry) {
+  std::vector<MutableCacheItem> mutable_items;
+  mutable_items.reserve(items.size());
+  for (const auto& item : items) {
+    if (!item.second) {
+      return client::ApiError::InvalidArgument();
+    }
+
+    mutable_items.emplace_back(
+        item.first,
+        leveldb::Slice(reinterpret_cast<const char*>(item.second->data()),
+                       item.second->size()));
+  }
+
+  std::lock_guard<std::mutex> lock(cache_lock_);
+  if (!is_open_) {
+    return client::ApiError::PreconditionFailed();
+  }
+
+  for (const auto& item : items) {
+    PutMemoryCache(item.first, item.second, expiry, item.second->size());
+  }
+
+  return PutMutableCache(mutable_items, expiry);
+}
+
+OperationOutcome<KeyValueCache::ValueListType> DefaultCacheImpl::ReadBatch(
+    const KeyValueCache::KeyListType& keys) {
+  std::lock_guard<std::mutex> lock(cache_lock_);
+  if (!is_open_) {
+    return client::ApiError::PreconditionFailed();
+  }
+
+  KeyValueCache::ValueListType values(keys.size());
+  std::vector<size_t> disk_indexes;
+
+  for (size_t index = 0u; index < keys.size(); ++index) {
+    if (memory_cache_) {
+      auto value = memory_cache_->Get(keys[index]);
+      if (!value.empty()) {
+        PromoteKeyLru(keys[index]);
+        values[index] = boost::any_cast<KeyValueCache::ValueTypePtr>(value);
+        continue;
+      }
+    }
+
+    disk_indexes.push_back(index);
+  }
+
+  GetFromDiskCache(keys, std::move(disk_indexes), values);
+  return values;
+}
+
 OperationOutcomeEmpty DefaultCacheImpl::Delete(const std::string& key) {
   std::lock_guard<std::mutex> lock(cache_lock_);
 
@@ -1136,6 +1815,7 @@ OperationOutcomeEmpty DefaultCacheImpl::Delete(const std::string& key) {
     memory_cache_->Remove(key);
   }
 
+  RemoveKeyMetadata(key);
   RemoveKeyLru(key);
 
   if (mutable_cache_) {
@@ -1173,6 +1853,18 @@ OperationOutcomeEmpty DefaultCacheImpl::DeleteByPrefix(
   // the start
   RemoveKeysWithPrefixLru(prefix);
 
+  if (mutable_cache_ && mutable_cache_lru_) {
+    const auto metadata_prefix_size = strlen(kLruMetadataPrefix);
+    auto metadata_filter = [&](const std::string& metadata_key) {
+      return filter(metadata_key.substr(metadata_prefix_size));
+    };
+
+    uint64_t removed_data_size = 0;
+    mutable_cache_->RemoveKeysWithPrefix(CreateLruMetadataKey(prefix),
+                                         removed_data_size, metadata_filter);
+    mutable_cache_data_size_ -= removed_data_size;
+  }
+
   if (mutable_cache_) {
     uint64_t removed_data_size = 0;
     auto result =
@@ -21,13 +21,19 @@
 
 #include "olp/core/cache/DefaultCache.h"
 
+#include <atomic>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include <olp/core/utils/HashLruCache.h>
 #include "DiskCache.h"
-#include "InMemoryCache.h"
 #include "ProtectedKeyList.h"
+#include "ShardedInMemoryCache.h"
 
 namespace olp {
 namespace cache {
@@ -69,11 +75,16 @@ class DefaultCacheImpl {
   void Promote(const std::string& key);
 
   OperationOutcome<KeyValueCache::ValueTypePtr> Read(const std::string& key);
+  OperationOutcome<ValueView> ReadView(const std::string& key);
   OperationOutcomeEmpty Write(const std::string& key,
                               const KeyValueCache::ValueTypePtr& value,
                               time_t expiry);
   OperationOutcomeEmpty Delete(const std::string& key);
   OperationOutcomeEmpty DeleteByPrefix(const std::string& prefix);
+  OperationOutcomeEmpty WriteBatch(const KeyValueCache::KeyValueListType& items,
+                                   time_t expiry);
+  OperationOutcome<KeyValueCache::ValueListType> ReadBatch(
+      const KeyValueCache::KeyListType& keys);
 
   uint64_t Size(DefaultCache::CacheType type) const;
   uint64_t Size(uint64_t new_size);
@@ -83,11 +94,13 @@ class DefaultCacheImpl {
   struct ValueProperties {
     size_t size{0ull};
     time_t expiry{KeyValueCache::kDefaultExpiry};
+    /// The position in the persisted LRU order, higher is more recent.
+    uint64_t tick{0ull};
   };
 
   /// The LRU cache definition using the leveldb keys as key and the value size
   /// as value.
-  using DiskLruCache = utils::LruCache<std::string, ValueProperties>;
+  using DiskLruCache = utils::HashLruCache<std::string, ValueProperties>;
 
   /// Returns LRU mutable cache, used for tests.
   const std::unique_ptr<DiskLruCache>& GetMutableCacheLru() const {
@@ -105,7 +118,7 @@ class DefaultCacheImpl {
   }
 
   /// Returns memory cache, used for tests.
-  const std::unique_ptr<InMemoryCache>& GetMemoryCache() const {
+  const std::unique_ptr<ShardedInMemoryCache>& GetMemoryCache() const {
     return memory_cache_;
   }
 
@@ -116,6 +129,9 @@ class DefaultCacheImpl {
   void SetEvictionPortion(uint64_t size);
 
  private:
+  /// The key and the value to be put into the mutable cache.
+  using MutableCacheItem = std::pair<std::string, leveldb::Slice>;
+
   /// Represents intermediate eviction result.
   struct EvictionResult {
     /// Number of evicted elements.
@@ -124,12 +140,34 @@ class DefaultCacheImpl {
     uint64_t size;
   };
 
+  /// LRU promotions of the memory cache hits, buffered per memory cache
+  /// segment.
+  struct PromotionBuffer {
+    std::mutex mutex;
+    std::vector<std::string> keys;
+  };
+
   /// Add single key to LRU.
   bool AddKeyLru(std::string key, const leveldb::Slice& value);
 
   /// Initializes LRU mutable cache if possible.
   void InitializeLru();
 
+  /// Restores the LRU from the persisted metadata keys. Returns false if the
+  /// metadata is missing or broken and a full scan is needed.
+  bool InitializeLruFromMetadata();
+
+  /// Writes the metadata of every key after a full scan, so that the next
+  /// open can skip the scan.
+  void StoreLruMetadata(
+      const std::map<std::string, ValueProperties>& protected_properties);
+
+  /// Persists the LRU positions of the keys promoted since the last open.
+  void StoreLruOrder();
+
+  /// Removes the persisted metadata of the key.
+  void RemoveKeyMetadata(const std::string& key);
+
   /// Removes key from the mutable lru cache;
   bool RemoveKeyLru(const std::string& key);
 
@@ -140,6 +178,13 @@ class DefaultCacheImpl {
   /// otherwise.
   bool PromoteKeyLru(const std::string& key);
 
+  /// Looks up the memory cache without taking the cache lock, the LRU
+  /// promotion of a hit is buffered. Used only with memory cache segments.
+  boost::any GetFromMemoryCacheUnlocked(const std::string& key);
+
+  /// Applies the buffered LRU promotions.
+  void ApplyPendingPromotions();
+
   /// Returns evicted data size.
   uint64_t MaybeEvictData();
 
@@ -164,18 +209,50 @@ class DefaultCacheImpl {
                                         const leveldb::Slice& value,
                                         time_t expiry);
 
+  /// Puts the list of items into the mutable cache with one write batch.
+  OperationOutcomeEmpty PutMutableCache(
+      const std::vector<MutableCacheItem>& items, time_t expiry);
+
+  /// Puts data into the memory cache
+  void PutMemoryCache(const std::string& key, const boost::any& value,
+                      time_t expiry, size_t size);
+
   DefaultCache::StorageOpenResult SetupStorage();
 
   DefaultCache::StorageOpenResult SetupProtectedCache();
 
   DefaultCache::StorageOpenResult SetupMutableCache();
 
+  /// Reads the protected keys, and moves the list stored as one value by the
+  /// older SDK versions to the separate entries.
+  void LoadProtectedKeys();
+
   void DestroyCache(DefaultCache::CacheType type);
 
+  /// Closes the disk cache and keeps its database while the value views use
+  /// it, so the cache is not opened again until the views are released.
+  void CloseDiskCache(std::unique_ptr<DiskCache>& disk_cache,
+                      std::weak_ptr<void>& closed_database);
+
+  /// Reads the value of the key from one of the disk caches.
+  using DiskCacheReader = std::function<OperationOutcomeEmpty(DiskCache&)>;
+
   OperationOutcomeEmpty GetFromDiskCache(const std::string& key,
                                          KeyValueCache::ValueTypePtr& value,
                                          time_t& expiry);
 
+  /// Looks for the key in the protected and then in the mutable cache, and
+  /// calls the reader for the first cache that has a valid entry.
+  OperationOutcomeEmpty GetFromDiskCache(const std::string& key,
+                                         const DiskCacheReader& reader,
+                                         time_t& expiry);
+
+  /// Reads the keys with the specified indexes from the disk caches. The
+  /// found values are stored in the values list at the same indexes.
+  void GetFromDiskCache(const KeyValueCache::KeyListType& keys,
+                        std::vector<size_t> indexes,
+                        KeyValueCache::ValueListType& values);
+
   boost::optional<std::pair<std::string, time_t>> GetFromDiscCache(
       const std::string& key);
 
@@ -183,14 +260,18 @@ class DefaultCacheImpl {
                                  const time_t& expiry) const;
 
   CacheSettings settings_;
-  bool is_open_;
-  std::unique_ptr<InMemoryCache> memory_cache_;
+  std::atomic<bool> is_open_;
+  std::unique_ptr<ShardedInMemoryCache> memory_cache_;
   std::unique_ptr<DiskCache> mutable_cache_;
   std::unique_ptr<DiskLruCache> mutable_cache_lru_;
   std::unique_ptr<DiskCache> protected_cache_;
+  std::weak_ptr<void> closed_mutable_database_;
+  std::weak_ptr<void> closed_protected_database_;
   uint64_t mutable_cache_data_size_;
+  uint64_t lru_tick_;
   ProtectedKeyList protected_keys_;
   mutable std::mutex cache_lock_;
+  std::vector<PromotionBuffer> promotion_buffers_;
   uint64_t eviction_portion_;
 };
 
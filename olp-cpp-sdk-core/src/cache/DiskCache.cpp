@@ -19,6 +19,7 @@
 
 #include "DiskCache.h"
 
+#include <algorithm>
 #include <iterator>
 #include <memory>
 #include <string>
@@ -146,6 +147,24 @@ int CheckCompactionFinished(leveldb::DB& db) {
   return false;
 }
 
+// Owns the database together with everything it uses, so the database can
+// outlive the DiskCache while there are value views pinned to it. The
+// database is declared last and destroyed first.
+struct DatabaseOwner {
+  std::shared_ptr<leveldb::Env> env;
+  std::shared_ptr<leveldb::Env> environment;
+  std::shared_ptr<const leveldb::FilterPolicy> filter_policy;
+  std::shared_ptr<leveldb::Logger> logger;
+  std::unique_ptr<leveldb::DB> database;
+};
+
+// Owns the iterator which pins the value of a view. The iterator is declared
+// last and destroyed before the database.
+struct IteratorOwner {
+  std::shared_ptr<leveldb::DB> database;
+  std::unique_ptr<leveldb::Iterator> iterator;
+};
+
 }  // anonymous namespace
 
 DiskCache::DiskCache(bool extend_permissions)
@@ -161,6 +180,13 @@ void DiskCache::Close() {
     compaction_thread_.join();
   }
 
+  if (database_ && database_.use_count() > 1) {
+    OLP_SDK_LOG_WARNING_F(kLogTag,
+                          "Close: database is kept open by value views, "
+                          "path='%s'",
+                          disk_cache_path_.c_str());
+  }
+
   database_.reset();
   filter_policy_.reset();
 }
@@ -293,7 +319,7 @@ OpenResult DiskCache::Open(const std::string& data_path,
     } else if (RepairCache(versioned_data_path)) {
       status = leveldb::DB::Open(open_options, versioned_data_path, &db);
       if (status.ok()) {
-        database_.reset(db);
+        SetDatabase(db);
         return OpenResult::Repaired;
       }
     }
@@ -318,11 +344,22 @@ OpenResult DiskCache::Open(const std::string& data_path,
     return OpenResult::Corrupted;
   }
 
-  database_.swap(tmp_db);
+  SetDatabase(tmp_db.release());
 
   return OpenResult::Success;
 }
 
+void DiskCache::SetDatabase(leveldb::DB* db) {
+  auto owner = std::make_shared<DatabaseOwner>();
+  owner->env = env_;
+  owner->environment = environment_;
+  owner->filter_policy = filter_policy_;
+  owner->logger = leveldb_logger_;
+  owner->database.reset(db);
+
+  database_ = std::shared_ptr<leveldb::DB>(owner, db);
+}
+
 bool DiskCache::Put(const std::string& key, leveldb::Slice slice) {
   if (!database_) {
     OLP_SDK_LOG_ERROR(kLogTag, "Put: Database is not initialized");
@@ -363,6 +400,34 @@ OperationOutcome<KeyValueCache::ValueTypePtr> DiskCache::Get(
   return client::ApiError::NotFound();
 }
 
+OperationOutcome<ValueView> DiskCache::GetView(const std::string& key) {
+  if (!database_) {
+    OLP_SDK_LOG_ERROR(kLogTag, "GetView: Database is not initialized");
+    return client::ApiError::PreconditionFailed();
+  }
+
+  leveldb::ReadOptions options;
+  options.verify_checksums = check_crc_;
+
+  auto owner = std::make_shared<IteratorOwner>();
+  owner->database = database_;
+  owner->iterator.reset(database_->NewIterator(options));
+
+  auto& iterator = *owner->iterator;
+  iterator.Seek(key);
+  if (iterator.Valid() && iterator.key() == key) {
+    // The slice stays valid while the iterator is not moved
+    const auto slice_value = iterator.value();
+    if (!slice_value.empty()) {
+      return ValueView(
+          reinterpret_cast<const unsigned char*>(slice_value.data()),
+          slice_value.size(), std::move(owner));
+    }
+  }
+
+  return client::ApiError::NotFound();
+}
+
 bool DiskCache::Contains(const std::string& key) {
   if (!database_) {
     OLP_SDK_LOG_ERROR(kLogTag, "Get: Database is not initialized");
@@ -403,6 +468,41 @@ DiskCache::OperationOutcome<> DiskCache::Remove(const std::string& key,
   return GetApiError(result);
 }
 
+OperationOutcome<KeyValueCache::ValueListType> DiskCache::GetBatch(
+    const KeyValueCache::KeyListType& keys) {
+  if (!database_) {
+    OLP_SDK_LOG_ERROR(kLogTag, "GetBatch: Database is not initialized");
+    return client::ApiError::PreconditionFailed();
+  }
+
+  // Seek in the key order, so the iterator moves mostly forward
+  std::vector<size_t> order(keys.size());
+  for (size_t index = 0u; index < order.size(); ++index) {
+    order[index] = index;
+  }
+  std::sort(order.begin(), order.end(),
+            [&](size_t lhs, size_t rhs) { return keys[lhs] < keys[rhs]; });
+
+  leveldb::ReadOptions options;
+  options.verify_checksums = check_crc_;
+  auto iterator = NewIterator(options);
+
+  KeyValueCache::ValueListType values(keys.size());
+  for (const auto index : order) {
+    const auto& key = keys[index];
+    iterator->Seek(key);
+    if (iterator->Valid() && iterator->key() == key) {
+      auto slice_value = iterator->value();
+      if (!slice_value.empty()) {
+        values[index] = std::make_shared<KeyValueCache::ValueType>(
+            slice_value.data(), slice_value.data() + slice_value.size());
+      }
+    }
+  }
+
+  return values;
+}
+
 std::unique_ptr<leveldb::Iterator> DiskCache::NewIterator(
     leveldb::ReadOptions options) {
   if (!database_) {
@@ -135,6 +135,15 @@ class DiskCache {
 
   OperationOutcome<KeyValueCache::ValueTypePtr> Get(const std::string& key);
 
+  /// Gets the value of the key without copying it. The view pins the block
+  /// with the value and keeps the database alive until it is released.
+  OperationOutcome<ValueView> GetView(const std::string& key);
+
+  /// Gets the values of the keys with one iterator, so all of them are read
+  /// from the same snapshot. The values of the missing keys are nullptr.
+  OperationOutcome<KeyValueCache::ValueListType> GetBatch(
+      const KeyValueCache::KeyListType& keys);
+
   /// Remove single key/value from DB.
   OperationOutcome<> Remove(const std::string& key,
                             uint64_t& removed_data_size);
@@ -159,6 +168,10 @@ class DiskCache {
   /// precise for read-only
   uint64_t Size() const;
 
+  /// Gets the database shared with the value views. It stays open after
+  /// Close() while any view exists.
+  std::weak_ptr<void> GetSharedDatabase() const { return database_; }
+
  private:
   /// Initialize empty db, so it can be used as protected cache.
   leveldb::Status InitializeDB(const StorageSettings& settings,
@@ -168,12 +181,17 @@ class DiskCache {
   leveldb::Options CreateOpenOptions(const StorageSettings& settings,
                                      bool is_read_only) const;
 
+  /// Takes the ownership of the opened database. The database shares the
+  /// ownership of the environment, the filter policy and the logger.
+  void SetDatabase(leveldb::DB* db);
+
   const std::shared_ptr<leveldb::Env> env_;
   std::string disk_cache_path_;
-  std::unique_ptr<const leveldb::FilterPolicy> filter_policy_;
-  std::unique_ptr<SizeCountingEnv> environment_;
-  std::unique_ptr<LevelDBLogger> leveldb_logger_;
-  std::unique_ptr<leveldb::DB> database_;
+  std::shared_ptr<const leveldb::FilterPolicy> filter_policy_;
+  std::shared_ptr<SizeCountingEnv> environment_;
+  std::shared_ptr<LevelDBLogger> leveldb_logger_;
+  /// Shared with the value views, which keep the database open after Close().
+  std::shared_ptr<leveldb::DB> database_;
   uint64_t max_size_{kSizeMax};
   bool check_crc_{false};
   bool enforce_immediate_flush_{false};
@@ -27,7 +27,7 @@
 #include <tuple>
 #include <vector>
 
-#include <olp/core/utils/LruCache.h>
+#include <olp/core/utils/HashLruCache.h>
 #include <boost/any.hpp>
 
 namespace olp {
@@ -88,8 +88,11 @@ class InMemoryCache {
   void OnEviction(const std::string& key, ItemTuple&& value);
 
  private:
+  using ItemTuplesLru =
+      utils::HashLruCache<std::string, ItemTuple, ModelCacheCostFunc>;
+
   mutable std::mutex mutex_;
-  utils::LruCache<std::string, ItemTuple, ModelCacheCostFunc> item_tuples_;
+  ItemTuplesLru item_tuples_;
   std::map<time_t, ItemTuples> item_expiries_;
   TimeProvider time_provider_;
 };
@@ -20,6 +20,7 @@
 #include "ProtectedKeyList.h"
 
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -35,22 +36,43 @@ class ReadBuffer : public std::basic_streambuf<char> {
   ReadBuffer(char* p, size_t l) { setg(p, p, p + l); }
 };
 
-bool IsPrefix(const std::string& prefix, const std::string& key) {
-  return (key.size() > prefix.size() &&
-          std::equal(prefix.begin(), prefix.end(), key.begin()));
+// Length of the common prefix of the label and the key starting at pos
+size_t CommonPrefixLength(const std::string& label, const std::string& key,
+                          size_t pos) {
+  const auto max_length = std::min(label.size(), key.size() - pos);
+  size_t length = 0u;
+  while (length < max_length && label[length] == key[pos + length]) {
+    ++length;
+  }
+  return length;
+}
+
+// Finds the child with the label starting with the character, or the position
+// to insert it
+template <typename Children>
+auto FindChild(Children& children, char c) -> decltype(children.begin()) {
+  return std::lower_bound(children.begin(), children.end(), c,
+                          [](const typename Children::value_type& child,
+                             char value) { return child->label[0] < value; });
+}
+
+template <typename Children, typename Iterator>
+bool IsChildFound(const Children& children, Iterator it, char c) {
+  return it != children.end() && (*it)->label[0] == c;
 }
 
-bool IsEqualOrPrefix(const std::string& prefix, const std::string& key) {
-  return (key.size() >= prefix.size() &&
-          std::equal(prefix.begin(), prefix.end(), key.begin()));
+std::uint64_t StorageSize(const std::string& key) {
+  return strlen(olp::cache::ProtectedKeyList::kStorageKeyPrefix) + key.size();
 }
 }  // namespace
 
 namespace olp {
 namespace cache {
 
+constexpr const char* ProtectedKeyList::kStorageKeyPrefix;
+
 ProtectedKeyList::ProtectedKeyList()
-    : protected_data_(), size_written_(0), dirty_(false) {}
+    : root_(), count_(0), size_written_(0), changes_() {}
 
 bool ProtectedKeyList::Deserialize(KeyValueCache::ValueTypePtr value) {
   if (!value) {
@@ -61,32 +83,39 @@ bool ProtectedKeyList::Deserialize(KeyValueCache::ValueTypePtr value) {
   std::istream stream(&buf);
 
   for (std::string str; std::getline(stream, str, '\0');) {
-    protected_data_.insert(str);
+    Insert(str, true);
   }
-  dirty_ = false;
-  size_written_ = value->size();
   return true;
 }
 
-KeyValueCache::ValueTypePtr ProtectedKeyList::Serialize() {
-  auto value = std::make_shared<std::vector<unsigned char>>();
-  auto size = 0;
-  for (const auto& key : protected_data_) {
-    size += key.length() + 1;
+void ProtectedKeyList::Load(const std::string& key) {
+  if (Insert(key, false)) {
+    size_written_ += StorageSize(key);
   }
-  if (size > 0) {
-    value->reserve(size);
+}
 
-    for (const auto& key : protected_data_) {
-      value->insert(value->end(), key.begin(), key.end());
-      if (key.back() != '\0') {
-        value->emplace_back('\0');
-      }
+ProtectedKeyList::Changes ProtectedKeyList::TakeChanges() {
+  Changes changes;
+  changes.swap(changes_);
+
+  // the recorded value is the persisted state, the keys changed back to it
+  // are skipped
+  for (auto it = changes.begin(); it != changes.end();) {
+    const bool is_protected = Contains(it->first);
+    if (is_protected == it->second) {
+      it = changes.erase(it);
+      continue;
     }
+
+    if (is_protected) {
+      size_written_ += StorageSize(it->first);
+    } else {
+      size_written_ -= StorageSize(it->first);
+    }
+    it->second = is_protected;
+    ++it;
   }
-  dirty_ = false;
-  size_written_ = value->size();
-  return value;
+  return changes;
 }
 
 bool ProtectedKeyList::Protect(
@@ -94,23 +123,7 @@ bool ProtectedKeyList::Protect(
     const ProtectedKeyChanged& change_key_to_protected) {
   auto was_updated = false;
   for (const auto& key : keys) {
-    // find key or prefix
-    auto hint = protected_data_.lower_bound(key);
-    if (hint != protected_data_.end()) {
-      // if hint is prefix for this key, ignore this key, it is allready
-      // protected
-      if (IsPrefix(*hint, key)) {
-        continue;
-      }
-      // if key is prefix for hint key, remove hint and add prefix
-      while (hint != protected_data_.end() && IsPrefix(key, *hint)) {
-        hint = protected_data_.erase(hint);
-      }
-    }
-    // add protected key
-    auto res = protected_data_.insert(hint, key);
-    if (res != hint) {
-      dirty_ = true;
+    if (Insert(key, true)) {
       was_updated = true;
       // notify that key now is protected
       change_key_to_protected(key);
@@ -122,56 +135,196 @@ bool ProtectedKeyList::Protect(
 bool ProtectedKeyList::Release(const KeyValueCache::KeyListType& keys) {
   auto result = false;
   for (const auto& key : keys) {
-    // find key or prefix
-    auto hint = protected_data_.lower_bound(key);
-    if (hint != protected_data_.end()) {
-      // if hint is prefix for this key, it is allready protected, could not
-      // unprotect one key, return error
-      if (IsPrefix(*hint, key)) {
-        OLP_SDK_LOG_WARNING_F(kLogTag,
-                              "Prefix is stored for key='%s', prefix='%s'",
-                              key.c_str(), (*hint).c_str());
-        result = false;
+    Node* node = &root_;
+    std::string path;
+    size_t pos = 0u;
+    bool prefix_protected = node->is_key && !key.empty();
+
+    while (!prefix_protected) {
+      if (key.empty()) {
+        // empty key is the prefix of all keys
+        if (node->is_key || !node->children.empty()) {
+          RemoveKeys(*node, path);
+          node->is_key = false;
+          node->children.clear();
+          result = true;
+        }
         break;
       }
-      // if key is equal of prefix for hint key, remove hint, notify that key is
-      // not longer protected (need to notify for all keys for this prefix)
-      while (hint != protected_data_.end() && IsEqualOrPrefix(key, *hint)) {
-        hint = protected_data_.erase(hint);
-        dirty_ = true;
+
+      auto it = FindChild(node->children, key[pos]);
+      if (!IsChildFound(node->children, it, key[pos])) {
+        break;
+      }
+
+      auto& child = *it;
+      const auto length = CommonPrefixLength(child->label, key, pos);
+      if (pos + length == key.size()) {
+        // key is equal or prefix for all the keys in the subtree, remove them
+        path.append(child->label);
+        RemoveKeys(*child, path);
+        node->children.erase(it);
         result = true;
+
+        // the node without key and with one child is merged with the child
+        if (node != &root_ && !node->is_key && node->children.size() == 1u) {
+          auto merged = std::move(node->children.front());
+          node->label.append(merged->label);
+          node->is_key = merged->is_key;
+          node->children = std::move(merged->children);
+        }
+        break;
       }
+
+      if (length < child->label.size()) {
+        break;
+      }
+
+      path.append(child->label);
+      pos += length;
+      node = child.get();
+      prefix_protected = node->is_key;
+    }
+
+    // if some prefix of this key is protected, could not unprotect one key,
+    // return error
+    if (prefix_protected) {
+      OLP_SDK_LOG_WARNING_F(kLogTag,
+                            "Prefix is stored for key='%s', prefix='%s'",
+                            key.c_str(), path.c_str());
+      result = false;
+      break;
     }
   }
   return result;
 }
 
 bool ProtectedKeyList::IsProtected(const std::string& key) const {
-  if (protected_data_.empty()) {
-    return false;
+  const Node* node = &root_;
+  size_t pos = 0u;
+  while (!node->is_key) {
+    if (pos == key.size()) {
+      return false;
+    }
+
+    auto it = FindChild(node->children, key[pos]);
+    if (!IsChildFound(node->children, it, key[pos])) {
+      return false;
+    }
+
+    const auto& label = (*it)->label;
+    if (key.compare(pos, label.size(), label) != 0) {
+      return false;
+    }
+
+    pos += label.size();
+    node = it->get();
   }
+  // the key or its prefix is stored
+  return true;
+}
 
-  auto it = protected_data_.lower_bound(key);
-  if (it == protected_data_.end()) {
-    return false;
+std::uint64_t ProtectedKeyList::Size() const { return size_written_; }
+
+bool ProtectedKeyList::IsDirty() const { return !changes_.empty(); }
+
+std::uint64_t ProtectedKeyList::Count() const { return count_; }
+
+std::string ProtectedKeyList::StorageKey(const std::string& key) {
+  return kStorageKeyPrefix + key;
+}
+
+bool ProtectedKeyList::Insert(const std::string& key, bool record_change) {
+  Node* node = &root_;
+  size_t pos = 0u;
+  while (pos < key.size()) {
+    // if some prefix of the key is stored, the key is already protected
+    if (node->is_key) {
+      return false;
+    }
+
+    auto& children = node->children;
+    auto it = FindChild(children, key[pos]);
+    if (!IsChildFound(children, it, key[pos])) {
+      std::unique_ptr<Node> leaf(new Node);
+      leaf->label = key.substr(pos);
+      leaf->is_key = true;
+      children.insert(it, std::move(leaf));
+      ++count_;
+      if (record_change) {
+        RecordChange(key, false);
+      }
+      return true;
+    }
+
+    auto& child = *it;
+    const auto length = CommonPrefixLength(child->label, key, pos);
+    if (length < child->label.size()) {
+      // split the child label at the end of the common prefix
+      std::unique_ptr<Node> split(new Node);
+      split->label = child->label.substr(0u, length);
+      child->label.erase(0u, length);
+      split->children.push_back(std::move(child));
+      child = std::move(split);
+    }
+
+    pos += length;
+    node = child.get();
   }
-  // need to check if keys equal, but only case when prefix stored, not
-  // othervise
-  if (key.length() < (*it).length()) {
+
+  if (node->is_key) {
     return false;
   }
-  // check if we store key or its prefix
-  if (IsEqualOrPrefix(*it, key)) {
-    return true;
+
+  // key is prefix for the stored keys, remove them and store the prefix
+  std::string path = key;
+  RemoveKeys(*node, path);
+  node->children.clear();
+  node->is_key = true;
+  ++count_;
+  if (record_change) {
+    RecordChange(key, false);
   }
-  return false;
+  return true;
 }
 
-std::uint64_t ProtectedKeyList::Size() const { return size_written_; }
+bool ProtectedKeyList::Contains(const std::string& key) const {
+  const Node* node = &root_;
+  size_t pos = 0u;
+  while (pos < key.size()) {
+    auto it = FindChild(node->children, key[pos]);
+    if (!IsChildFound(node->children, it, key[pos])) {
+      return false;
+    }
+
+    const auto& label = (*it)->label;
+    if (key.compare(pos, label.size(), label) != 0) {
+      return false;
+    }
 
-bool ProtectedKeyList::IsDirty() const { return dirty_; }
+    pos += label.size();
+    node = it->get();
+  }
+  return node->is_key;
+}
+
+void ProtectedKeyList::RemoveKeys(const Node& node, std::string& path) {
+  if (node.is_key) {
+    --count_;
+    RecordChange(path, true);
+  }
 
-std::uint64_t ProtectedKeyList::Count() const { return protected_data_.size(); }
+  for (const auto& child : node.children) {
+    path.append(child->label);
+    RemoveKeys(*child, path);
+    path.resize(path.size() - child->label.size());
+  }
+}
+
+void ProtectedKeyList::RecordChange(const std::string& key, bool stored) {
+  // keep the state of the first change, it is the persisted one
+  changes_.emplace(key, stored);
+}
 
 }  // namespace cache
 }  // namespace olp
@@ -20,20 +20,35 @@
 #pragma once
 
 #include <cstdint>
-#include <set>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <olp/core/cache/KeyValueCache.h>
 
 namespace olp {
 namespace cache {
 
+/// The protected keys and prefixes, stored in a radix tree. Every protected
+/// key is persisted as a separate entry, so only the changes are written.
 class ProtectedKeyList {
  public:
   using ProtectedKeyChanged = std::function<void(const std::string&)>;
 
+  /// The changed keys, true for the protected keys and false for the released
+  /// ones.
+  using Changes = std::unordered_map<std::string, bool>;
+
+  /// The prefix of the entries that store the protected keys.
+  static constexpr const char* kStorageKeyPrefix = "internal::protected::key::";
+
   ProtectedKeyList();
 
+  ProtectedKeyList(ProtectedKeyList&&) = default;
+
+  ProtectedKeyList& operator=(ProtectedKeyList&&) = default;
+
   ~ProtectedKeyList() = default;
 
   bool Protect(const KeyValueCache::KeyListType& keys,
@@ -41,41 +56,52 @@ class ProtectedKeyList {
 
   bool Release(const KeyValueCache::KeyListType& keys);
 
+  // Reads the list stored as one value by the older SDK versions. The keys are
+  // not stored as separate entries yet, so they are added as changes.
   bool Deserialize(KeyValueCache::ValueTypePtr value);
 
-  KeyValueCache::ValueTypePtr Serialize();
+  // Adds the key read from its storage entry, no change is recorded.
+  void Load(const std::string& key);
+
+  // Returns the changes since the last call, and treats them as persisted.
+  Changes TakeChanges();
 
   bool IsProtected(const std::string& key) const;
 
-  // Size calculated on last Serialize/Deserialize call. This size should mach
-  // data size written on disk
+  // Size of the persisted storage entries. This size should match the data
+  // size written on disk.
   std::uint64_t Size() const;
 
   bool IsDirty() const;
 
   std::uint64_t Count() const;
 
+  static std::string StorageKey(const std::string& key);
+
  private:
-  // custom comparator needed to reduce duplicates for keys, which are already
-  // protected by prefix
-  struct CustomCompare {
-    bool operator()(const std::string& lhs, const std::string& rhs) const {
-      if (rhs.length() < lhs.length()) {
-        if (std::equal(rhs.begin(), rhs.end(), lhs.begin())) {
-          return false;
-        }
-      } else if (lhs.length() < rhs.length()) {
-        if (std::equal(lhs.begin(), lhs.end(), rhs.begin())) {
-          return false;
-        }
-      }
-      return lhs < rhs;
-    }
+  // A node of the radix tree. The node path is the concatenation of the labels
+  // from the root, the children are sorted by the first label character.
+  struct Node {
+    std::string label;
+    bool is_key = false;
+    std::vector<std::unique_ptr<Node>> children;
   };
 
-  std::set<std::string, CustomCompare> protected_data_;
+  // Inserts the key, the keys with this prefix are removed
+  bool Insert(const std::string& key, bool record_change);
+
+  bool Contains(const std::string& key) const;
+
+  // Removes all the keys in the subtree, the path is the path of the node
+  void RemoveKeys(const Node& node, std::string& path);
+
+  void RecordChange(const std::string& key, bool stored);
+
+  Node root_;
+  std::uint64_t count_;
   std::uint64_t size_written_;
-  bool dirty_;
+  // The changed keys, mapped to whether they are persisted
+  Changes changes_;
 };
 
 }  // namespace cache
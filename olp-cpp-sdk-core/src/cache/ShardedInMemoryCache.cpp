@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "ShardedInMemoryCache.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace olp {
+namespace cache {
+
+ShardedInMemoryCache::ShardedInMemoryCache(size_t max_size,
+                                           size_t shards_count) {
+  shards_count = std::max<size_t>(shards_count, 1u);
+  const auto shard_size = std::max<size_t>(max_size / shards_count, 1u);
+
+  shards_.reserve(shards_count);
+  for (auto i = 0u; i < shards_count; ++i) {
+    shards_.emplace_back(new InMemoryCache(shard_size));
+  }
+}
+
+bool ShardedInMemoryCache::Put(const std::string& key, const boost::any& item,
+                               time_t expire_seconds, size_t size) {
+  return shards_[ShardIndex(key)]->Put(key, item, expire_seconds, size);
+}
+
+boost::any ShardedInMemoryCache::Get(const std::string& key) {
+  return shards_[ShardIndex(key)]->Get(key);
+}
+
+size_t ShardedInMemoryCache::Size() const {
+  size_t size = 0u;
+  for (const auto& shard : shards_) {
+    size += shard->Size();
+  }
+  return size;
+}
+
+void ShardedInMemoryCache::Clear() {
+  for (auto& shard : shards_) {
+    shard->Clear();
+  }
+}
+
+bool ShardedInMemoryCache::Remove(const std::string& key) {
+  return shards_[ShardIndex(key)]->Remove(key);
+}
+
+void ShardedInMemoryCache::RemoveKeysWithPrefix(
+    const std::string& key_prefix, const RemoveFilterFunc& filter) {
+  for (auto& shard : shards_) {
+    shard->RemoveKeysWithPrefix(key_prefix, filter);
+  }
+}
+
+bool ShardedInMemoryCache::Contains(const std::string& key) const {
+  return shards_[ShardIndex(key)]->Contains(key);
+}
+
+size_t ShardedInMemoryCache::ShardsCount() const { return shards_.size(); }
+
+size_t ShardedInMemoryCache::ShardIndex(const std::string& key) const {
+  if (shards_.size() == 1u) {
+    return 0u;
+  }
+  return std::hash<std::string>()(key) % shards_.size();
+}
+
+}  // namespace cache
+}  // namespace olp
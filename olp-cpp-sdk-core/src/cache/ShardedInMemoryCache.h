@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "InMemoryCache.h"
+
+namespace olp {
+namespace cache {
+
+/**
+ * @brief In-memory cache split into independently locked segments.
+ *
+ * Each key belongs to one segment selected by its hash, so the threads that
+ * access different keys mostly do not wait for each other. Every segment is
+ * an `InMemoryCache` with an equal part of the maximum size, which keeps the
+ * total size within the limit.
+ */
+class ShardedInMemoryCache {
+ public:
+  using RemoveFilterFunc = InMemoryCache::RemoveFilterFunc;
+
+  ShardedInMemoryCache(size_t max_size, size_t shards_count);
+
+  bool Put(const std::string& key, const boost::any& item,
+           time_t expire_seconds = InMemoryCache::kExpiryMax, size_t = 1u);
+
+  boost::any Get(const std::string& key);
+  size_t Size() const;
+  void Clear();
+
+  bool Remove(const std::string& key);
+  void RemoveKeysWithPrefix(const std::string& key_prefix,
+                            const RemoveFilterFunc& filter = nullptr);
+  bool Contains(const std::string& key) const;
+
+  /// Returns the number of segments.
+  size_t ShardsCount() const;
+
+  /// Returns the index of the segment the key belongs to.
+  size_t ShardIndex(const std::string& key) const;
+
+ private:
+  std::vector<std::unique_ptr<InMemoryCache>> shards_;
+};
+
+}  // namespace cache
+}  // namespace olp
@@ -19,8 +19,10 @@
 
 #include "olp/core/client/OlpClient.h"
 
+#include <algorithm>
 #include <cctype>
 #include <chrono>
+#include <cstdlib>
 #include <future>
 #ifdef OLP_SDK_NETWORK_IOS_BACKGROUND_DOWNLOAD
 #include <list>
@@ -29,6 +31,7 @@
 #include <thread>
 
 #include "PendingUrlRequests.h"
+#include "ResponseBodyBuffer.h"
 #include "olp/core/client/Condition.h"
 #include "olp/core/client/ErrorCode.h"
 #include "olp/core/http/HttpStatusCode.h"
@@ -143,6 +146,24 @@ using RequestSettingsPtr = std::shared_ptr<RequestSettings>;
 using NetworkCallbackType = std::function<void(const http::RequestId request_id,
                                                HttpResponse response)>;
 
+/// How the response body is received when there is no data callback.
+enum class ResponseBodyMode { kStringStream, kContiguousBuffer };
+
+// Bigger responses grow the buffer as the data is received
+constexpr size_t kMaxPreallocatedBodySize = 10u * 1024u * 1024u;
+
+/// The progress of a streamed download, used to continue the download from
+/// the received offset when the request is retried.
+struct StreamResume {
+  // The offset the request asks the body from
+  uint64_t offset{0};
+  // The offset of the body received so far
+  uint64_t received{0};
+  // True when the data that is not a part of the body, e.g. an error body,
+  // was passed to the data callback, so the stream can not be continued
+  bool invalid_data_passed{false};
+};
+
 static const auto kCancelledErrorResponse =
     http::NetworkResponse()
         .WithStatus(static_cast<int>(http::ErrorCode::CANCELLED_ERROR))
@@ -169,6 +190,17 @@ HttpResponse ToHttpResponse(const http::SendOutcome& outcome) {
           http::ErrorCodeToString(outcome.GetErrorCode())};
 }
 
+/// Returns the first byte position of the `Content-Range` header value, e.g.
+/// `bytes 100-199/200`.
+bool ParseContentRangeStart(const std::string& value, uint64_t& start) {
+  const auto digits = value.find_first_of("0123456789");
+  if (digits == std::string::npos || value.find('*') < digits) {
+    return false;
+  }
+  start = std::strtoull(value.c_str() + digits, nullptr, 10);
+  return true;
+}
+
 bool StatusSuccess(int status) {
   return status >= 0 && status < http::HttpStatusCode::BAD_REQUEST;
 }
@@ -182,6 +214,20 @@ bool CaseInsensitiveCompare(const std::string& str1, const std::string& str2) {
                     });
 }
 
+void SetResumeRange(http::NetworkRequest& request, uint64_t offset) {
+  auto& headers = request.GetMutableHeaders();
+  headers.erase(std::remove_if(headers.begin(), headers.end(),
+                               [](const http::Header& header) {
+                                 return CaseInsensitiveCompare(
+                                     header.first, http::kRangeHeader);
+                               }),
+                headers.end());
+  if (offset > 0) {
+    request.WithHeader(http::kRangeHeader,
+                       "bytes=" + std::to_string(offset) + "-");
+  }
+}
+
 RequestSettingsPtr GetRequestSettings(const RetrySettings& retry_settings) {
   return std::make_shared<RequestSettings>(
       retry_settings.initial_backdown_period, retry_settings.timeout);
@@ -207,13 +253,20 @@ std::chrono::milliseconds CalculateNextWaitTime(const RetrySettings& settings,
 void ExecuteSingleRequest(const std::shared_ptr<http::Network>& network,
                           const PendingUrlRequestPtr& pending_request,
                           const http::NetworkRequest& request,
-                          const NetworkCallbackType& callback) {
+                          const NetworkCallbackType& callback,
+                          const http::Network::DataCallback& data_callback) {
   auto response_body = std::make_shared<std::stringstream>();
   auto headers = std::make_shared<http::Headers>();
 
+  // The content passed to the data callback is not a part of the response
+  http::Network::Payload payload;
+  if (!data_callback) {
+    payload = response_body;
+  }
+
   auto make_request = [&](http::RequestId& id) {
     auto send_outcome = network->Send(
-        request, response_body,
+        request, payload,
         [=](const http::NetworkResponse& response) {
           auto status = response.GetStatus();
           if (!StatusSuccess(status)) {
@@ -228,7 +281,8 @@ void ExecuteSingleRequest(const std::shared_ptr<http::Network>& network,
         },
         [=](std::string key, std::string value) {
           headers->emplace_back(std::move(key), std::move(value));
-        });
+        },
+        data_callback);
 
     if (!send_outcome.IsSuccessful()) {
       callback(PendingUrlRequest::kInvalidRequestId,
@@ -257,7 +311,8 @@ NetworkCallbackType GetRetryCallback(
     const std::shared_ptr<http::Network>& network,
     const PendingUrlRequestsPtr& pending_requests,
     const PendingUrlRequestPtr& pending_request,
-    const NetworkRequestPtr& request) {
+    const NetworkRequestPtr& request,
+    const http::Network::DataCallback& data_callback) {
   return [=](const http::RequestId request_id, HttpResponse response) mutable {
     ++settings->current_try;
 
@@ -306,7 +361,9 @@ NetworkCallbackType GetRetryCallback(
     ExecuteSingleRequest(
         network, pending_request, *request,
         GetRetryCallback(merge, settings, retry_settings, network,
-                         pending_requests, pending_request, request));
+                         pending_requests, pending_request, request,
+                         data_callback),
+        data_callback);
   };
 }
 
@@ -332,31 +389,74 @@ http::NetworkRequest::HttpVerb GetHttpVerb(const std::string& verb) {
 
 HttpResponse SendRequest(const http::NetworkRequest& request,
                          const http::Network::DataCallback& data_callback,
+                         ResponseBodyMode body_mode,
                          const olp::client::OlpClientSettings& settings,
                          const olp::client::RetrySettings& retry_settings,
-                         client::CancellationContext context) {
+                         client::CancellationContext context,
+                         StreamResume* resume = nullptr) {
   struct ResponseData {
     Condition condition;
     http::NetworkResponse response{kCancelledErrorResponse};
     http::Headers headers;
     std::mutex mutex;
     bool can_call_data_callback{true};
+    // The offset of the received data in the whole body. The server sends
+    // the whole body when it ignores the range of the resumed request.
+    uint64_t body_offset{0};
+    // True when the response has a valid `Content-Range` for the resumed
+    // request.
+    bool body_range_valid{false};
+    uint64_t received{0};
   };
 
   auto response_data = std::make_shared<ResponseData>();
+  const auto resume_offset = resume ? resume->offset : 0u;
+  response_data->received = resume_offset;
 
   // We dont need a response body in case we want a stream
-  auto response_body =
-      data_callback ? nullptr : std::make_shared<std::stringstream>();
+  std::shared_ptr<std::stringstream> response_body;
+  std::shared_ptr<ResponseBodyBuffer> response_buffer;
+  if (!data_callback) {
+    if (body_mode == ResponseBodyMode::kContiguousBuffer) {
+      response_buffer = std::make_shared<ResponseBodyBuffer>();
+    } else {
+      response_body = std::make_shared<std::stringstream>();
+    }
+  }
+
+  http::Network::Payload payload;
+  if (response_buffer) {
+    payload = response_buffer;
+  } else {
+    payload = response_body;
+  }
 
   auto data_callback_proxy =
       !data_callback
           ? http::Network::DataCallback{}
-          : [data_callback, response_data](const uint8_t* data, uint64_t offset,
-                                           size_t length) {
+          : [data_callback, response_data, resume_offset](
+                const uint8_t* data, uint64_t offset, size_t length) {
               std::lock_guard<std::mutex> lock(response_data->mutex);
-              if (response_data->can_call_data_callback) {
+              if (!response_data->can_call_data_callback) {
+                return;
+              }
+
+              offset += response_data->body_offset;
+              // The body received before the resumed request is not passed
+              // again, e.g. when the server ignores the range or sends an
+              // error body instead.
+              if (offset < resume_offset) {
+                const auto skipped = std::min<uint64_t>(
+                    resume_offset - offset, static_cast<uint64_t>(length));
+                data += skipped;
+                offset += skipped;
+                length -= static_cast<size_t>(skipped);
+              }
+
+              if (length > 0u) {
                 data_callback(data, offset, length);
+                response_data->received =
+                    std::max(response_data->received, offset + length);
               }
             };
 
@@ -370,12 +470,30 @@ HttpResponse SendRequest(const http::NetworkRequest& request,
   context.ExecuteOrCancelled(
       [&]() {
         outcome = settings.network_request_handler->Send(
-            request, response_body,
+            request, payload,
             [response_data](http::NetworkResponse response) {
               response_data->response = std::move(response);
               response_data->condition.Notify();
             },
-            [response_data](std::string key, std::string value) {
+            [response_data, response_buffer, resume_offset](
+                std::string key, std::string value) {
+              uint64_t range_start = 0;
+              if (resume_offset > 0 &&
+                  CaseInsensitiveCompare(key, http::kContentRangeHeader) &&
+                  ParseContentRangeStart(value, range_start) &&
+                  range_start <= resume_offset) {
+                std::lock_guard<std::mutex> lock(response_data->mutex);
+                response_data->body_offset = range_start;
+                response_data->body_range_valid = true;
+              }
+              if (response_buffer &&
+                  CaseInsensitiveCompare(key, http::kContentLengthHeader)) {
+                const auto content_length =
+                    std::strtoull(value.c_str(), nullptr, 10);
+                response_buffer->Reserve(static_cast<size_t>(
+                    std::min<unsigned long long>(content_length,
+                                                 kMaxPreallocatedBodySize)));
+              }
               response_data->headers.emplace_back(std::move(key),
                                                   std::move(value));
             },
@@ -420,9 +538,32 @@ HttpResponse SendRequest(const http::NetworkRequest& request,
     context.CancelOperation();
   }
 
+  const auto received_status = response_data->response.GetStatus();
+  const auto partial_content =
+      received_status == http::HttpStatusCode::PARTIAL_CONTENT;
+  bool invalid_range = false;
   {
     std::lock_guard<std::mutex> lock(response_data->mutex);
     response_data->can_call_data_callback = false;
+    invalid_range = resume_offset > 0 && partial_content &&
+                    !response_data->body_range_valid;
+    if (resume) {
+      const auto data_passed = response_data->received > resume_offset;
+      if (invalid_range) {
+        // The position of the received part is unknown, start over
+        resume->received = 0u;
+        resume->invalid_data_passed = data_passed;
+      } else if (received_status < 0 ||
+                 received_status == http::HttpStatusCode::OK ||
+                 partial_content) {
+        // The interrupted transfer keeps the body received so far
+        resume->received = response_data->received;
+      } else {
+        // The error body is not a part of the requested body
+        resume->received = resume_offset;
+        resume->invalid_data_passed = data_passed;
+      }
+    }
   }
 
   if (context.IsCancelled() || !condition_triggered) {
@@ -430,10 +571,30 @@ HttpResponse SendRequest(const http::NetworkRequest& request,
                                               : kTimeoutErrorResponse);
   }
 
+  if (invalid_range) {
+    OLP_SDK_LOG_WARNING_F(kLogTag,
+                          "Resumed response without valid Content-Range, "
+                          "url='%s'",
+                          request.GetUrl().c_str());
+    // The retry starts the body over
+    auto response =
+        HttpResponse{static_cast<int>(http::ErrorCode::IO_ERROR),
+                     "Resumed response without a valid Content-Range."};
+    response.SetNetworkStatistics(GetStatistics(response_data->response));
+    return response;
+  }
+
   HttpResponse response = [&]() {
-    const auto status = response_data->response.GetStatus();
+    auto status = received_status;
+    if (resume_offset > 0 && partial_content) {
+      // The resumed request completes the body requested without a range
+      status = http::HttpStatusCode::OK;
+    }
     if (status < 0) {
       return HttpResponse{status, response_data->response.GetError()};
+    } else if (response_buffer) {
+      return HttpResponse{status, response_buffer->MoveBytes(),
+                          std::move(response_data->headers)};
     } else if (response_body) {
       return HttpResponse{status, std::move(*response_body),
                           std::move(response_data->headers)};
@@ -474,14 +635,18 @@ class OlpClient::OlpClientImpl {
                             const ParametersType& form_params,
                             const RequestBodyType& post_body,
                             const std::string& content_type,
-                            const NetworkAsyncCallback& callback) const;
+                            const NetworkAsyncCallback& callback,
+                            http::Network::DataCallback data_callback =
+                                nullptr) const;
 
   HttpResponse CallApi(std::string path, std::string method,
                        ParametersType query_params,
                        ParametersType header_params,
                        http::Network::DataCallback data_callback,
                        RequestBodyType post_body, std::string content_type,
-                       CancellationContext context) const;
+                       CancellationContext context,
+                       ResponseBodyMode body_mode =
+                           ResponseBodyMode::kStringStream) const;
 
   std::shared_ptr<http::NetworkRequest> CreateRequest(
       const std::string& path, const std::string& method,
@@ -618,8 +783,8 @@ CancellationToken OlpClient::OlpClientImpl::CallApi(
     const OlpClient::ParametersType& header_params,
     const OlpClient::ParametersType& /*form_params*/,
     const OlpClient::RequestBodyType& post_body,
-    const std::string& content_type,
-    const NetworkAsyncCallback& callback) const {
+    const std::string& content_type, const NetworkAsyncCallback& callback,
+    http::Network::DataCallback data_callback) const {
   if (!settings_.network_request_handler) {
     callback({static_cast<int>(http::ErrorCode::OFFLINE_ERROR),
               "Network layer offline or missing."});
@@ -655,8 +820,8 @@ CancellationToken OlpClient::OlpClientImpl::CallApi(
 
   // Only merge same request in case there is no body as a body can alter the
   // outcome of the request and may not match the response of a request with a
-  // different body.
-  bool merge = (!post_body || post_body->empty());
+  // different body. The content passed to a data callback is not shared.
+  bool merge = !data_callback && (!post_body || post_body->empty());
   OLP_SDK_LOG_DEBUG_F(kLogTag, "CallApi: url='%s', merge='%s'", url.c_str(),
                       merge ? "true" : "false");
 
@@ -701,7 +866,9 @@ CancellationToken OlpClient::OlpClientImpl::CallApi(
   ExecuteSingleRequest(
       network, request_ptr, *network_request,
       GetRetryCallback(merge, request_settings, retry_settings, network,
-                       pending_requests, request_ptr, network_request));
+                       pending_requests, request_ptr, network_request,
+                       data_callback),
+      data_callback);
 
   return cancellation_token;
 }
@@ -712,7 +879,7 @@ HttpResponse OlpClient::OlpClientImpl::CallApi(
     OlpClient::ParametersType header_params,
     http::Network::DataCallback data_callback,
     OlpClient::RequestBodyType post_body, std::string content_type,
-    CancellationContext context) const {
+    CancellationContext context, ResponseBodyMode body_mode) const {
   if (!settings_.network_request_handler) {
     return HttpResponse(static_cast<int>(olp::http::ErrorCode::OFFLINE_ERROR),
                         "Network request handler is empty.");
@@ -782,8 +949,23 @@ HttpResponse OlpClient::OlpClientImpl::CallApi(
     return {status, optional_error->GetMessage()};
   }
 
-  auto response = SendRequest(network_request, data_callback, settings_,
-                              retry_settings, context);
+  // The streamed body requested without a range is continued from the
+  // received offset when the request is retried, so the large downloads are
+  // not restarted from the beginning.
+  StreamResume resume;
+  const auto resumable =
+      data_callback &&
+      network_request.GetVerb() == http::NetworkRequest::HttpVerb::GET &&
+      std::none_of(header_params.begin(), header_params.end(),
+                   [](const OlpClient::ParametersType::value_type& header) {
+                     return CaseInsensitiveCompare(header.first,
+                                                   http::kRangeHeader);
+                   });
+  StreamResume* stream_resume = resumable ? &resume : nullptr;
+
+  auto response = SendRequest(network_request, data_callback, body_mode,
+                              settings_, retry_settings, context,
+                              stream_resume);
 
   NetworkStatistics accumulated_statistics = response.GetNetworkStatistics();
 
@@ -803,6 +985,17 @@ HttpResponse OlpClient::OlpClientImpl::CallApi(
       return response;
     }
 
+    // The data callback can not take back the data it already received
+    if (stream_resume && resume.invalid_data_passed) {
+      OLP_SDK_LOG_WARNING_F(kLogTag,
+                            "Stream not retried, the data callback received "
+                            "the body of a failed response, status=%i, "
+                            "url='%s'",
+                            response.GetStatus(),
+                            network_request.GetUrl().c_str());
+      break;
+    }
+
     // do the periodical sleep and check for cancellation status in between.
     auto duration_to_sleep =
         std::min(backdown_period, max_wait_time - accumulated_wait_time);
@@ -816,8 +1009,19 @@ HttpResponse OlpClient::OlpClientImpl::CallApi(
     }
 
     backdown_period = CalculateNextWaitTime(retry_settings, i);
-    response = SendRequest(network_request, data_callback, settings_,
-                           retry_settings, context);
+
+    if (stream_resume) {
+      if (resume.received > 0) {
+        OLP_SDK_LOG_DEBUG_F(kLogTag,
+                            "Resuming download, offset=%" PRIu64 ", url='%s'",
+                            resume.received, network_request.GetUrl().c_str());
+      }
+      resume.offset = resume.received;
+      SetResumeRange(network_request, resume.offset);
+    }
+
+    response = SendRequest(network_request, data_callback, body_mode,
+                           settings_, retry_settings, context, stream_resume);
 
     // In case we retry, accumulate the stats
     accumulated_statistics += response.GetNetworkStatistics();
@@ -874,6 +1078,17 @@ HttpResponse OlpClient::CallApi(std::string path, std::string method,
                         std::move(context));
 }
 
+CancellationToken OlpClient::CallApiStreamAsync(
+    const std::string& path, const std::string& method,
+    const ParametersType& query_params, const ParametersType& header_params,
+    http::Network::DataCallback data_callback, const RequestBodyType& post_body,
+    const std::string& content_type,
+    const NetworkAsyncCallback& callback) const {
+  return impl_->CallApi(path, method, query_params, header_params, {},
+                        post_body, content_type, callback,
+                        std::move(data_callback));
+}
+
 HttpResponse OlpClient::CallApiStream(std::string path, std::string method,
                                       ParametersType query_params,
                                       ParametersType header_params,
@@ -887,5 +1102,18 @@ HttpResponse OlpClient::CallApiStream(std::string path, std::string method,
                         std::move(content_type), std::move(context));
 }
 
+HttpResponse OlpClient::CallApiBytes(std::string path, std::string method,
+                                     ParametersType query_params,
+                                     ParametersType header_params,
+                                     RequestBodyType post_body,
+                                     std::string content_type,
+                                     CancellationContext context) const {
+  return impl_->CallApi(std::move(path), std::move(method),
+                        std::move(query_params), std::move(header_params),
+                        nullptr, std::move(post_body), std::move(content_type),
+                        std::move(context),
+                        ResponseBodyMode::kContiguousBuffer);
+}
+
 }  // namespace client
 }  // namespace olp
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+namespace olp {
+namespace client {
+
+/**
+ * @brief The output stream that receives the response body into a contiguous
+ * buffer.
+ *
+ * The stream behaves as `std::ostringstream` for the network: the writes go to
+ * the current position and `seekp` moves it. Unlike the string stream, the
+ * buffer can be pre-allocated and moved out without copying.
+ */
+class ResponseBodyBuffer final : public std::ostream {
+ public:
+  ResponseBodyBuffer() : std::ostream(&buffer_) {}
+
+  /// Pre-allocates the buffer, e.g. from the `Content-Length` header.
+  void Reserve(size_t size) { buffer_.bytes.reserve(size); }
+
+  /// Moves the received bytes out of the stream.
+  std::vector<unsigned char> MoveBytes() {
+    buffer_.position = 0u;
+    return std::move(buffer_.bytes);
+  }
+
+ private:
+  class VectorBuffer final : public std::streambuf {
+   public:
+    std::vector<unsigned char> bytes;
+    size_t position{0u};
+
+   protected:
+    std::streamsize xsputn(const char* data, std::streamsize count) override {
+      Write(data, static_cast<size_t>(count));
+      return count;
+    }
+
+    int_type overflow(int_type ch) override {
+      if (traits_type::eq_int_type(ch, traits_type::eof())) {
+        return traits_type::not_eof(ch);
+      }
+      const auto c = traits_type::to_char_type(ch);
+      Write(&c, 1u);
+      return ch;
+    }
+
+    pos_type seekoff(off_type offset, std::ios_base::seekdir direction,
+                     std::ios_base::openmode which) override {
+      off_type base = 0;
+      if (direction == std::ios_base::cur) {
+        base = static_cast<off_type>(position);
+      } else if (direction == std::ios_base::end) {
+        base = static_cast<off_type>(bytes.size());
+      }
+      return seekpos(pos_type(base + offset), which);
+    }
+
+    pos_type seekpos(pos_type new_position,
+                     std::ios_base::openmode which) override {
+      const auto new_offset = static_cast<off_type>(new_position);
+      if (!(which & std::ios_base::out) || new_offset < 0 ||
+          new_offset > static_cast<off_type>(bytes.size())) {
+        return pos_type(off_type(-1));
+      }
+      position = static_cast<size_t>(new_offset);
+      return new_position;
+    }
+
+   private:
+    void Write(const char* data, size_t count) {
+      // Overwrite the bytes after the position, append the rest
+      const auto overwrite = std::min(count, bytes.size() - position);
+      if (overwrite > 0u) {
+        std::memcpy(bytes.data() + position, data, overwrite);
+      }
+      bytes.insert(bytes.end(), data + overwrite, data + count);
+      position += count;
+    }
+  };
+
+  VectorBuffer buffer_;
+};
+
+}  // namespace client
+}  // namespace olp
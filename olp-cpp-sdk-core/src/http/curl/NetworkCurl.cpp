@@ -296,7 +296,9 @@ NetworkCurl::NetworkCurl(NetworkInitializationSettings settings)
     : handles_(settings.max_requests_count),
       static_handle_count_(
           std::max(static_cast<size_t>(1u), settings.max_requests_count / 4u)),
-      certificate_settings_(std::move(settings.certificate_settings)) {
+      certificate_settings_(std::move(settings.certificate_settings)),
+      http2_multiplexing_(settings.http2_multiplexing),
+      max_host_connections_(settings.max_host_connections) {
   OLP_SDK_LOG_TRACE(kLogTag, "Created NetworkCurl with address="
                                  << this << ", handles_count="
                                  << settings.max_requests_count);
@@ -347,6 +349,23 @@ NetworkCurl::NetworkCurl(NetworkInitializationSettings settings)
   OLP_SDK_LOG_INFO_F(
       kLogTag, "TLS backend: %s",
       version_data->ssl_version ? version_data->ssl_version : "<empty>");
+
+#if CURL_AT_LEAST_VERSION(7, 47, 0)
+  if (http2_multiplexing_ && !(version_data->features & CURL_VERSION_HTTP2)) {
+    OLP_SDK_LOG_WARNING(kLogTag,
+                        "CURL is built without HTTP/2, multiplexing disabled");
+    http2_multiplexing_ = false;
+  }
+#else
+  if (http2_multiplexing_) {
+    OLP_SDK_LOG_WARNING_F(
+        kLogTag,
+        "CURL does not support HTTP/2 multiplexing, required 7.47.0, "
+        "detected %s",
+        LIBCURL_VERSION);
+    http2_multiplexing_ = false;
+  }
+#endif
 }
 
 NetworkCurl::~NetworkCurl() {
@@ -416,6 +435,19 @@ bool NetworkCurl::Initialize() {
   const auto connects_cache_size = handles_.size() * 4;
   curl_multi_setopt(curl_, CURLMOPT_MAXCONNECTS, connects_cache_size);
 
+#if CURL_AT_LEAST_VERSION(7, 47, 0)
+  if (http2_multiplexing_) {
+    curl_multi_setopt(curl_, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+  }
+#endif
+
+#if CURL_AT_LEAST_VERSION(7, 30, 0)
+  if (max_host_connections_ > 0u) {
+    curl_multi_setopt(curl_, CURLMOPT_MAX_HOST_CONNECTIONS,
+                      static_cast<long>(max_host_connections_));
+  }
+#endif
+
   // handles setup
   std::shared_ptr<NetworkCurl> that = shared_from_this();
   for (auto& handle : handles_) {
@@ -679,6 +711,15 @@ ErrorCode NetworkCurl::SendImplementation(
     }
   }
 
+#if CURL_AT_LEAST_VERSION(7, 47, 0)
+  if (http2_multiplexing_) {
+    curl_easy_setopt(curl_handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+    // Waits for a stream on the connection being established instead of
+    // opening a new connection for each concurrent request
+    curl_easy_setopt(curl_handle, CURLOPT_PIPEWAIT, 1L);
+  }
+#endif
+
 #if CURL_AT_LEAST_VERSION(7, 24, 0)
   const auto& dns_servers = config.GetDNSServers();
   if (!dns_servers.empty()) {
@@ -392,6 +392,12 @@ class NetworkCurl : public olp::http::Network,
   /// blobs so cURL does not need to copy them.
   CertificateSettings certificate_settings_;
 
+  /// Use HTTP/2 and multiplex the concurrent requests to the same host.
+  bool http2_multiplexing_{false};
+
+  /// The maximum number of connections to one host, zero for no limit.
+  size_t max_host_connections_{0u};
+
 #ifdef OLP_SDK_CURL_HAS_SUPPORT_SSL_BLOBS
   /// SSL certificate blobs.
   boost::optional<SslCertificateBlobs> ssl_certificates_blobs_;
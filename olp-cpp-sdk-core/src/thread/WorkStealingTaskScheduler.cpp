@@ -0,0 +1,326 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "olp/core/thread/WorkStealingTaskScheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "olp/core/logging/Log.h"
+#include "olp/core/logging/LogContext.h"
+#include "olp/core/porting/make_unique.h"
+#include "olp/core/utils/Thread.h"
+
+namespace olp {
+namespace thread {
+
+namespace {
+constexpr auto kLogTag = "WorkStealingTaskScheduler";
+constexpr size_t kBandsCount = 3u;
+constexpr size_t kInitialDequeCapacity = 256u;
+
+using Task = TaskScheduler::CallFuncType;
+
+// The scheduler and the worker index of the current pool thread
+thread_local const void* tls_scheduler = nullptr;
+thread_local size_t tls_worker_index = 0u;
+
+size_t PriorityBand(uint32_t priority) {
+  if (priority >= HIGH) {
+    return 0u;
+  } else if (priority >= NORMAL) {
+    return 1u;
+  }
+  return 2u;
+}
+
+void SetExecutorName(size_t idx) {
+  std::string thread_name = "OLPSDKWSPOOL_" + std::to_string(idx);
+  olp::utils::Thread::SetCurrentThreadName(thread_name);
+  OLP_SDK_LOG_INFO_F(kLogTag, "Starting thread '%s'", thread_name.c_str());
+}
+
+/*
+ * Lock-free task deque. Only the owner thread pushes the tasks to the bottom,
+ * any thread takes them from the top, so the tasks are taken in FIFO order.
+ * When the ring is full, it is replaced with a bigger copy. The old rings are
+ * kept until the deque is destroyed, as a concurrent Take() may read them.
+ */
+class TaskDeque {
+ public:
+  TaskDeque() {
+    rings_.emplace_back(new Ring(kInitialDequeCapacity));
+    ring_.store(rings_.back().get());
+  }
+
+  ~TaskDeque() {
+    while (auto task = Take()) {
+      delete task;
+    }
+  }
+
+  void Push(Task* task) {
+    const auto bottom = bottom_.load(std::memory_order_relaxed);
+    const auto top = top_.load(std::memory_order_acquire);
+    auto ring = ring_.load(std::memory_order_relaxed);
+
+    if (bottom - top > static_cast<int64_t>(ring->mask)) {
+      std::unique_ptr<Ring> bigger(new Ring(2u * (ring->mask + 1u)));
+      for (auto index = top; index < bottom; ++index) {
+        bigger->Put(index, ring->Get(index));
+      }
+      ring = bigger.get();
+      rings_.push_back(std::move(bigger));
+      ring_.store(ring, std::memory_order_release);
+    }
+
+    ring->Put(bottom, task);
+    bottom_.store(bottom + 1, std::memory_order_release);
+  }
+
+  Task* Take() {
+    auto top = top_.load(std::memory_order_acquire);
+    for (;;) {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const auto bottom = bottom_.load(std::memory_order_acquire);
+      if (top >= bottom) {
+        return nullptr;
+      }
+
+      auto task = ring_.load(std::memory_order_acquire)->Get(top);
+      // On failure top is updated with the current value
+      if (top_.compare_exchange_weak(top, top + 1, std::memory_order_seq_cst,
+                                     std::memory_order_relaxed)) {
+        return task;
+      }
+    }
+  }
+
+ private:
+  struct Ring {
+    explicit Ring(size_t capacity)
+        : mask(capacity - 1u), slots(new std::atomic<Task*>[capacity]()) {}
+
+    Task* Get(int64_t index) const {
+      return slots[static_cast<size_t>(index) & mask].load(
+          std::memory_order_relaxed);
+    }
+
+    void Put(int64_t index, Task* task) {
+      slots[static_cast<size_t>(index) & mask].store(
+          task, std::memory_order_relaxed);
+    }
+
+    const size_t mask;
+    std::unique_ptr<std::atomic<Task*>[]> slots;
+  };
+
+  std::atomic<int64_t> top_{0};
+  std::atomic<int64_t> bottom_{0};
+  std::atomic<Ring*> ring_{nullptr};
+  std::vector<std::unique_ptr<Ring>> rings_;
+};
+
+struct Worker {
+  TaskDeque deques[kBandsCount];
+
+  /// Tasks scheduled from the threads outside of the pool.
+  std::mutex inbox_mutex;
+  std::deque<std::pair<size_t, std::unique_ptr<Task>>> inbox;
+
+  std::thread thread;
+};
+
+}  // namespace
+
+class WorkStealingTaskScheduler::Impl {
+ public:
+  explicit Impl(size_t thread_count) {
+    thread_count = std::max<size_t>(thread_count, 1u);
+
+    workers_.reserve(thread_count);
+    for (size_t idx = 0; idx < thread_count; ++idx) {
+      workers_.emplace_back(new Worker);
+    }
+
+    for (size_t idx = 0; idx < thread_count; ++idx) {
+      workers_[idx]->thread = std::thread([this, idx]() { Run(idx); });
+    }
+  }
+
+  ~Impl() {
+    {
+      std::lock_guard<std::mutex> lock(idle_mutex_);
+      closed_.store(true);
+    }
+    idle_condition_.notify_all();
+
+    for (auto& worker : workers_) {
+      worker->thread.join();
+    }
+  }
+
+  void Push(Task&& func, uint32_t priority) {
+    const auto band = PriorityBand(priority);
+    std::unique_ptr<Task> task(new Task(std::move(func)));
+
+    // Counted before the push, so the pulling thread never sees the task
+    // without the count
+    pending_tasks_.fetch_add(1u);
+
+    if (tls_scheduler == this) {
+      workers_[tls_worker_index]->deques[band].Push(task.release());
+    } else {
+      auto& worker = *workers_[next_worker_.fetch_add(1u) % workers_.size()];
+      std::lock_guard<std::mutex> lock(worker.inbox_mutex);
+      worker.inbox.emplace_back(band, std::move(task));
+    }
+
+    if (sleeping_workers_.load() > 0u) {
+      std::lock_guard<std::mutex> lock(idle_mutex_);
+      idle_condition_.notify_one();
+    }
+  }
+
+ private:
+  void Run(size_t index) {
+    // Set thread name for easy profiling and debugging
+    SetExecutorName(index);
+    tls_scheduler = this;
+    tls_worker_index = index;
+
+    while (!closed_.load()) {
+      std::unique_ptr<Task> task(Find(index));
+      if (task) {
+        pending_tasks_.fetch_sub(1u);
+        (*task)();
+        continue;
+      }
+
+      if (pending_tasks_.load() > 0u) {
+        // The task is being pushed right now
+        std::this_thread::yield();
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(idle_mutex_);
+      sleeping_workers_.fetch_add(1u);
+      idle_condition_.wait(lock, [this]() {
+        return pending_tasks_.load() > 0u || closed_.load();
+      });
+      sleeping_workers_.fetch_sub(1u);
+    }
+  }
+
+  Task* Find(size_t index) {
+    auto& own = *workers_[index];
+    DrainInbox(own);
+
+    for (size_t band = 0u; band < kBandsCount; ++band) {
+      if (auto task = own.deques[band].Take()) {
+        return task;
+      }
+
+      for (size_t offset = 1u; offset < workers_.size(); ++offset) {
+        auto& victim = *workers_[(index + offset) % workers_.size()];
+        if (auto task = victim.deques[band].Take()) {
+          return task;
+        }
+      }
+    }
+
+    // The owner of the inbox is busy with a long task
+    for (size_t offset = 1u; offset < workers_.size(); ++offset) {
+      auto& victim = *workers_[(index + offset) % workers_.size()];
+      std::unique_lock<std::mutex> lock(victim.inbox_mutex, std::try_to_lock);
+      if (lock.owns_lock() && !victim.inbox.empty()) {
+        auto task = victim.inbox.front().second.release();
+        victim.inbox.pop_front();
+        return task;
+      }
+    }
+
+    return nullptr;
+  }
+
+  void DrainInbox(Worker& worker) {
+    std::deque<std::pair<size_t, std::unique_ptr<Task>>> inbox;
+    {
+      std::lock_guard<std::mutex> lock(worker.inbox_mutex);
+      inbox.swap(worker.inbox);
+    }
+
+    for (auto& item : inbox) {
+      worker.deques[item.first].Push(item.second.release());
+    }
+  }
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::atomic<size_t> next_worker_{0u};
+  std::atomic<size_t> pending_tasks_{0u};
+  std::atomic<size_t> sleeping_workers_{0u};
+  std::atomic<bool> closed_{false};
+  std::mutex idle_mutex_;
+  std::condition_variable idle_condition_;
+};
+
+WorkStealingTaskScheduler::WorkStealingTaskScheduler(size_t thread_count)
+    : impl_{std::make_unique<Impl>(thread_count)} {}
+
+WorkStealingTaskScheduler::~WorkStealingTaskScheduler() = default;
+
+void WorkStealingTaskScheduler::EnqueueTask(
+    TaskScheduler::CallFuncType&& func) {
+  EnqueueTask(std::move(func), thread::NORMAL);
+}
+
+void WorkStealingTaskScheduler::EnqueueTask(TaskScheduler::CallFuncType&& func,
+                                            uint32_t priority) {
+  auto logContext = logging::GetContext();
+
+#if __cplusplus >= 201402L
+  // At least C++14, use generalized lambda capture
+  auto funcWithCapturedLogContext = [logContext = std::move(logContext),
+                                     func = std::move(func)]() {
+    olp::logging::ScopedLogContext scopedContext(logContext);
+    func();
+  };
+#else
+  // C++11 does not support generalized lambda capture :(
+  auto funcWithCapturedLogContext = std::bind(
+      [](std::shared_ptr<const olp::logging::LogContext>& logContext,
+         TaskScheduler::CallFuncType& func) {
+        olp::logging::ScopedLogContext scopedContext(logContext);
+        func();
+      },
+      std::move(logContext), std::move(func));
+#endif
+
+  impl_->Push(std::move(funcWithCapturedLogContext), priority);
+}
+
+}  // namespace thread
+}  // namespace olp
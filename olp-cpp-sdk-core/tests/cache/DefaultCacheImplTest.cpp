@@ -17,6 +17,7 @@
  * License-Filename: LICENSE
  */
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -125,6 +126,18 @@ class DefaultCacheImplHelper : public cache::DefaultCacheImpl {
     return disk_cache->Get(key).IsSuccessful();
   }
 
+  // Unlike Get, finds the keys with empty values as well
+  bool ContainsMutableCacheKey(const std::string& key) const {
+    const auto& disk_cache = GetCache(CacheType::kMutable);
+    if (!disk_cache) {
+      return false;
+    }
+
+    auto it = disk_cache->NewIterator(leveldb::ReadOptions());
+    it->Seek(key);
+    return it->Valid() && it->key() == key;
+  }
+
   uint64_t CalculateExpirySize(const std::string& key) const {
     const auto expiry_key = GetExpiryKey(key);
     const auto& disk_cache = GetCache(CacheType::kMutable);
@@ -145,6 +158,21 @@ class DefaultCacheImplHelper : public cache::DefaultCacheImpl {
     return expiry_key.size() + expiry_str.size();
   }
 
+  uint64_t CalculateLruMetadataSize(const std::string& key) const {
+    const auto metadata_key = "internal::lru::meta::" + key;
+    const auto& disk_cache = GetCache(CacheType::kMutable);
+    if (!disk_cache) {
+      return 0u;
+    }
+
+    auto metadata_result = disk_cache->Get(metadata_key);
+    if (!metadata_result) {
+      return 0u;
+    }
+
+    return metadata_key.size() + metadata_result.GetResult()->size();
+  }
+
   DiskLruCache::const_iterator BeginLru() {
     const auto& lru_cache = GetMutableCacheLru();
     if (!lru_cache) {
@@ -323,6 +351,44 @@ TEST_F(DefaultCacheImplTest, LruCacheGetPromote) {
   }
 }
 
+TEST_F(DefaultCacheImplTest, LruCacheGetPromoteShardedMemoryCache) {
+  cache::CacheSettings settings;
+  settings.disk_path_mutable = olp::utils::Dir::TempDirectory() + "/unittest";
+  settings.memory_cache_shards = 4u;
+  const std::vector<std::string> keys = {"somekey1", "somekey2", "somekey3"};
+  std::vector<unsigned char> binary_data = {1, 2, 3};
+
+  DefaultCacheImplHelper cache(settings);
+
+  cache.Open();
+  cache.Clear();
+  for (const auto& key : keys) {
+    cache.Put(key, std::make_shared<std::vector<unsigned char>>(binary_data),
+              (std::numeric_limits<time_t>::max)());
+  }
+
+  {
+    SCOPED_TRACE("Memory cache hit promotion is buffered");
+
+    EXPECT_TRUE(cache.ContainsMemoryCache(keys[0]));
+    EXPECT_NE(nullptr, cache.Get(keys[0]));
+    EXPECT_EQ(keys[2], cache.BeginLru()->key());
+  }
+
+  {
+    SCOPED_TRACE("Buffered promotion applied before Promote");
+
+    cache.Promote(keys[1]);
+
+    auto it = cache.BeginLru();
+    EXPECT_EQ(keys[1], it->key());
+    EXPECT_EQ(keys[0], (++it)->key());
+    EXPECT_EQ(keys[2], (++it)->key());
+  }
+
+  cache.Close();
+}
+
 TEST_F(DefaultCacheImplTest, LruCacheRemove) {
   cache::CacheSettings settings;
   settings.disk_path_mutable = olp::utils::Dir::TempDirectory() + "/unittest";
@@ -627,6 +693,33 @@ TEST_F(DefaultCacheImplTest, MutableCacheSize) {
     EXPECT_EQ(0u, cache.Size(CacheType::kMutable));
   }
 
+  {
+    SCOPED_TRACE("LRU metadata");
+
+    cache::CacheSettings settings;
+    settings.disk_path_mutable = cache_path_;
+    settings.max_disk_storage = 1024u * 1024u;
+    DefaultCacheImplHelper cache(settings);
+    cache.Open();
+    cache.Clear();
+
+    cache.Put(key1, data_ptr, (std::numeric_limits<time_t>::max)());
+    cache.Put(key2, data_ptr, expiry);
+    const auto data_size = key2.size() + binary_data.size() +
+                           cache.CalculateExpirySize(key2) +
+                           cache.CalculateLruMetadataSize(key2);
+    EXPECT_NE(0u, cache.CalculateLruMetadataSize(key1));
+    EXPECT_EQ(key1.size() + binary_data.size() +
+                  cache.CalculateLruMetadataSize(key1) + data_size,
+              cache.Size(CacheType::kMutable));
+
+    cache.Remove(key1);
+    EXPECT_EQ(data_size, cache.Size(CacheType::kMutable));
+
+    cache.RemoveKeysWithPrefix(key2);
+    EXPECT_EQ(0u, cache.Size(CacheType::kMutable));
+  }
+
   {
     SCOPED_TRACE("Cache not blocked");
 
@@ -931,7 +1024,7 @@ TEST_F(DefaultCacheImplTest, LruCacheEvictionWithProtected) {
     SCOPED_TRACE("Protect and release keys, which suppose to be evicted");
 
     const auto prefix{"somekey"};
-    const auto internal_key{"internal::protected::protected_data"};
+    const auto internal_key{"internal::protected::key::somekey"};
     const auto data_size = 1024u;
     std::vector<unsigned char> binary_data(data_size);
     cache::CacheSettings settings;
@@ -974,7 +1067,7 @@ TEST_F(DefaultCacheImplTest, LruCacheEvictionWithProtected) {
     // maximum is reached.
     ASSERT_TRUE(count == max_count);
     EXPECT_TRUE(cache.HasLruCache());
-    EXPECT_TRUE(cache.ContainsMutableCache(internal_key));
+    EXPECT_TRUE(cache.ContainsMutableCacheKey(internal_key));
     EXPECT_FALSE(cache.ContainsLru(internal_key));
 
     // no keys was evicted
@@ -990,6 +1083,54 @@ TEST_F(DefaultCacheImplTest, LruCacheEvictionWithProtected) {
   }
 }
 
+TEST_F(DefaultCacheImplTest, ProtectedKeysMigration) {
+  const std::string legacy_key = "internal::protected::protected_data";
+  const std::string legacy_value("key:1\0other:\0", 13);
+
+  cache::CacheSettings settings;
+  settings.disk_path_mutable = cache_path_;
+
+  {
+    // The list stored by the older SDK versions
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache.Open(), cache::DefaultCache::StorageOpenResult::Success);
+    ASSERT_TRUE(cache.Put(legacy_key,
+                          std::make_shared<cache::KeyValueCache::ValueType>(
+                              legacy_value.begin(), legacy_value.end()),
+                          cache::KeyValueCache::kDefaultExpiry));
+    cache.Close();
+  }
+
+  {
+    SCOPED_TRACE("The list is moved to separate entries on open");
+
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache.Open(), cache::DefaultCache::StorageOpenResult::Success);
+    EXPECT_TRUE(cache.IsProtected("key:1"));
+    EXPECT_TRUE(cache.IsProtected("other:key"));
+    EXPECT_FALSE(cache.ContainsMutableCacheKey(legacy_key));
+    EXPECT_TRUE(
+        cache.ContainsMutableCacheKey("internal::protected::key::key:1"));
+    EXPECT_TRUE(
+        cache.ContainsMutableCacheKey("internal::protected::key::other:"));
+
+    EXPECT_TRUE(cache.Release({"other:"}));
+    cache.Close();
+  }
+
+  {
+    SCOPED_TRACE("Only the changed keys are persisted");
+
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache.Open(), cache::DefaultCache::StorageOpenResult::Success);
+    EXPECT_TRUE(cache.IsProtected("key:1"));
+    EXPECT_FALSE(cache.IsProtected("other:key"));
+    EXPECT_FALSE(
+        cache.ContainsMutableCacheKey("internal::protected::key::other:"));
+    EXPECT_TRUE(cache.Clear());
+  }
+}
+
 TEST_F(DefaultCacheImplTest, ReadOnlyPartitionForProtectedCache) {
   SCOPED_TRACE("Read only partition protected cache");
   const std::string key{"somekey"};
@@ -1242,8 +1383,9 @@ TEST_F(DefaultCacheImplTest, SetMaxMutableSize) {
       cache.Put(key, std::make_shared<std::vector<unsigned char>>(binary_data),
                 expiry);
 
-      const auto size =
-          key.size() + binary_data.size() + cache.CalculateExpirySize(key);
+      const auto size = key.size() + binary_data.size() +
+                        cache.CalculateExpirySize(key) +
+                        cache.CalculateLruMetadataSize(key);
       sizes.push_back(size);
       total_size += size;
     }
@@ -1254,7 +1396,7 @@ TEST_F(DefaultCacheImplTest, SetMaxMutableSize) {
   {
     SCOPED_TRACE("Decrease without eviction");
 
-    EXPECT_EQ(cache.Size(1000), 0);
+    EXPECT_EQ(cache.Size(1500), 0);
     EXPECT_EQ(cache.Size(CacheType::kMutable), total_size);
   }
 
@@ -1273,7 +1415,7 @@ TEST_F(DefaultCacheImplTest, SetMaxMutableSize) {
       left_size += sizes[i];
     }
 
-    const auto new_max_size = 50;
+    const auto new_max_size = 250;
     const auto max_disk_used_threshold = 0.85;
     EXPECT_EQ(cache.Size(new_max_size), total_size - left_size);
     EXPECT_EQ(cache.Size(CacheType::kMutable), left_size);
@@ -1292,13 +1434,285 @@ TEST_F(DefaultCacheImplTest, SetMaxMutableSize) {
     auto binary_data = std::vector<unsigned char>(500, 'a');
     cache.Put(key, std::make_shared<std::vector<unsigned char>>(binary_data),
               1);
-    const auto new_item_size =
-        key.size() + binary_data.size() + cache.CalculateExpirySize(key);
+    const auto new_item_size = key.size() + binary_data.size() +
+                               cache.CalculateExpirySize(key) +
+                               cache.CalculateLruMetadataSize(key);
 
     EXPECT_EQ(cache.Size(CacheType::kMutable), total_size + new_item_size);
   }
 }
 
+TEST_F(DefaultCacheImplTest, LruCacheRestoredOnOpen) {
+  const std::string key1{"somekey1"};
+  const std::string key2{"somekey2"};
+  const std::string key3{"somekey3"};
+  const auto data_ptr =
+      std::make_shared<std::vector<unsigned char>>(std::vector<unsigned char>{
+          1, 2, 3});
+
+  cache::CacheSettings settings;
+  settings.disk_path_mutable = cache_path_;
+
+  uint64_t expected_size = 0u;
+
+  {
+    SCOPED_TRACE("Fill the cache");
+
+    DefaultCacheImplHelper cache(settings);
+    cache.Open();
+    cache.Clear();
+
+    cache.Put(key1, data_ptr, (std::numeric_limits<time_t>::max)());
+    cache.Put(key2, data_ptr, 321);
+    cache.Put(key3, data_ptr, (std::numeric_limits<time_t>::max)());
+    cache.Promote(key1);
+
+    expected_size = cache.Size(CacheType::kMutable);
+    cache.Close();
+  }
+
+  {
+    SCOPED_TRACE("Restore from metadata");
+
+    DefaultCacheImplHelper cache(settings);
+    cache.Open();
+
+    EXPECT_EQ(expected_size, cache.Size(CacheType::kMutable));
+
+    std::vector<std::string> keys;
+    for (auto it = cache.BeginLru(); it != cache.EndLru(); ++it) {
+      keys.push_back(it->key());
+    }
+    EXPECT_EQ(keys, (std::vector<std::string>{key1, key3, key2}));
+
+    cache.Remove(key3);
+    cache.Close();
+  }
+
+  {
+    SCOPED_TRACE("Open without LRU drops metadata");
+
+    settings.eviction_policy = cache::EvictionPolicy::kNone;
+    DefaultCacheImplHelper cache(settings);
+    cache.Open();
+    cache.Put(key3, data_ptr, (std::numeric_limits<time_t>::max)());
+    cache.Close();
+  }
+
+  {
+    SCOPED_TRACE("Full scan");
+
+    settings.eviction_policy = cache::EvictionPolicy::kLeastRecentlyUsed;
+    DefaultCacheImplHelper cache(settings);
+    cache.Open();
+
+    EXPECT_TRUE(cache.ContainsLru(key1));
+    EXPECT_TRUE(cache.ContainsLru(key2));
+    EXPECT_TRUE(cache.ContainsLru(key3));
+    EXPECT_EQ(expected_size, cache.Size(CacheType::kMutable));
+  }
+}
+
+TEST_F(DefaultCacheImplTest, WriteReadBatch) {
+  cache::CacheSettings settings;
+  settings.disk_path_mutable = cache_path_;
+  const std::vector<std::string> keys = {"key1", "key2", "key3"};
+  const auto missing_key = "key4";
+
+  cache::KeyValueCache::KeyValueListType items;
+  for (const auto& key : keys) {
+    items.emplace_back(key, std::make_shared<cache::KeyValueCache::ValueType>(
+                                key.begin(), key.end()));
+  }
+
+  {
+    SCOPED_TRACE("Batch and single writes have the same size");
+
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache.Open(), cache::DefaultCache::StorageOpenResult::Success);
+    ASSERT_TRUE(cache.Clear());
+    for (const auto& item : items) {
+      ASSERT_TRUE(cache.Write(item.first, item.second, 1000));
+    }
+    const auto expected_size = cache.Size(CacheType::kMutable);
+    ASSERT_TRUE(cache.Clear());
+
+    ASSERT_TRUE(cache.WriteBatch(items, 1000));
+    EXPECT_EQ(expected_size, cache.Size(CacheType::kMutable));
+    for (const auto& key : keys) {
+      EXPECT_TRUE(cache.ContainsLru(key));
+      EXPECT_TRUE(cache.ContainsMutableCache(key));
+    }
+    EXPECT_EQ(keys.back(), cache.BeginLru()->key());
+    cache.Close();
+  }
+
+  {
+    SCOPED_TRACE("Null value is rejected");
+
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache.Open(), cache::DefaultCache::StorageOpenResult::Success);
+    auto invalid_items = items;
+    invalid_items.emplace_back(missing_key, nullptr);
+
+    const auto result = cache.WriteBatch(invalid_items, 1000);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.GetError().GetErrorCode(),
+              olp::client::ErrorCode::InvalidArgument);
+    EXPECT_FALSE(cache.ContainsMutableCache(missing_key));
+  }
+
+  {
+    SCOPED_TRACE("Read from disk, values are in the keys order");
+
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache.Open(), cache::DefaultCache::StorageOpenResult::Success);
+
+    auto read_keys = keys;
+    std::reverse(read_keys.begin(), read_keys.end());
+    read_keys.insert(read_keys.begin() + 1, missing_key);
+
+    const auto result = cache.ReadBatch(read_keys);
+    ASSERT_TRUE(result);
+    const auto& values = result.GetResult();
+    ASSERT_EQ(read_keys.size(), values.size());
+    for (size_t i = 0u; i < read_keys.size(); ++i) {
+      if (read_keys[i] == missing_key) {
+        EXPECT_EQ(nullptr, values[i]);
+        continue;
+      }
+
+      ASSERT_NE(nullptr, values[i]);
+      EXPECT_EQ(read_keys[i],
+                std::string(values[i]->begin(), values[i]->end()));
+      EXPECT_TRUE(cache.ContainsMemoryCache(read_keys[i]));
+    }
+
+    // The keys are promoted in the order of the read
+    EXPECT_EQ(keys.front(), cache.BeginLru()->key());
+  }
+
+  {
+    SCOPED_TRACE("Expired values are removed");
+
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache.Open(), cache::DefaultCache::StorageOpenResult::Success);
+    ASSERT_TRUE(cache.Clear());
+    ASSERT_TRUE(cache.WriteBatch(items, -1));
+
+    const auto result = cache.ReadBatch(keys);
+    ASSERT_TRUE(result);
+    for (size_t i = 0u; i < keys.size(); ++i) {
+      EXPECT_EQ(nullptr, result.GetResult()[i]);
+      EXPECT_FALSE(cache.ContainsLru(keys[i]));
+      EXPECT_FALSE(cache.ContainsMutableCache(keys[i]));
+    }
+    EXPECT_EQ(0u, cache.Size(CacheType::kMutable));
+  }
+
+  {
+    SCOPED_TRACE("Closed cache");
+
+    DefaultCacheImplHelper cache(settings);
+    EXPECT_FALSE(cache.WriteBatch(items, 1000));
+    EXPECT_FALSE(cache.ReadBatch(keys));
+  }
+}
+
+TEST_F(DefaultCacheImplTest, ReadView) {
+  cache::CacheSettings settings;
+  settings.disk_path_mutable = cache_path_;
+  const std::string key = "key";
+  const std::string data = "some data";
+  const auto value = std::make_shared<cache::KeyValueCache::ValueType>(
+      data.begin(), data.end());
+
+  {
+    SCOPED_TRACE("Read from memory");
+
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache.Open(), cache::DefaultCache::StorageOpenResult::Success);
+    ASSERT_TRUE(cache.Clear());
+    ASSERT_TRUE(cache.Write(key, value, 1000));
+    ASSERT_TRUE(cache.ContainsMemoryCache(key));
+
+    const auto result = cache.ReadView(key);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(data, std::string(result.GetResult().begin(),
+                                result.GetResult().end()));
+    cache.Close();
+  }
+
+  {
+    SCOPED_TRACE("Read from disk, the view outlives the cache");
+
+    cache::ValueView view;
+    {
+      DefaultCacheImplHelper cache(settings);
+      ASSERT_EQ(cache.Open(), cache::DefaultCache::StorageOpenResult::Success);
+
+      auto result = cache.ReadView(key);
+      ASSERT_TRUE(result);
+      view = result.MoveResult();
+
+      // The view is not copied to the memory cache
+      EXPECT_FALSE(cache.ContainsMemoryCache(key));
+      EXPECT_TRUE(cache.ContainsLru(key));
+      cache.Close();
+    }
+
+    EXPECT_EQ(data, std::string(view.begin(), view.end()));
+    EXPECT_EQ(data.size(), view.ToVector().size());
+  }
+
+  {
+    SCOPED_TRACE("Reopen while a view is alive");
+
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache.Open(), cache::DefaultCache::StorageOpenResult::Success);
+
+    auto result = cache.ReadView(key);
+    ASSERT_TRUE(result);
+    auto view = result.MoveResult();
+    EXPECT_FALSE(cache.Clear());
+
+    cache.Close();
+    EXPECT_EQ(cache.Open(),
+              cache::DefaultCache::StorageOpenResult::OpenDiskPathFailure);
+    EXPECT_EQ(data, std::string(view.begin(), view.end()));
+
+    // The database is closed with the last view
+    view = cache::ValueView();
+    cache.Close();
+    ASSERT_EQ(cache.Open(), cache::DefaultCache::StorageOpenResult::Success);
+    const auto value_read = cache.Read(key);
+    ASSERT_TRUE(value_read);
+    EXPECT_EQ(data, std::string(value_read.GetResult()->begin(),
+                                value_read.GetResult()->end()));
+    cache.Close();
+  }
+
+  {
+    SCOPED_TRACE("Missing and expired values");
+
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache.Open(), cache::DefaultCache::StorageOpenResult::Success);
+    ASSERT_TRUE(cache.Clear());
+    ASSERT_TRUE(cache.Write(key, value, -1));
+
+    EXPECT_FALSE(cache.ReadView("missing key"));
+    EXPECT_FALSE(cache.ReadView(key));
+    EXPECT_FALSE(cache.ContainsMutableCache(key));
+  }
+
+  {
+    SCOPED_TRACE("Closed cache");
+
+    DefaultCacheImplHelper cache(settings);
+    EXPECT_FALSE(cache.ReadView(key));
+  }
+}
+
 TEST_F(DefaultCacheImplTest, ProtectedCacheSize) {
   cache::CacheSettings settings;
   settings.max_disk_storage = std::uint64_t(-1);
@@ -19,10 +19,20 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+#include <string>
+#include <vector>
+
 #include <cache/ProtectedKeyList.h>
 
 namespace {
 namespace cache = olp::cache;
+
+// Size of the storage entry of the key
+std::uint64_t EntrySize(const std::string& key) {
+  return strlen(cache::ProtectedKeyList::kStorageKeyPrefix) + key.size();
+}
+
 TEST(ProtectedKeyList, CanBeMoved) {
   SCOPED_TRACE("ProtectedKeyList can be moved");
 
@@ -31,17 +41,18 @@ TEST(ProtectedKeyList, CanBeMoved) {
   list_a.Protect({"key"}, cb);
   EXPECT_EQ(list_a.Size(), 0);
   EXPECT_TRUE(list_a.IsDirty());
-  auto raw_data = list_a.Serialize();
-  EXPECT_TRUE(raw_data.get());
-  EXPECT_EQ(raw_data->size(), 4);
+  auto changes = list_a.TakeChanges();
+  EXPECT_EQ(changes, cache::ProtectedKeyList::Changes({{"key", true}}));
   EXPECT_FALSE(list_a.IsDirty());
-  EXPECT_EQ(list_a.Size(), raw_data->size());
+  EXPECT_EQ(list_a.Size(), EntrySize("key"));
   cache::ProtectedKeyList list_b(std::move(list_a));
-  EXPECT_EQ(list_b.Size(), 4);
+  EXPECT_EQ(list_b.Size(), EntrySize("key"));
+  EXPECT_TRUE(list_b.IsProtected("key"));
   cache::ProtectedKeyList list_c;
   EXPECT_EQ(list_c.Size(), 0);
   list_c = std::move(list_b);
-  EXPECT_EQ(list_c.Size(), 4);
+  EXPECT_EQ(list_c.Size(), EntrySize("key"));
+  EXPECT_TRUE(list_c.IsProtected("key"));
 }
 
 TEST(ProtectedKeyList, Protect) {
@@ -57,100 +68,103 @@ TEST(ProtectedKeyList, Protect) {
       EXPECT_TRUE(protected_keys.Protect({"key:1"}, cb));
       EXPECT_TRUE(protected_keys.IsProtected({"key:1"}));
       EXPECT_TRUE(protected_keys.IsDirty());
-      auto raw_data = protected_keys.Serialize();
-      EXPECT_TRUE(raw_data.get());
-      EXPECT_EQ(raw_data->size(), 6);
+      auto changes = protected_keys.TakeChanges();
+      EXPECT_EQ(changes, cache::ProtectedKeyList::Changes({{"key:1", true}}));
       EXPECT_FALSE(protected_keys.IsDirty());
-      EXPECT_EQ(protected_keys.Size(), raw_data->size());
-      protected_keys = cache::ProtectedKeyList();
+      EXPECT_EQ(protected_keys.Size(), EntrySize("key:1"));
     }
 
     {
       SCOPED_TRACE("Protect prefix of previously protected key");
       EXPECT_TRUE(protected_keys.Protect({"key:"}, cb));
       EXPECT_TRUE(protected_keys.IsDirty());
-      auto raw_data = protected_keys.Serialize();
-      EXPECT_TRUE(raw_data.get());
       // previous key was removed, so size is smaller
-      EXPECT_EQ(raw_data->size(), 5);
+      auto changes = protected_keys.TakeChanges();
+      EXPECT_EQ(changes, cache::ProtectedKeyList::Changes(
+                             {{"key:", true}, {"key:1", false}}));
       EXPECT_FALSE(protected_keys.IsDirty());
+      EXPECT_EQ(protected_keys.Size(), EntrySize("key:"));
+      EXPECT_EQ(protected_keys.Count(), 1);
       EXPECT_TRUE(protected_keys.IsProtected("key:1"));
-      protected_keys = cache::ProtectedKeyList();
     }
 
     {
       SCOPED_TRACE("Protect new key with the its prefix already in cache");
-      EXPECT_TRUE(protected_keys.Protect({"key:"}, cb));
       EXPECT_FALSE(protected_keys.Protect({"key:2"}, cb));
-      EXPECT_TRUE(protected_keys.IsDirty());
-      auto raw_data = protected_keys.Serialize();
-      EXPECT_TRUE(raw_data.get());
       // size didn't change
-      EXPECT_EQ(raw_data->size(), 5);
       EXPECT_FALSE(protected_keys.IsDirty());
-      EXPECT_TRUE(protected_keys.IsProtected("key:1"));
-      protected_keys = cache::ProtectedKeyList();
+      EXPECT_EQ(protected_keys.Size(), EntrySize("key:"));
+      EXPECT_TRUE(protected_keys.IsProtected("key:2"));
     }
 
     {
       SCOPED_TRACE("Protect new key with the other prefix");
-      // old prefix
-      EXPECT_TRUE(protected_keys.Protect({"key:"}, cb));
-      // new prefix
       EXPECT_TRUE(protected_keys.Protect({"some_key:1"}, cb));
       EXPECT_TRUE(protected_keys.IsDirty());
-      auto raw_data = protected_keys.Serialize();
-      EXPECT_TRUE(raw_data.get());
-      // size changed
-      EXPECT_EQ(raw_data->size(), 5 + 11);
+      // only new key is changed
+      auto changes = protected_keys.TakeChanges();
+      EXPECT_EQ(changes,
+                cache::ProtectedKeyList::Changes({{"some_key:1", true}}));
       EXPECT_FALSE(protected_keys.IsDirty());
+      EXPECT_EQ(protected_keys.Size(),
+                EntrySize("key:") + EntrySize("some_key:1"));
       EXPECT_TRUE(protected_keys.IsProtected("some_key:1"));
-      protected_keys = cache::ProtectedKeyList();
+      EXPECT_FALSE(protected_keys.IsProtected("some_key:"));
+      EXPECT_FALSE(protected_keys.IsProtected("some"));
     }
 
     {
       SCOPED_TRACE("Protect multiple keys ");
-      // old data
-      EXPECT_TRUE(protected_keys.Protect({"key:", "some_key:1"}, cb));
-      // new data
       EXPECT_TRUE(
           protected_keys.Protect({"some_key:2", "some_key:3", "some_key:4",
                                   "some_key:5", "some_key:6"},
                                  cb));
       EXPECT_TRUE(protected_keys.IsDirty());
-      auto raw_data = protected_keys.Serialize();
-      EXPECT_TRUE(raw_data.get());
-      // size changed
-      EXPECT_EQ(raw_data->size(), 5 + 11 + 11 * 5);
+      auto changes = protected_keys.TakeChanges();
+      EXPECT_EQ(changes.size(), 5);
       EXPECT_FALSE(protected_keys.IsDirty());
+      EXPECT_EQ(protected_keys.Size(),
+                EntrySize("key:") + 6 * EntrySize("some_key:1"));
+      EXPECT_EQ(protected_keys.Count(), 7);
       EXPECT_TRUE(protected_keys.IsProtected("some_key:2"));
       EXPECT_FALSE(protected_keys.IsProtected("some_key:7"));
-      protected_keys = cache::ProtectedKeyList();
     }
 
     {
       SCOPED_TRACE("Protect multiple keys, its prefix already in cache ");
-      // old data
-      EXPECT_TRUE(protected_keys.Protect({"key:", "some_key:1"}, cb));
-      EXPECT_TRUE(
-          protected_keys.Protect({"some_key:2", "some_key:3", "some_key:4",
-                                  "some_key:5", "some_key:6"},
-                                 cb));
-      // new data
       EXPECT_FALSE(protected_keys.Protect(
           {"key:2", "key:3", "key:4", "key:5", "key:6"}, cb));
-      EXPECT_TRUE(protected_keys.IsDirty());
-      auto raw_data = protected_keys.Serialize();
-      EXPECT_TRUE(raw_data.get());
-      // size didn't change
-      EXPECT_EQ(raw_data->size(), 5 + 11 + 11 * 5);
+      // nothing changed
       EXPECT_FALSE(protected_keys.IsDirty());
+      EXPECT_EQ(protected_keys.Count(), 7);
       // this key is protected by prefix
       EXPECT_TRUE(protected_keys.IsProtected("key:7"));
       EXPECT_FALSE(protected_keys.IsProtected("some_key:7"));
-      protected_keys = cache::ProtectedKeyList();
     }
   }
+
+  {
+    SCOPED_TRACE("Protect and release before changes are taken");
+
+    cache::ProtectedKeyList protected_keys;
+    auto cb = [](const std::string&) {};
+    EXPECT_TRUE(protected_keys.Protect({"key:1"}, cb));
+    EXPECT_TRUE(protected_keys.Release({"key:1"}));
+    // the key was never persisted, so there is nothing to write
+    EXPECT_TRUE(protected_keys.TakeChanges().empty());
+    EXPECT_EQ(protected_keys.Size(), 0);
+    EXPECT_EQ(protected_keys.Count(), 0);
+  }
+
+  {
+    SCOPED_TRACE("Notify about protected keys");
+
+    cache::ProtectedKeyList protected_keys;
+    std::vector<std::string> notified;
+    auto cb = [&](const std::string& key) { notified.push_back(key); };
+    EXPECT_TRUE(protected_keys.Protect({"key:1", "key:", "key:2"}, cb));
+    EXPECT_EQ(notified, std::vector<std::string>({"key:1", "key:"}));
+  }
 }
 
 TEST(ProtectedKeyList, Release) {
@@ -167,12 +181,12 @@ TEST(ProtectedKeyList, Release) {
            "some_key:5", "some_key:6", "key:"},
           cb));
       EXPECT_TRUE(protected_keys.IsDirty());
-      auto raw_data = protected_keys.Serialize();
-      EXPECT_TRUE(raw_data.get());
       // 6 keys and prefix
-      EXPECT_EQ(raw_data->size(), 6 * 11 + 5);
+      auto changes = protected_keys.TakeChanges();
+      EXPECT_EQ(changes.size(), 7);
       EXPECT_FALSE(protected_keys.IsDirty());
-      EXPECT_EQ(protected_keys.Size(), raw_data->size());
+      EXPECT_EQ(protected_keys.Size(),
+                6 * EntrySize("some_key:1") + EntrySize("key:"));
       // this key is protected by prefix
       EXPECT_TRUE(protected_keys.IsProtected("key:7"));
       EXPECT_TRUE(protected_keys.IsProtected("some_key:6"));
@@ -183,12 +197,13 @@ TEST(ProtectedKeyList, Release) {
       SCOPED_TRACE("Release one key ");
       EXPECT_TRUE(protected_keys.Release({"some_key:6"}));
       EXPECT_TRUE(protected_keys.IsDirty());
-      auto raw_data = protected_keys.Serialize();
-      EXPECT_TRUE(raw_data.get());
+      auto changes = protected_keys.TakeChanges();
+      EXPECT_EQ(changes,
+                cache::ProtectedKeyList::Changes({{"some_key:6", false}}));
       // 5 keys and prefix
-      EXPECT_EQ(raw_data->size(), 5 * 11 + 5);
       EXPECT_FALSE(protected_keys.IsDirty());
-      EXPECT_EQ(protected_keys.Size(), raw_data->size());
+      EXPECT_EQ(protected_keys.Size(),
+                5 * EntrySize("some_key:1") + EntrySize("key:"));
       // key not longer protected
       EXPECT_FALSE(protected_keys.IsProtected("some_key:6"));
     }
@@ -198,12 +213,13 @@ TEST(ProtectedKeyList, Release) {
       EXPECT_TRUE(
           protected_keys.Release({"some_key:6", "some_key:5", "some_key:4"}));
       EXPECT_TRUE(protected_keys.IsDirty());
-      auto raw_data = protected_keys.Serialize();
-      EXPECT_TRUE(raw_data.get());
-      // 5 keys and prefix
-      EXPECT_EQ(raw_data->size(), 3 * 11 + 5);
+      auto changes = protected_keys.TakeChanges();
+      EXPECT_EQ(changes, cache::ProtectedKeyList::Changes(
+                             {{"some_key:4", false}, {"some_key:5", false}}));
+      // 3 keys and prefix
       EXPECT_FALSE(protected_keys.IsDirty());
-      EXPECT_EQ(protected_keys.Size(), raw_data->size());
+      EXPECT_EQ(protected_keys.Size(),
+                3 * EntrySize("some_key:1") + EntrySize("key:"));
       // key not longer protected
       EXPECT_FALSE(protected_keys.IsProtected("some_key:5"));
     }
@@ -212,12 +228,12 @@ TEST(ProtectedKeyList, Release) {
       SCOPED_TRACE("Release keys by prefix");
       EXPECT_TRUE(protected_keys.Release({"some_key:"}));
       EXPECT_TRUE(protected_keys.IsDirty());
-      auto raw_data = protected_keys.Serialize();
-      EXPECT_TRUE(raw_data.get());
-      // 5 keys and prefix
-      EXPECT_EQ(raw_data->size(), 5);
+      auto changes = protected_keys.TakeChanges();
+      EXPECT_EQ(changes.size(), 3);
+      // only prefix left
       EXPECT_FALSE(protected_keys.IsDirty());
-      EXPECT_EQ(protected_keys.Size(), raw_data->size());
+      EXPECT_EQ(protected_keys.Size(), EntrySize("key:"));
+      EXPECT_EQ(protected_keys.Count(), 1);
       // key not longer protected
       EXPECT_FALSE(protected_keys.IsProtected("some_key:1"));
       EXPECT_FALSE(protected_keys.IsProtected("some_key:2"));
@@ -228,15 +244,47 @@ TEST(ProtectedKeyList, Release) {
       EXPECT_FALSE(protected_keys.Release({"key:1"}));
       // nothing changed
       EXPECT_FALSE(protected_keys.IsDirty());
-      auto raw_data = protected_keys.Serialize();
-      EXPECT_TRUE(raw_data.get());
-      // 5 keys and prefix
-      EXPECT_EQ(raw_data->size(), 5);
-      EXPECT_FALSE(protected_keys.IsDirty());
-      EXPECT_EQ(protected_keys.Size(), raw_data->size());
+      EXPECT_EQ(protected_keys.Size(), EntrySize("key:"));
       // key still protected
       EXPECT_TRUE(protected_keys.IsProtected("key:1"));
     }
+
+    {
+      SCOPED_TRACE("Release a part of the key");
+      EXPECT_TRUE(protected_keys.Release({"ke"}));
+      auto changes = protected_keys.TakeChanges();
+      EXPECT_EQ(changes, cache::ProtectedKeyList::Changes({{"key:", false}}));
+      EXPECT_EQ(protected_keys.Size(), 0);
+      EXPECT_EQ(protected_keys.Count(), 0);
+      EXPECT_FALSE(protected_keys.IsProtected("key:1"));
+    }
+  }
+}
+
+TEST(ProtectedKeyList, Load) {
+  cache::ProtectedKeyList protected_keys;
+  {
+    SCOPED_TRACE("Load stored keys");
+    protected_keys.Load("key:1");
+    protected_keys.Load("key:2");
+    EXPECT_FALSE(protected_keys.IsDirty());
+    EXPECT_EQ(protected_keys.Count(), 2);
+    EXPECT_EQ(protected_keys.Size(), EntrySize("key:1") + EntrySize("key:2"));
+    EXPECT_TRUE(protected_keys.IsProtected("key:1"));
+    EXPECT_FALSE(protected_keys.IsProtected("key:3"));
+  }
+
+  {
+    SCOPED_TRACE("Deserialize the list stored in one value");
+    const std::string stored("key:3\0other:\0", 13);
+    EXPECT_TRUE(protected_keys.Deserialize(
+        std::make_shared<cache::KeyValueCache::ValueType>(stored.begin(),
+                                                          stored.end())));
+    EXPECT_TRUE(protected_keys.IsDirty());
+    EXPECT_TRUE(protected_keys.IsProtected("other:1"));
+    auto changes = protected_keys.TakeChanges();
+    EXPECT_EQ(changes, cache::ProtectedKeyList::Changes(
+                           {{"key:3", true}, {"other:", true}}));
   }
 }
 
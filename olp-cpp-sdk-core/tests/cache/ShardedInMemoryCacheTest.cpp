@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+
+#include "ShardedInMemoryCache.h"
+
+namespace {
+namespace cache = olp::cache;
+
+std::string Key(int index) { return "key" + std::to_string(index); }
+
+std::string Value(int index) { return "value" + std::to_string(index); }
+
+TEST(ShardedInMemoryCacheTest, PutGetRemove) {
+  cache::ShardedInMemoryCache cache(100u, 4u);
+  ASSERT_EQ(4u, cache.ShardsCount());
+
+  for (int i = 0; i < 10; i++) {
+    EXPECT_TRUE(cache.Put(Key(i), Value(i)));
+  }
+
+  EXPECT_EQ(10u, cache.Size());
+  for (int i = 0; i < 10; i++) {
+    auto value = cache.Get(Key(i));
+    ASSERT_FALSE(value.empty());
+    EXPECT_EQ(Value(i), boost::any_cast<std::string>(value));
+    EXPECT_TRUE(cache.Contains(Key(i)));
+  }
+
+  EXPECT_TRUE(cache.Remove(Key(0)));
+  EXPECT_FALSE(cache.Contains(Key(0)));
+  EXPECT_EQ(9u, cache.Size());
+
+  cache.RemoveKeysWithPrefix("key", [](const std::string& key) {
+    return key == Key(1);
+  });
+  EXPECT_EQ(1u, cache.Size());
+  EXPECT_TRUE(cache.Contains(Key(1)));
+
+  cache.Clear();
+  EXPECT_EQ(0u, cache.Size());
+}
+
+TEST(ShardedInMemoryCacheTest, KeysSpreadAcrossShards) {
+  cache::ShardedInMemoryCache cache(1000u, 8u);
+
+  std::set<size_t> shards;
+  for (int i = 0; i < 100; i++) {
+    const auto index = cache.ShardIndex(Key(i));
+    EXPECT_LT(index, cache.ShardsCount());
+    EXPECT_EQ(index, cache.ShardIndex(Key(i)));
+    shards.insert(index);
+  }
+
+  EXPECT_GT(shards.size(), 1u);
+}
+
+TEST(ShardedInMemoryCacheTest, TotalSizeWithinLimit) {
+  const size_t max_size = 40u;
+  const size_t item_size = 5u;
+  cache::ShardedInMemoryCache cache(max_size, 4u);
+
+  for (int i = 0; i < 100; i++) {
+    cache.Put(Key(i), Value(i), cache::InMemoryCache::kExpiryMax, item_size);
+  }
+
+  EXPECT_LE(cache.Size() * item_size, max_size);
+
+  // A value larger than a segment does not fit even if the total size allows
+  EXPECT_FALSE(cache.Put("big", Value(0), cache::InMemoryCache::kExpiryMax,
+                         max_size / 2u));
+}
+
+TEST(ShardedInMemoryCacheTest, SingleShard) {
+  cache::ShardedInMemoryCache cache(100u, 0u);
+  EXPECT_EQ(1u, cache.ShardsCount());
+  EXPECT_EQ(0u, cache.ShardIndex(Key(1)));
+  EXPECT_TRUE(cache.Put(Key(1), Value(1)));
+  EXPECT_FALSE(cache.Get(Key(1)).empty());
+}
+
+}  // namespace
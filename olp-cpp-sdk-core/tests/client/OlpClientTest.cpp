@@ -714,6 +714,431 @@ TEST_P(OlpClientTest, HttpResponse) {
   testing::Mock::VerifyAndClearExpectations(network.get());
 }
 
+TEST_P(OlpClientTest, CallApiBytes) {
+  auto network = network_;
+
+  olp::client::OlpClient client(client_settings_, kEmptyBaseUrl);
+
+  const std::string content = "binary content";
+
+  EXPECT_CALL(*network, Send(_, _, _, _, _))
+      .Times(2)
+      .WillRepeatedly([&](olp::http::NetworkRequest /*request*/,
+                          olp::http::Network::Payload payload,
+                          olp::http::Network::Callback callback,
+                          olp::http::Network::HeaderCallback header_callback,
+                          olp::http::Network::DataCallback data_callback) {
+        EXPECT_FALSE(data_callback);
+        header_callback(http::kContentLengthHeader,
+                        std::to_string(content.size()));
+
+        // Write in chunks, same as the network does
+        const auto half = content.size() / 2;
+        payload->write(content.data(), half);
+        payload->write(content.data() + half, content.size() - half);
+        callback(olp::http::NetworkResponse()
+                     .WithStatus(http::HttpStatusCode::OK)
+                     .WithRequestId(5));
+
+        return olp::http::SendOutcome(5);
+      });
+
+  {
+    SCOPED_TRACE("Move the body out");
+
+    auto response = client.CallApiBytes({}, "GET", {}, {}, nullptr, {}, {});
+    ASSERT_EQ(http::HttpStatusCode::OK, response.GetStatus());
+    EXPECT_EQ(content, response.GetResponseAsString());
+
+    const auto bytes = response.MoveResponseAsBytes();
+    EXPECT_EQ(content, std::string(bytes.begin(), bytes.end()));
+    EXPECT_TRUE(response.MoveResponseAsBytes().empty());
+  }
+
+  {
+    SCOPED_TRACE("Read the body as a stream");
+
+    auto response = client.CallApiBytes({}, "GET", {}, {}, nullptr, {}, {});
+    ASSERT_EQ(http::HttpStatusCode::OK, response.GetStatus());
+    EXPECT_EQ(content, response.GetRawResponse().str());
+
+    std::vector<unsigned char> bytes;
+    response.GetResponse(bytes);
+    EXPECT_EQ(content, std::string(bytes.begin(), bytes.end()));
+  }
+
+  testing::Mock::VerifyAndClearExpectations(network.get());
+}
+
+TEST_P(OlpClientTest, CallApiStreamResume) {
+  auto network = network_;
+  client_settings_.retry_settings.max_attempts = 2;
+  client_settings_.retry_settings.initial_backdown_period = 1;
+
+  olp::client::OlpClient client(client_settings_, kEmptyBaseUrl);
+
+  const std::string content = "streamed content";
+  const auto half = content.size() / 2;
+
+  auto range_header = [](const olp::http::NetworkRequest& request) {
+    const auto& headers = request.GetHeaders();
+    auto it = std::find_if(headers.begin(), headers.end(),
+                           [](const olp::http::Header& header) {
+                             return header.first == http::kRangeHeader;
+                           });
+    return it != headers.end() ? it->second : std::string();
+  };
+
+  std::string received;
+  auto data_callback = [&](const uint8_t* data, uint64_t offset,
+                           size_t length) {
+    received.resize(offset);
+    received.append(reinterpret_cast<const char*>(data), length);
+  };
+
+  {
+    SCOPED_TRACE("Resumed from the received offset");
+
+    testing::InSequence sequence;
+
+    EXPECT_CALL(*network, Send(_, _, _, _, _))
+        .WillOnce([&](olp::http::NetworkRequest request,
+                      olp::http::Network::Payload /*payload*/,
+                      olp::http::Network::Callback callback,
+                      olp::http::Network::HeaderCallback /*header_callback*/,
+                      olp::http::Network::DataCallback data_callback) {
+          EXPECT_TRUE(range_header(request).empty());
+          data_callback(reinterpret_cast<const uint8_t*>(content.data()), 0,
+                        half);
+          callback(olp::http::NetworkResponse()
+                       .WithStatus(static_cast<int>(
+                           olp::http::ErrorCode::TIMEOUT_ERROR))
+                       .WithRequestId(5));
+          return olp::http::SendOutcome(5);
+        });
+
+    EXPECT_CALL(*network, Send(_, _, _, _, _))
+        .WillOnce([&](olp::http::NetworkRequest request,
+                      olp::http::Network::Payload /*payload*/,
+                      olp::http::Network::Callback callback,
+                      olp::http::Network::HeaderCallback header_callback,
+                      olp::http::Network::DataCallback data_callback) {
+          EXPECT_EQ("bytes=" + std::to_string(half) + "-",
+                    range_header(request));
+          header_callback(http::kContentRangeHeader,
+                          "bytes " + std::to_string(half) + "-" +
+                              std::to_string(content.size() - 1) + "/" +
+                              std::to_string(content.size()));
+          data_callback(
+              reinterpret_cast<const uint8_t*>(content.data() + half), 0,
+              content.size() - half);
+          callback(olp::http::NetworkResponse()
+                       .WithStatus(http::HttpStatusCode::PARTIAL_CONTENT)
+                       .WithRequestId(6));
+          return olp::http::SendOutcome(6);
+        });
+
+    auto response = client.CallApiStream({}, "GET", {}, {}, data_callback,
+                                         nullptr, {}, {});
+    EXPECT_EQ(http::HttpStatusCode::OK, response.GetStatus());
+    EXPECT_EQ(content, received);
+    testing::Mock::VerifyAndClearExpectations(network.get());
+  }
+
+  {
+    SCOPED_TRACE("Range ignored by the server");
+
+    received.clear();
+    testing::InSequence sequence;
+
+    EXPECT_CALL(*network, Send(_, _, _, _, _))
+        .WillOnce([&](olp::http::NetworkRequest /*request*/,
+                      olp::http::Network::Payload /*payload*/,
+                      olp::http::Network::Callback callback,
+                      olp::http::Network::HeaderCallback /*header_callback*/,
+                      olp::http::Network::DataCallback data_callback) {
+          data_callback(reinterpret_cast<const uint8_t*>(content.data()), 0,
+                        half);
+          callback(olp::http::NetworkResponse()
+                       .WithStatus(
+                           static_cast<int>(olp::http::ErrorCode::IO_ERROR))
+                       .WithRequestId(5));
+          return olp::http::SendOutcome(5);
+        });
+
+    EXPECT_CALL(*network, Send(_, _, _, _, _))
+        .WillOnce([&](olp::http::NetworkRequest request,
+                      olp::http::Network::Payload /*payload*/,
+                      olp::http::Network::Callback callback,
+                      olp::http::Network::HeaderCallback /*header_callback*/,
+                      olp::http::Network::DataCallback data_callback) {
+          EXPECT_FALSE(range_header(request).empty());
+          data_callback(reinterpret_cast<const uint8_t*>(content.data()), 0,
+                        content.size());
+          callback(olp::http::NetworkResponse()
+                       .WithStatus(http::HttpStatusCode::OK)
+                       .WithRequestId(6));
+          return olp::http::SendOutcome(6);
+        });
+
+    auto response = client.CallApiStream({}, "GET", {}, {}, data_callback,
+                                         nullptr, {}, {});
+    EXPECT_EQ(http::HttpStatusCode::OK, response.GetStatus());
+    EXPECT_EQ(content, received);
+    testing::Mock::VerifyAndClearExpectations(network.get());
+  }
+
+  const auto send_first_half =
+      [&](olp::http::NetworkRequest /*request*/,
+          olp::http::Network::Payload /*payload*/,
+          olp::http::Network::Callback callback,
+          olp::http::Network::HeaderCallback /*header_callback*/,
+          olp::http::Network::DataCallback data_callback) {
+        data_callback(reinterpret_cast<const uint8_t*>(content.data()), 0,
+                      half);
+        callback(olp::http::NetworkResponse()
+                     .WithStatus(
+                         static_cast<int>(olp::http::ErrorCode::IO_ERROR))
+                     .WithRequestId(5));
+        return olp::http::SendOutcome(5);
+      };
+
+  const std::string error_body = "Service unavailable, retry later";
+  const auto send_error = [&](olp::http::NetworkRequest /*request*/,
+                              olp::http::Network::Payload /*payload*/,
+                              olp::http::Network::Callback callback,
+                              olp::http::Network::HeaderCallback
+                              /*header_callback*/,
+                              olp::http::Network::DataCallback data_callback) {
+    data_callback(reinterpret_cast<const uint8_t*>(error_body.data()), 0,
+                  error_body.size());
+    callback(olp::http::NetworkResponse()
+                 .WithStatus(http::HttpStatusCode::SERVICE_UNAVAILABLE)
+                 .WithRequestId(6));
+    return olp::http::SendOutcome(6);
+  };
+
+  {
+    SCOPED_TRACE("Error body is not retried");
+
+    received.clear();
+    testing::InSequence sequence;
+
+    EXPECT_CALL(*network, Send(_, _, _, _, _)).WillOnce(send_error);
+
+    // The data callback received the error body, so the stream fails
+    auto response = client.CallApiStream({}, "GET", {}, {}, data_callback,
+                                         nullptr, {}, {});
+    EXPECT_EQ(http::HttpStatusCode::SERVICE_UNAVAILABLE, response.GetStatus());
+    EXPECT_EQ(error_body, received);
+    testing::Mock::VerifyAndClearExpectations(network.get());
+
+    received.clear();
+    EXPECT_CALL(*network, Send(_, _, _, _, _))
+        .WillOnce([&](olp::http::NetworkRequest request,
+                      olp::http::Network::Payload /*payload*/,
+                      olp::http::Network::Callback callback,
+                      olp::http::Network::HeaderCallback /*header_callback*/,
+                      olp::http::Network::DataCallback data_callback) {
+          EXPECT_TRUE(range_header(request).empty());
+          data_callback(reinterpret_cast<const uint8_t*>(content.data()), 0,
+                        content.size());
+          callback(olp::http::NetworkResponse()
+                       .WithStatus(http::HttpStatusCode::OK)
+                       .WithRequestId(7));
+          return olp::http::SendOutcome(7);
+        });
+
+    response = client.CallApiStream({}, "GET", {}, {}, data_callback, nullptr,
+                                    {}, {});
+    EXPECT_EQ(http::HttpStatusCode::OK, response.GetStatus());
+    EXPECT_EQ(content, received);
+    testing::Mock::VerifyAndClearExpectations(network.get());
+  }
+
+  {
+    SCOPED_TRACE("Resumed stream is not retried after an error body");
+
+    received.clear();
+    testing::InSequence sequence;
+
+    EXPECT_CALL(*network, Send(_, _, _, _, _)).WillOnce(send_first_half);
+    EXPECT_CALL(*network, Send(_, _, _, _, _)).WillOnce(send_error);
+
+    auto response = client.CallApiStream({}, "GET", {}, {}, data_callback,
+                                         nullptr, {}, {});
+    EXPECT_EQ(http::HttpStatusCode::SERVICE_UNAVAILABLE, response.GetStatus());
+    testing::Mock::VerifyAndClearExpectations(network.get());
+  }
+
+  {
+    SCOPED_TRACE("Error without a body is retried");
+
+    received.clear();
+    testing::InSequence sequence;
+
+    EXPECT_CALL(*network, Send(_, _, _, _, _))
+        .WillOnce([&](olp::http::NetworkRequest /*request*/,
+                      olp::http::Network::Payload /*payload*/,
+                      olp::http::Network::Callback callback,
+                      olp::http::Network::HeaderCallback /*header_callback*/,
+                      olp::http::Network::DataCallback /*data_callback*/) {
+          callback(olp::http::NetworkResponse()
+                       .WithStatus(http::HttpStatusCode::SERVICE_UNAVAILABLE)
+                       .WithRequestId(6));
+          return olp::http::SendOutcome(6);
+        });
+
+    EXPECT_CALL(*network, Send(_, _, _, _, _))
+        .WillOnce([&](olp::http::NetworkRequest /*request*/,
+                      olp::http::Network::Payload /*payload*/,
+                      olp::http::Network::Callback callback,
+                      olp::http::Network::HeaderCallback /*header_callback*/,
+                      olp::http::Network::DataCallback data_callback) {
+          data_callback(reinterpret_cast<const uint8_t*>(content.data()), 0,
+                        content.size());
+          callback(olp::http::NetworkResponse()
+                       .WithStatus(http::HttpStatusCode::OK)
+                       .WithRequestId(7));
+          return olp::http::SendOutcome(7);
+        });
+
+    auto response = client.CallApiStream({}, "GET", {}, {}, data_callback,
+                                         nullptr, {}, {});
+    EXPECT_EQ(http::HttpStatusCode::OK, response.GetStatus());
+    EXPECT_EQ(content, received);
+    testing::Mock::VerifyAndClearExpectations(network.get());
+  }
+
+  {
+    SCOPED_TRACE("Partial content without Content-Range is restarted");
+
+    received.clear();
+    testing::InSequence sequence;
+
+    EXPECT_CALL(*network, Send(_, _, _, _, _)).WillOnce(send_first_half);
+
+    EXPECT_CALL(*network, Send(_, _, _, _, _))
+        .WillOnce([&](olp::http::NetworkRequest /*request*/,
+                      olp::http::Network::Payload /*payload*/,
+                      olp::http::Network::Callback callback,
+                      olp::http::Network::HeaderCallback /*header_callback*/,
+                      olp::http::Network::DataCallback data_callback) {
+          data_callback(
+              reinterpret_cast<const uint8_t*>(content.data() + half), 0,
+              content.size() - half);
+          callback(olp::http::NetworkResponse()
+                       .WithStatus(http::HttpStatusCode::PARTIAL_CONTENT)
+                       .WithRequestId(6));
+          return olp::http::SendOutcome(6);
+        });
+
+    EXPECT_CALL(*network, Send(_, _, _, _, _))
+        .WillOnce([&](olp::http::NetworkRequest request,
+                      olp::http::Network::Payload /*payload*/,
+                      olp::http::Network::Callback callback,
+                      olp::http::Network::HeaderCallback /*header_callback*/,
+                      olp::http::Network::DataCallback data_callback) {
+          EXPECT_TRUE(range_header(request).empty());
+          data_callback(reinterpret_cast<const uint8_t*>(content.data()), 0,
+                        content.size());
+          callback(olp::http::NetworkResponse()
+                       .WithStatus(http::HttpStatusCode::OK)
+                       .WithRequestId(7));
+          return olp::http::SendOutcome(7);
+        });
+
+    auto response = client.CallApiStream({}, "GET", {}, {}, data_callback,
+                                         nullptr, {}, {});
+    EXPECT_EQ(http::HttpStatusCode::OK, response.GetStatus());
+    EXPECT_EQ(content, received);
+    testing::Mock::VerifyAndClearExpectations(network.get());
+  }
+}
+
+TEST_P(OlpClientTest, CallApiStreamAsync) {
+  auto network = network_;
+  client_settings_.retry_settings.max_attempts = 2;
+  client_settings_.retry_settings.initial_backdown_period = 1;
+
+  olp::client::OlpClient client(client_settings_, kEmptyBaseUrl);
+
+  const std::string content = "streamed content";
+  const std::string error_content = "service unavailable";
+
+  std::string received;
+  auto data_callback = [&](const uint8_t* data, uint64_t offset,
+                           size_t length) {
+    received.resize(offset);
+    received.append(reinterpret_cast<const char*>(data), length);
+  };
+
+  std::future<void> future;
+  std::future<void> retry_future;
+  auto wait_for_release = std::make_shared<std::promise<void>>();
+
+  testing::InSequence sequence;
+
+  EXPECT_CALL(*network, Send(_, _, _, _, _))
+      .WillOnce([&](olp::http::NetworkRequest /*request*/,
+                    olp::http::Network::Payload payload,
+                    olp::http::Network::Callback callback,
+                    olp::http::Network::HeaderCallback /*header_callback*/,
+                    olp::http::Network::DataCallback data_callback) {
+        EXPECT_FALSE(payload);
+        future = std::async(std::launch::async, [=]() {
+          wait_for_release->get_future().get();
+          data_callback(
+              reinterpret_cast<const uint8_t*>(error_content.data()), 0,
+              error_content.size());
+          callback(olp::http::NetworkResponse()
+                       .WithStatus(http::HttpStatusCode::SERVICE_UNAVAILABLE)
+                       .WithRequestId(5));
+        });
+        return olp::http::SendOutcome(5);
+      });
+
+  EXPECT_CALL(*network, Send(_, _, _, _, _))
+      .WillOnce([&](olp::http::NetworkRequest /*request*/,
+                    olp::http::Network::Payload payload,
+                    olp::http::Network::Callback callback,
+                    olp::http::Network::HeaderCallback /*header_callback*/,
+                    olp::http::Network::DataCallback data_callback) {
+        EXPECT_FALSE(payload);
+        retry_future = std::async(std::launch::async, [=]() {
+          std::this_thread::sleep_for(kCallbackSleepTime);
+          data_callback(reinterpret_cast<const uint8_t*>(content.data()), 0,
+                        content.size());
+          callback(olp::http::NetworkResponse()
+                       .WithStatus(http::HttpStatusCode::OK)
+                       .WithRequestId(6));
+        });
+        return olp::http::SendOutcome(6);
+      });
+
+  std::promise<HttpResponse> promise;
+  client.CallApiStreamAsync({}, "GET", {}, {}, data_callback, nullptr, {},
+                            [&](HttpResponse response) {
+                              promise.set_value(std::move(response));
+                            });
+
+  // The call does not wait for the response
+  EXPECT_TRUE(received.empty());
+  wait_for_release->set_value();
+
+  auto response_future = promise.get_future();
+  ASSERT_EQ(std::future_status::ready,
+            response_future.wait_for(kCallbackWaitTime));
+  auto response = response_future.get();
+  future.wait();
+  retry_future.wait();
+
+  EXPECT_EQ(http::HttpStatusCode::OK, response.GetStatus());
+  // The retried request passes the content from the start
+  EXPECT_EQ(content, received);
+  testing::Mock::VerifyAndClearExpectations(network.get());
+}
+
 TEST_P(OlpClientTest, Paths) {
   auto network = network_;
 
@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <olp/core/client/CancellationContext.h>
+#include <olp/core/thread/WorkStealingTaskScheduler.h>
+
+using CancellationContext = olp::client::CancellationContext;
+using TaskScheduler = olp::thread::TaskScheduler;
+using WorkStealingScheduler = olp::thread::WorkStealingTaskScheduler;
+
+namespace chrono = std::chrono;
+
+namespace {
+constexpr size_t kThreads{3u};
+constexpr size_t kNumTasks{30u};
+constexpr chrono::milliseconds kSleep{100};
+constexpr int64_t kMaxWaitMs{1000};
+}  // namespace
+
+TEST(WorkStealingTaskSchedulerTest, MultiUserPush) {
+  SCOPED_TRACE("Multiple users push tasks");
+
+  constexpr uint32_t kPushThreads = 3;
+  constexpr uint32_t kTotalTasks = kPushThreads * (2 * kNumTasks);
+
+  auto thread_pool = std::make_shared<WorkStealingScheduler>(kThreads);
+  std::atomic<uint32_t> counter(0u);
+  std::vector<std::thread> push_threads;
+
+  // Create and start push threads for concurrent task creation
+  push_threads.reserve(kPushThreads);
+  for (size_t idx = 0; idx < kPushThreads; ++idx) {
+    push_threads.emplace_back([=, &counter] {
+      TaskScheduler& scheduler = *thread_pool;
+      for (uint32_t idx = 0u; idx < kNumTasks; ++idx) {
+        scheduler.ScheduleTask([&](const CancellationContext&) { ++counter; });
+        scheduler.ScheduleTask([&]() { ++counter; });
+      }
+    });
+  }
+
+  for (auto& thread : push_threads) {
+    thread.join();
+  }
+
+  // Wait for threads to finish but do not exceed the timeout
+  const auto start = chrono::system_clock::now();
+  auto check_condition = [&]() {
+    return counter.load() < kTotalTasks &&
+           chrono::duration_cast<chrono::milliseconds>(
+               chrono::system_clock::now() - start)
+                   .count() < kMaxWaitMs;
+  };
+
+  while (check_condition()) {
+    std::this_thread::sleep_for(kSleep / 10);
+  }
+
+  EXPECT_EQ(kTotalTasks, counter.load());
+
+  // Stop and join threads in destructor
+  thread_pool.reset();
+}
+
+TEST(WorkStealingTaskSchedulerTest, StealNestedTasks) {
+  SCOPED_TRACE("Tasks scheduled from the pool thread are stolen");
+
+  auto thread_pool = std::make_shared<WorkStealingScheduler>(kThreads);
+  TaskScheduler& scheduler = *thread_pool;
+
+  std::mutex mutex;
+  std::set<std::thread::id> thread_ids;
+  std::thread::id blocked_thread_id;
+  std::atomic<uint32_t> counter(0u);
+  std::promise<void> promise;
+  std::shared_future<void> future = promise.get_future().share();
+
+  // One task schedules the rest of the tasks to its own deque and blocks, so
+  // they can be only executed by the other threads
+  scheduler.ScheduleTask([&]() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      blocked_thread_id = std::this_thread::get_id();
+    }
+
+    for (uint32_t idx = 0u; idx < kNumTasks; ++idx) {
+      scheduler.ScheduleTask([&]() {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          thread_ids.insert(std::this_thread::get_id());
+        }
+        if (++counter == kNumTasks) {
+          promise.set_value();
+        }
+      });
+    }
+
+    future.wait_for(chrono::milliseconds(kMaxWaitMs));
+  });
+
+  EXPECT_EQ(future.wait_for(chrono::milliseconds(kMaxWaitMs)),
+            std::future_status::ready);
+  EXPECT_EQ(kNumTasks, counter.load());
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_FALSE(thread_ids.empty());
+    EXPECT_EQ(thread_ids.count(blocked_thread_id), 0u);
+  }
+
+  thread_pool.reset();
+}
+
+TEST(WorkStealingTaskSchedulerTest, Prioritization) {
+  auto thread_pool = std::make_shared<WorkStealingScheduler>(1);
+  TaskScheduler& scheduler = *thread_pool;
+
+  struct MockOp {
+    MOCK_METHOD(void, Op, (uint32_t, olp::thread::Priority));
+  } mockop;
+
+  testing::Sequence sequence;
+
+  std::promise<void> block_promise;
+  auto block_future = block_promise.get_future();
+
+  scheduler.ScheduleTask(
+      [&]() { block_future.wait_for(std::chrono::milliseconds(kMaxWaitMs)); },
+      std::numeric_limits<uint32_t>::max());
+
+  const uint32_t expected_tasks = 30u;
+  uint32_t counter(0u);
+
+  const olp::thread::Priority priorities[] = {
+      olp::thread::LOW, olp::thread::NORMAL, olp::thread::HIGH};
+  std::vector<uint32_t> tasks_by_priority[3];
+
+  for (uint32_t id = 0; id < expected_tasks; ++id) {
+    const auto band = id % 3;
+    const auto priority = priorities[band];
+    tasks_by_priority[band].push_back(id);
+    scheduler.ScheduleTask(
+        [&, id, priority]() {
+          counter++;
+          mockop.Op(id, priority);
+        },
+        priority);
+  }
+
+  // Same band tasks keep the order with one thread
+  for (auto band : {2, 1, 0}) {
+    for (auto id : tasks_by_priority[band]) {
+      EXPECT_CALL(mockop, Op(id, priorities[band])).InSequence(sequence);
+    }
+  }
+
+  block_promise.set_value();
+
+  // task to verify all tasks are finished
+  std::promise<void> promise;
+  auto future = promise.get_future();
+  scheduler.ScheduleTask([&]() { promise.set_value(); }, 1);
+
+  EXPECT_EQ(future.wait_for(std::chrono::milliseconds(kMaxWaitMs)),
+            std::future_status::ready);
+  EXPECT_EQ(expected_tasks, counter);
+
+  thread_pool.reset();
+
+  testing::Mock::VerifyAndClearExpectations(&mockop);
+}
+
+TEST(WorkStealingTaskSchedulerTest, DiscardOnDestruction) {
+  auto thread_pool = std::make_shared<WorkStealingScheduler>(1);
+  TaskScheduler& scheduler = *thread_pool;
+
+  std::promise<void> block_promise;
+  std::promise<void> started_promise;
+  auto started_future = started_promise.get_future();
+  auto block_future = block_promise.get_future();
+
+  scheduler.ScheduleTask([&]() {
+    started_promise.set_value();
+    block_future.wait_for(std::chrono::milliseconds(kMaxWaitMs));
+  });
+  ASSERT_EQ(started_future.wait_for(std::chrono::milliseconds(kMaxWaitMs)),
+            std::future_status::ready);
+
+  // The task is destroyed without being executed
+  auto executed = false;
+  auto token = std::make_shared<int>(0);
+  std::weak_ptr<int> weak_token = token;
+  scheduler.ScheduleTask([&executed, token]() { executed = true; });
+  token.reset();
+
+  std::thread release([&]() {
+    std::this_thread::sleep_for(kSleep);
+    block_promise.set_value();
+  });
+  thread_pool.reset();
+  release.join();
+
+  EXPECT_FALSE(executed);
+  EXPECT_FALSE(weak_token.lock());
+}
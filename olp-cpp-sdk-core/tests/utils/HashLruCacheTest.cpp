@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <olp/core/utils/HashLruCache.h>
+
+namespace {
+
+using Cache = olp::utils::HashLruCache<std::string, int>;
+
+std::vector<std::string> Keys(const Cache& cache) {
+  std::vector<std::string> keys;
+  for (const auto& entry : cache) {
+    keys.push_back(entry.key());
+  }
+  return keys;
+}
+
+TEST(HashLruCacheTest, InsertAndFind) {
+  Cache cache(3u);
+
+  EXPECT_TRUE(cache.Insert("a", 1).second);
+  EXPECT_TRUE(cache.Insert("b", 2).second);
+  EXPECT_TRUE(cache.Insert("c", 3).second);
+
+  {
+    SCOPED_TRACE("Insert does not update the existing value");
+
+    const auto result = cache.Insert("a", 10);
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(result.first.value(), 1);
+    EXPECT_EQ(Keys(cache), (std::vector<std::string>{"a", "c", "b"}));
+  }
+
+  {
+    SCOPED_TRACE("Find promotes, FindNoPromote does not");
+
+    EXPECT_EQ(cache.Find("b").value(), 2);
+    EXPECT_EQ(cache.FindNoPromote("c").value(), 3);
+    EXPECT_EQ(Keys(cache), (std::vector<std::string>{"b", "a", "c"}));
+    EXPECT_EQ(cache.Find("x"), cache.end());
+    EXPECT_EQ(cache.Find("x", -1), -1);
+  }
+
+  {
+    SCOPED_TRACE("The least recently used is evicted");
+
+    std::vector<std::string> evicted;
+    cache.SetEvictionCallback(
+        [&](const std::string& key, int&&) { evicted.push_back(key); });
+
+    EXPECT_TRUE(cache.Insert("d", 4).second);
+    EXPECT_EQ(evicted, std::vector<std::string>{"c"});
+    EXPECT_EQ(Keys(cache), (std::vector<std::string>{"d", "b", "a"}));
+    EXPECT_EQ(cache.rbegin().key(), "a");
+    EXPECT_EQ(cache.Size(), 3u);
+  }
+}
+
+TEST(HashLruCacheTest, InsertOrAssignWithCost) {
+  struct Cost {
+    std::size_t operator()(const int& value) const {
+      return static_cast<std::size_t>(value);
+    }
+  };
+  olp::utils::HashLruCache<std::string, int, Cost> cache(10u);
+
+  EXPECT_TRUE(cache.InsertOrAssign("a", 4).second);
+  EXPECT_TRUE(cache.InsertOrAssign("b", 4).second);
+  EXPECT_EQ(cache.Size(), 8u);
+
+  EXPECT_FALSE(cache.InsertOrAssign("a", 2).second);
+  EXPECT_EQ(cache.Size(), 6u);
+  EXPECT_EQ(cache.begin().key(), "a");
+
+  // Too big to be inserted
+  EXPECT_EQ(cache.InsertOrAssign("c", 11).first, cache.end());
+
+  // Evicts "b"
+  EXPECT_TRUE(cache.InsertOrAssign("c", 6).second);
+  EXPECT_EQ(cache.FindNoPromote("b"), cache.end());
+  EXPECT_EQ(cache.Size(), 8u);
+
+  cache.Resize(6u);
+  EXPECT_EQ(cache.Size(), 6u);
+  EXPECT_EQ(cache.FindNoPromote("a"), cache.end());
+}
+
+TEST(HashLruCacheTest, Erase) {
+  Cache cache(1000u);
+  for (auto i = 0; i < 1000; ++i) {
+    cache.Insert(std::to_string(i), i);
+  }
+
+  for (auto it = cache.begin(); it != cache.end();) {
+    if (it.value() % 2) {
+      it = cache.Erase(it);
+    } else {
+      ++it;
+    }
+  }
+  EXPECT_EQ(cache.Size(), 500u);
+
+  for (auto i = 0; i < 1000; ++i) {
+    const auto found = cache.FindNoPromote(std::to_string(i)) != cache.end();
+    EXPECT_EQ(found, i % 2 == 0);
+    EXPECT_EQ(cache.Erase(std::to_string(i)), i % 2 == 0);
+  }
+  EXPECT_EQ(cache.Size(), 0u);
+  EXPECT_EQ(cache.begin(), cache.end());
+
+  // The freed nodes are reused
+  EXPECT_TRUE(cache.Insert("a", 1).second);
+  EXPECT_EQ(Keys(cache), std::vector<std::string>{"a"});
+
+  cache.Clear();
+  EXPECT_EQ(cache.Size(), 0u);
+  EXPECT_EQ(cache.FindNoPromote("a"), cache.end());
+
+  // The nodes are allocated again after the clear
+  for (auto i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(cache.Insert(std::to_string(i), i).second);
+  }
+  EXPECT_EQ(cache.Size(), 1000u);
+  for (auto i = 0; i < 1000; ++i) {
+    EXPECT_NE(cache.FindNoPromote(std::to_string(i)), cache.end());
+  }
+}
+
+TEST(HashLruCacheTest, Move) {
+  Cache cache(3u);
+  cache.Insert("a", 1);
+  cache.Insert("b", 2);
+
+  Cache other(std::move(cache));
+  EXPECT_EQ(Keys(other), (std::vector<std::string>{"b", "a"}));
+  EXPECT_EQ(other.GetMaxSize(), 3u);
+
+  cache = std::move(other);
+  EXPECT_EQ(Keys(cache), (std::vector<std::string>{"b", "a"}));
+  EXPECT_EQ(cache.Find("a").value(), 1);
+}
+
+}  // namespace
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -220,6 +221,46 @@ class DATASERVICE_READ_API DataRequest final {
     return *this;
   }
 
+  /**
+   * @brief Gets the offset of the first requested byte of the data.
+   *
+   * @return The offset or `boost::none` if the whole data is requested.
+   */
+  inline const boost::optional<std::uint64_t>& GetRangeOffset() const {
+    return range_offset_;
+  }
+
+  /**
+   * @brief Gets the number of the requested bytes of the data.
+   *
+   * @return The number of bytes or `boost::none` if the data is requested
+   * from the offset to the end.
+   */
+  inline const boost::optional<std::uint64_t>& GetRangeSize() const {
+    return range_size_;
+  }
+
+  /**
+   * @brief Sets the byte range of the data to request.
+   *
+   * Only the requested bytes are downloaded, and the range is not cached. If
+   * the whole data is already cached, the range is read from the cache. The
+   * range is supported by the versioned layer data requests.
+   *
+   * @param offset The offset of the first requested byte.
+   * @param size The number of the requested bytes or `boost::none` to
+   * request the data from the offset to the end.
+   *
+   * @return A reference to the updated `DataRequest` instance.
+   */
+  inline DataRequest& WithRange(
+      std::uint64_t offset,
+      boost::optional<std::uint64_t> size = boost::none) {
+    range_offset_ = offset;
+    range_size_ = size;
+    return *this;
+  }
+
   /**
    * @brief Creates a readable format for the request.
    *
@@ -238,6 +279,13 @@ class DATASERVICE_READ_API DataRequest final {
       out << GetDataHandle().get();
     }
     out << "]";
+    if (GetRangeOffset()) {
+      out << "(" << GetRangeOffset().get() << ",";
+      if (GetRangeSize()) {
+        out << GetRangeSize().get();
+      }
+      out << ")";
+    }
     if (version) {
       out << "@" << version.get();
     }
@@ -253,6 +301,8 @@ class DATASERVICE_READ_API DataRequest final {
   boost::optional<int64_t> catalog_version_;
   boost::optional<std::string> data_handle_;
   boost::optional<std::string> billing_tag_;
+  boost::optional<std::uint64_t> range_offset_;
+  boost::optional<std::uint64_t> range_size_;
   FetchOptions fetch_option_{OnlineIfNotFound};
   uint32_t priority_{thread::NORMAL};
 };
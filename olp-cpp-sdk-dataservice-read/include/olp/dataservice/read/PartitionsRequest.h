@@ -179,6 +179,31 @@ class DATASERVICE_READ_API PartitionsRequest final {
     return *this;
   }
 
+  /**
+   * @brief Sets the maximum number of the parallel query requests.
+   *
+   * A single query request supports up to 100 partitions, so the longer list
+   * of partitions is split into the batches. The batches are requested in
+   * parallel using the task scheduler of the client.
+   *
+   * @param max_parallel_queries The maximum number of the query requests in
+   * flight. The default value 1 requests the batches one by one.
+   *
+   * @return A reference to the updated `PartitionsRequest` instance.
+   */
+  inline PartitionsRequest& WithMaxParallelQueries(
+      size_t max_parallel_queries) {
+    max_parallel_queries_ = max_parallel_queries;
+    return *this;
+  }
+
+  /**
+   * @brief Gets the maximum number of the parallel query requests.
+   *
+   * @return The maximum number of the query requests in flight.
+   */
+  inline size_t GetMaxParallelQueries() const { return max_parallel_queries_; }
+
   /**
    * @brief Creates a readable format for the request.
    *
@@ -206,6 +231,7 @@ class DATASERVICE_READ_API PartitionsRequest final {
   AdditionalFields additional_fields_;
   boost::optional<std::string> billing_tag_;
   FetchOptions fetch_option_{OnlineIfNotFound};
+  size_t max_parallel_queries_{1u};
 };
 
 }  // namespace read
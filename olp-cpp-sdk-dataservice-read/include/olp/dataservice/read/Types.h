@@ -19,10 +19,13 @@
 
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include <olp/core/cache/ValueView.h>
 #include <olp/core/client/ApiError.h>
 #include <olp/core/client/ApiNoResult.h>
 #include <olp/core/client/ApiResponse.h>
@@ -83,6 +86,32 @@ using DataResponse = Response<DataResult, client::NetworkStatistics>;
 /// The callback type of the data response.
 using DataResponseCallback = Callback<DataResult, client::NetworkStatistics>;
 
+/// The read-only view of the data.
+using DataViewResult = cache::ValueView;
+/// The data view response alias.
+using DataViewResponse = Response<DataViewResult, client::NetworkStatistics>;
+/// The callback type of the data view response.
+using DataViewResponseCallback =
+    Callback<DataViewResult, client::NetworkStatistics>;
+
+/// The results of the batch data requests in the order of the requests.
+using BatchDataResult = std::vector<DataResponse>;
+/// The batch data response alias.
+using BatchDataResponse = Response<BatchDataResult>;
+/// The callback type of the batch data response.
+using BatchDataResponseCallback = Callback<BatchDataResult>;
+
+/// The callback that receives the next chunk of the streamed data. The chunk
+/// is valid only during the call.
+using DataChunkCallback =
+    std::function<void(const unsigned char* data, std::size_t size)>;
+/// The streamed data response alias.
+using DataStreamResponse =
+    Response<client::ApiNoResult, client::NetworkStatistics>;
+/// The callback type of the streamed data response.
+using DataStreamResponseCallback =
+    Callback<client::ApiNoResult, client::NetworkStatistics>;
+
 /// The aggregated data response alias.
 using AggregatedDataResponse =
     Response<AggregatedDataResult, client::NetworkStatistics>;
@@ -187,6 +187,110 @@ class DATASERVICE_READ_API VersionedLayerClient final {
    */
   client::CancellableFuture<DataResponse> GetData(DataRequest data_request);
 
+  /**
+   * @brief Fetches a read-only view of the data asynchronously using
+   * a partition ID or data handle.
+   *
+   * Works like `GetData(DataRequest)`, but the data found in the cache is not
+   * copied out of the cache storage, which avoids copying of large blobs. The
+   * view keeps the data valid as long as it exists. The data fetched from
+   * the network is viewed without an additional copy.
+   *
+   * @param data_request The `DataRequest` instance that contains a complete set
+   * of request parameters.
+   * @note CacheWithUpdate fetch option is not supported.
+   * @param callback The `DataViewResponseCallback` object that is invoked if
+   * the `DataViewResult` object is available or an error is encountered.
+   *
+   * @return A token that can be used to cancel this request.
+   */
+  client::CancellationToken GetDataView(DataRequest data_request,
+                                        DataViewResponseCallback callback);
+
+  /**
+   * @brief Fetches a read-only view of the data asynchronously using
+   * a partition ID or data handle.
+   *
+   * Works like `GetData(DataRequest)`, but the data found in the cache is not
+   * copied out of the cache storage.
+   *
+   * @param data_request The `DataRequest` instance that contains a complete set
+   * of request parameters.
+   * @note CacheWithUpdate fetch option is not supported.
+   *
+   * @return `CancellableFuture` that contains the `DataViewResponse` instance
+   * or an error. You can also use `CancellableFuture` to cancel this request.
+   */
+  client::CancellableFuture<DataViewResponse> GetDataView(
+      DataRequest data_request);
+
+  /**
+   * @brief Fetches the data of several partitions asynchronously.
+   *
+   * Works like `GetData(DataRequest)` for every request, but the partitions
+   * metadata is queried in batches and the cache is looked up once for all
+   * the data. Only the data missing in the cache is downloaded, and the
+   * downloads run concurrently.
+   *
+   * The catalog version and the partitions metadata are resolved with the
+   * fetch option and billing tag of the first request. The data is fetched
+   * with the fetch option and billing tag of each request.
+   *
+   * @param data_requests The `DataRequest` instances that contain a partition
+   * ID or data handle each.
+   * @note CacheWithUpdate fetch option is not supported.
+   * @param callback The `BatchDataResponseCallback` object that is invoked
+   * with the `DataResponse` of every request, in the order of the requests,
+   * or with an error when the batch can't be processed.
+   *
+   * @return A token that can be used to cancel this request.
+   */
+  client::CancellationToken GetData(std::vector<DataRequest> data_requests,
+                                    BatchDataResponseCallback callback);
+
+  /**
+   * @brief Fetches the data of several partitions asynchronously.
+   *
+   * @see `GetData(std::vector<DataRequest>, BatchDataResponseCallback)` for
+   * more details.
+   *
+   * @param data_requests The `DataRequest` instances that contain a partition
+   * ID or data handle each.
+   *
+   * @return `CancellableFuture` that contains the `BatchDataResponse` instance
+   * or an error. You can also use `CancellableFuture` to cancel this request.
+   */
+  client::CancellableFuture<BatchDataResponse> GetData(
+      std::vector<DataRequest> data_requests);
+
+  /**
+   * @brief Streams data asynchronously using a partition ID or data handle.
+   *
+   * Works like `GetData(DataRequest)`, but the downloaded data is passed to
+   * the chunk callback while it arrives, so the data can be decoded during
+   * the download. The data found in the cache is passed as one chunk.
+   *
+   * The downloaded data is also collected to be written to the cache, unless
+   * the `OnlineOnly` fetch option is used. Use `OnlineOnly` to keep the
+   * memory usage independent of the data size.
+   *
+   * @param data_request The `DataRequest` instance that contains a complete set
+   * of request parameters.
+   * @note CacheWithUpdate fetch option is not supported.
+   * @param chunk_callback The `DataChunkCallback` object that receives the
+   * data chunks in order. It is called on the network thread and should not
+   * block.
+   * @param callback The `DataStreamResponseCallback` object that is invoked
+   * when all the data is streamed or an error is encountered. On an error,
+   * the chunks already passed to `chunk_callback` should be discarded, they
+   * are incomplete and can contain the body of the failed response.
+   *
+   * @return A token that can be used to cancel this request.
+   */
+  client::CancellationToken GetDataStream(DataRequest data_request,
+                                          DataChunkCallback chunk_callback,
+                                          DataStreamResponseCallback callback);
+
   /**
    * @brief Fetches data asynchronously using a TileKey.
    *
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <string>
+
+#include <olp/core/http/NetworkConstants.h>
+#include <olp/core/http/NetworkTypes.h>
+#include <olp/core/http/NetworkUtils.h>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+/// The validators of a conditional request and its response.
+struct ConditionalRequest {
+  /// The ETag of the cached response, sent as `If-None-Match`. The request
+  /// is unconditional when empty.
+  std::string if_none_match;
+  /// The ETag of the received response, empty if there is none.
+  std::string etag;
+};
+
+inline void AddConditionalHeaders(
+    const ConditionalRequest* conditional,
+    std::multimap<std::string, std::string>& header_params) {
+  if (conditional && !conditional->if_none_match.empty()) {
+    header_params.emplace(http::kIfNoneMatchHeader,
+                          conditional->if_none_match);
+  }
+}
+
+inline void ReadValidators(const http::Headers& headers,
+                           ConditionalRequest* conditional) {
+  if (!conditional) {
+    return;
+  }
+
+  auto it = std::find_if(
+      headers.begin(), headers.end(), [](const http::Header& header) {
+        return http::NetworkUtils::CaseInsensitiveCompare(header.first,
+                                                          http::kETagHeader);
+      });
+  conditional->etag = it != headers.end() ? it->second : std::string();
+}
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "Crc32c.h"
+
+#include <array>
+#include <cstdlib>
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define OLP_SDK_CRC32C_SSE42
+#include <nmmintrin.h>
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define OLP_SDK_CRC32C_SSE42
+#include <intrin.h>
+#include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#define OLP_SDK_CRC32C_ARM
+#include <arm_acle.h>
+#endif
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+namespace {
+constexpr std::uint32_t kCrc32cPolynomial = 0x82F63B78u;
+
+// The tables of the slicing-by-8 algorithm, the table `n` gives the checksum
+// of the byte followed by `n` zero bytes.
+using Crc32cTables = std::array<std::array<std::uint32_t, 256>, 8>;
+
+using UpdateFunction = std::uint32_t (*)(std::uint32_t crc,
+                                         const unsigned char* data,
+                                         std::size_t size);
+
+Crc32cTables MakeTables() {
+  Crc32cTables tables;
+  for (std::uint32_t i = 0u; i < 256u; ++i) {
+    auto crc = i;
+    for (auto bit = 0; bit < 8; ++bit) {
+      crc = (crc & 1u) ? (crc >> 1) ^ kCrc32cPolynomial : crc >> 1;
+    }
+    tables[0][i] = crc;
+  }
+  for (std::size_t table = 1u; table < tables.size(); ++table) {
+    for (std::size_t i = 0u; i < 256u; ++i) {
+      const auto crc = tables[table - 1][i];
+      tables[table][i] = (crc >> 8) ^ tables[0][crc & 0xFFu];
+    }
+  }
+  return tables;
+}
+
+const Crc32cTables& Tables() {
+  static const Crc32cTables tables = MakeTables();
+  return tables;
+}
+
+std::uint32_t ReadLittleEndian32(const unsigned char* data) {
+  return static_cast<std::uint32_t>(data[0]) |
+         static_cast<std::uint32_t>(data[1]) << 8 |
+         static_cast<std::uint32_t>(data[2]) << 16 |
+         static_cast<std::uint32_t>(data[3]) << 24;
+}
+
+std::uint32_t UpdateSoftware(std::uint32_t crc, const unsigned char* data,
+                             std::size_t size) {
+  const auto& t = Tables();
+  for (; size >= 8u; data += 8, size -= 8u) {
+    const auto low = crc ^ ReadLittleEndian32(data);
+    const auto high = ReadLittleEndian32(data + 4);
+    crc = t[7][low & 0xFFu] ^ t[6][(low >> 8) & 0xFFu] ^
+          t[5][(low >> 16) & 0xFFu] ^ t[4][low >> 24] ^ t[3][high & 0xFFu] ^
+          t[2][(high >> 8) & 0xFFu] ^ t[1][(high >> 16) & 0xFFu] ^
+          t[0][high >> 24];
+  }
+  for (; size > 0u; ++data, --size) {
+    crc = t[0][(crc ^ *data) & 0xFFu] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+#if defined(OLP_SDK_CRC32C_SSE42)
+#if defined(_MSC_VER)
+bool IsHardwareSupported() {
+  int info[4];
+  __cpuid(info, 1);
+  return (info[2] & (1 << 20)) != 0;
+}
+
+std::uint32_t UpdateHardware(std::uint32_t crc, const unsigned char* data,
+                             std::size_t size) {
+#else
+bool IsHardwareSupported() { return __builtin_cpu_supports("sse4.2"); }
+
+__attribute__((target("sse4.2"))) std::uint32_t UpdateHardware(
+    std::uint32_t crc, const unsigned char* data, std::size_t size) {
+#endif
+  std::uint64_t crc64 = crc;
+  for (; size >= 8u; data += 8, size -= 8u) {
+    std::uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    crc64 = _mm_crc32_u64(crc64, value);
+  }
+  crc = static_cast<std::uint32_t>(crc64);
+  for (; size > 0u; ++data, --size) {
+    crc = _mm_crc32_u8(crc, *data);
+  }
+  return crc;
+}
+#elif defined(OLP_SDK_CRC32C_ARM)
+bool IsHardwareSupported() { return true; }
+
+std::uint32_t UpdateHardware(std::uint32_t crc, const unsigned char* data,
+                             std::size_t size) {
+  for (; size >= 8u; data += 8, size -= 8u) {
+    std::uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    crc = __crc32cd(crc, value);
+  }
+  for (; size > 0u; ++data, --size) {
+    crc = __crc32cb(crc, *data);
+  }
+  return crc;
+}
+#endif
+
+UpdateFunction SelectUpdateFunction() {
+#if defined(OLP_SDK_CRC32C_SSE42) || defined(OLP_SDK_CRC32C_ARM)
+  if (IsHardwareSupported()) {
+    return &UpdateHardware;
+  }
+#endif
+  return &UpdateSoftware;
+}
+}  // namespace
+
+void Crc32c::Update(const unsigned char* data, std::size_t size) {
+  static const UpdateFunction update = SelectUpdateFunction();
+  crc_ = update(crc_, data, size);
+}
+
+std::uint32_t Crc32c::Value() const { return crc_ ^ 0xFFFFFFFFu; }
+
+bool Crc32c::Matches(const std::string& crc) const {
+  if (crc.empty() || crc.size() > 8u) {
+    return false;
+  }
+
+  char* end = nullptr;
+  const auto expected = std::strtoul(crc.c_str(), &end, 16);
+  return end == crc.c_str() + crc.size() && expected == Value();
+}
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+/// Computes the CRC-32C (Castagnoli) checksum of the data incrementally.
+///
+/// Uses the CRC32 instructions of SSE 4.2 or ARMv8 when the CPU supports them,
+/// and the slicing-by-8 tables otherwise.
+class Crc32c {
+ public:
+  /// Adds the next chunk of the data to the checksum.
+  void Update(const unsigned char* data, std::size_t size);
+
+  /// Gets the checksum of the data added so far.
+  std::uint32_t Value() const;
+
+  /// Checks that the checksum matches the partition `crc`, which is the
+  /// checksum formatted as 8 hex characters padded with zeros.
+  bool Matches(const std::string& crc) const;
+
+ private:
+  std::uint32_t crc_{0xFFFFFFFFu};
+};
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
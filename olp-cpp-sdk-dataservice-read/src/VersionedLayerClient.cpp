@@ -56,6 +56,34 @@ client::CancellableFuture<DataResponse> VersionedLayerClient::GetData(
   return impl_->GetData(std::move(data_request));
 }
 
+client::CancellationToken VersionedLayerClient::GetDataView(
+    DataRequest data_request, DataViewResponseCallback callback) {
+  return impl_->GetDataView(std::move(data_request), std::move(callback));
+}
+
+client::CancellableFuture<DataViewResponse> VersionedLayerClient::GetDataView(
+    DataRequest data_request) {
+  return impl_->GetDataView(std::move(data_request));
+}
+
+client::CancellationToken VersionedLayerClient::GetData(
+    std::vector<DataRequest> data_requests,
+    BatchDataResponseCallback callback) {
+  return impl_->GetData(std::move(data_requests), std::move(callback));
+}
+
+client::CancellableFuture<BatchDataResponse> VersionedLayerClient::GetData(
+    std::vector<DataRequest> data_requests) {
+  return impl_->GetData(std::move(data_requests));
+}
+
+client::CancellationToken VersionedLayerClient::GetDataStream(
+    DataRequest data_request, DataChunkCallback chunk_callback,
+    DataStreamResponseCallback callback) {
+  return impl_->GetDataStream(std::move(data_request),
+                              std::move(chunk_callback), std::move(callback));
+}
+
 client::CancellationToken VersionedLayerClient::GetPartitions(
     PartitionsRequest partitions_request, PartitionsResponseCallback callback) {
   return impl_->GetPartitions(std::move(partitions_request),
@@ -57,6 +57,37 @@ namespace {
 constexpr auto kLogTag = "VersionedLayerClientImpl";
 constexpr int64_t kInvalidVersion = -1;
 constexpr auto kQuadTreeDepth = 4;
+constexpr auto kMaxDecodedPartitions = 16384u;
+
+/// Collects the results of the batch data requests and passes them to the
+/// callback when the last download is completed.
+class BatchDataJob {
+ public:
+  BatchDataJob(BatchDataResult results, std::size_t downloads_count,
+               BatchDataResponseCallback callback)
+      : results_(std::move(results)),
+        downloads_count_(downloads_count),
+        callback_(std::move(callback)) {}
+
+  void CompleteDownload(std::size_t index, DataResponse response) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    results_[index] = std::move(response);
+    if (--downloads_count_ > 0u) {
+      return;
+    }
+
+    auto callback = std::move(callback_);
+    auto results = std::move(results_);
+    lock.unlock();
+    callback(std::move(results));
+  }
+
+ private:
+  BatchDataResult results_;
+  std::size_t downloads_count_;
+  BatchDataResponseCallback callback_;
+  std::mutex mutex_;
+};
 }  // namespace
 
 VersionedLayerClientImpl::VersionedLayerClientImpl(
@@ -69,6 +100,8 @@ VersionedLayerClientImpl::VersionedLayerClientImpl(
       catalog_version_(catalog_version ? catalog_version.get()
                                        : kInvalidVersion),
       lookup_client_(catalog_, settings_),
+      decoded_partitions_(std::make_shared<repository::DecodedPartitions>(
+          kMaxDecodedPartitions)),
       task_sink_(settings_.task_scheduler) {
   if (!settings_.cache) {
     settings_.cache = client::OlpClientSettingsFactory::CreateDefaultCache({});
@@ -100,8 +133,9 @@ client::CancellationToken VersionedLayerClientImpl::GetPartitions(
 
     const auto version = version_response.GetResult().GetVersion();
 
-    repository::PartitionsRepository repository(catalog_, layer_id_, settings_,
-                                                lookup_client_, mutex_storage_);
+    repository::PartitionsRepository repository(
+        catalog_, layer_id_, settings_, lookup_client_, mutex_storage_,
+        decoded_partitions_);
     return repository.GetVersionedPartitionsExtendedResponse(
         std::move(partitions_request), version, context);
   };
@@ -128,8 +162,9 @@ client::CancellationToken VersionedLayerClientImpl::StreamLayerPartitions(
 
     const auto version = version_response.GetResult().GetVersion();
 
-    repository::PartitionsRepository repository(catalog_, layer_id_, settings_,
-                                                lookup_client_, mutex_storage_);
+    repository::PartitionsRepository repository(
+        catalog_, layer_id_, settings_, lookup_client_, mutex_storage_,
+        decoded_partitions_);
 
     repository.StreamPartitions(async_stream, version,
                                 request.GetAdditionalFields(),
@@ -142,8 +177,9 @@ client::CancellationToken VersionedLayerClientImpl::StreamLayerPartitions(
       std::bind(request_task, std::placeholders::_1), nullptr, thread::NORMAL);
 
   auto parse_task = [=](client::CancellationContext context) {
-    repository::PartitionsRepository repository(catalog_, layer_id_, settings_,
-                                                lookup_client_, mutex_storage_);
+    repository::PartitionsRepository repository(
+        catalog_, layer_id_, settings_, lookup_client_, mutex_storage_,
+        decoded_partitions_);
 
     return repository.ParsePartitionsStream(
         async_stream, partition_stream_callback, std::move(context));
@@ -189,7 +225,7 @@ client::CancellationToken VersionedLayerClientImpl::GetData(
     }
 
     repository::DataRepository repository(catalog_, settings_, lookup_client_,
-                                          mutex_storage_);
+                                          mutex_storage_, decoded_partitions_);
     return repository.GetVersionedData(layer_id_, request, version, context,
                                        settings_.propagate_all_cache_errors);
   };
@@ -220,8 +256,9 @@ client::CancellationToken VersionedLayerClientImpl::QuadTreeIndex(
 
     const auto version = version_response.GetResult().GetVersion();
 
-    repository::PartitionsRepository repository(catalog_, layer_id_, settings_,
-                                                lookup_client_, mutex_storage_);
+    repository::PartitionsRepository repository(
+        catalog_, layer_id_, settings_, lookup_client_, mutex_storage_,
+        decoded_partitions_);
 
     static const std::vector<std::string> additional_fields = {
         PartitionsRequest::kChecksum, PartitionsRequest::kCrc,
@@ -252,6 +289,284 @@ client::CancellableFuture<DataResponse> VersionedLayerClientImpl::GetData(
   return {cancel_token, std::move(promise)};
 }
 
+client::CancellationToken VersionedLayerClientImpl::GetDataView(
+    DataRequest request, DataViewResponseCallback callback) {
+  auto data_task = [=](const client::CancellationContext& context) mutable
+      -> DataViewResponse {
+    if (request.GetFetchOption() == CacheWithUpdate) {
+      return client::ApiError::InvalidArgument(
+          "CacheWithUpdate option can not be used for versioned layer");
+    }
+
+    int64_t version = -1;
+    if (!request.GetDataHandle()) {
+      auto version_response = GetVersion(request.GetBillingTag(),
+                                         request.GetFetchOption(), context);
+      if (!version_response.IsSuccessful()) {
+        return version_response.GetError();
+      }
+      version = version_response.GetResult().GetVersion();
+    }
+
+    repository::DataRepository repository(catalog_, settings_, lookup_client_,
+                                          mutex_storage_, decoded_partitions_);
+    return repository.GetVersionedDataView(
+        layer_id_, request, version, context,
+        settings_.propagate_all_cache_errors);
+  };
+
+  return task_sink_.AddTask(std::move(data_task), std::move(callback),
+                            request.GetPriority());
+}
+
+client::CancellableFuture<DataViewResponse>
+VersionedLayerClientImpl::GetDataView(DataRequest data_request) {
+  auto promise = std::make_shared<std::promise<DataViewResponse>>();
+  auto cancel_token = GetDataView(std::move(data_request),
+                                  [promise](DataViewResponse response) {
+                                    promise->set_value(std::move(response));
+                                  });
+  return {cancel_token, std::move(promise)};
+}
+
+client::CancellationToken VersionedLayerClientImpl::GetData(
+    std::vector<DataRequest> requests, BatchDataResponseCallback callback) {
+  client::CancellationContext execution_context;
+
+  auto task = [=](client::CancellationContext context,
+                  std::vector<DataRequest>& requests) mutable {
+    if (context.IsCancelled()) {
+      callback(client::ApiError::Cancelled());
+      return;
+    }
+
+    if (requests.empty()) {
+      callback(client::ApiError::InvalidArgument("Empty requests list"));
+      return;
+    }
+
+    const auto is_cache_with_update = [](const DataRequest& request) {
+      return request.GetFetchOption() == CacheWithUpdate;
+    };
+    if (std::any_of(requests.begin(), requests.end(), is_cache_with_update)) {
+      callback(client::ApiError::InvalidArgument(
+          "CacheWithUpdate option can not be used for versioned layer"));
+      return;
+    }
+
+    const auto& billing_tag = requests.front().GetBillingTag();
+    const auto fetch_option = requests.front().GetFetchOption();
+
+    BatchDataResult results(requests.size());
+    std::vector<model::Partition> partitions(requests.size());
+    std::vector<std::size_t> resolved_items;
+    std::vector<std::size_t> partition_id_items;
+
+    for (auto i = 0u; i < requests.size(); ++i) {
+      const auto& request = requests[i];
+      if (request.GetDataHandle() && request.GetPartitionId()) {
+        results[i] = client::ApiError::PreconditionFailed(
+            "Both data handle and partition id specified");
+      } else if (request.GetDataHandle()) {
+        partitions[i].SetDataHandle(*request.GetDataHandle());
+        resolved_items.push_back(i);
+      } else if (request.GetPartitionId()) {
+        partition_id_items.push_back(i);
+      } else {
+        results[i] = client::ApiError::PreconditionFailed(
+            "Partition id or data handle is missing");
+      }
+    }
+
+    // The partitions metadata is resolved for all the requests at once
+    if (!partition_id_items.empty()) {
+      auto version_response = GetVersion(billing_tag, fetch_option, context);
+      if (!version_response.IsSuccessful()) {
+        callback(version_response.GetError());
+        return;
+      }
+
+      std::vector<std::string> partition_ids;
+      partition_ids.reserve(partition_id_items.size());
+      for (const auto i : partition_id_items) {
+        partition_ids.push_back(*requests[i].GetPartitionId());
+      }
+      std::sort(partition_ids.begin(), partition_ids.end());
+      partition_ids.erase(
+          std::unique(partition_ids.begin(), partition_ids.end()),
+          partition_ids.end());
+
+      repository::PartitionsRepository repository(
+          catalog_, layer_id_, settings_, lookup_client_, mutex_storage_,
+          decoded_partitions_);
+      auto partitions_response = repository.GetVersionedPartitionsBatch(
+          partition_ids, version_response.GetResult().GetVersion(),
+          fetch_option, billing_tag, context,
+          settings_.propagate_all_cache_errors);
+
+      std::map<std::string, model::Partition> found_partitions;
+      if (partitions_response.IsSuccessful()) {
+        auto result = partitions_response.MoveResult();
+        for (auto& partition : result.GetMutablePartitions()) {
+          auto partition_id = partition.GetPartition();
+          found_partitions.emplace(std::move(partition_id),
+                                   std::move(partition));
+        }
+      }
+
+      for (const auto i : partition_id_items) {
+        if (!partitions_response.IsSuccessful()) {
+          results[i] = partitions_response.GetError();
+          continue;
+        }
+
+        auto it = found_partitions.find(*requests[i].GetPartitionId());
+        if (it == found_partitions.end()) {
+          results[i] = client::ApiError::NotFound("Partition not found");
+        } else {
+          partitions[i] = it->second;
+          resolved_items.push_back(i);
+        }
+      }
+    }
+
+    // The cache is looked up for all the data at once
+    std::vector<std::size_t> cache_items;
+    std::vector<std::string> data_handles;
+    std::vector<std::size_t> download_items;
+    for (const auto i : resolved_items) {
+      if (requests[i].GetFetchOption() == OnlineOnly) {
+        download_items.push_back(i);
+      } else {
+        cache_items.push_back(i);
+        data_handles.push_back(partitions[i].GetDataHandle());
+      }
+    }
+
+    repository::DataCacheRepository data_cache_repository(
+        catalog_, settings_.cache, settings_.default_cache_expiration);
+    auto cached_data = data_cache_repository.Get(layer_id_, data_handles);
+
+    for (auto k = 0u; k < cache_items.size(); ++k) {
+      const auto i = cache_items[k];
+      if (cached_data[k]) {
+        results[i] = std::move(cached_data[k]);
+      } else if (requests[i].GetFetchOption() == CacheOnly) {
+        results[i] = client::ApiError::NotFound(
+            "CacheOnly: resource not found in cache");
+      } else {
+        download_items.push_back(i);
+      }
+    }
+
+    OLP_SDK_LOG_DEBUG_F(kLogTag,
+                        "GetData: batch, hrn=%s, layer=%s, requests=%zu, "
+                        "downloads=%zu",
+                        catalog_.ToCatalogHRNString().c_str(),
+                        layer_id_.c_str(), requests.size(),
+                        download_items.size());
+
+    if (download_items.empty()) {
+      callback(std::move(results));
+      return;
+    }
+
+    // Only the data missing in the cache is downloaded, concurrently
+    auto job = std::make_shared<BatchDataJob>(
+        std::move(results), download_items.size(), callback);
+    const auto priority = requests.front().GetPriority();
+
+    context.ExecuteOrCancelled(
+        [&]() {
+          VectorOfTokens tokens;
+          tokens.reserve(download_items.size());
+
+          for (const auto i : download_items) {
+            const auto& partition = partitions[i];
+            const auto item_fetch_option = requests[i].GetFetchOption();
+            const auto& item_billing_tag = requests[i].GetBillingTag();
+
+            auto download = [=](client::CancellationContext inner_context) {
+              repository::DataRepository repository(
+                  catalog_, settings_, lookup_client_, mutex_storage_,
+                  decoded_partitions_);
+              return repository.GetBlobData(
+                  layer_id_, "blob", partition, item_fetch_option,
+                  item_billing_tag, inner_context,
+                  settings_.propagate_all_cache_errors);
+            };
+
+            auto token = task_sink_.AddTaskChecked(
+                std::move(download),
+                [job, i](DataResponse response) {
+                  job->CompleteDownload(i, std::move(response));
+                },
+                priority);
+
+            if (!token) {
+              job->CompleteDownload(i, client::ApiError::Cancelled());
+            } else {
+              tokens.emplace_back(*token);
+            }
+          }
+
+          return CreateToken(std::move(tokens));
+        },
+        [&]() { callback(client::ApiError::Cancelled()); });
+  };
+
+  const auto priority =
+      requests.empty() ? thread::NORMAL : requests.front().GetPriority();
+  return task_sink_.AddTask(
+      std::bind(task, std::placeholders::_1, std::move(requests)), priority,
+      execution_context);
+}
+
+client::CancellableFuture<BatchDataResponse> VersionedLayerClientImpl::GetData(
+    std::vector<DataRequest> requests) {
+  auto promise = std::make_shared<std::promise<BatchDataResponse>>();
+  auto cancel_token =
+      GetData(std::move(requests), [promise](BatchDataResponse response) {
+        promise->set_value(std::move(response));
+      });
+  return {cancel_token, std::move(promise)};
+}
+
+client::CancellationToken VersionedLayerClientImpl::GetDataStream(
+    DataRequest request, DataChunkCallback chunk_callback,
+    DataStreamResponseCallback callback) {
+  auto data_task = [=](const client::CancellationContext& context) mutable
+      -> DataStreamResponse {
+    if (request.GetFetchOption() == CacheWithUpdate) {
+      return client::ApiError::InvalidArgument(
+          "CacheWithUpdate option can not be used for versioned layer");
+    }
+
+    if (!chunk_callback) {
+      return client::ApiError::InvalidArgument("Chunk callback is missing");
+    }
+
+    int64_t version = -1;
+    if (!request.GetDataHandle()) {
+      auto version_response = GetVersion(request.GetBillingTag(),
+                                         request.GetFetchOption(), context);
+      if (!version_response.IsSuccessful()) {
+        return version_response.GetError();
+      }
+      version = version_response.GetResult().GetVersion();
+    }
+
+    repository::DataRepository repository(catalog_, settings_, lookup_client_,
+                                          mutex_storage_, decoded_partitions_);
+    return repository.GetVersionedDataStream(
+        layer_id_, request, version, chunk_callback, context,
+        settings_.propagate_all_cache_errors);
+  };
+
+  return task_sink_.AddTask(std::move(data_task), std::move(callback),
+                            request.GetPriority());
+}
+
 client::CancellationToken VersionedLayerClientImpl::PrefetchPartitions(
     PrefetchPartitionsRequest request,
     PrefetchPartitionsResponseCallback callback,
@@ -306,8 +621,9 @@ client::CancellationToken VersionedLayerClientImpl::PrefetchPartitions(
     OLP_SDK_LOG_INFO_F(kLogTag, "PrefetchPartitions: catalog=%s, using key=%s",
                        catalog_.ToCatalogHRNString().c_str(), key.c_str());
 
-    repository::PartitionsRepository repository(catalog_, layer_id_, settings_,
-                                                lookup_client_, mutex_storage_);
+    repository::PartitionsRepository repository(
+        catalog_, layer_id_, settings_, lookup_client_, mutex_storage_,
+        decoded_partitions_);
 
     auto query = [=](std::vector<std::string> partitions,
                      client::CancellationContext inner_context) mutable
@@ -352,8 +668,9 @@ client::CancellationToken VersionedLayerClientImpl::PrefetchPartitions(
         return BlobApi::DataResponse(nullptr);
       }
 
-      repository::DataRepository repository(catalog_, settings_, lookup_client_,
-                                            mutex_storage_);
+      repository::DataRepository repository(
+          catalog_, settings_, lookup_client_, mutex_storage_,
+          decoded_partitions_);
       // Fetch from online
       return repository.GetVersionedData(
           layer_id_,
@@ -546,7 +863,8 @@ client::CancellationToken VersionedLayerClientImpl::PrefetchTiles(
                 }
 
                 repository::DataRepository repository(
-                    catalog_, settings_, lookup_client_, mutex_storage_);
+                    catalog_, settings_, lookup_client_, mutex_storage_,
+                    decoded_partitions_);
 
                 // Fetch from online
                 return repository.GetVersionedData(
@@ -658,7 +976,7 @@ client::CancellationToken VersionedLayerClientImpl::GetData(
     }
 
     repository::DataRepository repository(catalog_, settings_, lookup_client_,
-                                          mutex_storage_);
+                                          mutex_storage_, decoded_partitions_);
     return repository.GetVersionedTile(
         layer_id_, request, version_response.GetResult().GetVersion(),
         std::move(context));
@@ -829,7 +1147,8 @@ client::CancellationToken VersionedLayerClientImpl::GetAggregatedData(
 
     auto version = version_response.GetResult().GetVersion();
     repository::PartitionsRepository partition_repository(
-        catalog_, layer_id_, settings_, lookup_client_, mutex_storage_);
+        catalog_, layer_id_, settings_, lookup_client_, mutex_storage_,
+        decoded_partitions_);
     const auto& partition_response =
         partition_repository.GetAggregatedTile(request, version, context);
     if (!partition_response.IsSuccessful()) {
@@ -838,8 +1157,9 @@ client::CancellationToken VersionedLayerClientImpl::GetAggregatedData(
 
     const auto& partition = partition_response.GetResult();
 
-    repository::DataRepository data_repository(catalog_, settings_,
-                                               lookup_client_, mutex_storage_);
+    repository::DataRepository data_repository(
+        catalog_, settings_, lookup_client_, mutex_storage_,
+        decoded_partitions_);
     auto data_response = data_repository.GetBlobData(
         layer_id_, "blob", partition, fetch_option, billing_tag, context,
         settings_.propagate_all_cache_errors);
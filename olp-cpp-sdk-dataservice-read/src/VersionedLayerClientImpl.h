@@ -38,6 +38,7 @@
 #include <boost/optional.hpp>
 #include "TaskSink.h"
 #include "repositories/NamedMutex.h"
+#include "repositories/PartitionsCacheRepository.h"
 
 namespace olp {
 namespace thread {
@@ -66,6 +67,22 @@ class VersionedLayerClientImpl {
   virtual client::CancellableFuture<DataResponse> GetData(
       DataRequest data_request);
 
+  virtual client::CancellationToken GetDataView(
+      DataRequest request, DataViewResponseCallback callback);
+
+  virtual client::CancellableFuture<DataViewResponse> GetDataView(
+      DataRequest data_request);
+
+  virtual client::CancellationToken GetData(
+      std::vector<DataRequest> requests, BatchDataResponseCallback callback);
+
+  virtual client::CancellableFuture<BatchDataResponse> GetData(
+      std::vector<DataRequest> requests);
+
+  virtual client::CancellationToken GetDataStream(
+      DataRequest request, DataChunkCallback chunk_callback,
+      DataStreamResponseCallback callback);
+
   virtual client::CancellationToken GetData(TileRequest request,
                                             DataResponseCallback callback);
 
@@ -139,6 +156,7 @@ class VersionedLayerClientImpl {
   std::atomic<int64_t> catalog_version_;
   client::ApiLookupClient lookup_client_;
   repository::NamedMutexStorage mutex_storage_;
+  std::shared_ptr<repository::DecodedPartitions> decoded_partitions_;
   TaskSink task_sink_;
 };
 
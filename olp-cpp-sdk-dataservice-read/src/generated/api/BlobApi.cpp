@@ -19,13 +19,16 @@
 
 #include "BlobApi.h"
 
+#include <algorithm>
 #include <cstring>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <unordered_map>
 
 #include <olp/core/client/OlpClient.h>
+#include "Crc32c.h"
 
 namespace olp {
 namespace dataservice {
@@ -35,12 +38,14 @@ BlobApi::DataResponse BlobApi::GetBlob(
     const client::OlpClient& client, const std::string& layer_id,
     const model::Partition& partition, boost::optional<std::string> billing_tag,
     boost::optional<std::string> range,
-    const client::CancellationContext& context) {
+    const client::CancellationContext& context,
+    ConditionalRequest* conditional, Crc32c* crc) {
   std::multimap<std::string, std::string> header_params;
   header_params.emplace("Accept", "application/json");
   if (range) {
     header_params.emplace("Range", *range);
   }
+  AddConditionalHeaders(conditional, header_params);
 
   std::multimap<std::string, std::string> query_params;
   if (billing_tag) {
@@ -55,7 +60,7 @@ BlobApi::DataResponse BlobApi::GetBlob(
   // In case we know the size in advance, we should pre-allocated a buffer.
   const auto expected_size = partition.GetDataSize();
   const auto kPartitionPreallocateLimit = 10 * 1024 * 1024;
-  if (expected_size && *expected_size > 0 &&
+  if (!range && expected_size && *expected_size > 0 &&
       *expected_size < kPartitionPreallocateLimit) {
     buffer.reserve(*expected_size);
   }
@@ -64,18 +69,27 @@ BlobApi::DataResponse BlobApi::GetBlob(
                            std::size_t length) {
     if (!offset) {
       buffer.clear();
+      if (crc) {
+        *crc = Crc32c();
+      }
     }
 
     const auto buffer_size = buffer.size();
     buffer.resize(buffer_size + length);
     std::memcpy(buffer.data() + buffer_size, data, length);
+    if (crc) {
+      crc->Update(data, length);
+    }
   };
 
   auto api_response =
       client.CallApiStream(metadata_uri, "GET", query_params, header_params,
                            data_callback, nullptr, "", context);
+  ReadValidators(api_response.GetHeaders(), conditional);
 
-  if (api_response.GetStatus() != http::HttpStatusCode::OK) {
+  // The range is received with the partial content status
+  if (api_response.GetStatus() != http::HttpStatusCode::OK &&
+      api_response.GetStatus() != http::HttpStatusCode::PARTIAL_CONTENT) {
     return {client::ApiError(api_response.GetStatus()),
             api_response.GetNetworkStatistics()};
   }
@@ -83,6 +97,97 @@ BlobApi::DataResponse BlobApi::GetBlob(
   return {std::make_shared<std::vector<unsigned char>>(std::move(buffer)),
           api_response.GetNetworkStatistics()};
 }
+
+BlobApi::StreamResponse BlobApi::GetBlobStream(
+    const client::OlpClient& client, const std::string& layer_id,
+    const model::Partition& partition, boost::optional<std::string> billing_tag,
+    const ChunkCallback& chunk_callback,
+    const client::CancellationContext& context) {
+  std::multimap<std::string, std::string> header_params;
+  header_params.emplace("Accept", "application/json");
+
+  std::multimap<std::string, std::string> query_params;
+  if (billing_tag) {
+    query_params.emplace("billingTag", *billing_tag);
+  }
+
+  std::string metadata_uri =
+      "/layers/" + layer_id + "/data/" + partition.GetDataHandle();
+
+  // The data is received again from the beginning when the server ignores
+  // the range of the resumed request, the passed bytes are skipped.
+  std::uint64_t streamed = 0u;
+  auto data_callback = [&](const std::uint8_t* data, std::uint64_t offset,
+                           std::size_t length) {
+    const auto end = offset + length;
+    if (end <= streamed || offset > streamed) {
+      return;
+    }
+
+    const auto skip = static_cast<std::size_t>(streamed - offset);
+    chunk_callback(data + skip, length - skip);
+    streamed = end;
+  };
+
+  auto api_response =
+      client.CallApiStream(metadata_uri, "GET", query_params, header_params,
+                           data_callback, nullptr, "", context);
+
+  if (api_response.GetStatus() != http::HttpStatusCode::OK) {
+    return {client::ApiError(api_response.GetStatus()),
+            api_response.GetNetworkStatistics()};
+  }
+
+  return {streamed, api_response.GetNetworkStatistics()};
+}
+
+BlobApi::RangeResponse BlobApi::GetBlobRange(
+    const client::OlpClient& client, const std::string& layer_id,
+    const model::Partition& partition, boost::optional<std::string> billing_tag,
+    std::uint64_t offset, std::uint64_t size, unsigned char* output,
+    const client::CancellationContext& context,
+    ConditionalRequest* conditional) {
+  std::multimap<std::string, std::string> header_params;
+  header_params.emplace("Accept", "application/json");
+  header_params.emplace("Range", "bytes=" + std::to_string(offset) + "-" +
+                                     std::to_string(offset + size - 1u));
+  AddConditionalHeaders(conditional, header_params);
+
+  std::multimap<std::string, std::string> query_params;
+  if (billing_tag) {
+    query_params.emplace("billingTag", *billing_tag);
+  }
+
+  std::string metadata_uri =
+      "/layers/" + layer_id + "/data/" + partition.GetDataHandle();
+
+  std::uint64_t received = 0u;
+  auto data_callback = [&](const std::uint8_t* data, std::uint64_t data_offset,
+                           std::size_t length) {
+    // The bytes out of the range are dropped, e.g. when the range is ignored
+    if (data_offset >= size) {
+      return;
+    }
+
+    const auto copy_length =
+        std::min<std::uint64_t>(length, size - data_offset);
+    std::memcpy(output + data_offset, data, copy_length);
+    received = std::max(received, data_offset + copy_length);
+  };
+
+  auto api_response =
+      client.CallApiStream(metadata_uri, "GET", query_params, header_params,
+                           data_callback, nullptr, "", context);
+  ReadValidators(api_response.GetHeaders(), conditional);
+
+  if (api_response.GetStatus() != http::HttpStatusCode::PARTIAL_CONTENT) {
+    return {client::ApiError(api_response.GetStatus()),
+            api_response.GetNetworkStatistics()};
+  }
+
+  return {received, api_response.GetNetworkStatistics()};
+}
+
 }  // namespace read
 }  // namespace dataservice
 }  // namespace olp
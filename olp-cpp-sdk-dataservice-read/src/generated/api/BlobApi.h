@@ -19,12 +19,16 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
 
 #include <olp/core/client/ApiError.h>
 #include <olp/core/client/ApiResponse.h>
 #include <olp/core/client/HttpResponse.h>
 #include <boost/optional.hpp>
+#include "ConditionalRequest.h"
 #include "ExtendedApiResponse.h"
 #include "olp/dataservice/read/model/Data.h"
 #include "olp/dataservice/read/model/Partitions.h"
@@ -37,6 +41,8 @@ class CancellationContext;
 
 namespace dataservice {
 namespace read {
+class Crc32c;
+
 /**
  * @brief Api to upload and retrieve large volumes of data.
  */
@@ -44,6 +50,12 @@ class BlobApi {
  public:
   using DataResponse = ExtendedApiResponse<model::Data, client::ApiError,
                                            client::NetworkStatistics>;
+  using RangeResponse = ExtendedApiResponse<std::uint64_t, client::ApiError,
+                                            client::NetworkStatistics>;
+  using StreamResponse = ExtendedApiResponse<std::uint64_t, client::ApiError,
+                                             client::NetworkStatistics>;
+  using ChunkCallback =
+      std::function<void(const unsigned char* data, std::size_t size)>;
 
   /**
    * @brief Retrieves a data blob for specified handle.
@@ -62,6 +74,9 @@ class BlobApi {
    * use the pagination links returned in the response body.
    * @param context A CancellationContext, which can be used to cancel the
    * pending request.
+   * @param conditional The optional validators of the cached data.
+   * @param crc The optional checksum that is updated with the received data
+   * while it arrives.
    *
    * @return Data response.
    */
@@ -70,7 +85,63 @@ class BlobApi {
                               const model::Partition& partition,
                               boost::optional<std::string> billing_tag,
                               boost::optional<std::string> range,
-                              const client::CancellationContext& context);
+                              const client::CancellationContext& context,
+                              ConditionalRequest* conditional = nullptr,
+                              Crc32c* crc = nullptr);
+
+  /**
+   * @brief Retrieves a data blob and passes it to the chunk callback while
+   * it arrives.
+   *
+   * When the download is resumed, the chunks are passed from the last
+   * received byte, so every byte is passed once.
+   *
+   * @param client Instance of OlpClient used to make REST request.
+   * @param layer_id Layer id.
+   * @param partition The blob metadata.
+   * @param billing_tag An optional free-form tag which is used for grouping
+   * billing records together.
+   * @param chunk_callback The callback that receives the data chunks in order.
+   * @param context A CancellationContext, which can be used to cancel the
+   * pending request.
+   *
+   * @return The number of the streamed bytes.
+   */
+  static StreamResponse GetBlobStream(
+      const client::OlpClient& client, const std::string& layer_id,
+      const model::Partition& partition,
+      boost::optional<std::string> billing_tag,
+      const ChunkCallback& chunk_callback,
+      const client::CancellationContext& context);
+
+  /**
+   * @brief Retrieves a byte range of a data blob into the provided buffer.
+   *
+   * The range is written directly into the buffer without intermediate
+   * copies, so several ranges of one blob can be retrieved concurrently.
+   *
+   * @param client Instance of OlpClient used to make REST request.
+   * @param layer_id Layer id.
+   * @param partition The blob metadata.
+   * @param billing_tag An optional free-form tag which is used for grouping
+   * billing records together.
+   * @param offset The offset of the first byte of the range.
+   * @param size The number of bytes in the range.
+   * @param output The buffer of at least `size` bytes to write the range to.
+   * @param context A CancellationContext, which can be used to cancel the
+   * pending request.
+   *
+   * @return The number of received bytes. If the server does not support
+   * ranges, the error has the `OK` HTTP status code.
+   */
+  static RangeResponse GetBlobRange(const client::OlpClient& client,
+                                    const std::string& layer_id,
+                                    const model::Partition& partition,
+                                    boost::optional<std::string> billing_tag,
+                                    std::uint64_t offset, std::uint64_t size,
+                                    unsigned char* output,
+                                    const client::CancellationContext& context,
+                                    ConditionalRequest* conditional = nullptr);
 };
 
 }  // namespace read
@@ -36,9 +36,10 @@ namespace read {
 ConfigApi::CatalogResponse ConfigApi::GetCatalog(
     const client::OlpClient& client, const std::string& catalog_hrn,
     boost::optional<std::string> billing_tag,
-    client::CancellationContext context) {
+    client::CancellationContext context, ConditionalRequest* conditional) {
   std::multimap<std::string, std::string> header_params;
   header_params.insert(std::make_pair("Accept", "application/json"));
+  AddConditionalHeaders(conditional, header_params);
   std::multimap<std::string, std::string> query_params;
   if (billing_tag) {
     query_params.insert(std::make_pair("billingTag", *billing_tag));
@@ -49,6 +50,7 @@ ConfigApi::CatalogResponse ConfigApi::GetCatalog(
   client::HttpResponse response = client.CallApi(
       std::move(catalog_uri), "GET", std::move(query_params),
       std::move(header_params), {}, nullptr, std::string{}, std::move(context));
+  ReadValidators(response.GetHeaders(), conditional);
   if (response.GetStatus() != olp::http::HttpStatusCode::OK) {
     return client::ApiError(response.GetStatus(), response.GetResponseAsString());
   }
@@ -26,6 +26,7 @@
 #include <olp/core/client/ApiError.h>
 #include <olp/core/client/ApiResponse.h>
 #include <olp/core/client/CancellationContext.h>
+#include "ConditionalRequest.h"
 #include "olp/dataservice/read/model/Catalog.h"
 
 namespace olp {
@@ -52,12 +53,16 @@ class ConfigApi {
    * contain only alpha/numeric ASCII characters  [A-Za-z0-9].
    * @param context A CancellationContext instance which can be used to cancel
    * this method.
+   * @param conditional The optional validators of the conditional request. The
+   * `If-None-Match` header is sent when set, and the ETag of the response is
+   * stored back; the `304 Not Modified` response is returned as an error.
    * @return The result of operation as a client::ApiResponse object.
    */
   static CatalogResponse GetCatalog(const client::OlpClient& client,
                                     const std::string& catalog_hrn,
                                     boost::optional<std::string> billing_tag,
-                                    client::CancellationContext context);
+                                    client::CancellationContext context,
+                                    ConditionalRequest* conditional = nullptr);
 };
 
 }  // namespace read
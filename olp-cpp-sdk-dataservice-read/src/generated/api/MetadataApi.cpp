@@ -169,6 +169,35 @@ client::HttpResponse MetadataApi::GetPartitionsStream(
                               "", context);
 }
 
+client::CancellationToken MetadataApi::GetPartitionsStream(
+    const client::OlpClient& client, const std::string& layer_id,
+    boost::optional<int64_t> version,
+    const std::vector<std::string>& additional_fields,
+    boost::optional<std::string> billing_tag,
+    http::Network::DataCallback data_callback,
+    const client::NetworkAsyncCallback& callback) {
+  std::multimap<std::string, std::string> header_params;
+  header_params.emplace("Accept", "application/json");
+
+  std::multimap<std::string, std::string> query_params;
+  if (!additional_fields.empty()) {
+    query_params.emplace("additionalFields",
+                         concatStringArray(additional_fields, ","));
+  }
+  if (billing_tag) {
+    query_params.emplace("billingTag", *billing_tag);
+  }
+  if (version) {
+    query_params.emplace("version", std::to_string(*version));
+  }
+
+  std::string metadataUri = "/layers/" + layer_id + "/partitions";
+
+  return client.CallApiStreamAsync(metadataUri, "GET", query_params,
+                                   header_params, std::move(data_callback),
+                                   nullptr, "", callback);
+}
+
 MetadataApi::CatalogVersionResponse MetadataApi::GetLatestCatalogVersion(
     const client::OlpClient& client, std::int64_t startVersion,
     boost::optional<std::string> billing_tag,
@@ -145,6 +145,31 @@ class MetadataApi {
       http::Network::DataCallback data_callback,
       const client::CancellationContext& context);
 
+  /**
+   * @brief Stream metadata for all partitions in a specified layer without
+   * blocking the calling thread.
+   * @param client Instance of OlpClient used to make REST request.
+   * @param layer_id Layer id.
+   * @param version Specify the version for a versioned layer. Doesn't apply for
+   * other layer types.
+   * @param additional_fields Additional fields - dataSize, checksum,
+   * compressedDataSize.
+   * @param billing_tag An optional free-form tag which is used for grouping
+   * billing records together. If supplied, it must be between 4 - 16
+   * characters, contain only alpha/numeric ASCII characters  [A-Za-z0-9].
+   * @param data_callback A data callback that is passed to the network.
+   * @param callback A callback that receives the response without the content.
+   *
+   * @return A CancellationToken, which can be used to cancel request.
+   */
+  static client::CancellationToken GetPartitionsStream(
+      const client::OlpClient& client, const std::string& layer_id,
+      boost::optional<int64_t> version,
+      const std::vector<std::string>& additional_fields,
+      boost::optional<std::string> billing_tag,
+      http::Network::DataCallback data_callback,
+      const client::NetworkAsyncCallback& callback);
+
   /**
    * @brief Retrieves the latest metadata version for the catalog.
    * @param client Instance of OlpClient used to make REST request.
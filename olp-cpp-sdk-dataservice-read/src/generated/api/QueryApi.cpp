@@ -65,9 +65,10 @@ QueryApi::PartitionsExtendedResponse QueryApi::GetPartitionsbyId(
     boost::optional<int64_t> version,
     const std::vector<std::string>& additional_fields,
     boost::optional<std::string> billing_tag,
-    client::CancellationContext context) {
+    client::CancellationContext context, ConditionalRequest* conditional) {
   std::multimap<std::string, std::string> header_params;
   header_params.insert(std::make_pair("Accept", "application/json"));
+  AddConditionalHeaders(conditional, header_params);
 
   std::multimap<std::string, std::string> query_params;
   for (const auto& partition : partitions) {
@@ -89,6 +90,7 @@ QueryApi::PartitionsExtendedResponse QueryApi::GetPartitionsbyId(
   client::HttpResponse http_response = client.CallApi(
       metadata_uri, "GET", std::move(query_params), std::move(header_params),
       {}, nullptr, std::string{}, std::move(context));
+  ReadValidators(http_response.GetHeaders(), conditional);
 
   OLP_SDK_LOG_TRACE_F(kLogTag, "GetPartitionsbyId, layer_id=%s, status=%d",
                       layer_id.c_str(), http_response.GetStatus());
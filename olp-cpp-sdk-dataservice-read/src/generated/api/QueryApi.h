@@ -27,6 +27,7 @@
 #include <olp/core/client/CancellationContext.h>
 #include <olp/core/client/HttpResponse.h>
 #include <boost/optional.hpp>
+#include "ConditionalRequest.h"
 #include "ExtendedApiResponse.h"
 #include "generated/model/Index.h"
 #include "olp/dataservice/read/model/Partitions.h"
@@ -69,6 +70,9 @@ class QueryApi {
    * response.
    * @param context A CancellationContext instance which can be used to cancel
    * call of this method.
+   * @param conditional The optional validators of the conditional request. The
+   * `If-None-Match` header is sent when set, and the ETag of the response is
+   * stored back; the `304 Not Modified` response is returned as an error.
    * @return  The result of this operation as an extended client::ApiResponse
    * object with \c model::Partitions as a result.
    */
@@ -78,7 +82,8 @@ class QueryApi {
       boost::optional<int64_t> version,
       const std::vector<std::string>& additional_fields,
       boost::optional<std::string> billing_tag,
-      client::CancellationContext context);
+      client::CancellationContext context,
+      ConditionalRequest* conditional = nullptr);
 
   /**
    * @brief Gets index metadata
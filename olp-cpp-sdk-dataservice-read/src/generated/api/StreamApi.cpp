@@ -27,6 +27,7 @@
 #include <olp/core/client/CancellationContext.h>
 #include <olp/core/client/HttpResponse.h>
 #include <olp/core/client/OlpClient.h>
+#include <olp/core/http/NetworkUtils.h>
 #include <olp/core/logging/Log.h>
 #include <olp/dataservice/read/model/Data.h>
 // clang-format off
@@ -44,11 +45,13 @@ constexpr auto kLogTag = "read::StreamApi";
 
 void HandleCorrelationId(const olp::http::Headers& headers,
                          std::string& x_correlation_id) {
-  auto it =
-      std::find_if(std::begin(headers), std::end(headers),
-                   [&](const olp::http::Header& header) {
-                     return (header.first.compare("X-Correlation-Id") == 0);
-                   });
+  // The header names are lowercase with HTTP/2
+  auto it = std::find_if(
+      std::begin(headers), std::end(headers),
+      [&](const olp::http::Header& header) {
+        return olp::http::NetworkUtils::CaseInsensitiveCompare(
+            header.first, "X-Correlation-Id");
+      });
   if (it != headers.end()) {
     x_correlation_id = it->second;
   }
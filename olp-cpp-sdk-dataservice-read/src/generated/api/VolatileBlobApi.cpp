@@ -33,19 +33,21 @@ namespace read {
 VolatileBlobApi::DataResponse VolatileBlobApi::GetVolatileBlob(
     const client::OlpClient& client, const std::string& layer_id,
     const std::string& data_handle, boost::optional<std::string> billing_tag,
-    const client::CancellationContext& context) {
+    const client::CancellationContext& context,
+    ConditionalRequest* conditional) {
   std::multimap<std::string, std::string> header_params;
   header_params.insert(std::make_pair("Accept", "application/json"));
+  AddConditionalHeaders(conditional, header_params);
   std::multimap<std::string, std::string> query_params;
   if (billing_tag) {
     query_params.insert(std::make_pair("billingTag", *billing_tag));
   }
 
-  std::multimap<std::string, std::string> form_params;
   std::string metadata_uri = "/layers/" + layer_id + "/data/" + data_handle;
   auto api_response =
-      client.CallApi(metadata_uri, "GET", query_params, header_params,
-                     form_params, nullptr, "", context);
+      client.CallApiBytes(metadata_uri, "GET", query_params, header_params,
+                          nullptr, "", context);
+  ReadValidators(api_response.GetHeaders(), conditional);
 
   if (api_response.GetStatus() != http::HttpStatusCode::OK) {
     return DataResponse(
@@ -53,8 +55,8 @@ VolatileBlobApi::DataResponse VolatileBlobApi::GetVolatileBlob(
         api_response.GetNetworkStatistics());
   }
 
-  auto result = std::make_shared<std::vector<unsigned char>>();
-  api_response.GetResponse(*result);
+  auto result = std::make_shared<std::vector<unsigned char>>(
+      api_response.MoveResponseAsBytes());
   return DataResponse(result, api_response.GetNetworkStatistics());
 }
 }  // namespace read
@@ -26,6 +26,7 @@
 #include <boost/optional.hpp>
 #include "olp/dataservice/read/model/Data.h"
 
+#include "ConditionalRequest.h"
 #include "ExtendedApiResponse.h"
 
 namespace olp {
@@ -53,13 +54,17 @@ class VolatileBlobApi {
    * billing records together. If supplied, it must be between 4 - 16
    * characters, contain only alpha/numeric ASCII characters  [A-Za-z0-9].
    * @param context A CancellationContext, which can be used to cancel request.
+   * @param conditional The optional validators of the conditional request. The
+   * `If-None-Match` header is sent when set, and the ETag of the response is
+   * stored back; the `304 Not Modified` response is returned as an error.
    *
    * @return Data response.
    */
   static DataResponse GetVolatileBlob(
       const client::OlpClient& client, const std::string& layer_id,
       const std::string& data_handle, boost::optional<std::string> billing_tag,
-      const client::CancellationContext& context);
+      const client::CancellationContext& context,
+      ConditionalRequest* conditional = nullptr);
 };
 
 }  // namespace read
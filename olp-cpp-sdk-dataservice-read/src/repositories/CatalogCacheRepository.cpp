@@ -52,16 +52,23 @@ namespace repository {
 CatalogCacheRepository::CatalogCacheRepository(
     const client::HRN& hrn, std::shared_ptr<cache::KeyValueCache> cache,
     std::chrono::seconds default_expiry)
-    : hrn_(hrn), cache_(cache), default_expiry_(ConvertTime(default_expiry)) {}
+    : hrn_(hrn),
+      cache_(cache),
+      default_expiry_(ConvertTime(default_expiry)),
+      validators_(cache, default_expiry_) {}
 
-bool CatalogCacheRepository::Put(const model::Catalog& catalog) {
+bool CatalogCacheRepository::Put(const model::Catalog& catalog,
+                                 const std::string& etag) {
   const std::string hrn(hrn_.ToCatalogHRNString());
   const auto key = cache::KeyGenerator::CreateCatalogKey(hrn);
   OLP_SDK_LOG_TRACE_F(kLogTag, "Put -> '%s'", key.c_str());
 
+  // The validator is written first, so the catalog cached without
+  // expiration always has one
+  const auto expiry = validators_.Put(key, etag);
   return cache_->Put(key, catalog,
                      [&]() { return olp::serializer::serialize(catalog); },
-                     default_expiry_);
+                     expiry);
 }
 
 boost::optional<model::Catalog> CatalogCacheRepository::Get() {
@@ -69,6 +76,10 @@ boost::optional<model::Catalog> CatalogCacheRepository::Get() {
   const auto key = cache::KeyGenerator::CreateCatalogKey(hrn);
   OLP_SDK_LOG_TRACE_F(kLogTag, "Get -> '%s'", key.c_str());
 
+  if (validators_.IsStale(key)) {
+    return boost::none;
+  }
+
   auto cached_catalog = cache_->Get(key, [](const std::string& value) {
     return parser::parse<model::Catalog>(value);
   });
@@ -80,6 +91,18 @@ boost::optional<model::Catalog> CatalogCacheRepository::Get() {
   return boost::any_cast<model::Catalog>(cached_catalog);
 }
 
+boost::optional<CacheValidator> CatalogCacheRepository::GetValidator() {
+  const std::string hrn(hrn_.ToCatalogHRNString());
+  return validators_.Get(cache::KeyGenerator::CreateCatalogKey(hrn));
+}
+
+bool CatalogCacheRepository::RefreshValidator(
+    const CacheValidator& validator) {
+  const std::string hrn(hrn_.ToCatalogHRNString());
+  return validators_.Refresh(cache::KeyGenerator::CreateCatalogKey(hrn),
+                             validator);
+}
+
 bool CatalogCacheRepository::PutVersion(const model::VersionResponse& version) {
   const std::string hrn(hrn_.ToCatalogHRNString());
   const auto key = cache::KeyGenerator::CreateLatestVersionKey(hrn);
@@ -21,11 +21,13 @@
 
 #include <chrono>
 #include <memory>
+#include <string>
 
 #include <olp/core/client/HRN.h>
 #include <olp/dataservice/read/model/Catalog.h>
 #include <olp/dataservice/read/model/VersionResponse.h>
 #include <boost/optional.hpp>
+#include "ValidatorCacheRepository.h"
 
 namespace olp {
 namespace cache {
@@ -43,10 +45,18 @@ class CatalogCacheRepository final {
 
   ~CatalogCacheRepository() = default;
 
-  bool Put(const model::Catalog& catalog);
+  /// Writes the catalog, the catalog with an ETag is revalidated when
+  /// expired instead of being downloaded again.
+  bool Put(const model::Catalog& catalog,
+           const std::string& etag = std::string());
 
+  /// Returns the cached catalog, unless it needs to be revalidated.
   boost::optional<model::Catalog> Get();
 
+  boost::optional<CacheValidator> GetValidator();
+
+  bool RefreshValidator(const CacheValidator& validator);
+
   bool PutVersion(const model::VersionResponse& version);
 
   boost::optional<model::VersionResponse> GetVersion();
@@ -57,6 +67,7 @@ class CatalogCacheRepository final {
   client::HRN hrn_;
   std::shared_ptr<cache::KeyValueCache> cache_;
   time_t default_expiry_;
+  ValidatorCacheRepository validators_;
 };
 }  // namespace repository
 }  // namespace read
@@ -88,11 +88,43 @@ CatalogResponse CatalogRepository::GetCatalog(
   }
 
   const client::OlpClient& config_client = config_api.GetResult();
-  auto catalog_response = ConfigApi::GetCatalog(
-      config_client, catalog_str, request.GetBillingTag(), context);
+
+  // The expired catalog is revalidated, so it is not downloaded again when
+  // not modified.
+  ConditionalRequest conditional;
+  boost::optional<CacheValidator> validator;
+  if (fetch_options != OnlineOnly) {
+    validator = repository.GetValidator();
+  }
+  if (validator) {
+    conditional.if_none_match = validator->etag;
+  }
+
+  auto catalog_response =
+      ConfigApi::GetCatalog(config_client, catalog_str,
+                            request.GetBillingTag(), context, &conditional);
+
+  if (validator && !catalog_response.IsSuccessful() &&
+      catalog_response.GetError().GetHttpStatusCode() ==
+          http::HttpStatusCode::NOT_MODIFIED) {
+    repository.RefreshValidator(*validator);
+    auto cached = repository.Get();
+    if (cached) {
+      OLP_SDK_LOG_TRACE_F(kLogTag,
+                          "GetCatalog not modified, hrn='%s', key='%s'",
+                          catalog_str.c_str(), request_key.c_str());
+      return *cached;
+    }
+
+    // The catalog is evicted meanwhile, download it again
+    conditional.if_none_match.clear();
+    catalog_response =
+        ConfigApi::GetCatalog(config_client, catalog_str,
+                              request.GetBillingTag(), context, &conditional);
+  }
 
   if (catalog_response.IsSuccessful() && fetch_options != OnlineOnly) {
-    if (!repository.Put(catalog_response.GetResult())) {
+    if (!repository.Put(catalog_response.GetResult(), conditional.etag)) {
       OLP_SDK_LOG_WARNING_F(
           kLogTag,
           "GetCatalog failed to cache received results, hrn='%s',key='%s'",
@@ -45,16 +45,24 @@ DataCacheRepository::DataCacheRepository(
     std::chrono::seconds default_expiry)
     : hrn_(hrn.ToCatalogHRNString()),
       cache_(std::move(cache)),
-      default_expiry_(ConvertTime(default_expiry)) {}
+      default_expiry_(ConvertTime(default_expiry)),
+      validators_(cache_, default_expiry_) {}
 
 client::ApiNoResponse DataCacheRepository::Put(const model::Data& data,
                                                const std::string& layer_id,
-                                               const std::string& data_handle) {
+                                               const std::string& data_handle,
+                                               const std::string& etag) {
   const auto key =
       cache::KeyGenerator::CreateDataHandleKey(hrn_, layer_id, data_handle);
   OLP_SDK_LOG_TRACE_F(kLogTag, "Put -> '%s'", key.c_str());
 
-  auto write_result = cache_->Write(key, data, default_expiry_);
+  // The data is written together with its validator
+  cache::KeyValueCache::KeyValueListType items;
+  items.emplace_back(key, data);
+  validators_.Add(key, etag, items);
+
+  auto write_result =
+      cache_->WriteBatch(items, validators_.ResponseExpiry(etag));
   if (!write_result) {
     OLP_SDK_LOG_ERROR_F(kLogTag, "Failed to write -> '%s'", key.c_str());
     return write_result.GetError();
@@ -63,12 +71,40 @@ client::ApiNoResponse DataCacheRepository::Put(const model::Data& data,
   return {client::ApiNoResult{}};
 }
 
+client::ApiNoResponse DataCacheRepository::Put(
+    const std::vector<std::pair<std::string, model::Data>>& data,
+    const std::string& layer_id) {
+  cache::KeyValueCache::KeyValueListType items;
+  items.reserve(2u * data.size());
+
+  for (const auto& item : data) {
+    auto key =
+        cache::KeyGenerator::CreateDataHandleKey(hrn_, layer_id, item.first);
+    OLP_SDK_LOG_TRACE_F(kLogTag, "Put -> '%s'", key.c_str());
+    validators_.Add(key, std::string(), items);
+    items.emplace_back(std::move(key), item.second);
+  }
+
+  auto write_result = cache_->WriteBatch(items, default_expiry_);
+  if (!write_result) {
+    OLP_SDK_LOG_ERROR_F(kLogTag, "Failed to write %zu data handles",
+                        data.size());
+    return write_result.GetError();
+  }
+
+  return {client::ApiNoResult{}};
+}
+
 boost::optional<model::Data> DataCacheRepository::Get(
     const std::string& layer_id, const std::string& data_handle) {
   const auto key =
       cache::KeyGenerator::CreateDataHandleKey(hrn_, layer_id, data_handle);
   OLP_SDK_LOG_TRACE_F(kLogTag, "Get '%s'", key.c_str());
 
+  if (validators_.IsStale(key)) {
+    return boost::none;
+  }
+
   auto cached_data = cache_->Get(key);
   if (!cached_data) {
     return boost::none;
@@ -77,12 +113,74 @@ boost::optional<model::Data> DataCacheRepository::Get(
   return cached_data;
 }
 
+boost::optional<cache::ValueView> DataCacheRepository::GetView(
+    const std::string& layer_id, const std::string& data_handle) {
+  const auto key =
+      cache::KeyGenerator::CreateDataHandleKey(hrn_, layer_id, data_handle);
+  OLP_SDK_LOG_TRACE_F(kLogTag, "GetView '%s'", key.c_str());
+
+  if (validators_.IsStale(key)) {
+    return boost::none;
+  }
+
+  auto cached_view = cache_->ReadView(key);
+  if (!cached_view) {
+    return boost::none;
+  }
+
+  return cached_view.MoveResult();
+}
+
+std::vector<model::Data> DataCacheRepository::Get(
+    const std::string& layer_id, const std::vector<std::string>& data_handles) {
+  cache::KeyValueCache::KeyListType keys;
+  keys.reserve(data_handles.size());
+
+  for (const auto& data_handle : data_handles) {
+    keys.push_back(
+        cache::KeyGenerator::CreateDataHandleKey(hrn_, layer_id, data_handle));
+    OLP_SDK_LOG_TRACE_F(kLogTag, "Get '%s'", keys.back().c_str());
+  }
+
+  auto cached_data = cache_->ReadBatch(keys);
+  if (!cached_data) {
+    return std::vector<model::Data>(data_handles.size());
+  }
+
+  auto result = cached_data.MoveResult();
+  if (validators_.IsEnabled()) {
+    const auto stale = validators_.IsStale(keys);
+    for (auto i = 0u; i < result.size() && i < stale.size(); ++i) {
+      if (stale[i]) {
+        result[i] = nullptr;
+      }
+    }
+  }
+
+  return result;
+}
+
 bool DataCacheRepository::IsCached(const std::string& layer_id,
                                    const std::string& data_handle) const {
-  return cache_->Contains(
+  const auto key =
+      cache::KeyGenerator::CreateDataHandleKey(hrn_, layer_id, data_handle);
+  return cache_->Contains(key) && !validators_.IsStale(key);
+}
+
+boost::optional<CacheValidator> DataCacheRepository::GetValidator(
+    const std::string& layer_id, const std::string& data_handle) {
+  return validators_.Get(
       cache::KeyGenerator::CreateDataHandleKey(hrn_, layer_id, data_handle));
 }
 
+bool DataCacheRepository::RefreshValidator(const std::string& layer_id,
+                                           const std::string& data_handle,
+                                           const CacheValidator& validator) {
+  return validators_.Refresh(
+      cache::KeyGenerator::CreateDataHandleKey(hrn_, layer_id, data_handle),
+      validator);
+}
+
 client::ApiNoResponse DataCacheRepository::Clear(
     const std::string& layer_id, const std::string& data_handle) {
   const auto key =
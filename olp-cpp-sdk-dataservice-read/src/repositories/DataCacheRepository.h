@@ -21,11 +21,16 @@
 
 #include <chrono>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
+#include <olp/core/cache/ValueView.h>
 #include <olp/core/client/ApiNoResult.h>
 #include <olp/core/client/HRN.h>
 #include <olp/dataservice/read/model/Data.h>
 #include <boost/optional.hpp>
+#include "ValidatorCacheRepository.h"
 
 namespace olp {
 namespace cache {
@@ -43,15 +48,39 @@ class DataCacheRepository final {
 
   ~DataCacheRepository() = default;
 
+  /// Writes the data, the data with an ETag is revalidated when expired
+  /// instead of being downloaded again.
   client::ApiNoResponse Put(const model::Data& data,
                             const std::string& layer_id,
-                            const std::string& data_handle);
+                            const std::string& data_handle,
+                            const std::string& etag = std::string());
+
+  client::ApiNoResponse Put(
+      const std::vector<std::pair<std::string, model::Data>>& data,
+      const std::string& layer_id);
 
   boost::optional<model::Data> Get(const std::string& layer_id,
                                    const std::string& data_handle);
+
+  /// Returns the data in the order of the data handles, the data that is not
+  /// cached is nullptr.
+  std::vector<model::Data> Get(const std::string& layer_id,
+                               const std::vector<std::string>& data_handles);
+
+  /// Returns the view of the cached data, the data is not copied.
+  boost::optional<cache::ValueView> GetView(const std::string& layer_id,
+                                            const std::string& data_handle);
+
   bool IsCached(const std::string& layer_id,
                 const std::string& data_handle) const;
 
+  boost::optional<CacheValidator> GetValidator(const std::string& layer_id,
+                                               const std::string& data_handle);
+
+  bool RefreshValidator(const std::string& layer_id,
+                        const std::string& data_handle,
+                        const CacheValidator& validator);
+
   void PromoteInCache(const std::string& layer_id,
                       const std::string& data_handle);
 
@@ -62,6 +91,7 @@ class DataCacheRepository final {
   const std::string hrn_;
   std::shared_ptr<cache::KeyValueCache> cache_;
   time_t default_expiry_;
+  ValidatorCacheRepository validators_;
 };
 }  // namespace repository
 }  // namespace read
@@ -19,11 +19,17 @@
 
 #include "DataRepository.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <olp/core/client/Condition.h>
 #include <olp/core/logging/Log.h>
+#include "Crc32c.h"
 #include "DataCacheRepository.h"
 #include "PartitionsRepository.h"
 #include "generated/api/BlobApi.h"
@@ -40,22 +46,49 @@ namespace {
 constexpr auto kLogTag = "DataRepository";
 constexpr auto kBlobService = "blob";
 constexpr auto kVolatileBlobService = "volatile-blob";
+
+/// The shared state of the range requests of one blob.
+struct ParallelDownload {
+  explicit ParallelDownload(std::size_t parts_count)
+      : contexts(parts_count), responses(parts_count) {}
+
+  std::vector<client::CancellationContext> contexts;
+  std::vector<BlobApi::RangeResponse> responses;
+  std::mutex mutex;
+  std::condition_variable finished;
+  std::size_t next_part{0u};
+  std::size_t parts_in_progress{0u};
+  bool failed{false};
+};
+
+bool MatchesCrc(const unsigned char* data, std::size_t size,
+                const std::string& crc) {
+  Crc32c checksum;
+  checksum.Update(data, size);
+  return checksum.Matches(crc);
+}
+
+client::ApiError CrcMismatchError() {
+  return client::ApiError(client::ErrorCode::Unknown,
+                          "Downloaded data CRC mismatch", true);
+}
 }  // namespace
 
-DataRepository::DataRepository(client::HRN catalog,
-                               client::OlpClientSettings settings,
-                               client::ApiLookupClient client,
-                               NamedMutexStorage storage)
+DataRepository::DataRepository(
+    client::HRN catalog, client::OlpClientSettings settings,
+    client::ApiLookupClient client, NamedMutexStorage storage,
+    std::shared_ptr<DecodedPartitions> decoded_partitions)
     : catalog_(std::move(catalog)),
       settings_(std::move(settings)),
       lookup_client_(std::move(client)),
-      storage_(std::move(storage)) {}
+      storage_(std::move(storage)),
+      decoded_partitions_(std::move(decoded_partitions)) {}
 
 DataResponse DataRepository::GetVersionedTile(
     const std::string& layer_id, const TileRequest& request, int64_t version,
     client::CancellationContext context) {
   PartitionsRepository repository(catalog_, layer_id, settings_, lookup_client_,
-                                  storage_);
+                                  storage_, decoded_partitions_);
   auto response = repository.GetTile(request, version, context, {});
 
   auto network_statistics = response.GetPayload();
@@ -88,60 +121,450 @@ DataResponse DataRepository::GetVersionedTile(
 BlobApi::DataResponse DataRepository::GetVersionedData(
     const std::string& layer_id, const DataRequest& request, int64_t version,
     client::CancellationContext context, const bool fail_on_cache_error) {
+  auto partition_response = GetPartition(layer_id, request, version, context);
+  auto network_statistics = partition_response.GetPayload();
+
+  if (!partition_response) {
+    return DataResponse(partition_response.GetError(), network_statistics);
+  }
+
+  // finally get the data using a data handle
+  auto data_response =
+      request.GetRangeOffset()
+          ? GetBlobDataRange(layer_id, partition_response.GetResult(),
+                             request, std::move(context))
+          : GetBlobData(layer_id, kBlobService, partition_response.GetResult(),
+                        request.GetFetchOption(), request.GetBillingTag(),
+                        std::move(context), fail_on_cache_error);
+
+  network_statistics += data_response.GetPayload();
+
+  if (data_response) {
+    return DataResponse(data_response.MoveResult(), network_statistics);
+  } else {
+    return DataResponse(data_response.GetError(), network_statistics);
+  }
+}
+
+DataViewResponse DataRepository::GetVersionedDataView(
+    const std::string& layer_id, const DataRequest& request, int64_t version,
+    client::CancellationContext context, const bool fail_on_cache_error) {
+  if (request.GetRangeOffset()) {
+    // The range is a copy of the data anyway
+    auto data_response = GetVersionedData(layer_id, request, version,
+                                          std::move(context),
+                                          fail_on_cache_error);
+    auto network_statistics = data_response.GetPayload();
+    if (!data_response) {
+      return DataViewResponse(data_response.GetError(), network_statistics);
+    }
+    return DataViewResponse(cache::ValueView(data_response.MoveResult()),
+                            network_statistics);
+  }
+
+  auto partition_response = GetPartition(layer_id, request, version, context);
+  auto network_statistics = partition_response.GetPayload();
+
+  if (!partition_response) {
+    return DataViewResponse(partition_response.GetError(), network_statistics);
+  }
+
+  const auto& partition = partition_response.GetResult();
+  const auto& data_handle = partition.GetDataHandle();
+  const auto fetch_option = request.GetFetchOption();
+
+  if (!data_handle.empty() && fetch_option != OnlineOnly &&
+      fetch_option != CacheWithUpdate) {
+    repository::DataCacheRepository repository(
+        catalog_, settings_.cache, settings_.default_cache_expiration);
+
+    auto cached_view = repository.GetView(layer_id, data_handle);
+    if (cached_view) {
+      OLP_SDK_LOG_TRACE_F(
+          kLogTag, "GetVersionedDataView found in cache, hrn='%s', key='%s'",
+          catalog_.ToCatalogHRNString().c_str(), data_handle.c_str());
+      return DataViewResponse(std::move(*cached_view), network_statistics);
+    }
+  }
+
+  // The data is not cached, so the downloaded data is viewed instead
+  auto data_response = GetBlobData(
+      layer_id, kBlobService, partition, fetch_option, request.GetBillingTag(),
+      std::move(context), fail_on_cache_error);
+
+  network_statistics += data_response.GetPayload();
+
+  if (!data_response) {
+    return DataViewResponse(data_response.GetError(), network_statistics);
+  }
+
+  return DataViewResponse(cache::ValueView(data_response.MoveResult()),
+                          network_statistics);
+}
+
+DataStreamResponse DataRepository::GetVersionedDataStream(
+    const std::string& layer_id, const DataRequest& request, int64_t version,
+    const DataChunkCallback& chunk_callback,
+    client::CancellationContext context, const bool fail_on_cache_error) {
+  auto partition_response = GetPartition(layer_id, request, version, context);
+  auto network_statistics = partition_response.GetPayload();
+
+  if (!partition_response) {
+    return DataStreamResponse(partition_response.GetError(),
+                              network_statistics);
+  }
+
+  const auto& partition = partition_response.GetResult();
+  const auto& data_handle = partition.GetDataHandle();
+  if (data_handle.empty()) {
+    return DataStreamResponse(
+        client::ApiError::PreconditionFailed("Data handle is missing"),
+        network_statistics);
+  }
+
+  const auto fetch_option = request.GetFetchOption();
+  repository::DataCacheRepository repository(
+      catalog_, settings_.cache, settings_.default_cache_expiration);
+
+  const auto& crc = partition.GetCrc();
+  const auto verify_crc =
+      settings_.verify_data_integrity && crc && !crc->empty();
+
+  if (fetch_option != OnlineOnly) {
+    auto cached_view = repository.GetView(layer_id, data_handle);
+    if (cached_view && verify_crc &&
+        !MatchesCrc(cached_view->data(), cached_view->size(), *crc)) {
+      OLP_SDK_LOG_WARNING_F(
+          kLogTag,
+          "GetVersionedDataStream cached data CRC mismatch, remove from "
+          "cache, hrn='%s', key='%s'",
+          catalog_.ToCatalogHRNString().c_str(), data_handle.c_str());
+      cached_view = boost::none;
+      repository.Clear(layer_id, data_handle);
+    }
+    if (cached_view) {
+      OLP_SDK_LOG_TRACE_F(
+          kLogTag, "GetVersionedDataStream found in cache, hrn='%s', key='%s'",
+          catalog_.ToCatalogHRNString().c_str(), data_handle.c_str());
+      chunk_callback(cached_view->data(), cached_view->size());
+      return DataStreamResponse(client::ApiNoResult{}, network_statistics);
+    } else if (fetch_option == CacheOnly) {
+      OLP_SDK_LOG_INFO_F(
+          kLogTag,
+          "GetVersionedDataStream not found in cache, hrn='%s', key='%s'",
+          catalog_.ToCatalogHRNString().c_str(), data_handle.c_str());
+      return DataStreamResponse(
+          client::ApiError::NotFound("CacheOnly: resource not found in cache"),
+          network_statistics);
+    }
+  }
+
+  auto storage_api_lookup = lookup_client_.LookupApi(
+      kBlobService, "v1", static_cast<client::FetchOptions>(fetch_option),
+      context);
+
+  if (!storage_api_lookup.IsSuccessful()) {
+    return DataStreamResponse(storage_api_lookup.GetError(),
+                              network_statistics);
+  }
+
+  const auto cache_data = fetch_option != OnlineOnly;
+  auto data = std::make_shared<std::vector<unsigned char>>();
+  const auto& data_size = partition.GetDataSize();
+  if (cache_data && data_size && *data_size > 0) {
+    data->reserve(static_cast<std::size_t>(*data_size));
+  }
+
+  Crc32c checksum;
+  auto stream_response = BlobApi::GetBlobStream(
+      storage_api_lookup.GetResult(), layer_id, partition,
+      request.GetBillingTag(),
+      [&](const unsigned char* chunk, std::size_t size) {
+        if (cache_data) {
+          data->insert(data->end(), chunk, chunk + size);
+        }
+        if (verify_crc) {
+          checksum.Update(chunk, size);
+        }
+        chunk_callback(chunk, size);
+      },
+      context);
+
+  network_statistics += stream_response.GetPayload();
+
+  if (!stream_response) {
+    return DataStreamResponse(stream_response.GetError(), network_statistics);
+  }
+
+  if (verify_crc && !checksum.Matches(*crc)) {
+    OLP_SDK_LOG_WARNING_F(
+        kLogTag, "GetVersionedDataStream CRC mismatch, hrn='%s', key='%s'",
+        catalog_.ToCatalogHRNString().c_str(), data_handle.c_str());
+    return DataStreamResponse(CrcMismatchError(), network_statistics);
+  }
+
+  if (cache_data) {
+    const auto put_result = repository.Put(data, layer_id, data_handle);
+    if (!put_result.IsSuccessful() && fail_on_cache_error) {
+      OLP_SDK_LOG_ERROR_F(kLogTag,
+                          "Failed to write data to cache, hrn='%s', "
+                          "layer='%s', data_handle='%s'",
+                          catalog_.ToCatalogHRNString().c_str(),
+                          layer_id.c_str(), data_handle.c_str());
+      return DataStreamResponse(put_result.GetError(), network_statistics);
+    }
+  }
+
+  return DataStreamResponse(client::ApiNoResult{}, network_statistics);
+}
+
+DataRepository::PartitionResponse DataRepository::GetPartition(
+    const std::string& layer_id, const DataRequest& request, int64_t version,
+    client::CancellationContext context) {
   if (request.GetDataHandle() && request.GetPartitionId()) {
     return client::ApiError::PreconditionFailed(
         "Both data handle and partition id specified");
   }
 
-  client::NetworkStatistics network_statistics;
-
   model::Partition partition;
 
   if (request.GetDataHandle()) {
     partition.SetDataHandle(*request.GetDataHandle());
-  } else {
-    // get data handle for a partition to be queried
-    PartitionsRepository repository(catalog_, layer_id, settings_,
-                                    lookup_client_, storage_);
-    auto partitions_response =
-        repository.GetPartitionById(request, version, context);
+    return partition;
+  }
 
-    network_statistics = partitions_response.GetPayload();
+  // get data handle for a partition to be queried
+  PartitionsRepository repository(catalog_, layer_id, settings_,
+                                  lookup_client_, storage_,
+                                  decoded_partitions_);
+  auto partitions_response =
+      repository.GetPartitionById(request, version, std::move(context));
 
-    if (!partitions_response.IsSuccessful()) {
-      return DataResponse(partitions_response.GetError(), network_statistics);
-    }
+  const auto& network_statistics = partitions_response.GetPayload();
 
-    auto partitions_result = partitions_response.MoveResult();
-    auto& partitions = partitions_result.GetMutablePartitions();
-    if (partitions.empty()) {
+  if (!partitions_response.IsSuccessful()) {
+    return PartitionResponse(partitions_response.GetError(),
+                             network_statistics);
+  }
+
+  auto partitions_result = partitions_response.MoveResult();
+  auto& partitions = partitions_result.GetMutablePartitions();
+  if (partitions.empty()) {
+    OLP_SDK_LOG_INFO_F(
+        kLogTag, "GetVersionedData partition %s not found, hrn='%s', key='%s'",
+        request.GetPartitionId() ? request.GetPartitionId().get().c_str()
+                                 : "<none>",
+        catalog_.ToCatalogHRNString().c_str(),
+        request.CreateKey(layer_id, version).c_str());
+
+    return PartitionResponse(client::ApiError::NotFound("Partition not found"),
+                             network_statistics);
+  }
+
+  return PartitionResponse(std::move(partitions.front()), network_statistics);
+}
+
+BlobApi::DataResponse DataRepository::GetBlobDataRange(
+    const std::string& layer, const model::Partition& partition,
+    const DataRequest& request, client::CancellationContext context) {
+  const auto& data_handle = partition.GetDataHandle();
+  if (data_handle.empty()) {
+    return client::ApiError::PreconditionFailed("Data handle is missing");
+  }
+
+  const auto offset = request.GetRangeOffset().value_or(0u);
+  const auto& size = request.GetRangeSize();
+  if (size && *size == 0u) {
+    return client::ApiError::InvalidArgument("Range size is zero");
+  }
+
+  // The end of the range is not set when it is beyond the maximum offset
+  const auto has_end =
+      size && *size <= std::numeric_limits<std::uint64_t>::max() - offset;
+  const auto fetch_option = request.GetFetchOption();
+
+  if (fetch_option != OnlineOnly && fetch_option != CacheWithUpdate) {
+    repository::DataCacheRepository repository(
+        catalog_, settings_.cache, settings_.default_cache_expiration);
+
+    auto cached_view = repository.GetView(layer, data_handle);
+    if (cached_view) {
+      OLP_SDK_LOG_TRACE_F(
+          kLogTag, "GetBlobDataRange found in cache, hrn='%s', key='%s'",
+          catalog_.ToCatalogHRNString().c_str(), data_handle.c_str());
+
+      if (offset >= cached_view->size()) {
+        return client::ApiError::InvalidArgument("Range is out of the data");
+      }
+
+      const auto end =
+          has_end ? std::min<std::uint64_t>(offset + *size, cached_view->size())
+                  : cached_view->size();
+      return std::make_shared<std::vector<unsigned char>>(
+          cached_view->begin() + offset, cached_view->begin() + end);
+    } else if (fetch_option == CacheOnly) {
       OLP_SDK_LOG_INFO_F(
-          kLogTag,
-          "GetVersionedData partition %s not found, hrn='%s', key='%s'",
-          request.GetPartitionId() ? request.GetPartitionId().get().c_str()
-                                   : "<none>",
-          catalog_.ToCatalogHRNString().c_str(),
-          request.CreateKey(layer_id, version).c_str());
+          kLogTag, "GetBlobDataRange not found in cache, hrn='%s', key='%s'",
+          catalog_.ToCatalogHRNString().c_str(), data_handle.c_str());
+      return client::ApiError::NotFound(
+          "CacheOnly: resource not found in cache");
+    }
+  }
 
-      return DataResponse(client::ApiError::NotFound("Partition not found"),
-                          network_statistics);
+  auto storage_api_lookup = lookup_client_.LookupApi(
+      kBlobService, "v1", static_cast<client::FetchOptions>(fetch_option),
+      context);
+
+  if (!storage_api_lookup.IsSuccessful()) {
+    return storage_api_lookup.GetError();
+  }
+
+  auto range = "bytes=" + std::to_string(offset) + "-";
+  if (has_end) {
+    range += std::to_string(offset + *size - 1u);
+  }
+
+  return BlobApi::GetBlob(storage_api_lookup.GetResult(), layer, partition,
+                          request.GetBillingTag(), range, context);
+}
+
+boost::optional<BlobApi::DataResponse> DataRepository::GetBlobDataParallel(
+    const client::OlpClient& client, const std::string& layer,
+    const model::Partition& partition,
+    const boost::optional<std::string>& billing_tag,
+    client::CancellationContext context, ConditionalRequest* conditional) {
+  const auto& download_settings = settings_.parallel_download_settings;
+  const auto& data_size = partition.GetDataSize();
+  const auto& compressed_data_size = partition.GetCompressedDataSize();
+
+  // The ranges of the compressed blob can't be decoded separately
+  if (!settings_.task_scheduler || download_settings.min_blob_size == 0u ||
+      !data_size || *data_size <= 0 ||
+      static_cast<std::uint64_t>(*data_size) <
+          download_settings.min_blob_size ||
+      (compressed_data_size && *compressed_data_size > 0)) {
+    return boost::none;
+  }
+
+  const auto size = static_cast<std::uint64_t>(*data_size);
+  const auto min_range_size =
+      std::max<std::uint64_t>(download_settings.min_range_size, 1u);
+  const auto parts_count = static_cast<std::size_t>(
+      std::min<std::uint64_t>(download_settings.max_requests,
+                              (size - 1u) / min_range_size + 1u));
+  if (parts_count < 2u) {
+    return boost::none;
+  }
+
+  const auto part_size = (size - 1u) / parts_count + 1u;
+  auto data = std::make_shared<std::vector<unsigned char>>(
+      static_cast<std::size_t>(size));
+  auto download = std::make_shared<ParallelDownload>(parts_count);
+
+  // Every thread, including this one, takes the next part until all are
+  // taken, so the download does not wait for the free scheduler threads.
+  auto download_parts = [=]() {
+    while (true) {
+      std::size_t part = 0u;
+      {
+        std::lock_guard<std::mutex> lock(download->mutex);
+        if (download->failed || download->next_part == parts_count) {
+          return;
+        }
+        part = download->next_part++;
+        ++download->parts_in_progress;
+      }
+
+      const auto offset = part * part_size;
+      const auto length = std::min(part_size, size - offset);
+      auto response = BlobApi::GetBlobRange(
+          client, layer, partition, billing_tag, offset, length,
+          data->data() + offset, download->contexts[part],
+          part == 0u ? conditional : nullptr);
+
+      std::lock_guard<std::mutex> lock(download->mutex);
+      if (!response.IsSuccessful() || response.GetResult() != length) {
+        download->failed = true;
+        for (auto& part_context : download->contexts) {
+          part_context.CancelOperation();
+        }
+      }
+      download->responses[part] = std::move(response);
+      --download->parts_in_progress;
+      download->finished.notify_all();
     }
+  };
+
+  const auto started = context.ExecuteOrCancelled([&]() {
+    return client::CancellationToken([download]() {
+      std::lock_guard<std::mutex> lock(download->mutex);
+      download->failed = true;
+      for (auto& part_context : download->contexts) {
+        part_context.CancelOperation();
+      }
+    });
+  });
+
+  if (!started) {
+    return BlobApi::DataResponse(client::ApiError::Cancelled());
+  }
 
-    partition = std::move(partitions.front());
+  OLP_SDK_LOG_DEBUG_F(kLogTag,
+                      "GetBlobDataParallel, hrn='%s', key='%s', parts=%zu",
+                      catalog_.ToCatalogHRNString().c_str(),
+                      partition.GetDataHandle().c_str(), parts_count);
+
+  for (auto i = 1u; i < parts_count; ++i) {
+    settings_.task_scheduler->ScheduleTask(download_parts);
   }
+  download_parts();
 
-  // finally get the data using a data handle
-  auto data_response = GetBlobData(
-      layer_id, kBlobService, partition, request.GetFetchOption(),
-      request.GetBillingTag(), std::move(context), fail_on_cache_error);
+  std::unique_lock<std::mutex> lock(download->mutex);
+  download->finished.wait(lock,
+                          [&]() { return download->parts_in_progress == 0u; });
 
-  network_statistics += data_response.GetPayload();
+  client::NetworkStatistics network_statistics;
+  const BlobApi::RangeResponse* failed_response = nullptr;
+  // The parts are taken in order, the parts after the failure are not taken
+  for (auto part = 0u; part < download->next_part; ++part) {
+    const auto& response = download->responses[part];
+    network_statistics += response.GetPayload();
+    if (response.IsSuccessful()) {
+      continue;
+    }
 
-  if (data_response) {
-    return DataResponse(data_response.MoveResult(), network_statistics);
-  } else {
-    return DataResponse(data_response.GetError(), network_statistics);
+    // The parts cancelled after the failure of another part are skipped
+    if (!failed_response || failed_response->GetError().GetErrorCode() ==
+                                client::ErrorCode::Cancelled) {
+      failed_response = &response;
+    }
+  }
+
+  if (context.IsCancelled()) {
+    return BlobApi::DataResponse(client::ApiError::Cancelled(),
+                                 network_statistics);
+  }
+
+  if (failed_response) {
+    const auto& error = failed_response->GetError();
+    if (error.GetHttpStatusCode() == http::HttpStatusCode::OK) {
+      OLP_SDK_LOG_WARNING_F(
+          kLogTag,
+          "GetBlobDataParallel ranges are not supported, hrn='%s', key='%s'",
+          catalog_.ToCatalogHRNString().c_str(),
+          partition.GetDataHandle().c_str());
+      return boost::none;
+    }
+    return BlobApi::DataResponse(error, network_statistics);
   }
+
+  if (download->failed) {
+    return BlobApi::DataResponse(
+        client::ApiError::Unknown("Received range size mismatch"),
+        network_statistics);
+  }
+
+  return BlobApi::DataResponse(std::move(data), network_statistics);
 }
 
 BlobApi::DataResponse DataRepository::GetBlobData(
@@ -167,8 +590,28 @@ BlobApi::DataResponse DataRepository::GetBlobData(
   repository::DataCacheRepository repository(
       catalog_, settings_.cache, settings_.default_cache_expiration);
 
-  if (fetch_option != OnlineOnly && fetch_option != CacheWithUpdate) {
+  const auto& crc = partition.GetCrc();
+  const auto verify_crc =
+      settings_.verify_data_integrity && crc && !crc->empty();
+
+  // The corrupted data is removed, so it is downloaded again
+  auto get_cached_data = [&]() -> boost::optional<model::Data> {
     auto cached_data = repository.Get(layer, data_handle);
+    if (cached_data && verify_crc && *cached_data &&
+        !MatchesCrc((*cached_data)->data(), (*cached_data)->size(), *crc)) {
+      OLP_SDK_LOG_WARNING_F(
+          kLogTag,
+          "GetBlobData cached data CRC mismatch, remove from cache, "
+          "hrn='%s', key='%s'",
+          catalog_.ToCatalogHRNString().c_str(), data_handle.c_str());
+      repository.Clear(layer, data_handle);
+      return boost::none;
+    }
+    return cached_data;
+  };
+
+  if (fetch_option != OnlineOnly && fetch_option != CacheWithUpdate) {
+    auto cached_data = get_cached_data();
     if (cached_data) {
       OLP_SDK_LOG_TRACE_F(
           kLogTag, "GetBlobData found in cache, hrn='%s', key='%s'",
@@ -205,22 +648,113 @@ BlobApi::DataResponse DataRepository::GetBlobData(
     return storage_api_lookup.GetError();
   }
 
-  BlobApi::DataResponse storage_response;
+  // The expired data is revalidated, so it is not downloaded again when not
+  // modified.
+  ConditionalRequest conditional;
+  boost::optional<repository::CacheValidator> validator;
+  if (fetch_option != OnlineOnly) {
+    validator = repository.GetValidator(layer, data_handle);
+  }
+  if (validator) {
+    conditional.if_none_match = validator->etag;
+  }
 
-  if (service == kBlobService) {
-    storage_response =
-        BlobApi::GetBlob(storage_api_lookup.GetResult(), layer, partition,
-                         billing_tag, boost::none, context);
-  } else {
-    auto volatile_blob =
-        VolatileBlobApi::GetVolatileBlob(storage_api_lookup.GetResult(), layer,
-                                         data_handle, billing_tag, context);
-    storage_response = BlobApi::DataResponse(volatile_blob.MoveResult());
+  // The CRC of the data downloaded with one request is computed while the
+  // data arrives. The parts of the parallel download arrive out of order, so
+  // the assembled data is always verified afterwards.
+  auto crc_mismatch = false;
+  auto download = [&]() -> BlobApi::DataResponse {
+    Crc32c checksum;
+    auto checksum_computed = false;
+    auto verify_assembled_data = verify_crc;
+    boost::optional<BlobApi::DataResponse> response;
+
+    if (service == kBlobService) {
+      if (conditional.if_none_match.empty()) {
+        response =
+            GetBlobDataParallel(storage_api_lookup.GetResult(), layer,
+                                partition, billing_tag, context, &conditional);
+        verify_assembled_data = response && crc && !crc->empty();
+      }
+
+      if (!response) {
+        response = BlobApi::GetBlob(
+            storage_api_lookup.GetResult(), layer, partition, billing_tag,
+            boost::none, context, &conditional,
+            verify_crc ? &checksum : nullptr);
+        checksum_computed = verify_crc;
+      }
+    } else {
+      auto volatile_blob = VolatileBlobApi::GetVolatileBlob(
+          storage_api_lookup.GetResult(), layer, data_handle, billing_tag,
+          context, &conditional);
+      response = BlobApi::DataResponse(volatile_blob.MoveResult());
+    }
+
+    if (!checksum_computed && verify_assembled_data &&
+        response->IsSuccessful()) {
+      const auto& data = response->GetResult();
+      checksum.Update(data->data(), data->size());
+      checksum_computed = true;
+    }
+
+    crc_mismatch = checksum_computed && response->IsSuccessful() &&
+                   !checksum.Matches(*crc);
+    if (crc_mismatch) {
+      OLP_SDK_LOG_WARNING_F(kLogTag,
+                            "GetBlobData CRC mismatch, hrn='%s', key='%s'",
+                            catalog_.ToCatalogHRNString().c_str(),
+                            data_handle.c_str());
+      return BlobApi::DataResponse(CrcMismatchError(), response->GetPayload());
+    }
+
+    return std::move(*response);
+  };
+
+  auto storage_response = download();
+
+  // Downloads the data unconditionally and sums up the network statistics
+  auto download_again = [&]() {
+    auto network_statistics = storage_response.GetPayload();
+    conditional.if_none_match.clear();
+    storage_response = download();
+    network_statistics += storage_response.GetPayload();
+    storage_response = storage_response.IsSuccessful()
+                           ? BlobApi::DataResponse(
+                                 storage_response.MoveResult(),
+                                 network_statistics)
+                           : BlobApi::DataResponse(storage_response.GetError(),
+                                                   network_statistics);
+  };
+
+  if (validator && !storage_response.IsSuccessful() &&
+      storage_response.GetError().GetHttpStatusCode() ==
+          http::HttpStatusCode::NOT_MODIFIED) {
+    repository.RefreshValidator(layer, data_handle, *validator);
+    auto cached_data = get_cached_data();
+    if (cached_data) {
+      OLP_SDK_LOG_TRACE_F(
+          kLogTag, "GetBlobData not modified, hrn='%s', key='%s'",
+          catalog_.ToCatalogHRNString().c_str(), data_handle.c_str());
+      return BlobApi::DataResponse(cached_data.value(),
+                                   storage_response.GetPayload());
+    }
+
+    // The data is evicted meanwhile, download it again
+    download_again();
+  }
+
+  // The mismatch is retried only when the verification is requested
+  for (auto attempt = 0; crc_mismatch && settings_.verify_data_integrity &&
+                         attempt < settings_.retry_settings.max_attempts &&
+                         !context.IsCancelled();
+       ++attempt) {
+    download_again();
   }
 
   if (storage_response.IsSuccessful() && fetch_option != OnlineOnly) {
-    const auto put_result =
-        repository.Put(storage_response.GetResult(), layer, data_handle);
+    const auto put_result = repository.Put(storage_response.GetResult(), layer,
+                                           data_handle, conditional.etag);
     if (!put_result.IsSuccessful() && fail_on_cache_error) {
       OLP_SDK_LOG_ERROR_F(kLogTag,
                           "Failed to write data to cache, hrn='%s', "
@@ -262,7 +796,8 @@ BlobApi::DataResponse DataRepository::GetVolatileData(
     partition.SetDataHandle(*request.GetDataHandle());
   } else {
     PartitionsRepository repository(catalog_, layer_id, settings_,
-                                    lookup_client_, storage_);
+                                    lookup_client_, storage_,
+                                    decoded_partitions_);
     auto partitions_response =
         repository.GetPartitionById(request, boost::none, context);
 
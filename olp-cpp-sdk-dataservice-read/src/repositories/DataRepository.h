@@ -28,6 +28,7 @@
 #include "olp/dataservice/read/Types.h"
 
 #include "NamedMutex.h"
+#include "PartitionsCacheRepository.h"
 #include "generated/api/BlobApi.h"
 
 namespace olp {
@@ -40,7 +41,9 @@ class DataRepository final {
  public:
   DataRepository(client::HRN catalog, client::OlpClientSettings settings,
                  client::ApiLookupClient client,
-                 NamedMutexStorage storage = NamedMutexStorage());
+                 NamedMutexStorage storage = NamedMutexStorage(),
+                 std::shared_ptr<DecodedPartitions> decoded_partitions =
+                     nullptr);
 
   DataResponse GetVersionedTile(const std::string& layer_id,
                                 const TileRequest& request, int64_t version,
@@ -52,6 +55,23 @@ class DataRepository final {
                                          client::CancellationContext context,
                                          bool fail_on_cache_error);
 
+  /// Gets the data without copying it out of the cache, if the fetch option
+  /// allows it. Otherwise, views the data returned by `GetBlobData`.
+  DataViewResponse GetVersionedDataView(const std::string& layer_id,
+                                        const DataRequest& request,
+                                        int64_t version,
+                                        client::CancellationContext context,
+                                        bool fail_on_cache_error);
+
+  /// Passes the data to the chunk callback while it is downloaded. The
+  /// downloaded data is collected and cached, unless the fetch option is
+  /// `OnlineOnly`. The data that does not match the partition CRC is already
+  /// passed when the mismatch is detected, so it is only not cached.
+  DataStreamResponse GetVersionedDataStream(
+      const std::string& layer_id, const DataRequest& request,
+      int64_t version, const DataChunkCallback& chunk_callback,
+      client::CancellationContext context, bool fail_on_cache_error);
+
   BlobApi::DataResponse GetVolatileData(const std::string& layer_id,
                                         const DataRequest& request,
                                         client::CancellationContext context,
@@ -64,10 +84,35 @@ class DataRepository final {
       client::CancellationContext context, bool fail_on_cache_error);
 
  private:
+  using PartitionResponse =
+      Response<model::Partition, client::NetworkStatistics>;
+
+  /// Resolves the data handle of the requested partition.
+  PartitionResponse GetPartition(const std::string& layer_id,
+                                 const DataRequest& request, int64_t version,
+                                 client::CancellationContext context);
+
+  /// Downloads the large blob with concurrent range requests. Returns
+  /// `boost::none` when the blob is not split or the server does not support
+  /// ranges, so the blob is downloaded with one request.
+  boost::optional<BlobApi::DataResponse> GetBlobDataParallel(
+      const client::OlpClient& client, const std::string& layer,
+      const model::Partition& partition,
+      const boost::optional<std::string>& billing_tag,
+      client::CancellationContext context, ConditionalRequest* conditional);
+
+  /// Gets the byte range of the request. The range is read from the cached
+  /// data, or downloaded and not cached.
+  BlobApi::DataResponse GetBlobDataRange(const std::string& layer,
+                                         const model::Partition& partition,
+                                         const DataRequest& request,
+                                         client::CancellationContext context);
+
   client::HRN catalog_;
   client::OlpClientSettings settings_;
   client::ApiLookupClient lookup_client_;
   NamedMutexStorage storage_;
+  std::shared_ptr<DecodedPartitions> decoded_partitions_;
 };
 
 }  // namespace repository
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <olp/core/utils/HashLruCache.h>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+namespace repository {
+
+/*
+ * @brief A size-bounded in-memory cache of the already decoded objects, put in
+ * front of the byte cache, so the hot lookups do not parse the cached JSON
+ * again. The cache is owned by the layer client and shared by the repositories
+ * it creates.
+ *
+ * The cache does not track the expiration or removal of the keys in the byte
+ * cache, so the callers must check that the key is still in the byte cache
+ * and update or remove the decoded objects when they write or remove the keys.
+ * Other users of the same byte cache do not update the objects, so only the
+ * values that never change for a key, e.g. the versioned partitions, are kept.
+ */
+template <typename T>
+class DecodedObjectCache final {
+ public:
+  using ValuePtr = std::shared_ptr<const T>;
+
+  explicit DecodedObjectCache(std::size_t max_objects)
+      : objects_(std::max<std::size_t>(max_objects, 1u)) {}
+
+  void Put(const std::string& key, ValuePtr value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    objects_.InsertOrAssign(key, std::move(value));
+  }
+
+  ValuePtr Get(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = objects_.Find(key);
+    if (it == objects_.end()) {
+      ++misses_;
+      return nullptr;
+    }
+
+    ++hits_;
+    return it->value();
+  }
+
+  void Remove(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    objects_.Erase(key);
+  }
+
+  void RemoveKeysWithPrefix(const std::string& prefix) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = objects_.begin(); it != objects_.end();) {
+      if (it->key().compare(0, prefix.size(), prefix) == 0) {
+        it = objects_.Erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  std::size_t Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return objects_.Size();
+  }
+
+  std::uint64_t GetHits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+  }
+
+  std::uint64_t GetMisses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  utils::HashLruCache<std::string, ValuePtr> objects_;
+  std::uint64_t hits_{0};
+  std::uint64_t misses_{0};
+};
+
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
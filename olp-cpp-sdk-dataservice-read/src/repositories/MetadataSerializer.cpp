@@ -0,0 +1,369 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "MetadataSerializer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+// clang-format off
+#include "generated/parser/PartitionsParser.h"
+#include "generated/parser/LayerVersionsParser.h"
+#include <olp/core/generated/parser/JsonParser.h>
+// clang-format on
+
+namespace {
+namespace model = olp::dataservice::read::model;
+
+// Can not be the first byte of a JSON document
+constexpr unsigned char kMarker = 0xB1;
+constexpr unsigned char kFormatVersion = 1u;
+constexpr size_t kHeaderSize = 3u;
+
+enum ValueType : unsigned char {
+  kPartition = 1u,
+  kPartitionIds = 2u,
+  kLayerVersions = 3u
+};
+
+// Bits of the optional partition fields, which are present in the value
+constexpr std::uint64_t kChecksum = 1u << 0;
+constexpr std::uint64_t kCompressedDataSize = 1u << 1;
+constexpr std::uint64_t kDataSize = 1u << 2;
+constexpr std::uint64_t kCrc = 1u << 3;
+constexpr std::uint64_t kVersion = 1u << 4;
+
+class Writer {
+ public:
+  Writer(ValueType type, size_t size_hint) {
+    buffer_.reserve(kHeaderSize + size_hint);
+    buffer_.push_back(kMarker);
+    buffer_.push_back(kFormatVersion);
+    buffer_.push_back(type);
+  }
+
+  void WriteVarint(std::uint64_t value) {
+    while (value >= 0x80u) {
+      buffer_.push_back(static_cast<unsigned char>(value | 0x80u));
+      value >>= 7;
+    }
+    buffer_.push_back(static_cast<unsigned char>(value));
+  }
+
+  void WriteInt(std::int64_t value) {
+    // Zigzag encoding, so the small negative values are short as well
+    WriteVarint((static_cast<std::uint64_t>(value) << 1) ^
+                static_cast<std::uint64_t>(value >> 63));
+  }
+
+  void WriteString(const std::string& value, size_t offset = 0u) {
+    WriteVarint(value.size() - offset);
+    buffer_.insert(buffer_.end(), value.begin() + offset, value.end());
+  }
+
+  std::vector<unsigned char>&& Release() { return std::move(buffer_); }
+
+ private:
+  std::vector<unsigned char> buffer_;
+};
+
+class Reader {
+ public:
+  Reader(const unsigned char* data, size_t size)
+      : pos_(data), end_(data + size) {}
+
+  bool ReadHeader(ValueType type) {
+    if (end_ - pos_ < static_cast<std::ptrdiff_t>(kHeaderSize) ||
+        pos_[0] != kMarker || pos_[1] != kFormatVersion || pos_[2] != type) {
+      return false;
+    }
+    pos_ += kHeaderSize;
+    return true;
+  }
+
+  bool ReadVarint(std::uint64_t& value) {
+    value = 0u;
+    for (auto shift = 0u; shift < 64u; shift += 7u) {
+      if (pos_ == end_) {
+        return false;
+      }
+      const auto byte = *pos_++;
+      value |= static_cast<std::uint64_t>(byte & 0x7Fu) << shift;
+      if ((byte & 0x80u) == 0u) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool ReadInt(std::int64_t& value) {
+    std::uint64_t encoded = 0u;
+    if (!ReadVarint(encoded)) {
+      return false;
+    }
+    value = static_cast<std::int64_t>(encoded >> 1) ^
+            -static_cast<std::int64_t>(encoded & 1u);
+    return true;
+  }
+
+  bool ReadString(std::string& value, size_t offset = 0u) {
+    std::uint64_t size = 0u;
+    if (!ReadVarint(size) ||
+        size > static_cast<std::uint64_t>(end_ - pos_)) {
+      return false;
+    }
+    value.resize(offset);
+    value.append(reinterpret_cast<const char*>(pos_), size);
+    pos_ += size;
+    return true;
+  }
+
+  bool ReadOptionalString(std::uint64_t fields, std::uint64_t field,
+                          boost::optional<std::string>& value) {
+    if ((fields & field) == 0u) {
+      value = boost::none;
+      return true;
+    }
+    std::string result;
+    if (!ReadString(result)) {
+      return false;
+    }
+    value = std::move(result);
+    return true;
+  }
+
+  bool ReadOptionalInt(std::uint64_t fields, std::uint64_t field,
+                       boost::optional<std::int64_t>& value) {
+    if ((fields & field) == 0u) {
+      value = boost::none;
+      return true;
+    }
+    std::int64_t result = 0;
+    if (!ReadInt(result)) {
+      return false;
+    }
+    value = result;
+    return true;
+  }
+
+  bool IsEnd() const { return pos_ == end_; }
+
+ private:
+  const unsigned char* pos_;
+  const unsigned char* end_;
+};
+
+bool IsBinary(const unsigned char* data, size_t size) {
+  return size > 0u && data[0] == kMarker;
+}
+
+bool ReadPartition(Reader& reader, model::Partition& partition) {
+  std::uint64_t fields = 0u;
+  return reader.ReadVarint(fields) &&
+         reader.ReadString(partition.GetMutablePartition()) &&
+         reader.ReadString(partition.GetMutableDataHandle()) &&
+         reader.ReadOptionalString(fields, kChecksum,
+                                   partition.GetMutableChecksum()) &&
+         reader.ReadOptionalInt(fields, kCompressedDataSize,
+                                partition.GetMutableCompressedDataSize()) &&
+         reader.ReadOptionalInt(fields, kDataSize,
+                                partition.GetMutableDataSize()) &&
+         reader.ReadOptionalString(fields, kCrc, partition.GetMutableCrc()) &&
+         reader.ReadOptionalInt(fields, kVersion,
+                                partition.GetMutableVersion());
+}
+
+}  // namespace
+
+namespace olp {
+namespace dataservice {
+namespace read {
+namespace repository {
+namespace metadata {
+
+cache::KeyValueCache::ValueTypePtr Serialize(
+    const model::Partition& partition) {
+  const auto& checksum = partition.GetChecksum();
+  const auto& compressed_data_size = partition.GetCompressedDataSize();
+  const auto& data_size = partition.GetDataSize();
+  const auto& crc = partition.GetCrc();
+  const auto& version = partition.GetVersion();
+
+  std::uint64_t fields = 0u;
+  fields |= checksum ? kChecksum : 0u;
+  fields |= compressed_data_size ? kCompressedDataSize : 0u;
+  fields |= data_size ? kDataSize : 0u;
+  fields |= crc ? kCrc : 0u;
+  fields |= version ? kVersion : 0u;
+
+  Writer writer(kPartition, partition.GetPartition().size() +
+                                partition.GetDataHandle().size() + 32u);
+  writer.WriteVarint(fields);
+  writer.WriteString(partition.GetPartition());
+  writer.WriteString(partition.GetDataHandle());
+  if (checksum) {
+    writer.WriteString(*checksum);
+  }
+  if (compressed_data_size) {
+    writer.WriteInt(*compressed_data_size);
+  }
+  if (data_size) {
+    writer.WriteInt(*data_size);
+  }
+  if (crc) {
+    writer.WriteString(*crc);
+  }
+  if (version) {
+    writer.WriteInt(*version);
+  }
+
+  return std::make_shared<cache::KeyValueCache::ValueType>(writer.Release());
+}
+
+cache::KeyValueCache::ValueTypePtr Serialize(
+    const std::vector<std::string>& partition_ids) {
+  Writer writer(kPartitionIds, partition_ids.size() * 8u);
+  writer.WriteVarint(partition_ids.size());
+
+  const std::string* previous = nullptr;
+  for (const auto& partition_id : partition_ids) {
+    size_t prefix = 0u;
+    if (previous) {
+      prefix = std::mismatch(partition_id.begin(),
+                             partition_id.begin() +
+                                 std::min(partition_id.size(),
+                                          previous->size()),
+                             previous->begin())
+                   .first -
+               partition_id.begin();
+    }
+
+    writer.WriteVarint(prefix);
+    writer.WriteString(partition_id, prefix);
+    previous = &partition_id;
+  }
+
+  return std::make_shared<cache::KeyValueCache::ValueType>(writer.Release());
+}
+
+std::string Serialize(const model::LayerVersions& layer_versions) {
+  const auto& versions = layer_versions.GetLayerVersions();
+
+  Writer writer(kLayerVersions, versions.size() * 24u);
+  writer.WriteInt(layer_versions.GetVersion());
+  writer.WriteVarint(versions.size());
+  for (const auto& version : versions) {
+    writer.WriteString(version.GetLayer());
+    writer.WriteInt(version.GetVersion());
+    writer.WriteInt(version.GetTimestamp());
+  }
+
+  const auto buffer = writer.Release();
+  return std::string(buffer.begin(), buffer.end());
+}
+
+bool Parse(const cache::KeyValueCache::ValueTypePtr& value,
+           model::Partition& partition) {
+  if (!value) {
+    return false;
+  }
+
+  if (!IsBinary(value->data(), value->size())) {
+    partition = parser::parse<model::Partition>(value);
+    return true;
+  }
+
+  Reader reader(value->data(), value->size());
+  return reader.ReadHeader(kPartition) && ReadPartition(reader, partition) &&
+         reader.IsEnd();
+}
+
+bool Parse(const cache::KeyValueCache::ValueTypePtr& value,
+           std::vector<std::string>& partition_ids) {
+  if (!value) {
+    return false;
+  }
+
+  if (!IsBinary(value->data(), value->size())) {
+    partition_ids = parser::parse<std::vector<std::string>>(value);
+    return true;
+  }
+
+  Reader reader(value->data(), value->size());
+  std::uint64_t count = 0u;
+  if (!reader.ReadHeader(kPartitionIds) || !reader.ReadVarint(count) ||
+      count > value->size()) {
+    return false;
+  }
+
+  partition_ids.clear();
+  partition_ids.reserve(count);
+  for (auto i = 0u; i < count; ++i) {
+    std::uint64_t prefix = 0u;
+    if (!reader.ReadVarint(prefix) ||
+        prefix > (i > 0u ? partition_ids.back().size() : 0u)) {
+      return false;
+    }
+
+    std::string partition_id =
+        i > 0u ? partition_ids.back().substr(0, prefix) : std::string();
+    if (!reader.ReadString(partition_id, prefix)) {
+      return false;
+    }
+    partition_ids.push_back(std::move(partition_id));
+  }
+
+  return reader.IsEnd();
+}
+
+bool Parse(const std::string& value, model::LayerVersions& layer_versions) {
+  const auto data = reinterpret_cast<const unsigned char*>(value.data());
+  if (!IsBinary(data, value.size())) {
+    layer_versions = parser::parse<model::LayerVersions>(value);
+    return true;
+  }
+
+  Reader reader(data, value.size());
+  std::uint64_t count = 0u;
+  if (!reader.ReadHeader(kLayerVersions) ||
+      !reader.ReadInt(layer_versions.GetMutableVersion()) ||
+      !reader.ReadVarint(count) || count > value.size()) {
+    return false;
+  }
+
+  auto& versions = layer_versions.GetMutableLayerVersions();
+  versions.clear();
+  versions.resize(count);
+  for (auto& version : versions) {
+    if (!reader.ReadString(version.GetMutableLayer()) ||
+        !reader.ReadInt(version.GetMutableVersion()) ||
+        !reader.ReadInt(version.GetMutableTimestamp())) {
+      return false;
+    }
+  }
+
+  return reader.IsEnd();
+}
+
+}  // namespace metadata
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
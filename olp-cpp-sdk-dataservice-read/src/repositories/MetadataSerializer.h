@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <olp/core/cache/KeyValueCache.h>
+#include <olp/dataservice/read/model/Partitions.h>
+#include "generated/model/LayerVersions.h"
+
+namespace olp {
+namespace dataservice {
+namespace read {
+namespace repository {
+
+/*
+ * @brief A compact binary encoding of the partition metadata written to the
+ * cache, so the hot metadata reads do not tokenize JSON.
+ *
+ * The encoded values start with a marker byte that can not start a JSON
+ * document, followed by the format version and the value type. The integers
+ * are written as varints, the partition IDs of a list share the common prefix
+ * with the previous ID. The parse functions accept the JSON values written by
+ * the previous SDK versions as well.
+ */
+namespace metadata {
+
+cache::KeyValueCache::ValueTypePtr Serialize(const model::Partition& partition);
+
+cache::KeyValueCache::ValueTypePtr Serialize(
+    const std::vector<std::string>& partition_ids);
+
+std::string Serialize(const model::LayerVersions& layer_versions);
+
+/*
+ * @brief Parses the partition from the binary or the JSON value.
+ *
+ * @return False if the value has the unknown format or is truncated.
+ */
+bool Parse(const cache::KeyValueCache::ValueTypePtr& value,
+           model::Partition& partition);
+
+bool Parse(const cache::KeyValueCache::ValueTypePtr& value,
+           std::vector<std::string>& partition_ids);
+
+bool Parse(const std::string& value, model::LayerVersions& layer_versions);
+
+}  // namespace metadata
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
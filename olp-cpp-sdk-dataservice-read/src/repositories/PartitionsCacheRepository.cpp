@@ -28,16 +28,7 @@
 #include <olp/core/cache/KeyGenerator.h>
 #include <olp/core/cache/KeyValueCache.h>
 #include <olp/core/logging/Log.h>
-// clang-format off
-#include "generated/parser/PartitionsParser.h"
-#include "generated/parser/LayerVersionsParser.h"
-#include "JsonResultParser.h"
-#include <olp/core/generated/parser/JsonParser.h>
-#include <olp/core/generated/serializer/SerializerWrapper.h>
-#include "generated/serializer/PartitionsSerializer.h"
-#include "generated/serializer/LayerVersionsSerializer.h"
-#include "generated/serializer/JsonSerializer.h"
-// clang-format on
+#include "MetadataSerializer.h"
 
 namespace {
 constexpr auto kLogTag = "PartitionsCacheRepository";
@@ -57,51 +48,99 @@ namespace repository {
 PartitionsCacheRepository::PartitionsCacheRepository(
     const client::HRN& catalog, const std::string& layer_id,
     std::shared_ptr<cache::KeyValueCache> cache,
-    std::chrono::seconds default_expiry)
+    std::chrono::seconds default_expiry,
+    std::shared_ptr<DecodedPartitions> decoded_partitions)
     : catalog_(catalog.ToCatalogHRNString()),
       layer_id_(layer_id),
       cache_(std::move(cache)),
-      default_expiry_(ConvertTime(default_expiry)) {}
+      default_expiry_(ConvertTime(default_expiry)),
+      validators_(cache_, default_expiry_),
+      decoded_partitions_(std::move(decoded_partitions)) {}
 
 client::ApiNoResponse PartitionsCacheRepository::Put(
     const model::Partitions& partitions,
     const boost::optional<int64_t>& version,
     const boost::optional<time_t>& expiry, bool layer_metadata) {
+  if (!layer_metadata) {
+    return WritePartitions(partitions, version, expiry, nullptr);
+  }
+
   const auto& partitions_list = partitions.GetPartitions();
   std::vector<std::string> partition_ids;
   partition_ids.reserve(partitions_list.size());
+  for (const auto& partition : partitions_list) {
+    partition_ids.push_back(partition.GetPartition());
+  }
+
+  return WritePartitions(partitions, version, expiry, &partition_ids);
+}
+
+client::ApiNoResponse PartitionsCacheRepository::Put(
+    const model::Partitions& partitions,
+    const boost::optional<int64_t>& version,
+    const boost::optional<time_t>& expiry,
+    const std::vector<std::string>& layer_partition_ids) {
+  return WritePartitions(partitions, version, expiry, &layer_partition_ids);
+}
+
+client::ApiNoResponse PartitionsCacheRepository::Put(
+    const model::Partitions& partitions,
+    const boost::optional<int64_t>& version, const std::string& etag) {
+  return WritePartitions(partitions, version, validators_.ResponseExpiry(etag),
+                         nullptr, etag);
+}
+
+client::ApiNoResponse PartitionsCacheRepository::WritePartitions(
+    const model::Partitions& partitions,
+    const boost::optional<int64_t>& version,
+    const boost::optional<time_t>& expiry,
+    const std::vector<std::string>* layer_partition_ids,
+    const std::string& etag) {
+  const auto& partitions_list = partitions.GetPartitions();
+
+  // All the partitions and their validators are written with one cache write,
+  // the partitions go first
+  const auto items_per_partition = validators_.IsEnabled() ? 2u : 1u;
+  cache::KeyValueCache::KeyValueListType items;
+  items.reserve(items_per_partition * partitions_list.size() + 1u);
 
   for (const auto& partition : partitions_list) {
-    const auto key = cache::KeyGenerator::CreatePartitionKey(
+    auto key = cache::KeyGenerator::CreatePartitionKey(
         catalog_, layer_id_, partition.GetPartition(), version);
     OLP_SDK_LOG_TRACE_F(kLogTag, "Put -> '%s'", key.c_str());
 
-    const auto put_result =
-        cache_->Write(key, serializer::serialize_bytes(partition),
-                      expiry.get_value_or(default_expiry_));
-
-    if (!put_result) {
-      OLP_SDK_LOG_ERROR_F(kLogTag, "Failed to write -> '%s'", key.c_str());
-      return put_result.GetError();
-    }
+    items.emplace_back(std::move(key), metadata::Serialize(partition));
+  }
 
-    if (layer_metadata) {
-      partition_ids.push_back(partition.GetPartition());
-    }
+  for (auto i = 0u; i < partitions_list.size(); ++i) {
+    // A copy, as the validator is appended to the same items
+    const auto key = items[i].first;
+    validators_.Add(key, etag, items);
   }
 
-  if (layer_metadata) {
-    const auto key =
+  if (layer_partition_ids) {
+    auto key =
         cache::KeyGenerator::CreatePartitionsKey(catalog_, layer_id_, version);
     OLP_SDK_LOG_TRACE_F(kLogTag, "Put -> '%s'", key.c_str());
 
-    const auto put_result =
-        cache_->Write(key, serializer::serialize_bytes(partition_ids),
-                      expiry.get_value_or(default_expiry_));
+    items.emplace_back(std::move(key),
+                       metadata::Serialize(*layer_partition_ids));
+  }
+
+  const auto put_result =
+      cache_->WriteBatch(items, expiry.get_value_or(default_expiry_));
+
+  if (!put_result) {
+    OLP_SDK_LOG_ERROR_F(kLogTag, "Failed to write %zu partitions",
+                        partitions_list.size());
+    return put_result.GetError();
+  }
 
-    if (!put_result) {
-      OLP_SDK_LOG_ERROR_F(kLogTag, "Failed to write -> '%s'", key.c_str());
-      return put_result.GetError();
+  if (decoded_partitions_ && version) {
+    for (auto i = 0u; i < partitions_list.size(); ++i) {
+      decoded_partitions_->Put(
+          items[i].first,
+          std::make_shared<model::Partition>(partitions_list[i]));
     }
   }
 
@@ -115,16 +154,52 @@ model::Partitions PartitionsCacheRepository::Get(
   auto& cached_partitions = cached_partitions_model.GetMutablePartitions();
   cached_partitions.reserve(partition_ids.size());
 
+  cache::KeyValueCache::KeyListType keys;
+  keys.reserve(partition_ids.size());
+
   for (const auto& partition_id : partition_ids) {
-    const auto key = cache::KeyGenerator::CreatePartitionKey(
-        catalog_, layer_id_, partition_id, version);
-    OLP_SDK_LOG_TRACE_F(kLogTag, "Get '%s'", key.c_str());
+    keys.push_back(cache::KeyGenerator::CreatePartitionKey(
+        catalog_, layer_id_, partition_id, version));
+    OLP_SDK_LOG_TRACE_F(kLogTag, "Get '%s'", keys.back().c_str());
+  }
 
-    auto read_response = cache_->Read(key);
+  const auto stale = validators_.IsStale(keys);
+
+  // The decoded partitions are used first, only the rest is read and parsed
+  std::vector<DecodedPartitions::ValuePtr> found(keys.size());
+  cache::KeyValueCache::KeyListType missing_keys;
+  std::vector<std::size_t> missing_indexes;
+  for (auto i = 0u; i < keys.size(); ++i) {
+    if (i < stale.size() && stale[i]) {
+      continue;
+    }
+
+    found[i] = GetDecoded(keys[i], version);
+    if (!found[i]) {
+      missing_keys.push_back(keys[i]);
+      missing_indexes.push_back(i);
+    }
+  }
+
+  if (!missing_keys.empty()) {
+    auto read_response = cache_->ReadBatch(missing_keys);
     if (read_response) {
-      auto partition =
-          parser::parse<model::Partition>(read_response.GetResult());
-      cached_partitions.emplace_back(std::move(partition));
+      const auto& values = read_response.GetResult();
+      for (auto i = 0u; i < values.size(); ++i) {
+        auto partition = std::make_shared<model::Partition>();
+        if (metadata::Parse(values[i], *partition)) {
+          if (decoded_partitions_ && version) {
+            decoded_partitions_->Put(missing_keys[i], partition);
+          }
+          found[missing_indexes[i]] = std::move(partition);
+        }
+      }
+    }
+  }
+
+  for (const auto& partition : found) {
+    if (partition) {
+      cached_partitions.emplace_back(*partition);
     }
   }
 
@@ -141,9 +216,9 @@ boost::optional<model::Partitions> PartitionsCacheRepository::Get(
 
   if (partition_ids.empty()) {
     auto read_response = cache_->Read(key);
-    if (read_response) {
-      const auto cached_ids =
-          parser::parse<std::vector<std::string>>(read_response.GetResult());
+    std::vector<std::string> cached_ids;
+    if (read_response &&
+        metadata::Parse(read_response.GetResult(), cached_ids)) {
       partitions = Get(cached_ids, version);
     } else {
       partitions = boost::none;
@@ -162,6 +237,20 @@ boost::optional<model::Partitions> PartitionsCacheRepository::Get(
   return partitions;
 }
 
+boost::optional<CacheValidator> PartitionsCacheRepository::GetValidator(
+    const std::string& partition_id, const boost::optional<int64_t>& version) {
+  return validators_.Get(cache::KeyGenerator::CreatePartitionKey(
+      catalog_, layer_id_, partition_id, version));
+}
+
+bool PartitionsCacheRepository::RefreshValidator(
+    const std::string& partition_id, const boost::optional<int64_t>& version,
+    const CacheValidator& validator) {
+  return validators_.Refresh(cache::KeyGenerator::CreatePartitionKey(
+                                 catalog_, layer_id_, partition_id, version),
+                             validator);
+}
+
 bool PartitionsCacheRepository::Put(
     int64_t catalog_version, const model::LayerVersions& layer_versions) {
   const auto key =
@@ -169,7 +258,7 @@ bool PartitionsCacheRepository::Put(
   OLP_SDK_LOG_TRACE_F(kLogTag, "Put -> '%s'", key.c_str());
 
   return cache_->Put(key, layer_versions,
-                     [&]() { return serializer::serialize(layer_versions); },
+                     [&]() { return metadata::Serialize(layer_versions); },
                      default_expiry_);
 }
 
@@ -180,8 +269,12 @@ boost::optional<model::LayerVersions> PartitionsCacheRepository::Get(
   OLP_SDK_LOG_TRACE_F(kLogTag, "Get -> '%s'", key.c_str());
 
   auto cached_layer_versions =
-      cache_->Get(key, [](const std::string& serialized_object) {
-        return parser::parse<model::LayerVersions>(serialized_object);
+      cache_->Get(key, [](const std::string& serialized_object) -> boost::any {
+        model::LayerVersions layer_versions;
+        if (!metadata::Parse(serialized_object, layer_versions)) {
+          return {};
+        }
+        return layer_versions;
       });
 
   if (cached_layer_versions.empty()) {
@@ -235,6 +328,9 @@ bool PartitionsCacheRepository::Get(geo::TileKey tile_key, int32_t depth,
 bool PartitionsCacheRepository::Clear() {
   auto key = catalog_ + "::" + layer_id_ + "::";
   OLP_SDK_LOG_INFO_F(kLogTag, "Clear -> '%s'", key.c_str());
+  if (decoded_partitions_) {
+    decoded_partitions_->RemoveKeysWithPrefix(key);
+  }
   return cache_->RemoveKeysWithPrefix(key);
 }
 
@@ -250,9 +346,12 @@ bool PartitionsCacheRepository::ClearPartitions(
     passed = cache_->RemoveKeysWithPrefix(catalog_ + "::" + layer_id_ +
                                           "::" + partition.GetDataHandle()) &&
              passed;
-    passed = cache_->RemoveKeysWithPrefix(catalog_ + "::" + layer_id_ +
-                                          "::" + partition.GetPartition()) &&
-             passed;
+    const auto partition_prefix =
+        catalog_ + "::" + layer_id_ + "::" + partition.GetPartition();
+    if (decoded_partitions_) {
+      decoded_partitions_->RemoveKeysWithPrefix(partition_prefix);
+    }
+    passed = cache_->RemoveKeysWithPrefix(partition_prefix) && passed;
   }
 
   return passed;
@@ -283,7 +382,13 @@ client::ApiNoResponse PartitionsCacheRepository::ClearPartitionMetadata(
     return client::ApiNoResponse{read_response.GetError()};
   }
 
-  out_partition = parser::parse<model::Partition>(read_response.GetResult());
+  model::Partition partition;
+  if (metadata::Parse(read_response.GetResult(), partition)) {
+    out_partition = std::move(partition);
+  }
+  if (decoded_partitions_) {
+    decoded_partitions_->RemoveKeysWithPrefix(key);
+  }
   return cache_->DeleteByPrefix(key);
 }
 
@@ -294,11 +399,18 @@ bool PartitionsCacheRepository::GetPartitionHandle(
       catalog_, layer_id_, partition_id, catalog_version);
   OLP_SDK_LOG_TRACE_F(kLogTag, "IsPartitionCached -> '%s'", key.c_str());
 
+  const auto decoded_partition = GetDecoded(key, catalog_version);
+  if (decoded_partition) {
+    data_handle = decoded_partition->GetDataHandle();
+    return true;
+  }
+
   auto read_response = cache_->Read(key);
-  if (!read_response) {
+  model::Partition partition;
+  if (!read_response ||
+      !metadata::Parse(read_response.GetResult(), partition)) {
     return false;
   }
-  auto partition = parser::parse<model::Partition>(read_response.GetResult());
   data_handle = std::move(partition.GetMutableDataHandle());
   return true;
 }
@@ -333,6 +445,28 @@ bool PartitionsCacheRepository::ContainsTree(
       catalog_, layer_id_, key, version, depth));
 }
 
+DecodedPartitions::ValuePtr PartitionsCacheRepository::GetDecoded(
+    const std::string& key, const boost::optional<int64_t>& version) {
+  if (!decoded_partitions_ || !version) {
+    return nullptr;
+  }
+
+  auto partition = decoded_partitions_->Get(key);
+  if (!partition) {
+    return nullptr;
+  }
+
+  // Expired or removed from the byte cache, i.e. by the eviction
+  if (!cache_->Contains(key)) {
+    decoded_partitions_->Remove(key);
+    return nullptr;
+  }
+
+  // Contains does not promote the key, the hit counts as a read
+  cache_->Promote(key);
+  return partition;
+}
+
 cache::KeyValueCache::KeyListType
 PartitionsCacheRepository::CreatePartitionKeys(
     const std::string& partition_id, const boost::optional<int64_t>& version) {
@@ -27,7 +27,9 @@
 #include <olp/dataservice/read/PartitionsRequest.h>
 #include <olp/dataservice/read/model/Partitions.h>
 #include <boost/optional.hpp>
+#include "DecodedObjectCache.h"
 #include "QuadTreeIndex.h"
+#include "ValidatorCacheRepository.h"
 #include "generated/model/LayerVersions.h"
 
 namespace olp {
@@ -38,12 +40,16 @@ namespace dataservice {
 namespace read {
 namespace repository {
 
+/// The decoded partitions, kept only for the versioned layers.
+using DecodedPartitions = DecodedObjectCache<model::Partition>;
+
 class PartitionsCacheRepository final {
  public:
   PartitionsCacheRepository(
       const client::HRN& catalog, const std::string& layer_id,
       std::shared_ptr<cache::KeyValueCache> cache,
-      std::chrono::seconds default_expiry = std::chrono::seconds::max());
+      std::chrono::seconds default_expiry = std::chrono::seconds::max(),
+      std::shared_ptr<DecodedPartitions> decoded_partitions = nullptr);
 
   ~PartitionsCacheRepository() = default;
 
@@ -52,9 +58,33 @@ class PartitionsCacheRepository final {
                             const boost::optional<time_t>& expiry,
                             bool layer_metadata = false);
 
+  /// Writes the partitions together with the list of all the layer
+  /// partitions. Used for the last batch of the layer metadata written in
+  /// batches, so the list is in the cache only when all the partitions are.
+  client::ApiNoResponse Put(
+      const model::Partitions& partitions,
+      const boost::optional<int64_t>& version,
+      const boost::optional<time_t>& expiry,
+      const std::vector<std::string>& layer_partition_ids);
+
+  /// Writes the partitions received with an ETag, so they are revalidated
+  /// when expired instead of being downloaded again.
+  client::ApiNoResponse Put(const model::Partitions& partitions,
+                            const boost::optional<int64_t>& version,
+                            const std::string& etag);
+
+  /// Returns the cached partitions, except the ones that need to be
+  /// revalidated.
   model::Partitions Get(const std::vector<std::string>& partition_ids,
                         const boost::optional<int64_t>& version);
 
+  boost::optional<CacheValidator> GetValidator(
+      const std::string& partition_id, const boost::optional<int64_t>& version);
+
+  bool RefreshValidator(const std::string& partition_id,
+                        const boost::optional<int64_t>& version,
+                        const CacheValidator& validator);
+
   boost::optional<model::Partitions> Get(
       const PartitionsRequest& request,
       const boost::optional<int64_t>& version);
@@ -100,6 +130,17 @@ class PartitionsCacheRepository final {
                const boost::optional<int64_t>& version);
 
  private:
+  client::ApiNoResponse WritePartitions(
+      const model::Partitions& partitions,
+      const boost::optional<int64_t>& version,
+      const boost::optional<time_t>& expiry,
+      const std::vector<std::string>* layer_partition_ids,
+      const std::string& etag = std::string());
+
+  /// Gets the decoded partition, if the partition is still in the cache.
+  DecodedPartitions::ValuePtr GetDecoded(
+      const std::string& key, const boost::optional<int64_t>& version);
+
   cache::KeyValueCache::KeyListType CreatePartitionKeys(
       const std::string& partition_id, const boost::optional<int64_t>& version);
 
@@ -107,6 +148,8 @@ class PartitionsCacheRepository final {
   const std::string layer_id_;
   std::shared_ptr<cache::KeyValueCache> cache_;
   time_t default_expiry_;
+  ValidatorCacheRepository validators_;
+  std::shared_ptr<DecodedPartitions> decoded_partitions_;
 };
 }  // namespace repository
 }  // namespace read
@@ -20,11 +20,17 @@
 #include "PartitionsRepository.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
 #include <utility>
 
 #include <olp/core/cache/KeyGenerator.h>
 #include <olp/core/client/Condition.h>
 #include <olp/core/logging/Log.h>
+#include <olp/core/thread/TaskScheduler.h>
 #include <boost/functional/hash.hpp>
 #include "CatalogRepository.h"
 #include "generated/api/MetadataApi.h"
@@ -46,6 +52,7 @@ namespace repository = olp::dataservice::read::repository;
 constexpr auto kLogTag = "PartitionsRepository";
 constexpr auto kAggregateQuadTreeDepth = 4;
 constexpr auto kQueryRequestLimit = 100;
+constexpr size_t kCacheWriteBatchSize = 1000u;
 
 using LayerVersionReponse = client::ApiResponse<int64_t, client::ApiError>;
 using LayerVersionCallback = std::function<void(LayerVersionReponse)>;
@@ -170,6 +177,79 @@ bool CheckAdditionalFields(
 
   return true;
 }
+
+olp::http::Network::DataCallback StreamDataCallback(
+    std::shared_ptr<repository::AsyncJsonStream> async_stream) {
+  return [=](const std::uint8_t* data, std::uint64_t offset,
+             std::size_t length) mutable {
+    const char* json_chunk = reinterpret_cast<const char*>(data);
+    if (!offset) {
+      // TODO: we can use ranges to avoid reseting the stream, instead continue
+      // download from the last offset + length.
+      async_stream->ResetStream(json_chunk, length);
+    } else {
+      async_stream->AppendContent(json_chunk, length);
+    }
+  };
+}
+
+/// The state of the layer metadata download, shared with the network
+/// callback.
+struct MetadataDownload {
+  std::mutex mutex;
+  client::NetworkStatistics network_statistics;
+};
+
+/// The state of the partition batches queried in parallel, shared with the
+/// scheduled tasks.
+struct QueryBatchesState {
+  using QueryBatch = std::function<read::QueryApi::PartitionsExtendedResponse(
+      const read::PartitionsRequest::PartitionIds&,
+      client::CancellationContext)>;
+
+  QueryBatch query;
+  std::vector<read::PartitionsRequest::PartitionIds> batches;
+  std::vector<read::QueryApi::PartitionsExtendedResponse> responses;
+  // The contexts of the workers, cancelled together on the first failed
+  // batch or when the request is cancelled.
+  std::vector<client::CancellationContext> contexts;
+  boost::optional<client::ApiError> error;
+  size_t next_batch{0u};
+  size_t batches_in_progress{0u};
+  std::mutex mutex;
+  std::condition_variable condition;
+};
+
+void CancelQueryBatches(QueryBatchesState& state) {
+  for (auto& context : state.contexts) {
+    context.CancelOperation();
+  }
+}
+
+/// Queries the batches not taken by other workers until the first error.
+void ProcessQueryBatches(const std::shared_ptr<QueryBatchesState>& state,
+                         size_t worker) {
+  auto& context = state->contexts[worker];
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  while (state->next_batch < state->batches.size() && !state->error &&
+         !context.IsCancelled()) {
+    const auto index = state->next_batch++;
+    ++state->batches_in_progress;
+    lock.unlock();
+
+    auto response = state->query(state->batches[index], context);
+
+    lock.lock();
+    --state->batches_in_progress;
+    if (!response && !state->error) {
+      state->error = response.GetError();
+      CancelQueryBatches(*state);
+    }
+    state->responses[index] = std::move(response);
+    state->condition.notify_all();
+  }
+}
 }  // namespace
 
 namespace olp {
@@ -179,13 +259,15 @@ namespace repository {
 
 PartitionsRepository::PartitionsRepository(
     client::HRN catalog, std::string layer, client::OlpClientSettings settings,
-    const client::ApiLookupClient& client, NamedMutexStorage storage)
+    const client::ApiLookupClient& client, NamedMutexStorage storage,
+    std::shared_ptr<DecodedPartitions> decoded_partitions)
     : catalog_(std::move(catalog)),
       layer_id_(std::move(layer)),
       settings_(std::move(settings)),
       lookup_client_(client),
       cache_(catalog_, layer_id_, settings_.cache,
-             settings_.default_cache_expiration),
+             settings_.default_cache_expiration,
+             std::move(decoded_partitions)),
       storage_(std::move(storage)) {}
 
 QueryApi::PartitionsExtendedResponse
@@ -196,6 +278,62 @@ PartitionsRepository::GetVersionedPartitionsExtendedResponse(
                                        boost::none, fail_on_cache_error);
 }
 
+QueryApi::PartitionsExtendedResponse
+PartitionsRepository::GetVersionedPartitionsBatch(
+    const std::vector<std::string>& partition_ids, std::int64_t version,
+    FetchOptions fetch_option, const boost::optional<std::string>& billing_tag,
+    client::CancellationContext context, const bool fail_on_cache_error) {
+  model::Partitions cached_partitions;
+  if (fetch_option != OnlineOnly && fetch_option != CacheWithUpdate) {
+    cached_partitions = cache_.Get(partition_ids, version);
+  }
+
+  std::unordered_set<std::string> cached_ids;
+  for (const auto& partition : cached_partitions.GetPartitions()) {
+    cached_ids.insert(partition.GetPartition());
+  }
+
+  std::vector<std::string> missing_ids;
+  for (const auto& partition_id : partition_ids) {
+    if (cached_ids.find(partition_id) == cached_ids.end()) {
+      missing_ids.push_back(partition_id);
+    }
+  }
+
+  if (missing_ids.empty() || fetch_option == CacheOnly) {
+    return cached_partitions;
+  }
+
+  OLP_SDK_LOG_DEBUG_F(kLogTag,
+                      "GetVersionedPartitionsBatch, hrn='%s', layer='%s', "
+                      "cached=%zu, missing=%zu",
+                      catalog_.ToCatalogHRNString().c_str(), layer_id_.c_str(),
+                      cached_ids.size(), missing_ids.size());
+
+  auto request = PartitionsRequest()
+                     .WithPartitionIds(std::move(missing_ids))
+                     .WithBillingTag(billing_tag)
+                     .WithFetchOption(fetch_option)
+                     .WithAdditionalFields({PartitionsRequest::kChecksum,
+                                            PartitionsRequest::kCrc,
+                                            PartitionsRequest::kDataSize});
+
+  auto response = GetVersionedPartitionsExtendedResponse(
+      request, version, std::move(context), fail_on_cache_error);
+  if (!response) {
+    return response;
+  }
+
+  auto network_statistics = response.GetPayload();
+  auto result = response.MoveResult();
+  auto& partitions = result.GetMutablePartitions();
+  auto& cached = cached_partitions.GetMutablePartitions();
+  partitions.insert(partitions.end(), std::make_move_iterator(cached.begin()),
+                    std::make_move_iterator(cached.end()));
+
+  return {std::move(result), network_statistics};
+}
+
 PartitionsResponse PartitionsRepository::GetVolatilePartitions(
     const PartitionsRequest& request,
     const client::CancellationContext& context) {
@@ -274,10 +412,25 @@ PartitionsRepository::GetPartitionsExtendedResponse(
       return metadata_api.GetError();
     }
 
-    response =
-        MetadataApi::GetPartitions(metadata_api.GetResult(), layer_id_, version,
-                                   request.GetAdditionalFields(), boost::none,
-                                   request.GetBillingTag(), context);
+    // The layer metadata is parsed and cached while it is downloaded. Only
+    // the partitions returned to the caller are collected.
+    model::Partitions partitions;
+    auto& layer_partitions = partitions.GetMutablePartitions();
+    auto stream_response = StreamLayerMetadata(
+        metadata_api.GetResult(), request, version, expiry,
+        fetch_option != OnlineOnly, fail_on_cache_error,
+        [&](std::vector<model::Partition> batch) {
+          std::move(batch.begin(), batch.end(),
+                    std::back_inserter(layer_partitions));
+        },
+        [&]() { layer_partitions.clear(); }, context);
+
+    response = stream_response
+                   ? QueryApi::PartitionsExtendedResponse(
+                         std::move(partitions), stream_response.GetPayload())
+                   : QueryApi::PartitionsExtendedResponse(
+                         stream_response.GetError(),
+                         stream_response.GetPayload());
   } else {
     auto query_api = lookup_client_.LookupApi(
         "query", "v1", static_cast<client::FetchOptions>(fetch_option),
@@ -294,17 +447,18 @@ PartitionsRepository::GetPartitionsExtendedResponse(
     } else {
       response = QueryPartitionsInBatches(
           query_api.GetResult(), partition_ids, version,
-          request.GetAdditionalFields(), request.GetBillingTag(), context);
+          request.GetAdditionalFields(), request.GetBillingTag(),
+          request.GetMaxParallelQueries(), context);
     }
   }
-  // Save all partitions only when downloaded via metadata API
+  // The layer metadata is already in the cache
   const bool is_layer_metadata = partition_ids.empty();
-  if (response.IsSuccessful() && fetch_option != OnlineOnly) {
+  if (response.IsSuccessful() && fetch_option != OnlineOnly &&
+      !is_layer_metadata) {
     OLP_SDK_LOG_TRACE_F(kLogTag,
                         "GetPartitions put to cache, hrn='%s', key='%s'",
                         catalog_str.c_str(), key.c_str());
-    const auto put_result =
-        cache_.Put(response.GetResult(), version, expiry, is_layer_metadata);
+    const auto put_result = cache_.Put(response.GetResult(), version, expiry);
     if (!put_result.IsSuccessful() && fail_on_cache_error) {
       OLP_SDK_LOG_ERROR_F(kLogTag,
                           "Failed to write data to cache, hrn='%s', key='%s'",
@@ -376,16 +530,55 @@ PartitionsResponse PartitionsRepository::GetPartitionById(
 
   const client::OlpClient& client = query_api.GetResult();
 
-  PartitionsResponse query_response =
-      QueryApi::GetPartitionsbyId(client, layer_id_, partitions, version, {},
-                                  request.GetBillingTag(), context);
+  // The expired partition is revalidated, so it is not downloaded again when
+  // not modified.
+  ConditionalRequest conditional;
+  boost::optional<CacheValidator> validator;
+  if (fetch_option != OnlineOnly) {
+    validator = cache_.GetValidator(partition_id.value(), version);
+  }
+  if (validator) {
+    conditional.if_none_match = validator->etag;
+  }
+
+  PartitionsResponse query_response = QueryApi::GetPartitionsbyId(
+      client, layer_id_, partitions, version, {}, request.GetBillingTag(),
+      context, &conditional);
+
+  if (validator && !query_response.IsSuccessful() &&
+      query_response.GetError().GetHttpStatusCode() ==
+          http::HttpStatusCode::NOT_MODIFIED) {
+    cache_.RefreshValidator(partition_id.value(), version, *validator);
+    auto cached_partitions = cache_.Get(partitions, version);
+    if (cached_partitions.GetPartitions().size() == partitions.size()) {
+      OLP_SDK_LOG_TRACE_F(kLogTag,
+                          "GetPartitionById not modified, hrn='%s', key='%s'",
+                          catalog_.ToCatalogHRNString().c_str(), key.c_str());
+      return PartitionsResponse(std::move(cached_partitions),
+                                query_response.GetPayload());
+    }
+
+    // The partition is evicted meanwhile, download it again
+    auto network_statistics = query_response.GetPayload();
+    conditional.if_none_match.clear();
+    query_response = QueryApi::GetPartitionsbyId(
+        client, layer_id_, partitions, version, {}, request.GetBillingTag(),
+        context, &conditional);
+    network_statistics += query_response.GetPayload();
+    query_response =
+        query_response.IsSuccessful()
+            ? PartitionsResponse(query_response.MoveResult(),
+                                 network_statistics)
+            : PartitionsResponse(query_response.GetError(),
+                                 network_statistics);
+  }
 
   if (query_response.IsSuccessful() && fetch_option != OnlineOnly) {
     OLP_SDK_LOG_TRACE_F(kLogTag,
                         "GetPartitionById put to cache, hrn='%s', key='%s'",
                         catalog_.ToCatalogHRNString().c_str(), key.c_str());
     const auto put_result =
-        cache_.Put(query_response.GetResult(), version, boost::none);
+        cache_.Put(query_response.GetResult(), version, conditional.etag);
     if (!put_result.IsSuccessful()) {
       OLP_SDK_LOG_ERROR_F(kLogTag,
                           "GetPartitionById failed to write data to cache, "
@@ -606,31 +799,66 @@ PartitionsRepository::QueryPartitionsInBatches(
     const PartitionsRequest::PartitionIds& partition_ids,
     boost::optional<std::int64_t> version,
     const PartitionsRequest::AdditionalFields& additional_fields,
-    boost::optional<std::string> billing_tag,
+    boost::optional<std::string> billing_tag, size_t max_parallel_queries,
     client::CancellationContext context) {
+  auto state = std::make_shared<QueryBatchesState>();
+
+  for (size_t i = 0; i < partition_ids.size(); i += kQueryRequestLimit) {
+    state->batches.emplace_back(
+        partition_ids.begin() + i,
+        partition_ids.begin() +
+            std::min(partition_ids.size(), i + kQueryRequestLimit));
+  }
+
+  const auto parallel_queries = std::min(
+      std::max<size_t>(max_parallel_queries, 1u), state->batches.size());
+
+  state->responses.resize(state->batches.size());
+  state->contexts.resize(parallel_queries);
+  const auto& layer_id = layer_id_;
+  state->query = [=](const PartitionsRequest::PartitionIds& batch,
+                     client::CancellationContext batch_context) {
+    return QueryApi::GetPartitionsbyId(client, layer_id, batch, version,
+                                       additional_fields, billing_tag,
+                                       batch_context);
+  };
+
+  if (!context.ExecuteOrCancelled([&]() {
+        return client::CancellationToken(
+            [state]() { CancelQueryBatches(*state); });
+      })) {
+    return client::ApiError::Cancelled();
+  }
+
+  // The current thread takes part in the querying, so the batches are
+  // processed even when all the scheduler threads are busy.
+  for (size_t worker = 1u; worker < parallel_queries; ++worker) {
+    thread::ExecuteOrSchedule(settings_.task_scheduler, [state, worker]() {
+      ProcessQueryBatches(state, worker);
+    });
+  }
+  ProcessQueryBatches(state, 0u);
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  // The workers scheduled too late find no batches left and are not awaited
+  state->condition.wait(lock,
+                        [&]() { return state->batches_in_progress == 0u; });
+
+  if (state->error) {
+    return *state->error;
+  }
+
+  // Cancelled before all the batches are taken
+  if (state->next_batch < state->batches.size()) {
+    return client::ApiError::Cancelled();
+  }
+
   std::vector<model::Partition> aggregated_partitions;
   aggregated_partitions.reserve(partition_ids.size());
 
   client::NetworkStatistics aggregated_network_statistics;
 
-  PartitionsRequest::PartitionIds batch;
-  batch.reserve(kQueryRequestLimit);
-
-  for (size_t i = 0; i < partition_ids.size(); i += kQueryRequestLimit) {
-    batch.clear();
-
-    std::copy(partition_ids.begin() + i,
-              partition_ids.begin() +
-                  std::min(partition_ids.size(), i + kQueryRequestLimit),
-              std::back_inserter(batch));
-
-    auto query_response =
-        QueryApi::GetPartitionsbyId(client, layer_id_, batch, version,
-                                    additional_fields, billing_tag, context);
-    if (!query_response) {
-      return query_response.GetError();
-    }
-
+  for (auto& query_response : state->responses) {
     auto partitions = query_response.MoveResult();
     auto& mutable_partitions = partitions.GetMutablePartitions();
     std::move(mutable_partitions.begin(), mutable_partitions.end(),
@@ -648,11 +876,17 @@ PartitionsRepository::QueryPartitionsInBatches(
 client::ApiNoResponse PartitionsRepository::ParsePartitionsStream(
     const std::shared_ptr<AsyncJsonStream>& async_stream,
     const PartitionsStreamCallback& partition_callback,
-    client::CancellationContext context) {
+    client::CancellationContext context,
+    const std::function<void()>& attempt_callback) {
   rapidjson::ParseResult parse_result;
 
   // We must perform at least one attempt to parse.
   do {
+    // The partitions of the previous attempt are parsed again
+    if (attempt_callback) {
+      attempt_callback();
+    }
+
     rapidjson::Reader reader;
     auto partitions_handler =
         std::make_shared<repository::PartitionsSaxHandler>(partition_callback);
@@ -685,6 +919,127 @@ client::ApiNoResponse PartitionsRepository::ParsePartitionsStream(
   }
 }
 
+PartitionsRepository::MetadataStreamResponse
+PartitionsRepository::StreamLayerMetadata(
+    const client::OlpClient& client, const read::PartitionsRequest& request,
+    boost::optional<std::int64_t> version, boost::optional<time_t> expiry,
+    bool write_to_cache, bool fail_on_cache_error,
+    const PartitionsBatchCallback& batch_callback,
+    const std::function<void()>& restart_callback,
+    client::CancellationContext context) {
+  auto async_stream = std::make_shared<AsyncJsonStream>();
+  client::CancellationContext download_context;
+  client::CancellationContext parse_context;
+
+  if (!context.ExecuteOrCancelled([&]() {
+        return client::CancellationToken([=]() mutable {
+          download_context.CancelOperation();
+          parse_context.CancelOperation();
+        });
+      })) {
+    return client::ApiError::Cancelled();
+  }
+
+  model::Partitions batch;
+  auto& batch_partitions = batch.GetMutablePartitions();
+  std::vector<std::string> partition_ids;
+  boost::optional<client::ApiError> cache_error;
+
+  // Only the current batch and the partition ids are kept for the cache
+  auto write_batch = [&](const std::vector<std::string>* layer_partitions) {
+    if (write_to_cache && !cache_error) {
+      auto put_result =
+          layer_partitions
+              ? cache_.Put(batch, version, expiry, *layer_partitions)
+              : cache_.Put(batch, version, expiry);
+      if (!put_result) {
+        cache_error = put_result.GetError();
+      }
+    }
+    batch_callback(std::move(batch_partitions));
+    batch_partitions.clear();
+  };
+
+  auto parse = [&]() {
+    auto response = ParsePartitionsStream(
+        async_stream,
+        [&](model::Partition partition) {
+          if (write_to_cache) {
+            partition_ids.push_back(partition.GetPartition());
+          }
+          batch_partitions.emplace_back(std::move(partition));
+          if (batch_partitions.size() >= kCacheWriteBatchSize) {
+            write_batch(nullptr);
+          }
+        },
+        parse_context,
+        [&]() {
+          batch_partitions.clear();
+          partition_ids.clear();
+          if (restart_callback) {
+            restart_callback();
+          }
+        });
+
+    if (!response) {
+      download_context.CancelOperation();
+    }
+    return response;
+  };
+
+  // The network feeds the stream while this thread parses it, so the parsing
+  // needs no free scheduler thread and only the unparsed chunks are buffered.
+  auto download = std::make_shared<MetadataDownload>();
+  download_context.ExecuteOrCancelled(
+      [&]() {
+        return MetadataApi::GetPartitionsStream(
+            client, layer_id_, version, request.GetAdditionalFields(),
+            request.GetBillingTag(), StreamDataCallback(async_stream),
+            [=](client::HttpResponse http_response) {
+              {
+                std::lock_guard<std::mutex> lock(download->mutex);
+                download->network_statistics =
+                    http_response.GetNetworkStatistics();
+              }
+              async_stream->CloseStream(
+                  http_response.GetStatus() != olp::http::HttpStatusCode::OK
+                      ? boost::make_optional(
+                            client::ApiError(http_response.GetStatus()))
+                      : boost::none);
+            });
+      },
+      [&]() { async_stream->CloseStream(client::ApiError::Cancelled()); });
+
+  const auto parse_response = parse();
+
+  // The successful parsing ends when the download is completed
+  client::NetworkStatistics network_statistics;
+  {
+    std::lock_guard<std::mutex> lock(download->mutex);
+    network_statistics = download->network_statistics;
+  }
+
+  if (!parse_response) {
+    return {parse_response.GetError(), network_statistics};
+  }
+
+  // The list of the layer partitions is written with the last batch
+  write_batch(&partition_ids);
+
+  if (cache_error) {
+    OLP_SDK_LOG_ERROR_F(kLogTag,
+                        "Failed to write layer metadata to cache, hrn='%s', "
+                        "layer='%s'",
+                        catalog_.ToCatalogHRNString().c_str(),
+                        layer_id_.c_str());
+    if (fail_on_cache_error) {
+      return {*cache_error, network_statistics};
+    }
+  }
+
+  return {client::ApiNoResult{}, network_statistics};
+}
+
 void PartitionsRepository::StreamPartitions(
     const std::shared_ptr<AsyncJsonStream>& async_stream, std::int64_t version,
     const std::vector<std::string>& additional_fields,
@@ -697,21 +1052,10 @@ void PartitionsRepository::StreamPartitions(
     return async_stream->CloseStream(metadata_api.GetError());
   }
 
-  auto data_callback = [=](const std::uint8_t* data, std::uint64_t offset,
-                           std::size_t length) mutable {
-    const char* json_chunk = reinterpret_cast<const char*>(data);
-    if (!offset) {
-      // TODO: we can use ranges to avoid reseting the stream, instead continue
-      // download from the last offset + length.
-      async_stream->ResetStream(json_chunk, length);
-    } else {
-      async_stream->AppendContent(json_chunk, length);
-    }
-  };
-
   auto http_response = MetadataApi::GetPartitionsStream(
       metadata_api.GetResult(), layer_id_, version, additional_fields,
-      boost::none, std::move(billing_tag), data_callback, context);
+      boost::none, std::move(billing_tag), StreamDataCallback(async_stream),
+      context);
 
   auto error =
       http_response.GetStatus() != olp::http::HttpStatusCode::OK
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -57,7 +58,9 @@ class PartitionsRepository {
   PartitionsRepository(client::HRN catalog, std::string layer,
                        client::OlpClientSettings settings,
                        const client::ApiLookupClient& client,
-                       NamedMutexStorage storage = NamedMutexStorage());
+                       NamedMutexStorage storage = NamedMutexStorage(),
+                       std::shared_ptr<DecodedPartitions> decoded_partitions =
+                           nullptr);
 
   PartitionsResponse GetVolatilePartitions(
       const read::PartitionsRequest& request,
@@ -67,6 +70,15 @@ class PartitionsRepository {
       const read::PartitionsRequest& request, std::int64_t version,
       client::CancellationContext context, bool fail_on_cache_error = false);
 
+  /// Resolves the partitions by the IDs, only the partitions missing in the
+  /// cache are queried. The partitions not found in the layer are missing in
+  /// the result.
+  QueryApi::PartitionsExtendedResponse GetVersionedPartitionsBatch(
+      const std::vector<std::string>& partition_ids, std::int64_t version,
+      FetchOptions fetch_option,
+      const boost::optional<std::string>& billing_tag,
+      client::CancellationContext context, bool fail_on_cache_error = false);
+
   PartitionsResponse GetPartitionById(const DataRequest& request,
                                       boost::optional<int64_t> version,
                                       client::CancellationContext context);
@@ -86,7 +98,8 @@ class PartitionsRepository {
   client::ApiNoResponse ParsePartitionsStream(
       const std::shared_ptr<AsyncJsonStream>& async_stream,
       const PartitionsStreamCallback& partition_callback,
-      client::CancellationContext context);
+      client::CancellationContext context,
+      const std::function<void()>& attempt_callback = nullptr);
 
   void StreamPartitions(const std::shared_ptr<AsyncJsonStream>& async_stream,
                         std::int64_t version,
@@ -107,12 +120,31 @@ class PartitionsRepository {
       boost::optional<time_t> expiry = boost::none,
       bool fail_on_cache_error = false);
 
+  using MetadataStreamResponse =
+      ExtendedApiResponse<client::ApiNoResult, client::ApiError,
+                          client::NetworkStatistics>;
+  using PartitionsBatchCallback =
+      std::function<void(std::vector<model::Partition>)>;
+
+  /// Downloads the layer metadata and parses it on the calling thread while
+  /// it is received. The parsed partitions are written to the cache and
+  /// passed to the batch callback in batches of bounded size, no batch is
+  /// kept afterwards. The restart callback is called when the download is
+  /// retried, so the partitions are parsed again from the first one.
+  MetadataStreamResponse StreamLayerMetadata(
+      const client::OlpClient& client, const read::PartitionsRequest& request,
+      boost::optional<std::int64_t> version, boost::optional<time_t> expiry,
+      bool write_to_cache, bool fail_on_cache_error,
+      const PartitionsBatchCallback& batch_callback,
+      const std::function<void()>& restart_callback,
+      client::CancellationContext context);
+
   QueryApi::PartitionsExtendedResponse QueryPartitionsInBatches(
       const client::OlpClient& client,
       const PartitionsRequest::PartitionIds& partitions,
       boost::optional<std::int64_t> version,
       const PartitionsRequest::AdditionalFields& additional_fields,
-      boost::optional<std::string> billing_tag,
+      boost::optional<std::string> billing_tag, size_t max_parallel_queries,
       client::CancellationContext context);
 
   const client::HRN catalog_;
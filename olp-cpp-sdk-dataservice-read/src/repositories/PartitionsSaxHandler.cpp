@@ -19,6 +19,9 @@
 
 #include "PartitionsSaxHandler.h"
 
+#include <limits>
+#include <string>
+
 namespace olp {
 namespace dataservice {
 namespace read {
@@ -37,32 +40,39 @@ PartitionsSaxHandler::PartitionsSaxHandler(PartitionCallback partition_callback)
 
 bool PartitionsSaxHandler::StartObject() {
   if (state_ == State::kWaitForRootObject) {
-    state_ = State::kWaitForRootPartitions;
+    state_ = State::kWaitForRootAttribute;
     return continue_parsing_;
   }
 
+  if (IsParsingValue()) {
+    return StartSkippedContainer();
+  }
+
   if (state_ != State::kWaitForNextPartition) {
     return false;
   }
 
+  partition_ = model::Partition();
   state_ = State::kProcessingAttribute;
 
   return continue_parsing_;
 }
 
 bool PartitionsSaxHandler::String(const char* str, unsigned int length, bool) {
+  if (skip_depth_ > 0u) {
+    return continue_parsing_;
+  }
+
   switch (state_) {
     case State::kProcessingAttribute:
       state_ = ProcessNextAttribute(str, length);
       return continue_parsing_;
 
-    case State::kWaitForRootPartitions:
-      if (HashStringToInt("partitions") == HashStringToInt(str)) {
-        state_ = State::kWaitPartitionsArray;
-        return continue_parsing_;
-      } else {
-        return false;
-      }
+    case State::kWaitForRootAttribute:
+      state_ = HashStringToInt("partitions") == HashStringToInt(str)
+                   ? State::kWaitPartitionsArray
+                   : State::kParsingIgnoreRootAttribute;
+      return continue_parsing_;
 
     case State::kParsingPartitionName:
       partition_.SetPartition(std::string(str, length));
@@ -76,42 +86,35 @@ bool PartitionsSaxHandler::String(const char* str, unsigned int length, bool) {
     case State::kParsingCrc:
       partition_.SetCrc(std::string(str, length));
       break;
-    case State::kParsingIgnoreAttribute:
-      break;
 
-    case State::kWaitForRootObject:          // Not expected
-    case State::kWaitForNextPartition:       // Not expected
-    case State::kWaitForRootObjectEnd:       // Not expected
-    case State::kParsingVersion:             // Version is not a string
-    case State::kParsingDataSize:            // DataSize is not a string
-    case State::kParsingCompressedDataSize:  // CompressedDataSize is not a
-                                             // string
     default:
-      return false;
+      break;
   }
 
-  state_ = State::kProcessingAttribute;
-
-  return continue_parsing_;
+  return EndValue();
 }
 
-bool PartitionsSaxHandler::Uint(unsigned int value) {
-  if (state_ == State::kParsingVersion) {
-    partition_.SetVersion(value);
-  } else if (state_ == State::kParsingDataSize) {
-    partition_.SetDataSize(value);
-  } else if (state_ == State::kParsingCompressedDataSize) {
-    partition_.SetCompressedDataSize(value);
-  } else {
-    return false;
-  }
+bool PartitionsSaxHandler::Int(int value) { return Number(value); }
 
-  state_ = State::kProcessingAttribute;
-  return continue_parsing_;
+bool PartitionsSaxHandler::Uint(unsigned int value) { return Number(value); }
+
+bool PartitionsSaxHandler::Int64(std::int64_t value) { return Number(value); }
+
+bool PartitionsSaxHandler::Uint64(std::uint64_t value) {
+  // The values out of the attribute range are skipped
+  if (value > static_cast<std::uint64_t>(
+                  std::numeric_limits<std::int64_t>::max())) {
+    return Default();
+  }
+  return Number(static_cast<std::int64_t>(value));
 }
 
 bool PartitionsSaxHandler::EndObject(unsigned int) {
-  if (state_ == State::kWaitForRootObjectEnd) {
+  if (skip_depth_ > 0u) {
+    return EndSkippedContainer();
+  }
+
+  if (state_ == State::kWaitForRootAttribute) {
     state_ = State::kParsingComplete;
     return true;  // complete
   }
@@ -132,6 +135,10 @@ bool PartitionsSaxHandler::EndObject(unsigned int) {
 }
 
 bool PartitionsSaxHandler::StartArray() {
+  if (IsParsingValue()) {
+    return StartSkippedContainer();
+  }
+
   // We expect only a single array in whol response
   if (state_ != State::kWaitPartitionsArray) {
     return false;
@@ -143,18 +150,88 @@ bool PartitionsSaxHandler::StartArray() {
 }
 
 bool PartitionsSaxHandler::EndArray(unsigned int) {
+  if (skip_depth_ > 0u) {
+    return EndSkippedContainer();
+  }
+
   if (state_ != State::kWaitForNextPartition) {
     return false;
   }
 
-  state_ = State::kWaitForRootObjectEnd;
+  state_ = State::kWaitForRootAttribute;
   return continue_parsing_;
 }
 
-bool PartitionsSaxHandler::Default() { return false; }
+bool PartitionsSaxHandler::Default() {
+  // Null, bool and double values are not used
+  if (skip_depth_ > 0u) {
+    return continue_parsing_;
+  }
+
+  return EndValue();
+}
 
 void PartitionsSaxHandler::Abort() { continue_parsing_.store(false); }
 
+bool PartitionsSaxHandler::IsParsingValue() const {
+  switch (state_) {
+    case State::kParsingVersion:
+    case State::kParsingPartitionName:
+    case State::kParsingDataHandle:
+    case State::kParsingChecksum:
+    case State::kParsingDataSize:
+    case State::kParsingCompressedDataSize:
+    case State::kParsingCrc:
+    case State::kParsingIgnoreAttribute:
+    case State::kParsingIgnoreRootAttribute:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool PartitionsSaxHandler::Number(std::int64_t value) {
+  if (skip_depth_ > 0u) {
+    return continue_parsing_;
+  }
+
+  if (state_ == State::kParsingVersion) {
+    partition_.SetVersion(value);
+  } else if (state_ == State::kParsingDataSize) {
+    partition_.SetDataSize(value);
+  } else if (state_ == State::kParsingCompressedDataSize) {
+    partition_.SetCompressedDataSize(value);
+  }
+
+  return EndValue();
+}
+
+bool PartitionsSaxHandler::EndValue() {
+  if (!IsParsingValue()) {
+    return false;
+  }
+
+  state_ = state_ == State::kParsingIgnoreRootAttribute
+               ? State::kWaitForRootAttribute
+               : State::kProcessingAttribute;
+  return continue_parsing_;
+}
+
+bool PartitionsSaxHandler::StartSkippedContainer() {
+  if (state_ != State::kParsingIgnoreRootAttribute) {
+    state_ = State::kParsingIgnoreAttribute;
+  }
+  ++skip_depth_;
+  return continue_parsing_;
+}
+
+bool PartitionsSaxHandler::EndSkippedContainer() {
+  if (--skip_depth_ > 0u) {
+    return continue_parsing_;
+  }
+  return EndValue();
+}
+
 PartitionsSaxHandler::State PartitionsSaxHandler::ProcessNextAttribute(
     const char* name, unsigned int /*length*/) {
   switch (HashStringToInt(name)) {
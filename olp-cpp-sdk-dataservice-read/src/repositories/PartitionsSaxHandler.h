@@ -20,6 +20,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <functional>
 
 #include "rapidjson/reader.h"
@@ -47,9 +48,13 @@ class PartitionsSaxHandler
   bool StartArray();
   bool EndArray(unsigned int);
 
-  /// Json attributes events
+  /// Json attributes events. The values of the unknown attributes, and the
+  /// values of unexpected types, are skipped.
   bool String(const char* str, unsigned int length, bool);
+  bool Int(int value);
   bool Uint(unsigned int value);
+  bool Int64(std::int64_t value);
+  bool Uint64(std::uint64_t value);
   bool Default();
 
   /// Abort parsing
@@ -58,10 +63,9 @@ class PartitionsSaxHandler
  private:
   enum class State {
     kWaitForRootObject,
-    kWaitForRootPartitions,
+    kWaitForRootAttribute,
     kWaitPartitionsArray,
     kWaitForNextPartition,
-    kWaitForRootObjectEnd,
 
     kProcessingAttribute,
 
@@ -73,13 +77,29 @@ class PartitionsSaxHandler
     kParsingCompressedDataSize,
     kParsingCrc,
     kParsingIgnoreAttribute,
+    kParsingIgnoreRootAttribute,
 
     kParsingComplete,
   };
 
   State ProcessNextAttribute(const char* name, unsigned int length);
 
+  /// Checks if the next value belongs to an attribute.
+  bool IsParsingValue() const;
+
+  /// Sets the numeric attribute and completes the value.
+  bool Number(std::int64_t value);
+
+  /// Completes the attribute value and waits for the next attribute.
+  bool EndValue();
+
+  /// Enters or leaves the object or array nested in the skipped value.
+  bool StartSkippedContainer();
+  bool EndSkippedContainer();
+
   State state_{State::kWaitForRootObject};
+  /// The depth of the containers nested in the skipped value.
+  unsigned int skip_depth_{0u};
   model::Partition partition_;
   PartitionCallback partition_callback_;
   std::atomic_bool continue_parsing_{true};
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "ValidatorCacheRepository.h"
+
+#include <cstdlib>
+#include <limits>
+#include <utility>
+
+#include <olp/core/logging/Log.h>
+
+namespace {
+constexpr auto kLogTag = "ValidatorCacheRepository";
+constexpr auto kTimetMax = std::numeric_limits<time_t>::max();
+constexpr auto kValidatorSuffix = "::etag";
+
+std::string CreateValidatorKey(const std::string& key) {
+  return key + kValidatorSuffix;
+}
+
+olp::cache::KeyValueCache::ValueTypePtr Serialize(
+    const olp::dataservice::read::repository::CacheValidator& validator) {
+  // The validator is stored as "<fresh_until> <etag>"
+  const auto value = std::to_string(validator.fresh_until) + " " +
+                     validator.etag;
+  return std::make_shared<olp::cache::KeyValueCache::ValueType>(value.begin(),
+                                                                value.end());
+}
+
+boost::optional<olp::dataservice::read::repository::CacheValidator> Parse(
+    const olp::cache::KeyValueCache::ValueTypePtr& value) {
+  if (!value) {
+    return boost::none;
+  }
+
+  const std::string str(value->begin(), value->end());
+  const auto separator = str.find(' ');
+  if (separator == std::string::npos) {
+    return boost::none;
+  }
+
+  olp::dataservice::read::repository::CacheValidator validator;
+  validator.fresh_until =
+      static_cast<time_t>(std::strtoll(str.c_str(), nullptr, 10));
+  validator.etag = str.substr(separator + 1);
+  return validator;
+}
+
+using CacheValidator = olp::dataservice::read::repository::CacheValidator;
+
+bool IsOutdated(const boost::optional<CacheValidator>& validator) {
+  return !validator || validator->fresh_until <= std::time(nullptr);
+}
+
+time_t FreshUntil(time_t expiry) {
+  const auto now = std::time(nullptr);
+  return expiry < kTimetMax - now ? now + expiry : kTimetMax;
+}
+}  // namespace
+
+namespace olp {
+namespace dataservice {
+namespace read {
+namespace repository {
+
+ValidatorCacheRepository::ValidatorCacheRepository(
+    std::shared_ptr<cache::KeyValueCache> cache, time_t default_expiry)
+    : cache_(std::move(cache)), default_expiry_(default_expiry) {}
+
+bool ValidatorCacheRepository::IsEnabled() const {
+  return default_expiry_ != kTimetMax;
+}
+
+time_t ValidatorCacheRepository::ResponseExpiry(const std::string& etag) const {
+  return IsEnabled() && !etag.empty() ? kTimetMax : default_expiry_;
+}
+
+void ValidatorCacheRepository::Add(
+    const std::string& key, const std::string& etag,
+    cache::KeyValueCache::KeyValueListType& items) const {
+  if (IsEnabled()) {
+    items.emplace_back(CreateValidatorKey(key),
+                       Serialize(CreateValidator(etag)));
+  }
+}
+
+time_t ValidatorCacheRepository::Put(const std::string& key,
+                                     const std::string& etag) {
+  if (!IsEnabled()) {
+    return default_expiry_;
+  }
+
+  const auto validator_key = CreateValidatorKey(key);
+  OLP_SDK_LOG_TRACE_F(kLogTag, "Put -> '%s'", validator_key.c_str());
+
+  const auto expiry = ResponseExpiry(etag);
+  if (!cache_->Put(validator_key, Serialize(CreateValidator(etag)), expiry)) {
+    OLP_SDK_LOG_WARNING_F(kLogTag, "Failed to write validator -> '%s'",
+                          validator_key.c_str());
+    return default_expiry_;
+  }
+
+  return expiry;
+}
+
+boost::optional<CacheValidator> ValidatorCacheRepository::Get(
+    const std::string& key) const {
+  if (!IsEnabled()) {
+    return boost::none;
+  }
+
+  return Parse(cache_->Get(CreateValidatorKey(key)));
+}
+
+bool ValidatorCacheRepository::Refresh(const std::string& key,
+                                       const CacheValidator& validator) {
+  const auto validator_key = CreateValidatorKey(key);
+  OLP_SDK_LOG_TRACE_F(kLogTag, "Refresh -> '%s'", validator_key.c_str());
+
+  auto refreshed = validator;
+  refreshed.fresh_until = FreshUntil(default_expiry_);
+
+  // The validator outlives the response, it is removed together with it
+  return cache_->Put(validator_key, Serialize(refreshed), kTimetMax);
+}
+
+bool ValidatorCacheRepository::IsStale(const std::string& key) const {
+  // The protected responses never expire, like the other protected keys
+  return IsEnabled() && !cache_->IsProtected(key) && IsOutdated(Get(key));
+}
+
+std::vector<bool> ValidatorCacheRepository::IsStale(
+    const cache::KeyValueCache::KeyListType& keys) const {
+  std::vector<bool> stale(keys.size(), false);
+  if (!IsEnabled()) {
+    return stale;
+  }
+
+  cache::KeyValueCache::KeyListType validator_keys;
+  validator_keys.reserve(keys.size());
+  for (const auto& key : keys) {
+    validator_keys.push_back(CreateValidatorKey(key));
+  }
+
+  // All the responses but the protected ones are stale if the read fails
+  auto read_result = cache_->ReadBatch(validator_keys);
+  const auto& values = read_result.GetResult();
+  for (auto i = 0u; i < stale.size(); ++i) {
+    if (cache_->IsProtected(keys[i])) {
+      continue;
+    }
+
+    stale[i] = !read_result ||
+               IsOutdated(i < values.size() ? Parse(values[i]) : boost::none);
+  }
+
+  return stale;
+}
+
+CacheValidator ValidatorCacheRepository::CreateValidator(
+    const std::string& etag) const {
+  // The response without an ETag expires together with its empty validator
+  CacheValidator validator;
+  validator.etag = etag;
+  validator.fresh_until =
+      etag.empty() ? kTimetMax : FreshUntil(default_expiry_);
+  return validator;
+}
+
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <olp/core/cache/KeyValueCache.h>
+#include <boost/optional.hpp>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+namespace repository {
+
+/// The validator of a cached response.
+struct CacheValidator {
+  /// The ETag of the response, sent as `If-None-Match` to revalidate it.
+  std::string etag;
+  /// The time until which the response is fresh.
+  time_t fresh_until{0};
+};
+
+/*
+ * @brief Stores the validators (ETags) of the cached responses, so the expired
+ * responses are revalidated with conditional requests instead of being
+ * downloaded again.
+ *
+ * The response with a validator is cached without expiration, and its
+ * freshness is tracked by the validator instead. The validator is stored under
+ * the key of the response with the `::etag` suffix, so it is removed together
+ * with the response when the response is removed by prefix.
+ *
+ * The validators are used only when the cached responses expire. Then every
+ * response is cached with a validator, the response without an ETag has an
+ * empty one that expires together with the response. A response without a
+ * validator, e.g. because the validator was evicted, is treated as expired.
+ */
+class ValidatorCacheRepository final {
+ public:
+  ValidatorCacheRepository(std::shared_ptr<cache::KeyValueCache> cache,
+                           time_t default_expiry);
+
+  /// Returns true if the cached responses expire, and so are revalidated.
+  bool IsEnabled() const;
+
+  /// Returns the expiry to cache the response with the specified ETag with,
+  /// when its validator is written together with it.
+  time_t ResponseExpiry(const std::string& etag) const;
+
+  /// Adds the validator of the response cached under the key to the items
+  /// written in one batch with the response.
+  void Add(const std::string& key, const std::string& etag,
+           cache::KeyValueCache::KeyValueListType& items) const;
+
+  /// Stores the validator of the response to be cached under the key, and
+  /// returns the expiry to cache the response with. The validator is written
+  /// before the response, so the response that does not expire always has
+  /// one. If the validator is not stored, the response expires as usual.
+  time_t Put(const std::string& key, const std::string& etag);
+
+  /// Returns the validator of the response cached under the key.
+  boost::optional<CacheValidator> Get(const std::string& key) const;
+
+  /// Marks the response cached under the key as fresh again, used when the
+  /// server confirms that the response is not modified.
+  bool Refresh(const std::string& key, const CacheValidator& validator);
+
+  /// Returns true if the response cached under the key has an outdated or no
+  /// validator and needs to be revalidated before it is used. The protected
+  /// responses are never stale.
+  bool IsStale(const std::string& key) const;
+
+  /// Returns the staleness of the responses in the order of the keys.
+  std::vector<bool> IsStale(
+      const cache::KeyValueCache::KeyListType& keys) const;
+
+ private:
+  /// Returns the validator to cache with a response with the ETag.
+  CacheValidator CreateValidator(const std::string& etag) const;
+
+  std::shared_ptr<cache::KeyValueCache> cache_;
+  time_t default_expiry_;
+};
+
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -24,6 +24,7 @@
 #include <mocks/CacheMock.h>
 #include <mocks/NetworkMock.h>
 #include <olp/core/client/OlpClientFactory.h>
+#include <olp/core/client/OlpClientSettingsFactory.h>
 #include "ApiClientLookup.h"
 #include "olp/dataservice/read/CatalogRequest.h"
 #include "olp/dataservice/read/CatalogVersionRequest.h"
@@ -486,6 +487,50 @@ TEST_F(CatalogRepositoryTest, GetCatalogOnlineIfNotFound) {
   }
 }
 
+TEST_F(CatalogRepositoryTest, GetCatalogNotModified) {
+  olp::client::CancellationContext context;
+
+  const std::string etag = "\"config-etag\"";
+  const auto if_none_match =
+      std::make_pair(std::string(olp::http::kIfNoneMatchHeader), etag);
+
+  settings_.cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+  settings_.default_cache_expiration = std::chrono::hours(1);
+
+  ON_CALL(*network_, Send(IsGetRequest(kUrlLookupConfig), _, _, _, _))
+      .WillByDefault(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                            olp::http::HttpStatusCode::OK),
+                                        kResponseLookupConfig));
+
+  EXPECT_CALL(*network_, Send(IsGetRequest(kUrlConfig), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          kResponseConfig, {{olp::http::kETagHeader, etag}}));
+
+  EXPECT_CALL(*network_,
+              Send(testing::AllOf(IsGetRequest(kUrlConfig),
+                                  HeadersContain(if_none_match)),
+                   _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::NOT_MODIFIED),
+                                   ""));
+
+  ApiLookupClient lookup_client(kHrn, settings_);
+  repository::CatalogRepository repository(kHrn, settings_, lookup_client);
+
+  auto response = repository.GetCatalog(
+      read::CatalogRequest().WithFetchOption(read::OnlineIfNotFound), context);
+  ASSERT_TRUE(response.IsSuccessful());
+
+  // The cached catalog is revalidated and returned when not modified
+  response = repository.GetCatalog(
+      read::CatalogRequest().WithFetchOption(read::CacheWithUpdate), context);
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(3, response.GetResult().GetVersion());
+}
+
 TEST_F(CatalogRepositoryTest, GetCatalogCacheOnlyFound) {
   olp::client::CancellationContext context;
 
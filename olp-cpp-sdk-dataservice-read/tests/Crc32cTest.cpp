@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <Crc32c.h>
+
+namespace {
+
+using olp::dataservice::read::Crc32c;
+
+std::uint32_t Checksum(const std::string& data) {
+  Crc32c crc;
+  crc.Update(reinterpret_cast<const unsigned char*>(data.data()), data.size());
+  return crc.Value();
+}
+
+TEST(Crc32cTest, KnownValues) {
+  EXPECT_EQ(Checksum(""), 0x00000000u);
+  EXPECT_EQ(Checksum("a"), 0xC1D04330u);
+  EXPECT_EQ(Checksum("123456789"), 0xE3069283u);
+  EXPECT_EQ(Checksum(std::string(32, '\0')), 0x8A9136AAu);
+  EXPECT_EQ(Checksum(std::string(32, '\xFF')), 0x62A8AB43u);
+}
+
+TEST(Crc32cTest, ChunkedUpdate) {
+  std::vector<unsigned char> data(1000);
+  for (auto i = 0u; i < data.size(); ++i) {
+    data[i] = static_cast<unsigned char>(i * 31u + 7u);
+  }
+
+  Crc32c whole;
+  whole.Update(data.data(), data.size());
+
+  // The chunks are not aligned to the 8 bytes processed at once
+  for (const auto chunk_size : {1u, 3u, 7u, 8u, 13u, 64u, 999u}) {
+    SCOPED_TRACE(chunk_size);
+
+    Crc32c chunked;
+    for (auto offset = 0u; offset < data.size(); offset += chunk_size) {
+      const auto size = std::min<std::size_t>(chunk_size, data.size() - offset);
+      chunked.Update(data.data() + offset, size);
+    }
+    EXPECT_EQ(chunked.Value(), whole.Value());
+  }
+}
+
+TEST(Crc32cTest, Matches) {
+  const std::string data = "someData";
+  Crc32c crc;
+  crc.Update(reinterpret_cast<const unsigned char*>(data.data()), data.size());
+
+  EXPECT_TRUE(crc.Matches("a33a7e8e"));
+  EXPECT_TRUE(crc.Matches("A33A7E8E"));
+  EXPECT_FALSE(crc.Matches("a33a7e8f"));
+  EXPECT_FALSE(crc.Matches(""));
+  EXPECT_FALSE(crc.Matches("a33a7e8e0"));
+  EXPECT_FALSE(crc.Matches("a33a7e8x"));
+}
+
+}  // namespace
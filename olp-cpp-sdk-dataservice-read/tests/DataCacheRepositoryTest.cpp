@@ -21,8 +21,10 @@
 
 #include <gmock/gmock.h>
 #include <olp/core/cache/CacheSettings.h>
+#include <olp/core/cache/KeyGenerator.h>
 #include <olp/core/cache/KeyValueCache.h>
 #include <olp/core/client/OlpClientSettingsFactory.h>
+#include <olp/core/utils/Dir.h>
 
 namespace {
 namespace read = olp::dataservice::read;
@@ -102,4 +104,216 @@ TEST(PartitionsCacheRepositoryTest, IsCached) {
   }
 }
 
+TEST(PartitionsCacheRepositoryTest, Batch) {
+  const auto hrn = client::HRN::FromString(kCatalog);
+  const auto layer = "layer";
+
+  std::vector<std::pair<std::string, read::model::Data>> data;
+  std::vector<std::string> data_handles;
+  for (auto i = 0; i < 10; ++i) {
+    data_handles.push_back(kDataHandle + std::to_string(i));
+    data.emplace_back(data_handles.back(),
+                      std::make_shared<std::vector<unsigned char>>(
+                          data_handles.back().begin(),
+                          data_handles.back().end()));
+  }
+
+  std::shared_ptr<cache::KeyValueCache> cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+  repository::DataCacheRepository repository(hrn, cache);
+
+  ASSERT_TRUE(repository.Put(data, layer));
+
+  auto requested_handles = data_handles;
+  requested_handles.push_back(kDataHandle);
+  const auto result = repository.Get(layer, requested_handles);
+
+  ASSERT_EQ(requested_handles.size(), result.size());
+  for (size_t i = 0; i < data.size(); ++i) {
+    ASSERT_TRUE(result[i]);
+    EXPECT_EQ(*data[i].second, *result[i]);
+    EXPECT_TRUE(repository.IsCached(layer, data_handles[i]));
+  }
+  EXPECT_FALSE(result.back());
+}
+
+TEST(PartitionsCacheRepositoryTest, GetView) {
+  const auto hrn = client::HRN::FromString(kCatalog);
+  const auto layer = "layer";
+
+  const auto data = std::vector<unsigned char>{1, 2, 3};
+  const auto model_data = std::make_shared<std::vector<unsigned char>>(data);
+
+  std::shared_ptr<cache::KeyValueCache> cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+  repository::DataCacheRepository repository(hrn, cache);
+
+  {
+    SCOPED_TRACE("Not cached");
+
+    EXPECT_FALSE(repository.GetView(layer, kDataHandle));
+  }
+
+  {
+    SCOPED_TRACE("Cached");
+
+    ASSERT_TRUE(repository.Put(model_data, layer, kDataHandle));
+    const auto result = repository.GetView(layer, kDataHandle);
+
+    ASSERT_TRUE(result);
+    EXPECT_EQ(data, result->ToVector());
+  }
+}
+
+TEST(PartitionsCacheRepositoryTest, Validator) {
+  const auto hrn = client::HRN::FromString(kCatalog);
+  const auto layer = "layer";
+  const auto etag = "\"1234\"";
+
+  const auto data = std::vector<unsigned char>{1, 2, 3};
+  const auto model_data = std::make_shared<std::vector<unsigned char>>(data);
+
+  {
+    SCOPED_TRACE("Fresh");
+
+    std::shared_ptr<cache::KeyValueCache> cache =
+        olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+    repository::DataCacheRepository repository(hrn, cache,
+                                               std::chrono::hours(1));
+
+    ASSERT_TRUE(repository.Put(model_data, layer, kDataHandle, etag));
+
+    EXPECT_TRUE(repository.Get(layer, kDataHandle));
+    EXPECT_TRUE(repository.IsCached(layer, kDataHandle));
+    const auto validator = repository.GetValidator(layer, kDataHandle);
+    ASSERT_TRUE(validator);
+    EXPECT_EQ(etag, validator->etag);
+  }
+
+  {
+    SCOPED_TRACE("Expired");
+
+    std::shared_ptr<cache::KeyValueCache> cache =
+        olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+    repository::DataCacheRepository repository(hrn, cache,
+                                               std::chrono::seconds(-1));
+
+    ASSERT_TRUE(repository.Put(model_data, layer, kDataHandle, etag));
+
+    // The expired data is kept for the revalidation, but not returned
+    EXPECT_FALSE(repository.Get(layer, kDataHandle));
+    EXPECT_FALSE(repository.GetView(layer, kDataHandle));
+    EXPECT_FALSE(repository.IsCached(layer, kDataHandle));
+    EXPECT_FALSE(repository.Get(layer, std::vector<std::string>{kDataHandle})
+                     .front());
+
+    const auto validator = repository.GetValidator(layer, kDataHandle);
+    ASSERT_TRUE(validator);
+    EXPECT_EQ(etag, validator->etag);
+  }
+
+  {
+    SCOPED_TRACE("Revalidated");
+
+    std::shared_ptr<cache::KeyValueCache> cache =
+        olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+    repository::DataCacheRepository expired_repository(
+        hrn, cache, std::chrono::seconds(-1));
+    ASSERT_TRUE(expired_repository.Put(model_data, layer, kDataHandle, etag));
+
+    repository::DataCacheRepository repository(hrn, cache,
+                                               std::chrono::hours(1));
+    const auto validator = repository.GetValidator(layer, kDataHandle);
+    ASSERT_TRUE(validator);
+    ASSERT_TRUE(repository.RefreshValidator(layer, kDataHandle, *validator));
+
+    const auto result = repository.Get(layer, kDataHandle);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(data, **result);
+  }
+
+  {
+    SCOPED_TRACE("Without ETag");
+
+    std::shared_ptr<cache::KeyValueCache> cache =
+        olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+    repository::DataCacheRepository repository(hrn, cache,
+                                               std::chrono::hours(1));
+
+    ASSERT_TRUE(repository.Put(model_data, layer, kDataHandle, ""));
+
+    EXPECT_TRUE(repository.Get(layer, kDataHandle));
+    const auto validator = repository.GetValidator(layer, kDataHandle);
+    ASSERT_TRUE(validator);
+    EXPECT_TRUE(validator->etag.empty());
+  }
+
+  {
+    SCOPED_TRACE("Missing validator");
+
+    std::shared_ptr<cache::KeyValueCache> cache =
+        olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+    repository::DataCacheRepository repository(hrn, cache,
+                                               std::chrono::hours(1));
+
+    ASSERT_TRUE(repository.Put(model_data, layer, kDataHandle, etag));
+
+    // The data that does not expire is never used without its validator
+    const auto key = olp::cache::KeyGenerator::CreateDataHandleKey(
+        hrn.ToCatalogHRNString(), layer, kDataHandle);
+    ASSERT_TRUE(cache->Remove(key + "::etag"));
+
+    EXPECT_FALSE(repository.Get(layer, kDataHandle));
+    EXPECT_FALSE(repository.IsCached(layer, kDataHandle));
+    EXPECT_FALSE(repository.Get(layer, std::vector<std::string>{kDataHandle})
+                     .front());
+  }
+
+  {
+    SCOPED_TRACE("Protected");
+
+    const auto cache_path = olp::utils::Dir::TempDirectory() + "/unittest";
+    olp::utils::Dir::Remove(cache_path);
+
+    cache::CacheSettings cache_settings;
+    cache_settings.disk_path_mutable = cache_path;
+    std::shared_ptr<cache::KeyValueCache> cache =
+        olp::client::OlpClientSettingsFactory::CreateDefaultCache(
+            cache_settings);
+    ASSERT_TRUE(cache);
+    repository::DataCacheRepository repository(hrn, cache,
+                                               std::chrono::seconds(-1));
+
+    ASSERT_TRUE(repository.Put(model_data, layer, kDataHandle, etag));
+    const auto key = olp::cache::KeyGenerator::CreateDataHandleKey(
+        hrn.ToCatalogHRNString(), layer, kDataHandle);
+    ASSERT_TRUE(cache->Protect({key}));
+
+    // The protected data is used even when its validator is outdated
+    const auto result = repository.Get(layer, kDataHandle);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(data, **result);
+    EXPECT_TRUE(repository.GetView(layer, kDataHandle));
+    EXPECT_TRUE(repository.IsCached(layer, kDataHandle));
+    EXPECT_TRUE(repository.Get(layer, std::vector<std::string>{kDataHandle})
+                    .front());
+
+    cache.reset();
+    olp::utils::Dir::Remove(cache_path);
+  }
+
+  {
+    SCOPED_TRACE("Expiration disabled");
+
+    std::shared_ptr<cache::KeyValueCache> cache =
+        olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+    repository::DataCacheRepository repository(hrn, cache);
+
+    ASSERT_TRUE(repository.Put(model_data, layer, kDataHandle, etag));
+
+    EXPECT_TRUE(repository.Get(layer, kDataHandle));
+    EXPECT_FALSE(repository.GetValidator(layer, kDataHandle));
+  }
+}
+
 }  // namespace
@@ -31,9 +31,11 @@
 #include <olp/core/client/OlpClientFactory.h>
 #include <olp/core/client/OlpClientSettings.h>
 #include <olp/core/client/OlpClientSettingsFactory.h>
+#include <olp/core/http/NetworkConstants.h>
 #include <olp/core/utils/Url.h>
 #include <olp/dataservice/read/DataRequest.h>
 #include <olp/dataservice/read/TileRequest.h>
+#include <repositories/DataCacheRepository.h>
 #include <repositories/DataRepository.h>
 #include <repositories/NamedMutex.h>
 #include <repositories/PartitionsCacheRepository.h>
@@ -141,6 +143,161 @@ TEST_F(DataRepositoryTest, GetBlobData) {
   ASSERT_TRUE(response.IsSuccessful());
 }
 
+TEST_F(DataRepositoryTest, GetBlobDataParallel) {
+  settings_->task_scheduler =
+      olp::client::OlpClientSettingsFactory::CreateDefaultTaskScheduler(2u);
+  settings_->parallel_download_settings.min_blob_size = 1u;
+  settings_->parallel_download_settings.min_range_size = 4u;
+
+  olp::dataservice::read::model::Partition partition;
+  partition.SetDataHandle(kUrlBlobDataHandle);
+  partition.SetDataSize(8);
+  partition.SetCrc(std::string("a33a7e8e"));
+
+  auto expect_range = [&](const std::string& range, const std::string& data) {
+    EXPECT_CALL(*network_mock_,
+                Send(testing::AllOf(IsGetRequest(kUrlBlobData269),
+                                    HeadersContain(olp::http::Header(
+                                        olp::http::kRangeHeader, range))),
+                     _, _, _, _))
+        .WillOnce(ReturnHttpResponse(
+            olp::http::NetworkResponse().WithStatus(
+                olp::http::HttpStatusCode::PARTIAL_CONTENT),
+            data));
+  };
+
+  EXPECT_CALL(*network_mock_, Send(IsGetRequest(kUrlLookup), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::OK),
+                                   kUrlResponseLookup));
+
+  olp::client::HRN hrn(GetTestCatalog());
+  ApiLookupClient lookup_client(hrn, *settings_);
+  DataRepository repository(hrn, *settings_, lookup_client);
+
+  {
+    SCOPED_TRACE("Ranges are assembled");
+
+    expect_range("bytes=0-3", "some");
+    expect_range("bytes=4-7", "Data");
+
+    olp::client::CancellationContext context;
+    auto response = repository.GetBlobData(
+        kLayerId, kService, partition,
+        olp::dataservice::read::FetchOptions::OnlineOnly, boost::none, context,
+        false);
+
+    ASSERT_TRUE(response.IsSuccessful());
+    const auto& data = response.GetResult();
+    EXPECT_EQ(std::string(data->begin(), data->end()), "someData");
+    testing::Mock::VerifyAndClearExpectations(network_mock_.get());
+  }
+
+  {
+    SCOPED_TRACE("CRC mismatch");
+
+    expect_range("bytes=0-3", "some");
+    expect_range("bytes=4-7", "Date");
+
+    olp::client::CancellationContext context;
+    auto response = repository.GetBlobData(
+        kLayerId, kService, partition,
+        olp::dataservice::read::FetchOptions::OnlineOnly, boost::none, context,
+        false);
+
+    EXPECT_FALSE(response.IsSuccessful());
+  }
+}
+
+TEST_F(DataRepositoryTest, GetBlobDataVerifyCrc) {
+  settings_->verify_data_integrity = true;
+  settings_->retry_settings.max_attempts = 1;
+
+  olp::dataservice::read::model::Partition partition;
+  partition.SetDataHandle(kUrlBlobDataHandle);
+  partition.SetCrc(std::string("a33a7e8e"));
+
+  EXPECT_CALL(*network_mock_, Send(IsGetRequest(kUrlLookup), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::OK),
+                                   kUrlResponseLookup));
+
+  olp::client::HRN hrn(GetTestCatalog());
+  ApiLookupClient lookup_client(hrn, *settings_);
+  DataRepository repository(hrn, *settings_, lookup_client);
+
+  auto get_blob_data = [&](olp::dataservice::read::FetchOptions option) {
+    olp::client::CancellationContext context;
+    return repository.GetBlobData(kLayerId, kService, partition, option,
+                                  boost::none, context, false);
+  };
+
+  auto expect_blob = [&](const std::string& data) {
+    EXPECT_CALL(*network_mock_,
+                Send(IsGetRequest(kUrlBlobData269), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::OK),
+                                     data))
+        .RetiresOnSaturation();
+  };
+
+  {
+    SCOPED_TRACE("Mismatch is not cached");
+
+    expect_blob("someDate");
+    expect_blob("someDate");
+
+    auto response =
+        get_blob_data(olp::dataservice::read::FetchOptions::OnlineIfNotFound);
+
+    ASSERT_FALSE(response.IsSuccessful());
+    EXPECT_TRUE(response.GetError().ShouldRetry());
+    EXPECT_FALSE(
+        get_blob_data(olp::dataservice::read::FetchOptions::CacheOnly));
+    testing::Mock::VerifyAndClearExpectations(network_mock_.get());
+  }
+
+  {
+    SCOPED_TRACE("Mismatch is downloaded again");
+
+    // The expectation set last is matched first
+    expect_blob("someData");
+    expect_blob("someDate");
+
+    auto response =
+        get_blob_data(olp::dataservice::read::FetchOptions::OnlineIfNotFound);
+
+    ASSERT_TRUE(response.IsSuccessful());
+    const auto& data = response.GetResult();
+    EXPECT_EQ(std::string(data->begin(), data->end()), "someData");
+    EXPECT_TRUE(
+        get_blob_data(olp::dataservice::read::FetchOptions::CacheOnly));
+    testing::Mock::VerifyAndClearExpectations(network_mock_.get());
+  }
+
+  {
+    SCOPED_TRACE("Corrupted cached data is downloaded again");
+
+    olp::dataservice::read::repository::DataCacheRepository cache_repository(
+        hrn, settings_->cache);
+    const std::string corrupted = "someDate";
+    ASSERT_TRUE(cache_repository
+                    .Put(std::make_shared<std::vector<unsigned char>>(
+                             corrupted.begin(), corrupted.end()),
+                         kLayerId, kUrlBlobDataHandle)
+                    .IsSuccessful());
+
+    expect_blob("someData");
+
+    auto response =
+        get_blob_data(olp::dataservice::read::FetchOptions::OnlineIfNotFound);
+
+    ASSERT_TRUE(response.IsSuccessful());
+    const auto& data = response.GetResult();
+    EXPECT_EQ(std::string(data->begin(), data->end()), "someData");
+  }
+}
+
 TEST_F(DataRepositoryTest, GetBlobDataApiLookupFailed403) {
   EXPECT_CALL(*network_mock_, Send(IsGetRequest(kUrlLookup), _, _, _, _))
       .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
@@ -375,6 +532,192 @@ TEST_F(DataRepositoryTest, GetBlobDataSimultaniousFailedCalls) {
   second_request_thread.join();
 }
 
+TEST_F(DataRepositoryTest, GetVersionedDataRange) {
+  using olp::dataservice::read::DataRequest;
+  using olp::dataservice::read::FetchOptions;
+
+  const auto kVersion = 4;
+  ApiLookupClient lookup_client(hrn_, *settings_);
+  DataRepository repository(hrn_, *settings_, lookup_client);
+
+  {
+    SCOPED_TRACE("Range is downloaded");
+
+    EXPECT_CALL(*network_mock_, Send(IsGetRequest(kUrlLookup), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::OK),
+                                     kUrlResponseLookup));
+    EXPECT_CALL(*network_mock_,
+                Send(testing::AllOf(IsGetRequest(kUrlBlobData269),
+                                    HeadersContain(olp::http::Header(
+                                        olp::http::kRangeHeader, "bytes=2-5"))),
+                     _, _, _, _))
+        .WillOnce(ReturnHttpResponse(
+            olp::http::NetworkResponse().WithStatus(
+                olp::http::HttpStatusCode::PARTIAL_CONTENT),
+            "meDa"));
+
+    olp::client::CancellationContext context;
+    auto response = repository.GetVersionedData(
+        kLayerId,
+        DataRequest().WithDataHandle(kUrlBlobDataHandle).WithRange(2u, 4u),
+        kVersion, context, false);
+
+    ASSERT_TRUE(response.IsSuccessful());
+    const auto& data = response.GetResult();
+    EXPECT_EQ(std::string(data->begin(), data->end()), "meDa");
+    testing::Mock::VerifyAndClearExpectations(network_mock_.get());
+  }
+
+  {
+    SCOPED_TRACE("Range is read from the cached data");
+
+    EXPECT_CALL(*network_mock_, Send(IsGetRequest(kUrlBlobData269), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::OK),
+                                     "someData"));
+
+    olp::client::CancellationContext context;
+    auto response = repository.GetVersionedData(
+        kLayerId, DataRequest().WithDataHandle(kUrlBlobDataHandle), kVersion,
+        context, false);
+    ASSERT_TRUE(response.IsSuccessful());
+
+    response = repository.GetVersionedData(
+        kLayerId,
+        DataRequest()
+            .WithDataHandle(kUrlBlobDataHandle)
+            .WithRange(4u)
+            .WithFetchOption(FetchOptions::CacheOnly),
+        kVersion, context, false);
+
+    ASSERT_TRUE(response.IsSuccessful());
+    const auto& data = response.GetResult();
+    EXPECT_EQ(std::string(data->begin(), data->end()), "Data");
+
+    response = repository.GetVersionedData(
+        kLayerId,
+        DataRequest()
+            .WithDataHandle(kUrlBlobDataHandle)
+            .WithRange(100u, 1u)
+            .WithFetchOption(FetchOptions::CacheOnly),
+        kVersion, context, false);
+
+    ASSERT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(response.GetError().GetErrorCode(),
+              olp::client::ErrorCode::InvalidArgument);
+  }
+}
+
+TEST_F(DataRepositoryTest, GetVersionedDataStream) {
+  using olp::dataservice::read::DataRequest;
+  using olp::dataservice::read::FetchOptions;
+
+  const auto kVersion = 4;
+  ApiLookupClient lookup_client(hrn_, *settings_);
+  DataRepository repository(hrn_, *settings_, lookup_client);
+
+  std::string streamed;
+  auto chunk_callback = [&](const unsigned char* data, std::size_t size) {
+    streamed.append(reinterpret_cast<const char*>(data), size);
+  };
+
+  {
+    SCOPED_TRACE("Data is streamed and cached");
+
+    EXPECT_CALL(*network_mock_, Send(IsGetRequest(kUrlLookup), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::OK),
+                                     kUrlResponseLookup));
+    EXPECT_CALL(*network_mock_, Send(IsGetRequest(kUrlBlobData269), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::OK),
+                                     "someData"));
+
+    olp::client::CancellationContext context;
+    auto response = repository.GetVersionedDataStream(
+        kLayerId, DataRequest().WithDataHandle(kUrlBlobDataHandle), kVersion,
+        chunk_callback, context, false);
+
+    ASSERT_TRUE(response.IsSuccessful());
+    EXPECT_EQ(streamed, "someData");
+    testing::Mock::VerifyAndClearExpectations(network_mock_.get());
+  }
+
+  {
+    SCOPED_TRACE("Cached data is streamed");
+
+    streamed.clear();
+    olp::client::CancellationContext context;
+    auto response = repository.GetVersionedDataStream(
+        kLayerId,
+        DataRequest()
+            .WithDataHandle(kUrlBlobDataHandle)
+            .WithFetchOption(FetchOptions::CacheOnly),
+        kVersion, chunk_callback, context, false);
+
+    ASSERT_TRUE(response.IsSuccessful());
+    EXPECT_EQ(streamed, "someData");
+  }
+}
+
+TEST_F(DataRepositoryTest, GetVersionedDataStreamErrorBody) {
+  using olp::dataservice::read::DataRequest;
+
+  const auto kVersion = 4;
+  ApiLookupClient lookup_client(hrn_, *settings_);
+  DataRepository repository(hrn_, *settings_, lookup_client);
+
+  std::string streamed;
+  auto chunk_callback = [&](const unsigned char* data, std::size_t size) {
+    streamed.append(reinterpret_cast<const char*>(data), size);
+  };
+
+  EXPECT_CALL(*network_mock_, Send(IsGetRequest(kUrlLookup), _, _, _, _))
+      .WillRepeatedly(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          kUrlResponseLookup));
+
+  testing::InSequence sequence;
+  EXPECT_CALL(*network_mock_, Send(IsGetRequest(kUrlBlobData269), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::SERVICE_UNAVAILABLE),
+          "Service unavailable"));
+  EXPECT_CALL(*network_mock_, Send(IsGetRequest(kUrlBlobData269), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::OK),
+                                   "someData"));
+
+  {
+    SCOPED_TRACE("Stream fails after passing the error body");
+
+    // Not retried, as the retry would skip the data of the error body
+    olp::client::CancellationContext context;
+    auto response = repository.GetVersionedDataStream(
+        kLayerId, DataRequest().WithDataHandle(kUrlBlobDataHandle), kVersion,
+        chunk_callback, context, false);
+
+    ASSERT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(response.GetError().GetHttpStatusCode(),
+              olp::http::HttpStatusCode::SERVICE_UNAVAILABLE);
+  }
+
+  {
+    SCOPED_TRACE("Data is streamed from the beginning");
+
+    streamed.clear();
+    olp::client::CancellationContext context;
+    auto response = repository.GetVersionedDataStream(
+        kLayerId, DataRequest().WithDataHandle(kUrlBlobDataHandle), kVersion,
+        chunk_callback, context, false);
+
+    ASSERT_TRUE(response.IsSuccessful());
+    EXPECT_EQ(streamed, "someData");
+  }
+}
+
 TEST_F(DataRepositoryTest, GetVersionedDataTile) {
   EXPECT_CALL(*network_mock_, Send(IsGetRequest(kUrlLookup), _, _, _, _))
       .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
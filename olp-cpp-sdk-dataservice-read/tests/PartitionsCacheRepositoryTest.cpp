@@ -19,9 +19,12 @@
 
 #include "repositories/PartitionsCacheRepository.h"
 
+#include <limits>
+
 #include <gmock/gmock.h>
 #include <mocks/CacheMock.h>
 #include <olp/core/cache/CacheSettings.h>
+#include <olp/core/cache/KeyGenerator.h>
 #include <olp/core/cache/KeyValueCache.h>
 #include <olp/core/client/OlpClientSettingsFactory.h>
 
@@ -300,3 +303,174 @@ TEST(PartitionsCacheRepositoryTest, ClearPartitions) {
 }
 
 }  // namespace
+
+TEST(PartitionsCacheRepositoryTest, DecodedPartitions) {
+  const auto hrn = HRN::FromString(kCatalog);
+  const auto layer = "layer";
+  const auto version = 4;
+
+  model::Partition some_partition;
+  some_partition.SetPartition(kPartitionId);
+  some_partition.SetDataHandle(kDataHandle);
+  model::Partitions partitions;
+  partitions.GetMutablePartitions().push_back(some_partition);
+
+  std::shared_ptr<KeyValueCache> cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+  const auto decoded_partitions =
+      std::make_shared<repository::DecodedPartitions>(1u);
+  const auto expiry = std::chrono::seconds::max();
+
+  {
+    SCOPED_TRACE("Written partitions are shared by the repositories");
+
+    repository::PartitionsCacheRepository writer(hrn, layer, cache, expiry,
+                                                 decoded_partitions);
+    ASSERT_TRUE(writer.Put(partitions, version, boost::none));
+
+    repository::PartitionsCacheRepository reader(hrn, layer, cache, expiry,
+                                                 decoded_partitions);
+    const auto result = reader.Get({kPartitionId}, version);
+    ASSERT_EQ(result.GetPartitions().size(), 1u);
+    EXPECT_EQ(result.GetPartitions().front().GetDataHandle(), kDataHandle);
+    EXPECT_EQ(decoded_partitions->GetHits(), 1u);
+    EXPECT_EQ(decoded_partitions->GetMisses(), 0u);
+
+    std::string handle;
+    EXPECT_TRUE(reader.GetPartitionHandle(kPartitionId, version, handle));
+    EXPECT_EQ(handle, kDataHandle);
+    EXPECT_EQ(decoded_partitions->GetHits(), 2u);
+  }
+
+  {
+    SCOPED_TRACE("Partitions removed from the cache are not returned");
+
+    repository::PartitionsCacheRepository repository(hrn, layer, cache, expiry,
+                                                     decoded_partitions);
+    ASSERT_TRUE(repository.Clear());
+    EXPECT_EQ(decoded_partitions->Size(), 0u);
+    EXPECT_TRUE(
+        repository.Get({kPartitionId}, version).GetPartitions().empty());
+    EXPECT_EQ(decoded_partitions->GetMisses(), 1u);
+  }
+
+  {
+    SCOPED_TRACE("Partitions read from the cache are decoded once");
+
+    ASSERT_TRUE(cache->Write(
+        olp::cache::KeyGenerator::CreatePartitionKey(kCatalog, layer,
+                                                     kPartitionId, version),
+        olp::serializer::serialize_bytes(some_partition),
+        std::numeric_limits<time_t>::max()));
+
+    repository::PartitionsCacheRepository repository(hrn, layer, cache, expiry,
+                                                     decoded_partitions);
+    EXPECT_EQ(repository.Get({kPartitionId}, version).GetPartitions().size(),
+              1u);
+    EXPECT_EQ(decoded_partitions->GetMisses(), 2u);
+    EXPECT_EQ(repository.Get({kPartitionId}, version).GetPartitions().size(),
+              1u);
+    EXPECT_EQ(decoded_partitions->GetHits(), 3u);
+  }
+
+  {
+    SCOPED_TRACE("Partitions without version are not kept decoded");
+
+    repository::PartitionsCacheRepository repository(hrn, layer, cache, expiry,
+                                                     decoded_partitions);
+    ASSERT_TRUE(repository.Clear());
+    ASSERT_TRUE(repository.Put(partitions, boost::none, boost::none));
+    EXPECT_EQ(
+        repository.Get({kPartitionId}, boost::none).GetPartitions().size(),
+        1u);
+    EXPECT_EQ(decoded_partitions->Size(), 0u);
+  }
+}
+
+TEST(PartitionsCacheRepositoryTest, BinaryMetadata) {
+  const auto hrn = HRN::FromString(kCatalog);
+  const auto layer = "layer";
+  const auto version = 4;
+
+  model::Partition some_partition;
+  some_partition.SetPartition(kPartitionId);
+  some_partition.SetDataHandle(kDataHandle);
+  some_partition.SetDataSize(1024);
+  some_partition.SetCrc(std::string("a33a7e8e"));
+  some_partition.SetVersion(version);
+  model::Partitions partitions;
+  partitions.GetMutablePartitions().push_back(some_partition);
+
+  const auto partition_key = olp::cache::KeyGenerator::CreatePartitionKey(
+      kCatalog, layer, kPartitionId, version);
+
+  {
+    SCOPED_TRACE("Partitions are written in the binary format");
+
+    std::shared_ptr<KeyValueCache> cache =
+        olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+    repository::PartitionsCacheRepository writer(hrn, layer, cache);
+    ASSERT_TRUE(writer.Put(partitions, version, boost::none, true));
+
+    const auto value = cache->Read(partition_key);
+    ASSERT_TRUE(value);
+    ASSERT_FALSE(value.GetResult()->empty());
+    EXPECT_NE(value.GetResult()->front(), '{');
+
+    // Reads a copy, so the partitions are decoded from the cached bytes
+    std::shared_ptr<KeyValueCache> copy =
+        olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+    ASSERT_TRUE(copy->Write(partition_key, value.GetResult(),
+                            std::numeric_limits<time_t>::max()));
+    ASSERT_TRUE(copy->Write(
+        olp::cache::KeyGenerator::CreatePartitionsKey(kCatalog, layer,
+                                                      version),
+        cache->Read(olp::cache::KeyGenerator::CreatePartitionsKey(
+                        kCatalog, layer, version))
+            .GetResult(),
+        std::numeric_limits<time_t>::max()));
+
+    repository::PartitionsCacheRepository reader(hrn, layer, copy);
+    const auto result = reader.Get(read::PartitionsRequest(), version);
+    ASSERT_TRUE(result);
+    ASSERT_EQ(result->GetPartitions().size(), 1u);
+    const auto& partition = result->GetPartitions().front();
+    EXPECT_EQ(partition.GetPartition(), kPartitionId);
+    EXPECT_EQ(partition.GetDataHandle(), kDataHandle);
+    EXPECT_EQ(partition.GetDataSize().get_value_or(0), 1024);
+    EXPECT_EQ(partition.GetCrc().get_value_or(""), "a33a7e8e");
+    EXPECT_EQ(partition.GetVersion().get_value_or(0), version);
+    EXPECT_FALSE(partition.GetChecksum());
+    EXPECT_FALSE(partition.GetCompressedDataSize());
+  }
+
+  {
+    SCOPED_TRACE("Partitions written in JSON are read");
+
+    std::shared_ptr<KeyValueCache> cache =
+        olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+    ASSERT_TRUE(cache->Write(partition_key,
+                             olp::serializer::serialize_bytes(some_partition),
+                             std::numeric_limits<time_t>::max()));
+
+    repository::PartitionsCacheRepository repository(hrn, layer, cache);
+    std::string handle;
+    EXPECT_TRUE(repository.GetPartitionHandle(kPartitionId, version, handle));
+    EXPECT_EQ(handle, kDataHandle);
+  }
+
+  {
+    SCOPED_TRACE("Unknown format is a cache miss");
+
+    std::shared_ptr<KeyValueCache> cache =
+        olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+    ASSERT_TRUE(cache->Write(
+        partition_key,
+        std::make_shared<KeyValueCache::ValueType>(3u, 0xB1u),
+        std::numeric_limits<time_t>::max()));
+
+    repository::PartitionsCacheRepository repository(hrn, layer, cache);
+    std::string handle;
+    EXPECT_FALSE(repository.GetPartitionHandle(kPartitionId, version, handle));
+  }
+}
@@ -713,6 +713,192 @@ TEST_F(PartitionsRepositoryTest, GetVersionedPartitions) {
     ASSERT_TRUE(response.IsSuccessful()) << response.GetError().GetMessage();
     EXPECT_TRUE(response.GetResult().GetPartitions().empty());
   }
+  {
+    SCOPED_TRACE("Successful fetch from network, layer cached in batches");
+
+    // More partitions than a single cache write contains
+    const size_t kPartitionsCount = 2500u;
+    std::string partitions_response = R"jsonString({"partitions":[)jsonString";
+    for (size_t i = 0; i < kPartitionsCount; ++i) {
+      if (i > 0) {
+        partitions_response.append(",");
+      }
+      const auto index = std::to_string(i);
+      partitions_response.append(R"({"version":4,"partition":")" + index +
+                                 R"(","dataHandle":"handle-)" + index +
+                                 R"("})");
+    }
+    partitions_response.append("]}");
+
+    OlpClientSettings settings;
+    settings.cache = client::OlpClientSettingsFactory::CreateDefaultCache({});
+    settings.network_request_handler = mock_network;
+    settings.retry_settings.timeout = 1;
+
+    EXPECT_CALL(*mock_network,
+                Send(IsGetRequest(kOlpSdkUrlLookupMetadata2), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::OK),
+                                     kOlpSdkHttpResponseLookupMetadata2));
+
+    EXPECT_CALL(*mock_network,
+                Send(IsGetRequest(kOlpSdkUrlVersionedPartitions), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::OK),
+                                     partitions_response));
+
+    client::CancellationContext context;
+    ApiLookupClient lookup_client(catalog, settings);
+    repository::PartitionsRepository repository(catalog, kVersionedLayerId,
+                                                settings, lookup_client);
+    read::PartitionsRequest request;
+
+    auto response = repository.GetVersionedPartitionsExtendedResponse(
+        request, kVersion, context);
+
+    ASSERT_TRUE(response.IsSuccessful()) << response.GetError().GetMessage();
+    const auto& partitions = response.GetResult().GetPartitions();
+    ASSERT_EQ(partitions.size(), kPartitionsCount);
+    // The partitions are in the response order
+    EXPECT_EQ(partitions.front().GetPartition(), "0");
+    EXPECT_EQ(partitions.back().GetPartition(),
+              std::to_string(kPartitionsCount - 1));
+
+    request.WithFetchOption(read::CacheOnly);
+
+    response = repository.GetVersionedPartitionsExtendedResponse(
+        request, kVersion, context);
+
+    ASSERT_TRUE(response.IsSuccessful()) << response.GetError().GetMessage();
+    EXPECT_EQ(response.GetResult().GetPartitions().size(), kPartitionsCount);
+  }
+  {
+    SCOPED_TRACE("Unknown values skipped");
+
+    const auto partitions_response =
+        R"jsonString({"partitions":[{"version":4,"partition":"1","dataHandle":"handle-1","dataSize":5000000000,"checksum":null,"additionalMetadata":{"tags":["a","b"]},"deleted":false}],"next":null})jsonString";
+
+    OlpClientSettings settings;
+    settings.cache = client::OlpClientSettingsFactory::CreateDefaultCache({});
+    settings.network_request_handler = mock_network;
+    settings.task_scheduler =
+        client::OlpClientSettingsFactory::CreateDefaultTaskScheduler(1u);
+    settings.retry_settings.timeout = 1;
+
+    EXPECT_CALL(*mock_network,
+                Send(IsGetRequest(kOlpSdkUrlLookupMetadata2), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::OK),
+                                     kOlpSdkHttpResponseLookupMetadata2));
+
+    EXPECT_CALL(*mock_network,
+                Send(IsGetRequest(kOlpSdkUrlVersionedPartitions), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::OK),
+                                     partitions_response));
+
+    client::CancellationContext context;
+    ApiLookupClient lookup_client(catalog, settings);
+    repository::PartitionsRepository repository(catalog, kVersionedLayerId,
+                                                settings, lookup_client);
+
+    auto response = repository.GetVersionedPartitionsExtendedResponse(
+        read::PartitionsRequest(), kVersion, context);
+
+    ASSERT_TRUE(response.IsSuccessful()) << response.GetError().GetMessage();
+    const auto& partitions = response.GetResult().GetPartitions();
+    ASSERT_EQ(partitions.size(), 1u);
+    EXPECT_EQ(partitions.front().GetDataHandle(), "handle-1");
+    EXPECT_EQ(partitions.front().GetDataSize().get_value_or(0), 5000000000);
+    EXPECT_FALSE(partitions.front().GetChecksum());
+  }
+  {
+    SCOPED_TRACE("Parsed while downloaded, single scheduler thread is busy");
+
+    // The first chunk contains more partitions than a single cache write
+    const size_t kPartitionsCount = 1500u;
+    std::string first_chunk = R"jsonString({"partitions":[)jsonString";
+    std::string last_chunk;
+    for (size_t i = 0; i < kPartitionsCount; ++i) {
+      auto& chunk = i < 1200u ? first_chunk : last_chunk;
+      if (i > 0) {
+        chunk.append(",");
+      }
+      const auto index = std::to_string(i);
+      chunk.append(R"({"version":4,"partition":")" + index +
+                   R"(","dataHandle":"handle-)" + index + R"("})");
+    }
+    last_chunk.append("]}");
+
+    OlpClientSettings settings;
+    settings.cache = client::OlpClientSettingsFactory::CreateDefaultCache({});
+    settings.network_request_handler = mock_network;
+    settings.task_scheduler =
+        client::OlpClientSettingsFactory::CreateDefaultTaskScheduler(1u);
+    settings.retry_settings.timeout = 1;
+
+    const std::string first_batch_key = kCatalog + "::" + kVersionedLayerId +
+                                        "::0::" + std::to_string(kVersion) +
+                                        "::partition";
+    auto cache = settings.cache;
+    std::promise<bool> parsed_before_completion;
+
+    EXPECT_CALL(*mock_network,
+                Send(IsGetRequest(kOlpSdkUrlLookupMetadata2), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::OK),
+                                     kOlpSdkHttpResponseLookupMetadata2));
+
+    EXPECT_CALL(*mock_network,
+                Send(IsGetRequest(kOlpSdkUrlVersionedPartitions), _, _, _, _))
+        .WillOnce([&](olp::http::NetworkRequest /*request*/,
+                      olp::http::Network::Payload /*payload*/,
+                      olp::http::Network::Callback callback,
+                      olp::http::Network::HeaderCallback /*header_callback*/,
+                      olp::http::Network::DataCallback data_callback) {
+          std::thread([=, &parsed_before_completion]() {
+            data_callback(
+                reinterpret_cast<const uint8_t*>(first_chunk.data()), 0,
+                first_chunk.size());
+
+            // The first batch is cached before the response is completed
+            auto parsed = false;
+            for (auto i = 0; i < 100 && !parsed; ++i) {
+              std::this_thread::sleep_for(std::chrono::milliseconds(50));
+              parsed = cache->Contains(first_batch_key);
+            }
+            parsed_before_completion.set_value(parsed);
+
+            data_callback(reinterpret_cast<const uint8_t*>(last_chunk.data()),
+                          first_chunk.size(), last_chunk.size());
+            callback(olp::http::NetworkResponse()
+                         .WithStatus(olp::http::HttpStatusCode::OK)
+                         .WithRequestId(6));
+          })
+              .detach();
+          return olp::http::SendOutcome(6);
+        });
+
+    ApiLookupClient lookup_client(catalog, settings);
+    repository::PartitionsRepository repository(catalog, kVersionedLayerId,
+                                                settings, lookup_client);
+
+    // The request occupies the only scheduler thread
+    std::promise<read::QueryApi::PartitionsExtendedResponse> promise;
+    settings.task_scheduler->ScheduleTask([&]() {
+      promise.set_value(repository.GetVersionedPartitionsExtendedResponse(
+          read::PartitionsRequest(), kVersion, client::CancellationContext()));
+    });
+
+    auto future = promise.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(10)),
+              std::future_status::ready);
+    auto response = future.get();
+
+    EXPECT_TRUE(parsed_before_completion.get_future().get());
+    ASSERT_TRUE(response.IsSuccessful()) << response.GetError().GetMessage();
+    EXPECT_EQ(response.GetResult().GetPartitions().size(), kPartitionsCount);
+  }
 }
 
 TEST_F(PartitionsRepositoryTest, GetVolatilePartitions) {
@@ -1681,6 +1867,45 @@ TEST_F(PartitionsRepositoryTest, GetVersionedPartitionsBatch) {
     EXPECT_EQ(response.GetError().GetErrorCode(),
               olp::client::ErrorCode::BadRequest);
   }
+  {
+    SCOPED_TRACE("Parallel fetch from network with a list of partitions");
+
+    OlpClientSettings settings;
+    settings.cache = client::OlpClientSettingsFactory::CreateDefaultCache({});
+    settings.network_request_handler = mock_network;
+    settings.retry_settings.timeout = 1;
+    settings.task_scheduler =
+        client::OlpClientSettingsFactory::CreateDefaultTaskScheduler(2);
+
+    EXPECT_CALL(*mock_network,
+                Send(IsGetRequest(kOlpSdkUrlLookupQuery), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::OK),
+                                     kOlpSdkHttpResponseLookupQuery));
+
+    const PartitionIds partitions{450, kPartitionId};
+    const auto batchedUrls = createBatchedUrls(partitions);
+
+    for (const std::string& url : batchedUrls) {
+      EXPECT_CALL(*mock_network, Send(IsGetRequest(url), _, _, _, _))
+          .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                           olp::http::HttpStatusCode::OK),
+                                       kOlpSdkHttpResponsePartitionById));
+    }
+
+    client::CancellationContext context;
+    ApiLookupClient lookup_client(catalog, settings);
+    repository::PartitionsRepository repository(catalog, kVersionedLayerId,
+                                                settings, lookup_client);
+    read::PartitionsRequest request;
+    request.WithPartitionIds(partitions).WithMaxParallelQueries(4);
+
+    auto response = repository.GetVersionedPartitionsExtendedResponse(
+        request, kVersion, context);
+
+    ASSERT_TRUE(response.IsSuccessful()) << response.GetError().GetMessage();
+    EXPECT_EQ(response.GetResult().GetPartitions().size(), batchedUrls.size());
+  }
 }
 
 TEST_F(PartitionsRepositoryTest, GetVersionedPartitionsBatch_MockedCache) {
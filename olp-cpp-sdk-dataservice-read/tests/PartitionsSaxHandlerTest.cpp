@@ -19,6 +19,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "repositories/PartitionsSaxHandler.h"
 
 namespace {
@@ -101,12 +103,10 @@ TEST(PartitionsSaxHandlerTest, WrongJSONStructure) {
 
   ASSERT_TRUE(handler.StartObject());
 
-  // next state expects a partitions string
-  ASSERT_FALSE(handler.String(kDataHandle, len(kDataHandle), true));
+  // next state expects an attribute name
   ASSERT_FALSE(handler.Uint(6));
   ASSERT_FALSE(handler.StartArray());
   ASSERT_FALSE(handler.StartObject());
-  ASSERT_FALSE(handler.EndObject(0));
   ASSERT_FALSE(handler.EndArray(0));
 
   ASSERT_TRUE(handler.String(kPartitions, len(kPartitions), true));
@@ -137,27 +137,15 @@ TEST(PartitionsSaxHandlerTest, WrongJSONStructure) {
 
   ASSERT_TRUE(handler.String(kDataHandle, len(kDataHandle), true));
 
-  // expect string attribute value
-  ASSERT_FALSE(handler.Uint(6));
-  ASSERT_FALSE(handler.StartArray());
+  // expect attribute value
   ASSERT_FALSE(handler.EndObject(0));
+  ASSERT_FALSE(handler.EndArray(0));
 
   ASSERT_TRUE(handler.String(kDataHandleValue, len(kDataHandleValue), true));
 
   // object is not valid
   ASSERT_FALSE(handler.EndObject(0));
 
-  // integer properties
-  ASSERT_TRUE(handler.String(kDataSize, len(kDataSize), true));
-
-  ASSERT_FALSE(handler.String(kDataHandle, len(kDataHandle), true));
-  ASSERT_FALSE(handler.StartArray());
-  ASSERT_FALSE(handler.EndArray(0));
-  ASSERT_FALSE(handler.StartObject());
-  ASSERT_FALSE(handler.EndObject(0));
-
-  ASSERT_TRUE(handler.Uint(6));
-
   ASSERT_TRUE(handler.String(kPartition, len(kPartition), true));
   ASSERT_TRUE(handler.String(kPartitionValue, len(kPartitionValue), true));
 
@@ -179,4 +167,90 @@ TEST(PartitionsSaxHandlerTest, WrongJSONStructure) {
   ASSERT_FALSE(handler.EndObject(0));
 }
 
+TEST(PartitionsSaxHandlerTest, SkipUnknownValues) {
+  std::vector<model::Partition> parsed_partitions;
+  auto callback = [&](model::Partition partition) {
+    parsed_partitions.push_back(std::move(partition));
+  };
+
+  repository::PartitionsSaxHandler handler(callback);
+
+  const char* kUnknown = "unknown";
+
+  ASSERT_TRUE(handler.StartObject());
+
+  // unknown root attributes
+  ASSERT_TRUE(handler.String(kUnknown, len(kUnknown), true));
+  ASSERT_TRUE(handler.StartObject());
+  ASSERT_TRUE(handler.String(kPartitions, len(kPartitions), true));
+  ASSERT_TRUE(handler.StartArray());
+  ASSERT_TRUE(handler.EndArray(0));
+  ASSERT_TRUE(handler.EndObject(0));
+  ASSERT_TRUE(handler.String(kVersion, len(kVersion), true));
+  ASSERT_TRUE(handler.Default());
+
+  ASSERT_TRUE(handler.String(kPartitions, len(kPartitions), true));
+  ASSERT_TRUE(handler.StartArray());
+
+  ASSERT_TRUE(handler.StartObject());
+  ASSERT_TRUE(handler.String(kDataHandle, len(kDataHandle), true));
+  ASSERT_TRUE(handler.String(kDataHandleValue, len(kDataHandleValue), true));
+  ASSERT_TRUE(handler.String(kPartition, len(kPartition), true));
+  ASSERT_TRUE(handler.String(kPartitionValue, len(kPartitionValue), true));
+  // 64 bit values
+  ASSERT_TRUE(handler.String(kDataSize, len(kDataSize), true));
+  ASSERT_TRUE(handler.Uint64(5000000000u));
+  ASSERT_TRUE(handler.String(kVersion, len(kVersion), true));
+  ASSERT_TRUE(handler.Int64(-1));
+  // null and values of unexpected types
+  ASSERT_TRUE(handler.String(kChecksum, len(kChecksum), true));
+  ASSERT_TRUE(handler.Default());
+  ASSERT_TRUE(handler.String(kCompressedDataSize, len(kCompressedDataSize),
+                             true));
+  ASSERT_TRUE(handler.String(kChecksumValue, len(kChecksumValue), true));
+  ASSERT_TRUE(handler.String(kCrc, len(kCrc), true));
+  ASSERT_TRUE(handler.Uint(6));
+  // unknown attributes of any type
+  ASSERT_TRUE(handler.String(kUnknown, len(kUnknown), true));
+  ASSERT_TRUE(handler.StartArray());
+  ASSERT_TRUE(handler.StartObject());
+  ASSERT_TRUE(handler.String(kDataHandle, len(kDataHandle), true));
+  ASSERT_TRUE(handler.Default());
+  ASSERT_TRUE(handler.EndObject(0));
+  ASSERT_TRUE(handler.Uint(6));
+  ASSERT_TRUE(handler.EndArray(0));
+  ASSERT_TRUE(handler.String(kUnknown, len(kUnknown), true));
+  ASSERT_TRUE(handler.Default());
+  ASSERT_TRUE(handler.EndObject(0));
+
+  // the next partition has no attributes of the previous one
+  ASSERT_TRUE(handler.StartObject());
+  ASSERT_TRUE(handler.String(kDataHandle, len(kDataHandle), true));
+  ASSERT_TRUE(handler.String(kDataHandleValue, len(kDataHandleValue), true));
+  ASSERT_TRUE(handler.String(kPartition, len(kPartition), true));
+  ASSERT_TRUE(handler.String(kPartitionValue, len(kPartitionValue), true));
+  ASSERT_TRUE(handler.EndObject(0));
+
+  ASSERT_TRUE(handler.EndArray(0));
+
+  // unknown root attribute after the partitions
+  ASSERT_TRUE(handler.String(kUnknown, len(kUnknown), true));
+  ASSERT_TRUE(handler.String(kUnknown, len(kUnknown), true));
+  ASSERT_TRUE(handler.EndObject(0));
+
+  ASSERT_EQ(parsed_partitions.size(), 2u);
+
+  const auto& partition = parsed_partitions.front();
+  EXPECT_EQ(partition.GetDataHandle(), std::string(kDataHandleValue));
+  EXPECT_EQ(partition.GetPartition(), std::string(kPartitionValue));
+  EXPECT_EQ(partition.GetDataSize().get_value_or(0), 5000000000);
+  EXPECT_EQ(partition.GetVersion().get_value_or(0), -1);
+  EXPECT_FALSE(partition.GetChecksum());
+  EXPECT_FALSE(partition.GetCompressedDataSize());
+  EXPECT_FALSE(partition.GetCrc());
+
+  EXPECT_FALSE(parsed_partitions.back().GetDataSize());
+  EXPECT_FALSE(parsed_partitions.back().GetVersion());
+}
+
 }  // namespace
@@ -199,6 +199,29 @@ TEST_F(StreamApiTest, Subscribe) {
 
     Mock::VerifyAndClearExpectations(network_mock_.get());
   }
+  {
+    SCOPED_TRACE("Subscribe with a lowercase correlation ID header");
+
+    EXPECT_CALL(*network_mock_,
+                Send(IsPostRequest(kUrlSubscribeNoQueryParams), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(
+            http::NetworkResponse().WithStatus(http::HttpStatusCode::CREATED),
+            kHttpResponseSubscribeSucceeds,
+            {{"x-correlation-id", kCorrelationId}}));
+
+    olp_client_.SetBaseUrl(kBaseUrl);
+    std::string x_correlation_id;
+    client::CancellationContext context;
+    const auto subscribe_response = read::StreamApi::Subscribe(
+        olp_client_, kLayerId, boost::none, boost::none, boost::none,
+        boost::none, context, x_correlation_id);
+
+    EXPECT_TRUE(subscribe_response.IsSuccessful())
+        << ApiErrorToString(subscribe_response.GetError());
+    EXPECT_EQ(x_correlation_id, kCorrelationId);
+
+    Mock::VerifyAndClearExpectations(network_mock_.get());
+  }
   {
     SCOPED_TRACE("Subscribe fails");
 
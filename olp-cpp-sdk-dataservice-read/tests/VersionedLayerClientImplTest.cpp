@@ -107,6 +107,83 @@ TEST(VersionedLayerClientTest, GetData) {
   Mock::VerifyAndClearExpectations(network_mock.get());
 }
 
+TEST(VersionedLayerClientTest, GetDataBatch) {
+  std::shared_ptr<NetworkMock> network_mock = std::make_shared<NetworkMock>();
+  olp::client::OlpClientSettings settings;
+  settings.network_request_handler = network_mock;
+  settings.cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+  settings.task_scheduler =
+      olp::client::OlpClientSettingsFactory::CreateDefaultTaskScheduler(2u);
+
+  auto apis = ApiDefaultResponses::GenerateResourceApisResponse(kCatalog);
+  auto api_response = ResponseGenerator::ResourceApis(apis);
+  PlatformUrlsGenerator generator(apis, kLayerId);
+
+  const std::string kOtherDataHandle = "other-data-handle";
+
+  read::VersionedLayerClientImpl client(kHrn, kLayerId, boost::none, settings);
+
+  {
+    SCOPED_TRACE("Missing data is downloaded");
+
+    EXPECT_CALL(*network_mock, Send(IsGetRequest(kUrlLookup), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::OK),
+                                     api_response));
+    EXPECT_CALL(*network_mock,
+                Send(IsGetRequest(generator.DataBlob(kBlobDataHandle)), _, _,
+                     _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::OK),
+                                     "someData"));
+
+    std::vector<read::DataRequest> requests = {
+        read::DataRequest().WithDataHandle(kBlobDataHandle)};
+
+    auto future = client.GetData(std::move(requests)).GetFuture();
+    ASSERT_EQ(future.wait_for(kTimeout), std::future_status::ready);
+
+    const auto response = future.get();
+    ASSERT_TRUE(response.IsSuccessful());
+    ASSERT_EQ(response.GetResult().size(), 1u);
+    ASSERT_TRUE(response.GetResult()[0].IsSuccessful());
+    const auto& data = response.GetResult()[0].GetResult();
+    EXPECT_EQ(std::string(data->begin(), data->end()), "someData");
+    Mock::VerifyAndClearExpectations(network_mock.get());
+  }
+
+  {
+    SCOPED_TRACE("Results are in the order of the requests");
+
+    std::vector<read::DataRequest> requests = {
+        read::DataRequest()
+            .WithDataHandle(kOtherDataHandle)
+            .WithFetchOption(read::CacheOnly),
+        read::DataRequest()
+            .WithPartitionId(kPartitionId)
+            .WithDataHandle(kBlobDataHandle),
+        read::DataRequest()
+            .WithDataHandle(kBlobDataHandle)
+            .WithFetchOption(read::CacheOnly)};
+
+    auto future = client.GetData(std::move(requests)).GetFuture();
+    ASSERT_EQ(future.wait_for(kTimeout), std::future_status::ready);
+
+    const auto response = future.get();
+    ASSERT_TRUE(response.IsSuccessful());
+    const auto& results = response.GetResult();
+    ASSERT_EQ(results.size(), 3u);
+    ASSERT_FALSE(results[0].IsSuccessful());
+    EXPECT_EQ(results[0].GetError().GetErrorCode(), ErrorCode::NotFound);
+    ASSERT_FALSE(results[1].IsSuccessful());
+    EXPECT_EQ(results[1].GetError().GetErrorCode(),
+              ErrorCode::PreconditionFailed);
+    ASSERT_TRUE(results[2].IsSuccessful());
+    EXPECT_EQ(results[2].GetResult()->size(), 8u);
+  }
+}
+
 TEST(VersionedLayerClientTest, DeleteFromCachePartition) {
   olp::client::OlpClientSettings settings;
   std::shared_ptr<CacheMock> cache_mock = std::make_shared<CacheMock>();
@@ -19,16 +19,29 @@
 
 #pragma once
 
+#include <cstddef>
+
+#include <olp/dataservice/write/DataServiceWriteApi.h>
+
 namespace olp {
 namespace dataservice {
 namespace write {
 
-struct AutoFlushSettings {
+/// Configures the background flush of the requests queued to the
+/// `StreamLayerClient`.
+struct DATASERVICE_WRITE_API AutoFlushSettings {
   /**
    * How many requests can be cached before an auto flush event is triggered.
+   * Setting 0 indicates this feature is disabled.
    */
   int auto_flush_num_events = 20;
 
+  /**
+   * The total size (in bytes) of the queued data that triggers an auto flush
+   * event. Setting 0 indicates this feature is disabled.
+   */
+  size_t auto_flush_data_size = 0u;
+
   /**
    * The period (in seconds) between sequential auto flush events when using
    * interval based auto-flush. Setting 0 indicates this feature is disabled.
@@ -24,7 +24,7 @@
 #include <mutex>
 #include <vector>
 
-#include "FlushEventListener.h"
+#include <olp/dataservice/write/FlushEventListener.h>
 
 namespace olp {
 namespace dataservice {
@@ -32,9 +32,9 @@ namespace write {
 
 /**
  @brief Default implementation of the FlushEventListener.
- @deprecated Currently deperecated and not used in the public API.
- Should be refactored and used directly in \c StreamLayerClientImpl and \c
- AutoFlushController.
+
+ Collects the \c FlushMetrics of the flush events. Override
+ \c NotifyFlushMetricsHasChanged to get the updated metrics.
  */
 template <typename FlushResponse>
 class DefaultFlushEventListener : public FlushEventListener<FlushResponse> {
@@ -49,20 +49,37 @@ class DefaultFlushEventListener : public FlushEventListener<FlushResponse> {
     NotifyFlushMetricsHasChanged(std::move(metrics));
   }
 
-  void NotifyFlushEventResults(FlushResponse results) override;
+  void NotifyFlushEventResults(FlushResponse results) override {
+    FlushMetrics metrics;
+    {
+      std::lock_guard<std::mutex> locker(mutex_);
+      ++metrics_.num_total_flush_events;
+      if (results.empty() || CollateFlushEventResults(results)) {
+        ++metrics_.num_failed_flush_events;
+      }
+      metrics = metrics_;
+    }
+    NotifyFlushMetricsHasChanged(std::move(metrics));
+  }
+
+  void NotifyFlushMetricsHasChanged(FlushMetrics /*metrics*/) override {}
 
-  void NotifyFlushMetricsHasChanged(FlushMetrics metrics) override{};
+  /// Gets the metrics collected so far.
+  FlushMetrics GetMetrics() const {
+    std::lock_guard<std::mutex> locker(mutex_);
+    return metrics_;
+  }
 
  protected:
   template <typename T>
   bool CollateFlushEventResults(const std::vector<T>& results) {
     metrics_.num_total_flushed_requests += results.size();
 
-    thread_local size_t flush_requests_failed =
-        std::count_if(std::begin(results), std::end(results),
-                      [](T result) -> bool { return !result.IsSuccessful(); });
+    const size_t flush_requests_failed = std::count_if(
+        std::begin(results), std::end(results),
+        [](const T& result) -> bool { return !result.IsSuccessful(); });
     metrics_.num_failed_flushed_requests += flush_requests_failed;
-    return flush_requests_failed > 0ull;
+    return flush_requests_failed > 0u;
   }
 
   mutable std::mutex mutex_;
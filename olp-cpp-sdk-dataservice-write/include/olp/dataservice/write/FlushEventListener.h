@@ -19,7 +19,7 @@
 
 #pragma once
 
-#include "FlushMetrics.h"
+#include <olp/dataservice/write/FlushMetrics.h>
 
 namespace olp {
 namespace dataservice {
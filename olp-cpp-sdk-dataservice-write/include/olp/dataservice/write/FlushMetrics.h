@@ -33,28 +33,28 @@ struct FlushMetrics {
   /**
   * @brief Number of attempted flush events.
   */
-  size_t num_attempted_flush_events;
+  size_t num_attempted_flush_events{0u};
 
   /**
    * @brief Number of failed flush events
    */
-  size_t num_failed_flush_events;
+  size_t num_failed_flush_events{0u};
 
   /**
    * @brief Total number of flush events.
    */
-  size_t num_total_flush_events;
+  size_t num_total_flush_events{0u};
 
   /**
    * @brief Total number of requests queued to \c StreamLayerClient.
    */
-  size_t num_total_flushed_requests;
+  size_t num_total_flushed_requests{0u};
 
   /**
    * @brief Number of failed requests, which were queued to \c
    * StreamLayerClient.
    */
-  size_t num_failed_flushed_requests;
+  size_t num_failed_flushed_requests{0u};
 };
 
 }  // namespace write
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <future>
 #include <memory>
 #include <string>
 #include <vector>
@@ -27,7 +28,9 @@
 #include <olp/core/client/ApiResponse.h>
 #include <olp/core/client/OlpClientSettings.h>
 #include <olp/core/porting/deprecated.h>
+#include <olp/dataservice/write/AutoFlushSettings.h>
 #include <olp/dataservice/write/DataServiceWriteApi.h>
+#include <olp/dataservice/write/FlushEventListener.h>
 #include <olp/dataservice/write/StreamLayerClientSettings.h>
 #include <olp/dataservice/write/generated/model/ResponseOk.h>
 #include <olp/dataservice/write/generated/model/ResponseOkSingle.h>
@@ -64,6 +67,9 @@ class DATASERVICE_WRITE_API StreamLayerClient {
   /// An alias for the flush callback.
   using FlushCallback = std::function<void(FlushResponse response)>;
 
+  /// An alias for the listener of the auto flush events.
+  using FlushListener = FlushEventListener<const FlushResponse&>;
+
   /**
    * @brief Creates the `StreamLayerClient` insatnce.
    *
@@ -132,6 +138,11 @@ class DATASERVICE_WRITE_API StreamLayerClient {
   /**
    * @brief Flushes `PublishDataRequests` that are queued via the Queue API.
    *
+   * The requests that fail with a retryable error, or are not published
+   * because the flush is cancelled, are queued back to the front of the
+   * queue. The requests that fail with other errors are removed from the
+   * queue, their errors are in `FlushResponse`.
+   *
    * @param request The `FlushRequest` object.
    *
    * @return `CancellableFuture` that contains `FlushResponse`.
@@ -152,6 +163,31 @@ class DATASERVICE_WRITE_API StreamLayerClient {
   olp::client::CancellationToken Flush(model::FlushRequest request,
                                        FlushCallback callback);
 
+  /**
+   * @brief Enables the background flush of the requests queued via
+   * the Queue API.
+   *
+   * The flush is triggered when the number of the queued requests or their
+   * total data size reaches the configured limit, and periodically if
+   * the interval is set. Calling this method again replaces the settings.
+   *
+   * @param settings The `AutoFlushSettings` instance with the flush triggers.
+   * @param listener The optional listener that is notified about the flush
+   * events and their results. Use `DefaultFlushEventListener` to collect
+   * the `FlushMetrics`.
+   */
+  void EnableAutoFlush(AutoFlushSettings settings,
+                       std::shared_ptr<FlushListener> listener = nullptr);
+
+  /**
+   * @brief Disables the background flush and cancels the ongoing auto flush
+   * events.
+   *
+   * @return The future that is ready when the ongoing auto flush events are
+   * finished.
+   */
+  std::future<void> DisableAutoFlush();
+
   /**
    * @brief Sends a list of SDII messages to a stream layer.
    *
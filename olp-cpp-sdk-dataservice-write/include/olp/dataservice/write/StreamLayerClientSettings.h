@@ -36,6 +36,22 @@ struct DATASERVICE_WRITE_API StreamLayerClientSettings {
    * Make sure it is a positive number.
    */
   size_t maximum_requests = std::numeric_limits<size_t>::max();
+
+  /**
+   * @brief The maximum number of the queued requests that are published in
+   * parallel by `Flush`.
+   *
+   * The default value 1 publishes the requests one by one in the queue order.
+   */
+  size_t flush_parallel_requests = 1u;
+
+  /**
+   * @brief Publishes the queued requests to the same layer in the queue order
+   * when they are flushed in parallel.
+   *
+   * The requests to the different layers are still published in parallel.
+   */
+  bool flush_preserve_layer_order = false;
 };
 
 }  // namespace write
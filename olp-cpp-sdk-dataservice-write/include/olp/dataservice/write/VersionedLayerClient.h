@@ -20,6 +20,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <olp/core/client/ApiError.h>
 #include <olp/core/client/ApiNoResult.h>
@@ -71,6 +72,11 @@ using PublishPartitionDataResponse =
 using PublishPartitionDataCallback =
     std::function<void(PublishPartitionDataResponse response)>;
 
+using PublishPartitionsDataResponse =
+    client::ApiResponse<model::ResponseOk, client::ApiError>;
+using PublishPartitionsDataCallback =
+    std::function<void(PublishPartitionsDataResponse response)>;
+
 using CheckDataExistsStatusCode = int;
 using CheckDataExistsResponse =
     client::ApiResponse<CheckDataExistsStatusCode, client::ApiError>;
@@ -246,6 +252,53 @@ class DATASERVICE_WRITE_API VersionedLayerClient {
       const model::Publication& pub, model::PublishPartitionDataRequest request,
       PublishPartitionDataCallback callback);
 
+  /**
+   * @brief Publishes the data of several partitions to the versioned layers.
+   *
+   * The blobs are uploaded concurrently, with a bounded number of uploads in
+   * flight. The partitions metadata is uploaded in chunks of many partitions
+   * per request, as soon as the blobs of a chunk are uploaded.
+   *
+   * If one of the uploads fails, no new uploads are started and the error is
+   * returned. The upload is not atomic: the metadata chunks that are already
+   * uploaded stay in the publication, and the blobs uploaded for the failed
+   * chunks are not referenced by any partition. Call `CancelBatch` to discard
+   * the publication with all its partitions, or publish the failed requests
+   * again before `CompleteBatch`.
+   *
+   * @note The content-type of every request is set implicitly based on
+   * the layer metadata of its target layer.
+   *
+   * @param pub The `Publication` instance.
+   * @param requests The `PublishPartitionDataRequest` objects.
+   *
+   * @return `CancellableFuture` that contains `PublishPartitionsDataResponse`
+   * with the publication ID as the parent ID and the partition IDs in the
+   * order of the requests as the generated IDs.
+   */
+  olp::client::CancellableFuture<PublishPartitionsDataResponse> PublishToBatch(
+      const model::Publication& pub,
+      std::vector<model::PublishPartitionDataRequest> requests);
+
+  /**
+   * @brief Publishes the data of several partitions to the versioned layers.
+   *
+   * @see `PublishToBatch(const model::Publication&,
+   * std::vector<model::PublishPartitionDataRequest>)` for details.
+   *
+   * @param pub The `Publication` instance.
+   * @param requests The `PublishPartitionDataRequest` objects.
+   * @param callback `PublishPartitionsDataCallback` that is called with
+   * `PublishPartitionsDataResponse` when the operation completes.
+   *
+   * @return `CancellationToken` that can be used to cancel the ongoing
+   * request.
+   */
+  olp::client::CancellationToken PublishToBatch(
+      const model::Publication& pub,
+      std::vector<model::PublishPartitionDataRequest> requests,
+      PublishPartitionsDataCallback callback);
+
   /**
    * @brief Checks whether the data handle exits.
    *
@@ -19,6 +19,9 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -35,6 +38,22 @@ namespace model {
 /// Publishes data to a versioned and volatile layer.
 class DATASERVICE_WRITE_API PublishPartitionDataRequest {
  public:
+  /**
+   * @brief Reads the next chunk of the data to be published.
+   *
+   * Fills the buffer with up to `size` bytes of the data, and returns the
+   * number of bytes read. Returns 0 at the end of the data, and a negative
+   * value on a read error. The reader is called from one thread at a time.
+   */
+  using DataReader =
+      std::function<std::int64_t(unsigned char* buffer, std::size_t size)>;
+
+  /// The default size of the parts of the multipart upload, 5 MB.
+  static constexpr std::size_t kDefaultPartSize = 5u * 1024u * 1024u;
+
+  /// The default number of the parts uploaded in parallel.
+  static constexpr std::size_t kDefaultParallelParts = 4u;
+
   PublishPartitionDataRequest() = default;
   PublishPartitionDataRequest(const PublishPartitionDataRequest&) = default;
   PublishPartitionDataRequest(PublishPartitionDataRequest&&) = default;
@@ -75,6 +94,96 @@ class DATASERVICE_WRITE_API PublishPartitionDataRequest {
     return *this;
   }
 
+  /**
+   * @brief Gets the reader of the data to be published.
+   *
+   * @return The data reader.
+   */
+  inline const DataReader& GetDataReader() const { return data_reader_; }
+
+  /**
+   * @brief Sets the reader of the data to be published to the HERE platform.
+   *
+   * Use it instead of `WithData` to publish the data that does not fit into
+   * memory. The data is uploaded to the versioned layer in parts, and several
+   * parts are uploaded in parallel, so only about the part size multiplied by
+   * the number of the parallel parts is kept in memory. A failed part is
+   * retried according to the retry settings of the client, without
+   * restarting the whole upload.
+   *
+   * @note Only the versioned layers support the multipart upload.
+   *
+   * @param reader The data reader.
+   */
+  inline PublishPartitionDataRequest& WithDataReader(DataReader reader) {
+    data_reader_ = std::move(reader);
+    return *this;
+  }
+
+  /**
+   * @brief Gets the size of the parts of the multipart upload.
+   *
+   * @return The part size in bytes.
+   */
+  inline std::size_t GetPartSize() const { return part_size_; }
+
+  /**
+   * @brief Sets the size of the parts of the multipart upload.
+   *
+   * The service requires all the parts except the last one to be at least
+   * 5 MB, and accepts up to 10000 parts.
+   *
+   * @param part_size The part size in bytes.
+   */
+  inline PublishPartitionDataRequest& WithPartSize(std::size_t part_size) {
+    part_size_ = part_size;
+    return *this;
+  }
+
+  /**
+   * @brief Gets the number of the parts uploaded in parallel.
+   *
+   * @return The number of the parallel parts.
+   */
+  inline std::size_t GetParallelParts() const { return parallel_parts_; }
+
+  /**
+   * @brief Sets the number of the parts uploaded in parallel.
+   *
+   * @param parallel_parts The number of the parallel parts.
+   */
+  inline PublishPartitionDataRequest& WithParallelParts(
+      std::size_t parallel_parts) {
+    parallel_parts_ = parallel_parts;
+    return *this;
+  }
+
+  /**
+   * @brief Checks whether the upload of the data that already exists is
+   * skipped.
+   *
+   * @return True if the existing data is not uploaded again.
+   */
+  inline bool GetDeduplication() const { return deduplication_; }
+
+  /**
+   * @brief Skips the upload of the data that already exists in the layer.
+   *
+   * The data handle is the SHA-256 hash of the data, so the same data always
+   * gets the same data handle. The data is uploaded only when no blob with
+   * this data handle exists in the layer. Use it when the same data is
+   * published in several versions or to several partitions.
+   *
+   * @note Only the data set with `WithData` is deduplicated, the data that
+   * is read with the data reader is always uploaded.
+   *
+   * @param deduplication True to skip the upload of the existing data.
+   */
+  inline PublishPartitionDataRequest& WithDeduplication(bool deduplication) {
+    deduplication_ = deduplication;
+    return *this;
+  }
+
   /**
    * @brief Gets the layer ID of the catalog where you want to store the data.
    *
@@ -227,6 +336,14 @@ class DATASERVICE_WRITE_API PublishPartitionDataRequest {
  private:
   std::shared_ptr<std::vector<unsigned char>> data_;
 
+  DataReader data_reader_;
+
+  std::size_t part_size_{kDefaultPartSize};
+
+  std::size_t parallel_parts_{kDefaultParallelParts};
+
+  bool deduplication_{false};
+
   std::string layer_id_;
 
   boost::optional<std::string> partition_id_;
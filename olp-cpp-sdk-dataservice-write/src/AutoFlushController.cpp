@@ -19,6 +19,10 @@
 
 #include "AutoFlushController.h"
 
+#include <map>
+#include <set>
+#include <thread>
+
 #include <olp/dataservice/write/StreamLayerClient.h>
 #include "BackgroundTaskCollection.h"
 #include "StreamLayerClientImpl.h"
@@ -36,11 +40,7 @@ namespace write {
 class DisabledAutoFlushControllerImpl
     : public AutoFlushController::AutoFlushControllerImpl {
  public:
-  std::future<void> Disable() override {
-    std::promise<void> ret;
-    ret.set_value();
-    return ret.get_future();
-  }
+  void Disable() override {}
 
   void NotifyQueueEventStart() override {}
 
@@ -61,10 +61,12 @@ class EnabledAutoFlushControllerImpl
  public:
   EnabledAutoFlushControllerImpl(
       std::shared_ptr<ClientImpl> client_impl, AutoFlushSettings flush_settings,
-      std::shared_ptr<FlushEventListener<FlushResponse>> listener)
+      std::shared_ptr<FlushEventListener<FlushResponse>> listener,
+      std::shared_ptr<AutoFlushController::FlushState> flush_state)
       : client_impl_(client_impl),
         flush_settings_(std::move(flush_settings)),
         listener_(listener),
+        flush_state_(std::move(flush_state)),
         background_task_col_(),
         cancel_mutex_(),
         cancel_token_map_(),
@@ -81,10 +83,7 @@ class EnabledAutoFlushControllerImpl
     AutoFlushNumEvents();
   }
 
-  std::future<void> Disable() override {
-    Cancel();
-    return WaitForBackgroundTaskCompletionAsync();
-  }
+  void Disable() override { Cancel(); }
 
   void NotifyQueueEventStart() override { HandleNotifyQueueEventStart(); }
 
@@ -95,13 +94,25 @@ class EnabledAutoFlushControllerImpl
   void AddCancelToken(size_t id,
                       const olp::client::CancellationToken& cancel_token) {
     std::lock_guard<std::mutex> lock(cancel_mutex_);
+    // The flush might be already finished, e.g. when there is no task
+    // scheduler and it runs synchronously.
+    if (completed_tasks_.erase(id) > 0u) {
+      return;
+    }
+
+    if (is_cancelled_) {
+      cancel_token.Cancel();
+    }
+
     cancel_token_map_.insert(
         std::pair<size_t, olp::client::CancellationToken>(id, cancel_token));
   }
 
   void RemoveCancelToken(size_t id) {
     std::lock_guard<std::mutex> lock(cancel_mutex_);
-    cancel_token_map_.erase(id);
+    if (cancel_token_map_.erase(id) == 0u) {
+      completed_tasks_.insert(id);
+    }
   }
 
   bool IsCancelled() {
@@ -111,17 +122,25 @@ class EnabledAutoFlushControllerImpl
 
  private:
   void AutoFlushNumEvents() {
-    if (IsAutoFlushNumEventsRequired()) {
+    if (IsAutoFlushRequired()) {
       AddBackgroundFlushTask();
     }
   }
 
-  bool IsAutoFlushNumEventsRequired() {
+  bool IsAutoFlushRequired() {
     auto impl_pointer = client_impl_.lock();
-    if (impl_pointer) {
-      return impl_pointer->QueueSize() >= flush_settings_.auto_flush_num_events;
+    if (!impl_pointer) {
+      return false;
+    }
+
+    const auto num_events = flush_settings_.auto_flush_num_events;
+    if (num_events > 0 &&
+        impl_pointer->QueueSize() >= static_cast<size_t>(num_events)) {
+      return true;
     }
-    return false;
+
+    const auto data_size = flush_settings_.auto_flush_data_size;
+    return data_size > 0u && impl_pointer->QueuedDataSize() >= data_size;
   }
 
   void InitialiseAutoFlushInterval() {
@@ -158,12 +177,40 @@ class EnabledAutoFlushControllerImpl
     is_cancelled_ = true;
   }
 
+  bool StartFlush() {
+    std::lock_guard<std::mutex> lock(flush_state_->mutex);
+    if (flush_state_->in_progress) {
+      return false;
+    }
+    flush_state_->in_progress = true;
+    return true;
+  }
+
+  void FinishFlush() {
+    std::vector<std::promise<void>> finished_promises;
+    {
+      std::lock_guard<std::mutex> lock(flush_state_->mutex);
+      flush_state_->in_progress = false;
+      finished_promises.swap(flush_state_->finished_promises);
+    }
+
+    for (auto& finished : finished_promises) {
+      finished.set_value();
+    }
+  }
+
   bool AddBackgroundFlushTask() {
     auto impl_pointer = client_impl_.lock();
-    if (!impl_pointer) {
+    if (!impl_pointer || IsCancelled()) {
       return false;
     }
 
+    // Only one flush runs at a time, the requests queued meanwhile are
+    // flushed by the next one.
+    if (!StartFlush()) {
+      return true;
+    }
+
     auto self = this->shared_from_this();
     NotifyFlushEventStart();
     auto flush_thread = std::thread([self, impl_pointer]() {
@@ -176,9 +223,10 @@ class EnabledAutoFlushControllerImpl
               num_requests_to_flush);
       auto cancel_token = impl_pointer->Flush(
           std::move(request), [self, id](FlushResponse results) {
-            self->background_task_col_.ReleaseTask(id);
             self->RemoveCancelToken(id);
             self->NotifyFlushEventResults(results);
+            self->background_task_col_.ReleaseTask(id);
+            self->FinishFlush();
           });
       self->AddCancelToken(id, cancel_token);
     });
@@ -202,61 +250,47 @@ class EnabledAutoFlushControllerImpl
     auto_flush_interval_thread.detach();
   }
 
-  void WaitForBackgroundTaskCompletion() {
-    background_task_col_.WaitForBackgroundTaskCompletion();
-  }
-
   template <typename T>
   void WaitForBackgroundTaskCompletion(const T& timeout) {
     background_task_col_.WaitForBackgroundTaskCompletion(timeout);
   }
 
-  std::future<void> WaitForBackgroundTaskCompletionAsync() {
-    auto self = this->shared_from_this();
-    auto ret = std::make_shared<std::promise<void>>();
-    std::thread([self, ret]() {
-      self->WaitForBackgroundTaskCompletion();
-      ret->set_value();
-    }).detach();
-    return ret->get_future();
-  }
-
  private:
   std::weak_ptr<ClientImpl> client_impl_;
   AutoFlushSettings flush_settings_;
   std::shared_ptr<FlushEventListener<FlushResponse>> listener_;
+  std::shared_ptr<AutoFlushController::FlushState> flush_state_;
   BackgroundTaskCollection<size_t> background_task_col_;
   std::mutex cancel_mutex_;
   std::map<size_t, olp::client::CancellationToken> cancel_token_map_;
+  std::set<size_t> completed_tasks_;
   bool is_cancelled_{false};
 };
 
-AutoFlushController::AutoFlushController(
-    const AutoFlushSettings& flush_settings)
-    : flush_settings_(flush_settings),
+AutoFlushController::AutoFlushController()
+    : flush_state_(std::make_shared<FlushState>()),
       impl_(std::make_shared<DisabledAutoFlushControllerImpl>()) {}
 
 template <typename ClientImpl, typename FlushResponse>
 void AutoFlushController::Enable(
-    std::shared_ptr<ClientImpl> client_impl,
+    std::shared_ptr<ClientImpl> client_impl, AutoFlushSettings flush_settings,
     std::shared_ptr<FlushEventListener<FlushResponse>> listener) {
-  if (std::dynamic_pointer_cast<
-          EnabledAutoFlushControllerImpl<ClientImpl, FlushResponse>>(impl_)) {
-    return;
-  }
-
-  std::atomic_store(
-      &impl_,
-      std::static_pointer_cast<AutoFlushControllerImpl>(
-          std::make_shared<
-              EnabledAutoFlushControllerImpl<ClientImpl, FlushResponse>>(
-              client_impl, flush_settings_, listener)));
-  impl_->Enable();
+  auto enabled_impl = std::static_pointer_cast<AutoFlushControllerImpl>(
+      std::make_shared<
+          EnabledAutoFlushControllerImpl<ClientImpl, FlushResponse>>(
+          client_impl, std::move(flush_settings), listener, flush_state_));
+
+  // The running flush of the previous settings is cancelled. The new settings
+  // start no flush until it is finished, and Disable() waits for it.
+  auto previous_impl = std::atomic_exchange(&impl_, enabled_impl);
+  previous_impl->Disable();
+  enabled_impl->Enable();
 }
 
 template void AutoFlushController::Enable<
     StreamLayerClientImpl, const StreamLayerClient::FlushResponse&>(
     std::shared_ptr<StreamLayerClientImpl> apiIngestPublish,
+    AutoFlushSettings flush_settings,
     std::shared_ptr<FlushEventListener<const StreamLayerClient::FlushResponse&>>
         listener);
 
@@ -264,16 +298,28 @@ std::future<void> AutoFlushController::Disable() {
   auto sp = std::atomic_exchange(
       &impl_, std::static_pointer_cast<AutoFlushControllerImpl>(
                   std::make_shared<DisabledAutoFlushControllerImpl>()));
-  return sp->Disable();
+  sp->Disable();
+
+  std::promise<void> finished;
+  auto future = finished.get_future();
+  std::lock_guard<std::mutex> lock(flush_state_->mutex);
+  if (flush_state_->in_progress) {
+    flush_state_->finished_promises.push_back(std::move(finished));
+  } else {
+    finished.set_value();
+  }
+  return future;
 }
 
 void AutoFlushController::NotifyQueueEventStart() {
-  impl_->NotifyQueueEventStart();
+  std::atomic_load(&impl_)->NotifyQueueEventStart();
 }
 void AutoFlushController::NotifyQueueEventComplete() {
-  impl_->NotifyQueueEventComplete();
+  std::atomic_load(&impl_)->NotifyQueueEventComplete();
+}
+void AutoFlushController::NotifyFlushEvent() {
+  std::atomic_load(&impl_)->NotifyFlushEvent();
 }
-void AutoFlushController::NotifyFlushEvent() { impl_->NotifyFlushEvent(); }
 
 }  // namespace write
 }  // namespace dataservice
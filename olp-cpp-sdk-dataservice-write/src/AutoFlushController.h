@@ -21,9 +21,11 @@
 
 #include <future>
 #include <memory>
+#include <mutex>
+#include <vector>
 
-#include "FlushEventListener.h"
-#include "AutoFlushSettings.h"
+#include <olp/dataservice/write/AutoFlushSettings.h>
+#include <olp/dataservice/write/FlushEventListener.h>
 
 namespace olp {
 namespace dataservice {
@@ -31,25 +33,38 @@ namespace write {
 
 class AutoFlushController {
  public:
-  AutoFlushController(const AutoFlushSettings& flush_settings);
+  AutoFlushController();
 
+  /// Enables the auto flush, replaces the settings if it is already enabled.
   template <typename ClientImpl, typename FlushResponse>
   void Enable(std::shared_ptr<ClientImpl> client_impl,
+              AutoFlushSettings flush_settings,
               std::shared_ptr<FlushEventListener<FlushResponse>> listener);
 
+  /// Disables the auto flush. The returned future is ready when the running
+  /// flush, also the one of the replaced settings, is finished.
   std::future<void> Disable();
 
   void NotifyQueueEventStart();
   void NotifyQueueEventComplete();
   void NotifyFlushEvent();
 
+  /// The state of the background flush. It is shared by the implementations,
+  /// so only one flush runs at a time, also when the settings are replaced.
+  struct FlushState {
+    std::mutex mutex;
+    bool in_progress{false};
+    std::vector<std::promise<void>> finished_promises;
+  };
+
   // Implmentation base class
   class AutoFlushControllerImpl {
    public:
     virtual ~AutoFlushControllerImpl() {}
 
     virtual void Enable() {}
-    virtual std::future<void> Disable() = 0;
+    /// Cancels the running flush and prevents the new ones.
+    virtual void Disable() = 0;
 
     virtual void NotifyQueueEventStart() = 0;
     virtual void NotifyQueueEventComplete() = 0;
@@ -57,7 +72,7 @@ class AutoFlushController {
   };
 
  private:
-  AutoFlushSettings flush_settings_;
+  std::shared_ptr<FlushState> flush_state_;
   std::shared_ptr<AutoFlushControllerImpl> impl_;
 };
 
@@ -1,45 +0,0 @@
-/*
- * Copyright (C) 2019 HERE Europe B.V.
- *
- * Licensed under the Apache License, Version 2.0 (the "License");
- * you may not use this file except in compliance with the License.
- * You may obtain a copy of the License at
- *
- *     http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS,
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- *
- * SPDX-License-Identifier: Apache-2.0
- * License-Filename: LICENSE
- */
-
-#include "DefaultFlushEventListener.h"
-
-#include <olp/dataservice/write/StreamLayerClient.h>
-
-namespace olp {
-namespace dataservice {
-namespace write {
-
-template <>
-void DefaultFlushEventListener<const StreamLayerClient::FlushResponse&>::
-    NotifyFlushEventResults(const StreamLayerClient::FlushResponse& results) {
-  FlushMetrics metrics;
-  {
-    std::lock_guard<std::mutex> locker(mutex_);
-    ++metrics_.num_total_flush_events;
-    if (results.empty() || CollateFlushEventResults(results)) {
-      ++metrics_.num_failed_flush_events;
-    }
-    metrics = metrics_;
-  }
-  NotifyFlushMetricsHasChanged(std::move(metrics));
-}
-
-}  // namespace write
-}  // namespace dataservice
-}  // namespace olp
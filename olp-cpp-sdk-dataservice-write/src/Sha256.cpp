@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "Sha256.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+namespace {
+constexpr std::uint32_t kRoundConstants[64] = {
+    0x428a2f98u, 0x71374491u, 0xb5c0fbcfu, 0xe9b5dba5u, 0x3956c25bu,
+    0x59f111f1u, 0x923f82a4u, 0xab1c5ed5u, 0xd807aa98u, 0x12835b01u,
+    0x243185beu, 0x550c7dc3u, 0x72be5d74u, 0x80deb1feu, 0x9bdc06a7u,
+    0xc19bf174u, 0xe49b69c1u, 0xefbe4786u, 0x0fc19dc6u, 0x240ca1ccu,
+    0x2de92c6fu, 0x4a7484aau, 0x5cb0a9dcu, 0x76f988dau, 0x983e5152u,
+    0xa831c66du, 0xb00327c8u, 0xbf597fc7u, 0xc6e00bf3u, 0xd5a79147u,
+    0x06ca6351u, 0x14292967u, 0x27b70a85u, 0x2e1b2138u, 0x4d2c6dfcu,
+    0x53380d13u, 0x650a7354u, 0x766a0abbu, 0x81c2c92eu, 0x92722c85u,
+    0xa2bfe8a1u, 0xa81a664bu, 0xc24b8b70u, 0xc76c51a3u, 0xd192e819u,
+    0xd6990624u, 0xf40e3585u, 0x106aa070u, 0x19a4c116u, 0x1e376c08u,
+    0x2748774cu, 0x34b0bcb5u, 0x391c0cb3u, 0x4ed8aa4au, 0x5b9cca4fu,
+    0x682e6ff3u, 0x748f82eeu, 0x78a5636fu, 0x84c87814u, 0x8cc70208u,
+    0x90befffau, 0xa4506cebu, 0xbef9a3f7u, 0xc67178f2u};
+
+inline std::uint32_t RotateRight(std::uint32_t value, int bits) {
+  return (value >> bits) | (value << (32 - bits));
+}
+}  // namespace
+
+void Sha256::Update(const unsigned char* data, std::size_t size) {
+  total_size_ += size;
+
+  if (block_size_ > 0u) {
+    const auto count = std::min(size, block_.size() - block_size_);
+    std::memcpy(block_.data() + block_size_, data, count);
+    block_size_ += count;
+    data += count;
+    size -= count;
+
+    if (block_size_ < block_.size()) {
+      return;
+    }
+    Transform(block_.data());
+    block_size_ = 0u;
+  }
+
+  // Full blocks are hashed directly from the input
+  for (; size >= block_.size(); data += block_.size(), size -= block_.size()) {
+    Transform(data);
+  }
+
+  if (size > 0u) {
+    std::memcpy(block_.data(), data, size);
+    block_size_ = size;
+  }
+}
+
+Sha256::Digest Sha256::Finalize() {
+  const auto total_bits = total_size_ * 8u;
+
+  // Pad with 0x80, zeros, and the message size in bits, big endian
+  unsigned char padding[72] = {0x80u};
+  const auto padding_size = (block_size_ < 56u ? 56u : 120u) - block_size_;
+  for (auto i = 0u; i < 8u; ++i) {
+    padding[padding_size + i] =
+        static_cast<unsigned char>(total_bits >> (56u - 8u * i));
+  }
+  Update(padding, padding_size + 8u);
+
+  Digest digest;
+  for (auto i = 0u; i < state_.size(); ++i) {
+    digest[4u * i] = static_cast<std::uint8_t>(state_[i] >> 24);
+    digest[4u * i + 1u] = static_cast<std::uint8_t>(state_[i] >> 16);
+    digest[4u * i + 2u] = static_cast<std::uint8_t>(state_[i] >> 8);
+    digest[4u * i + 3u] = static_cast<std::uint8_t>(state_[i]);
+  }
+  return digest;
+}
+
+std::string Sha256::FinalizeHex() {
+  static const char kHexDigits[] = "0123456789abcdef";
+
+  const auto digest = Finalize();
+  std::string hex;
+  hex.reserve(2u * digest.size());
+  for (const auto byte : digest) {
+    hex.push_back(kHexDigits[byte >> 4]);
+    hex.push_back(kHexDigits[byte & 0x0Fu]);
+  }
+  return hex;
+}
+
+void Sha256::Transform(const unsigned char* block) {
+  std::uint32_t w[64];
+  for (auto i = 0u; i < 16u; ++i) {
+    w[i] = (static_cast<std::uint32_t>(block[4u * i]) << 24) |
+           (static_cast<std::uint32_t>(block[4u * i + 1u]) << 16) |
+           (static_cast<std::uint32_t>(block[4u * i + 2u]) << 8) |
+           static_cast<std::uint32_t>(block[4u * i + 3u]);
+  }
+  for (auto i = 16u; i < 64u; ++i) {
+    const auto s0 = RotateRight(w[i - 15u], 7) ^ RotateRight(w[i - 15u], 18) ^
+                    (w[i - 15u] >> 3);
+    const auto s1 = RotateRight(w[i - 2u], 17) ^ RotateRight(w[i - 2u], 19) ^
+                    (w[i - 2u] >> 10);
+    w[i] = w[i - 16u] + s0 + w[i - 7u] + s1;
+  }
+
+  auto a = state_[0];
+  auto b = state_[1];
+  auto c = state_[2];
+  auto d = state_[3];
+  auto e = state_[4];
+  auto f = state_[5];
+  auto g = state_[6];
+  auto h = state_[7];
+
+  for (auto i = 0u; i < 64u; ++i) {
+    const auto s1 = RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+    const auto ch = (e & f) ^ (~e & g);
+    const auto t1 = h + s1 + ch + kRoundConstants[i] + w[i];
+    const auto s0 = RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+    const auto maj = (a & b) ^ (a & c) ^ (b & c);
+    const auto t2 = s0 + maj;
+
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+
+  state_[0] += a;
+  state_[1] += b;
+  state_[2] += c;
+  state_[3] += d;
+  state_[4] += e;
+  state_[5] += f;
+  state_[6] += g;
+  state_[7] += h;
+}
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+/// Computes the SHA-256 digest of the data incrementally.
+class Sha256 {
+ public:
+  using Digest = std::array<std::uint8_t, 32>;
+
+  /// Adds the next chunk of the data to the digest.
+  void Update(const unsigned char* data, std::size_t size);
+
+  /// Finishes the digest, no data can be added afterwards.
+  Digest Finalize();
+
+  /// Finishes the digest and formats it as 64 lowercase hex characters.
+  std::string FinalizeHex();
+
+ private:
+  void Transform(const unsigned char* block);
+
+  std::array<std::uint32_t, 8> state_{{0x6a09e667u, 0xbb67ae85u, 0x3c6ef372u,
+                                       0xa54ff53au, 0x510e527fu, 0x9b05688cu,
+                                       0x1f83d9abu, 0x5be0cd19u}};
+  std::array<unsigned char, 64> block_{};
+  std::size_t block_size_{0u};
+  std::uint64_t total_size_{0u};
+};
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
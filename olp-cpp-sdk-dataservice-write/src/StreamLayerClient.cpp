@@ -68,6 +68,15 @@ olp::client::CancellationToken StreamLayerClient::Flush(
   return impl_->Flush(std::move(request), std::move(callback));
 }
 
+void StreamLayerClient::EnableAutoFlush(
+    AutoFlushSettings settings, std::shared_ptr<FlushListener> listener) {
+  impl_->EnableAutoFlush(std::move(settings), std::move(listener));
+}
+
+std::future<void> StreamLayerClient::DisableAutoFlush() {
+  return impl_->DisableAutoFlush();
+}
+
 olp::client::CancellableFuture<PublishSdiiResponse>
 StreamLayerClient::PublishSdii(model::PublishSdiiRequest request) {
   return impl_->PublishSdii(request);
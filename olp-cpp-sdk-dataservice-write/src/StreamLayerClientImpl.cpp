@@ -19,6 +19,16 @@
 
 #include "StreamLayerClientImpl.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
@@ -57,6 +67,47 @@ namespace write {
 namespace {
 constexpr auto kLogTag = "StreamLayerClientImpl";
 constexpr int64_t kTwentyMib = 20971520;  // 20 MiB
+constexpr auto kQueueHead = "head";
+constexpr auto kQueueTail = "tail";
+constexpr auto kQueueDataSize = "size";
+
+using CacheItems = cache::KeyValueCache::KeyValueListType;
+
+void AddCacheItem(CacheItems& items, std::string key,
+                  const std::string& value) {
+  items.emplace_back(std::move(key),
+                     std::make_shared<cache::KeyValueCache::ValueType>(
+                         value.begin(), value.end()));
+}
+
+void AddCacheItem(CacheItems& items, std::string key, uint64_t counter) {
+  AddCacheItem(items, std::move(key), std::to_string(counter));
+}
+
+void AddCacheItem(CacheItems& items, std::string key,
+                  const model::PublishDataRequest& request) {
+  AddCacheItem(items, std::move(key),
+               olp::serializer::serialize<model::PublishDataRequest>(request));
+}
+
+// The state of a parallel flush, shared with the cancellation callback.
+struct FlushState {
+  using QueuedRequest = std::pair<size_t, model::PublishDataRequest>;
+  using IndexedResponse = std::pair<size_t, PublishDataResponse>;
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::vector<client::CancellationContext> contexts;
+  std::deque<QueuedRequest> popped_requests;
+  std::vector<QueuedRequest> failed_requests;
+  std::set<std::string> layers_in_flight;
+  std::vector<IndexedResponse> responses;
+  size_t popped_count{0u};
+  size_t active_workers{0u};
+  bool popping{false};
+  bool queue_drained{false};
+  bool finished{false};
+};
 }  // namespace
 
 StreamLayerClientImpl::StreamLayerClientImpl(
@@ -72,6 +123,7 @@ StreamLayerClientImpl::StreamLayerClientImpl(
       task_scheduler_(std::move(settings_.task_scheduler)) {}
 
 StreamLayerClientImpl::~StreamLayerClientImpl() {
+  auto_flush_controller_.Disable().wait();
   pending_requests_->CancelAllAndWait();
 }
 
@@ -87,18 +139,116 @@ std::string StreamLayerClientImpl::GetUuidListKey() const {
   return uuid_list_key;
 }
 
-size_t StreamLayerClientImpl::QueueSize() const {
-  std::lock_guard<std::mutex> lock(cache_mutex_);
+std::string StreamLayerClientImpl::GetQueueKey(
+    const std::string& suffix) const {
+  return GetUuidListKey() + "::" + suffix;
+}
+
+std::string StreamLayerClientImpl::GetQueueItemKey(uint64_t index) const {
+  return GetQueueKey(std::to_string(index));
+}
+
+uint64_t StreamLayerClientImpl::GetQueueCounter(const std::string& key) const {
+  const auto value = cache_->Get(key);
+  if (!value) {
+    return 0u;
+  }
+
+  const std::string counter(value->begin(), value->end());
+  return std::strtoull(counter.c_str(), nullptr, 10);
+}
+
+bool StreamLayerClientImpl::WriteQueueBatch(const CacheItems& items) const {
+  auto result = cache_->WriteBatch(items);
+  if (!result) {
+    OLP_SDK_LOG_ERROR_F(kLogTag, "Failed to write the queue, error=%s",
+                        result.GetError().GetMessage().c_str());
+    return false;
+  }
+  return true;
+}
+
+void StreamLayerClientImpl::MigrateUuidList() const {
+  if (uuid_list_migrated_) {
+    return;
+  }
+  uuid_list_migrated_ = true;
 
   const auto uuid_list_any =
       cache_->Get(GetUuidListKey(), [](const std::string& s) { return s; });
-  std::string uuid_list = "";
-  if (!uuid_list_any.empty()) {
-    uuid_list = boost::any_cast<std::string>(uuid_list_any);
-    return std::count(uuid_list.cbegin(), uuid_list.cend(), ',');
+  if (uuid_list_any.empty()) {
+    return;
   }
 
-  return 0;
+  const auto uuid_list = boost::any_cast<std::string>(uuid_list_any);
+  auto tail = GetQueueCounter(GetQueueKey(kQueueTail));
+  auto data_size = GetQueueCounter(GetQueueKey(kQueueDataSize));
+  CacheItems items;
+  std::vector<std::string> publish_data_keys;
+
+  std::string::size_type begin = 0u;
+  auto end = uuid_list.find(',', begin);
+  while (end != std::string::npos) {
+    const auto publish_data_key = uuid_list.substr(begin, end - begin);
+    const auto publish_data_any =
+        cache_->Get(publish_data_key, [](const std::string& s) {
+          return olp::parser::parse<model::PublishDataRequest>(s);
+        });
+    if (!publish_data_any.empty()) {
+      const auto request =
+          boost::any_cast<model::PublishDataRequest>(publish_data_any);
+      AddCacheItem(items, GetQueueItemKey(tail++), request);
+      data_size += request.GetData() ? request.GetData()->size() : 0u;
+    }
+    publish_data_keys.push_back(publish_data_key);
+
+    begin = end + 1;
+    end = uuid_list.find(',', begin);
+  }
+
+  const auto migrated = items.size();
+  AddCacheItem(items, GetQueueKey(kQueueTail), tail);
+  AddCacheItem(items, GetQueueKey(kQueueDataSize), data_size);
+  if (!WriteQueueBatch(items)) {
+    return;
+  }
+
+  // The list is removed first, so an interrupted migration never queues the
+  // same request twice
+  cache_->Remove(GetUuidListKey());
+  for (const auto& publish_data_key : publish_data_keys) {
+    cache_->Remove(publish_data_key);
+  }
+
+  OLP_SDK_LOG_INFO_F(kLogTag, "Migrated %zu queued publish requests",
+                     migrated);
+}
+
+size_t StreamLayerClientImpl::QueueSizeUnlocked() const {
+  MigrateUuidList();
+
+  const auto head = GetQueueCounter(GetQueueKey(kQueueHead));
+  const auto tail = GetQueueCounter(GetQueueKey(kQueueTail));
+  return tail > head ? static_cast<size_t>(tail - head) : 0u;
+}
+
+size_t StreamLayerClientImpl::QueueSize() const {
+  if (!cache_) {
+    return 0u;
+  }
+
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  return QueueSizeUnlocked();
+}
+
+size_t StreamLayerClientImpl::QueuedDataSize() const {
+  if (!cache_) {
+    return 0u;
+  }
+
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  MigrateUuidList();
+  return static_cast<size_t>(GetQueueCounter(GetQueueKey(kQueueDataSize)));
 }
 
 boost::optional<std::string> StreamLayerClientImpl::Queue(
@@ -118,71 +268,327 @@ boost::optional<std::string> StreamLayerClientImpl::Queue(
         "PublishDataRequest does not contain a Layer ID");
   }
 
-  if (!(StreamLayerClientImpl::QueueSize() <
-        stream_client_settings_.maximum_requests)) {
-    return boost::make_optional<std::string>(
-        "Maximum number of requests has reached");
-  }
+  auto_flush_controller_.NotifyQueueEventStart();
 
   {
     std::lock_guard<std::mutex> lock(cache_mutex_);
-    const auto publish_data_key = GenerateUuid();
-    cache_->Put(publish_data_key, request, [=]() {
-      return olp::serializer::serialize<model::PublishDataRequest>(request);
-    });
 
-    const auto uuid_list_any =
-        cache_->Get(GetUuidListKey(), [](const std::string& s) { return s; });
-    std::string uuid_list = "";
-    if (!uuid_list_any.empty()) {
-      uuid_list = boost::any_cast<std::string>(uuid_list_any);
+    if (!(QueueSizeUnlocked() < stream_client_settings_.maximum_requests)) {
+      return boost::make_optional<std::string>(
+          "Maximum number of requests has reached");
     }
-    uuid_list += publish_data_key + ",";
 
-    cache_->Put(GetUuidListKey(), uuid_list,
-                [&uuid_list]() { return uuid_list; });
+    const auto tail_key = GetQueueKey(kQueueTail);
+    const auto tail = GetQueueCounter(tail_key);
+    const auto data_size_key = GetQueueKey(kQueueDataSize);
+
+    CacheItems items;
+    AddCacheItem(items, GetQueueItemKey(tail), request);
+    AddCacheItem(items, tail_key, tail + 1);
+    AddCacheItem(items, data_size_key,
+                 GetQueueCounter(data_size_key) + request.GetData()->size());
+    if (!WriteQueueBatch(items)) {
+      return boost::make_optional<std::string>(
+          "Unable to store the request in the cache");
+    }
   }
 
+  // Might trigger the auto flush, so should be called without the lock
+  auto_flush_controller_.NotifyQueueEventComplete();
+
   return boost::none;
 }
 
 boost::optional<model::PublishDataRequest>
 StreamLayerClientImpl::PopFromQueue() {
-  std::lock_guard<std::mutex> lock(cache_mutex_);
+  if (!cache_) {
+    return boost::none;
+  }
 
-  const auto uuid_list_any =
-      cache_->Get(GetUuidListKey(), [](const std::string& s) { return s; });
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  MigrateUuidList();
 
-  if (uuid_list_any.empty()) {
-    OLP_SDK_LOG_ERROR(kLogTag, "Unable to Restore UUID list from Cache");
+  const auto head_key = GetQueueKey(kQueueHead);
+  const auto head = GetQueueCounter(head_key);
+  const auto tail = GetQueueCounter(GetQueueKey(kQueueTail));
+  if (head >= tail) {
     return boost::none;
   }
 
-  auto uuid_list = boost::any_cast<std::string>(uuid_list_any);
+  const auto publish_data_key = GetQueueItemKey(head);
+  const auto publish_data = cache_->Get(publish_data_key);
 
-  auto pos = uuid_list.find(",");
-  if (pos == std::string::npos) {
+  CacheItems items;
+  AddCacheItem(items, head_key, head + 1);
+
+  const auto data_size_key = GetQueueKey(kQueueDataSize);
+  if (!publish_data) {
+    // The size of the lost request is unknown, reset it with the queue
+    if (head + 1 == tail) {
+      AddCacheItem(items, data_size_key, uint64_t{0u});
+    }
+    WriteQueueBatch(items);
+
+    OLP_SDK_LOG_ERROR(kLogTag,
+                      "Unable to Restore PublishData Request from Cache");
     return boost::none;
   }
 
-  const auto publish_data_key = uuid_list.substr(0, pos);
-  auto publish_data_any =
-      cache_->Get(publish_data_key, [](const std::string& s) {
-        return olp::parser::parse<model::PublishDataRequest>(s);
-      });
+  auto request = olp::parser::parse<model::PublishDataRequest>(publish_data);
 
+  const auto data_size = GetQueueCounter(data_size_key);
+  const auto request_size = request.GetData() ? request.GetData()->size() : 0u;
+  AddCacheItem(items, data_size_key,
+               head + 1 == tail || data_size < request_size
+                   ? uint64_t{0u}
+                   : data_size - request_size);
+  if (!WriteQueueBatch(items)) {
+    return boost::none;
+  }
+
+  // The item is removed after the counters, so it is never lost while the
+  // counters still refer to it
   cache_->Remove(publish_data_key);
-  uuid_list.erase(0, pos + 1);
-  cache_->Put(GetUuidListKey(), uuid_list,
-              [&uuid_list]() { return uuid_list; });
 
-  if (publish_data_any.empty()) {
-    OLP_SDK_LOG_ERROR(kLogTag,
-                      "Unable to Restore PublishData Request from Cache");
+  return request;
+}
+
+void StreamLayerClientImpl::QueueFront(
+    const std::vector<model::PublishDataRequest>& requests) {
+  if (!cache_ || requests.empty()) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  MigrateUuidList();
+
+  const auto head_key = GetQueueKey(kQueueHead);
+  auto head = GetQueueCounter(head_key);
+  const auto data_size_key = GetQueueKey(kQueueDataSize);
+  auto data_size = GetQueueCounter(data_size_key);
+
+  // The requests were popped, so their slots before the head are free
+  CacheItems items;
+  auto it = requests.rbegin();
+  for (; it != requests.rend() && head > 0u; ++it) {
+    const auto& request = *it;
+    AddCacheItem(items, GetQueueItemKey(--head), request);
+    data_size += request.GetData() ? request.GetData()->size() : 0u;
+  }
+
+  // No free slots are left when the queue counters were reset meanwhile,
+  // e.g. by clearing the cache, so the rest is queued back at the tail
+  const auto not_fitting =
+      static_cast<size_t>(std::distance(it, requests.rend()));
+  if (not_fitting > 0u) {
+    OLP_SDK_LOG_WARNING_F(kLogTag,
+                          "Queued back %zu requests at the tail of the queue",
+                          not_fitting);
+
+    const auto tail_key = GetQueueKey(kQueueTail);
+    auto tail = GetQueueCounter(tail_key);
+    for (size_t i = 0u; i < not_fitting; ++i) {
+      const auto& request = requests[i];
+      AddCacheItem(items, GetQueueItemKey(tail++), request);
+      data_size += request.GetData() ? request.GetData()->size() : 0u;
+    }
+    AddCacheItem(items, tail_key, tail);
+  }
+
+  AddCacheItem(items, head_key, head);
+  AddCacheItem(items, data_size_key, data_size);
+  WriteQueueBatch(items);
+}
+
+void StreamLayerClientImpl::EnableAutoFlush(
+    AutoFlushSettings settings,
+    std::shared_ptr<StreamLayerClient::FlushListener> listener) {
+  auto_flush_controller_.Enable(shared_from_this(), std::move(settings),
+                                std::move(listener));
+}
+
+std::future<void> StreamLayerClientImpl::DisableAutoFlush() {
+  return auto_flush_controller_.Disable();
+}
+
+StreamLayerClient::FlushResponse StreamLayerClientImpl::FlushQueue(
+    int maximum_events_number, client::CancellationContext context) {
+  const auto max_requests = static_cast<size_t>(maximum_events_number);
+  auto parallel_requests =
+      std::max<size_t>(stream_client_settings_.flush_parallel_requests, 1u);
+  if (max_requests > 0u) {
+    parallel_requests = std::min(parallel_requests, max_requests);
+  }
+  const auto preserve_layer_order =
+      stream_client_settings_.flush_preserve_layer_order &&
+      parallel_requests > 1u;
+
+  auto state = std::make_shared<FlushState>();
+  state->contexts.resize(parallel_requests);
+
+  // The flush cancels the requests in flight of all the workers, so every
+  // worker publishes with a context of its own.
+  auto cancel_workers = [state]() {
+    for (auto& worker_context : state->contexts) {
+      worker_context.CancelOperation();
+    }
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->condition.notify_all();
+  };
+
+  if (!context.ExecuteOrCancelled(
+          [&]() { return client::CancellationToken(cancel_workers); },
+          cancel_workers)) {
+    return {};
+  }
+
+  using QueuedRequest = FlushState::QueuedRequest;
+
+  // Takes the next request that can be published, pops the requests from the
+  // queue while there is a room in the window. One worker at a time pops,
+  // without holding the state lock, so the requests keep the queue order.
+  auto next_request = [=](const client::CancellationContext& worker_context)
+      -> boost::optional<QueuedRequest> {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    auto& popped = state->popped_requests;
+
+    while (!worker_context.IsCancelled()) {
+      auto it = std::find_if(
+          popped.begin(), popped.end(), [&](const QueuedRequest& queued) {
+            return !preserve_layer_order ||
+                   state->layers_in_flight.count(
+                       queued.second.GetLayerId()) == 0u;
+          });
+
+      if (it != popped.end()) {
+        auto queued = std::move(*it);
+        popped.erase(it);
+        if (preserve_layer_order) {
+          state->layers_in_flight.insert(queued.second.GetLayerId());
+        }
+        return queued;
+      }
+
+      const auto can_pop =
+          !state->queue_drained && popped.size() < parallel_requests &&
+          (max_requests == 0u || state->popped_count < max_requests);
+      if (can_pop && !state->popping) {
+        state->popping = true;
+        lock.unlock();
+
+        auto publish_request = PopFromQueue();
+        const auto queue_drained = !publish_request && QueueSize() == 0u;
+
+        lock.lock();
+        state->popping = false;
+        if (publish_request) {
+          popped.emplace_back(state->popped_count++,
+                              std::move(*publish_request));
+        } else if (queue_drained) {
+          state->queue_drained = true;
+        }
+        state->condition.notify_all();
+        continue;
+      }
+
+      if (popped.empty() && !can_pop) {
+        break;
+      }
+
+      // The popped requests wait for the requests to the same layer
+      state->condition.wait(lock);
+    }
+
     return boost::none;
+  };
+
+  auto worker = [=](client::CancellationContext worker_context) {
+    while (auto queued = next_request(worker_context)) {
+      auto publish_response = PublishDataTask(queued->second, worker_context);
+
+      std::lock_guard<std::mutex> lock(state->mutex);
+      // The cancelled requests and the ones failed with a retryable error are
+      // queued back after the flush, the other failed ones are dropped
+      if (!publish_response.IsSuccessful()) {
+        const auto& error = publish_response.GetError();
+        if (worker_context.IsCancelled() ||
+            error.GetErrorCode() == client::ErrorCode::Cancelled ||
+            error.ShouldRetry()) {
+          state->failed_requests.emplace_back(queued->first, queued->second);
+        }
+      }
+      state->responses.emplace_back(queued->first,
+                                    std::move(publish_response));
+      if (preserve_layer_order) {
+        state->layers_in_flight.erase(queued->second.GetLayerId());
+      }
+      state->condition.notify_all();
+    }
+  };
+
+  // The scheduled workers that start after the flush is finished, e.g. when
+  // the flush itself occupies the only scheduler thread, do nothing.
+  auto scheduled_worker = [=](client::CancellationContext worker_context) {
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (state->finished) {
+        return;
+      }
+      ++state->active_workers;
+    }
+
+    worker(std::move(worker_context));
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    --state->active_workers;
+    state->condition.notify_all();
+  };
+
+  for (size_t i = 1u; i < parallel_requests; ++i) {
+    auto worker_context = state->contexts[i];
+    thread::ExecuteOrSchedule(task_scheduler_, [=]() {
+      scheduled_worker(worker_context);
+    });
+  }
+  worker(state->contexts[0]);
+
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->condition.wait(lock,
+                          [&]() { return state->active_workers == 0u; });
+    state->finished = true;
   }
 
-  return boost::any_cast<model::PublishDataRequest>(publish_data_any);
+  // The requests not published because of the cancellation, and the failed
+  // ones, are queued back to the front in the queue order
+  auto& requeued = state->failed_requests;
+  std::move(state->popped_requests.begin(), state->popped_requests.end(),
+            std::back_inserter(requeued));
+  std::sort(requeued.begin(), requeued.end(),
+            [](const QueuedRequest& lhs, const QueuedRequest& rhs) {
+              return lhs.first < rhs.first;
+            });
+
+  std::vector<model::PublishDataRequest> requests;
+  requests.reserve(requeued.size());
+  for (auto& queued : requeued) {
+    requests.emplace_back(std::move(queued.second));
+  }
+  QueueFront(requests);
+
+  auto& responses = state->responses;
+  std::sort(responses.begin(), responses.end(),
+            [](const FlushState::IndexedResponse& lhs,
+               const FlushState::IndexedResponse& rhs) {
+              return lhs.first < rhs.first;
+            });
+
+  StreamLayerClient::FlushResponse result;
+  result.reserve(responses.size());
+  for (auto& response : responses) {
+    result.emplace_back(std::move(response.second));
+  }
+  return result;
 }
 
 olp::client::CancellableFuture<StreamLayerClient::FlushResponse>
@@ -221,27 +627,10 @@ olp::client::CancellationToken StreamLayerClientImpl::Flush(
           return EmptyFlushApiResponse{};
         }
 
-        int counter = 0;
-        while ((!maximum_events_number || counter < maximum_events_number) &&
-               (this->QueueSize() > 0) && !context.IsCancelled()) {
-          auto publish_request = this->PopFromQueue();
-          if (publish_request == boost::none) {
-            continue;
-          }
-
-          auto publish_response = PublishDataTask(*publish_request, context);
-          responses.emplace_back(std::move(publish_response));
-
-          // If cancelled queue back task
-          if (context.IsCancelled()) {
-            this->Queue(*publish_request);
-            break;
-          }
-
-          counter++;
-        }
+        responses = FlushQueue(maximum_events_number, context);
 
-        OLP_SDK_LOG_INFO_F(kLogTag, "Flushed %d publish requests", counter);
+        OLP_SDK_LOG_INFO_F(kLogTag, "Flushed %zu publish requests",
+                           responses.size());
         callback(responses);
         return EmptyFlushApiResponse{};
       },
@@ -19,14 +19,21 @@
 
 #pragma once
 
+#include <cstdint>
+#include <future>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
 
 #include <boost/optional.hpp>
 
+#include <olp/core/cache/KeyValueCache.h>
 #include <olp/core/client/HRN.h>
 #include <olp/core/client/OlpClientSettings.h>
 
 #include <olp/dataservice/write/StreamLayerClient.h>
+#include "AutoFlushController.h"
 #include "CatalogSettings.h"
 #include "generated/model/Catalog.h"
 
@@ -39,7 +46,8 @@ class PendingRequests;
 namespace dataservice {
 namespace write {
 
-class StreamLayerClientImpl {
+class StreamLayerClientImpl
+    : public std::enable_shared_from_this<StreamLayerClientImpl> {
  public:
   StreamLayerClientImpl(client::HRN catalog,
                         StreamLayerClientSettings client_settings,
@@ -60,8 +68,16 @@ class StreamLayerClientImpl {
   olp::client::CancellationToken Flush(
       model::FlushRequest request, StreamLayerClient::FlushCallback callback);
   size_t QueueSize() const;
+  /// The total size of the data of the queued requests.
+  size_t QueuedDataSize() const;
   boost::optional<model::PublishDataRequest> PopFromQueue();
 
+  /// Should be called only when the instance is owned by a shared pointer.
+  void EnableAutoFlush(
+      AutoFlushSettings settings,
+      std::shared_ptr<StreamLayerClient::FlushListener> listener);
+  std::future<void> DisableAutoFlush();
+
   client::CancellableFuture<PublishSdiiResponse> PublishSdii(
       model::PublishSdiiRequest request);
 
@@ -87,8 +103,37 @@ class StreamLayerClientImpl {
   virtual std::string GenerateUuid() const;
 
  private:
+  /// The key of the queue in the format used by the previous SDK versions,
+  /// a comma separated list of the request keys.
   std::string GetUuidListKey() const;
 
+  /// The queue is stored as a sequence of keys between the head and tail
+  /// counters, so all the operations on it do not depend on its size.
+  std::string GetQueueKey(const std::string& suffix) const;
+  std::string GetQueueItemKey(uint64_t index) const;
+  uint64_t GetQueueCounter(const std::string& key) const;
+
+  /// Writes the queue items together with the counters in one batch, so the
+  /// counters never point to an item that is not stored.
+  bool WriteQueueBatch(
+      const cache::KeyValueCache::KeyValueListType& items) const;
+
+  /// Moves the requests queued in the previous format to the queue, only
+  /// once per client instance. Should be called with cache_mutex_ locked.
+  void MigrateUuidList() const;
+
+  size_t QueueSizeUnlocked() const;
+
+  /// Puts the popped requests back to the front of the queue, the first
+  /// request of the vector becomes the head.
+  void QueueFront(const std::vector<model::PublishDataRequest>& requests);
+
+  /// Publishes the queued requests with up to `flush_parallel_requests`
+  /// requests in flight. The responses are in the queue order. The failed
+  /// and cancelled requests are queued back.
+  StreamLayerClient::FlushResponse FlushQueue(
+      int maximum_events_number, client::CancellationContext context);
+
  private:
   client::HRN catalog_;
 
@@ -97,10 +142,12 @@ class StreamLayerClientImpl {
 
   std::shared_ptr<cache::KeyValueCache> cache_;
   mutable std::mutex cache_mutex_;
+  mutable bool uuid_list_migrated_{false};
   StreamLayerClientSettings stream_client_settings_;
 
   std::shared_ptr<client::PendingRequests> pending_requests_;
   std::shared_ptr<thread::TaskScheduler> task_scheduler_;
+  AutoFlushController auto_flush_controller_;
 };
 
 }  // namespace write
@@ -96,6 +96,20 @@ olp::client::CancellationToken VersionedLayerClient::PublishToBatch(
   return impl_->PublishToBatch(pub, request, std::move(callback));
 }
 
+olp::client::CancellableFuture<PublishPartitionsDataResponse>
+VersionedLayerClient::PublishToBatch(
+    const model::Publication& pub,
+    std::vector<model::PublishPartitionDataRequest> requests) {
+  return impl_->PublishToBatch(pub, std::move(requests));
+}
+
+olp::client::CancellationToken VersionedLayerClient::PublishToBatch(
+    const model::Publication& pub,
+    std::vector<model::PublishPartitionDataRequest> requests,
+    PublishPartitionsDataCallback callback) {
+  return impl_->PublishToBatch(pub, std::move(requests), std::move(callback));
+}
+
 olp::client::CancellableFuture<CheckDataExistsResponse>
 VersionedLayerClient::CheckDataExists(model::CheckDataExistsRequest request) {
   return impl_->CheckDataExists(request);
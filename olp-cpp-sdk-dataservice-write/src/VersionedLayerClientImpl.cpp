@@ -23,22 +23,44 @@
 
 #include "ApiClientLookup.h"
 #include "Common.h"
+#include "Sha256.h"
 #include "generated/BlobApi.h"
 #include "generated/ConfigApi.h"
 #include "generated/MetadataApi.h"
 #include "generated/PublishApi.h"
 #include "generated/QueryApi.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include <boost/format.hpp>
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
 
 namespace {
+/// The maximum number of the blobs uploaded at the same time by the bulk
+/// publish.
+constexpr size_t kMaxConcurrentBlobUploads = 32u;
+
+/// The maximum number of the partitions in one metadata upload request.
+constexpr size_t kMaxPartitionsPerUpload = 1000u;
+
 std::string GenerateUuid() {
   static boost::uuids::random_generator gen;
   return boost::uuids::to_string(gen());
 }
+
+/// The deduplicated data is addressed by its content, the data handle is the
+/// SHA-256 hash of the data.
+std::string ContentDataHandle(
+    const std::shared_ptr<std::vector<unsigned char>>& data) {
+  olp::dataservice::write::Sha256 hash;
+  if (data) {
+    hash.Update(data->data(), data->size());
+  }
+  return hash.FinalizeHex();
+}
 }  // namespace
 
 namespace olp {
@@ -449,7 +471,10 @@ olp::client::CancellationToken VersionedLayerClientImpl::PublishToBatch(
                "Invalid publication: layer ID missing", true}};
     }
 
-    const auto data_handle = GenerateUuid();
+    const bool deduplicated =
+        request.GetDeduplication() && !request.GetDataReader();
+    const auto data_handle =
+        deduplicated ? ContentDataHandle(request.GetData()) : GenerateUuid();
     model::PublishPartition partition;
     partition.SetPartition(request.GetPartitionId().value_or(""));
     partition.SetData(request.GetData());
@@ -472,12 +497,28 @@ olp::client::CancellationToken VersionedLayerClientImpl::PublishToBatch(
       return {{client::ErrorCode::InvalidArgument, errmsg.str()}};
     }
 
-    auto upload_blob_response =
-        UploadBlob(partition, data_handle, layer_settings.content_type,
-                   layer_settings.content_encoding, layer_id,
-                   request.GetBillingTag(), context);
-    if (!upload_blob_response.IsSuccessful()) {
-      return upload_blob_response.GetError();
+    bool blob_exists = false;
+    if (deduplicated) {
+      auto check_blob_response = CheckBlobExists(
+          layer_id, data_handle, request.GetBillingTag(), context);
+      if (!check_blob_response.IsSuccessful()) {
+        return check_blob_response.GetError();
+      }
+      blob_exists = check_blob_response.GetResult();
+    }
+
+    if (!blob_exists) {
+      auto upload_blob_response =
+          request.GetDataReader()
+              ? UploadBlobMultipart(request, data_handle,
+                                    layer_settings.content_type,
+                                    layer_settings.content_encoding, context)
+              : UploadBlob(partition, data_handle, layer_settings.content_type,
+                           layer_settings.content_encoding, layer_id,
+                           request.GetBillingTag(), context);
+      if (!upload_blob_response.IsSuccessful()) {
+        return upload_blob_response.GetError();
+      }
     }
 
     auto upload_partition_response =
@@ -495,6 +536,363 @@ olp::client::CancellationToken VersionedLayerClientImpl::PublishToBatch(
                  std::move(publish_task), std::move(callback));
 }
 
+olp::client::CancellableFuture<PublishPartitionsDataResponse>
+VersionedLayerClientImpl::PublishToBatch(
+    const model::Publication& pub,
+    std::vector<model::PublishPartitionDataRequest> requests) {
+  auto promise =
+      std::make_shared<std::promise<PublishPartitionsDataResponse>>();
+  return olp::client::CancellableFuture<PublishPartitionsDataResponse>(
+      PublishToBatch(pub, std::move(requests),
+                     [promise](PublishPartitionsDataResponse response) {
+                       promise->set_value(std::move(response));
+                     }),
+      promise);
+}
+
+olp::client::CancellationToken VersionedLayerClientImpl::PublishToBatch(
+    const model::Publication& pub,
+    std::vector<model::PublishPartitionDataRequest> requests,
+    PublishPartitionsDataCallback callback) {
+  auto publish_task = [=](client::CancellationContext context)
+      -> PublishPartitionsDataResponse {
+    if (!pub.GetId()) {
+      return {{client::ErrorCode::InvalidArgument,
+               "Invalid publication: publication ID missing", true}};
+    }
+
+    if (requests.empty()) {
+      return {{client::ErrorCode::InvalidArgument,
+               "Invalid request: no partitions to publish", true}};
+    }
+
+    LayerSettingsMap layers_settings;
+    for (const auto& request : requests) {
+      const auto& layer_id = request.GetLayerId();
+      if (layer_id.empty()) {
+        return {{client::ErrorCode::InvalidArgument,
+                 "Invalid publication: layer ID missing", true}};
+      }
+
+      if (request.GetDataReader()) {
+        return {{client::ErrorCode::InvalidArgument,
+                 "Invalid request: data reader is not supported, publish the "
+                 "partition with a data reader separately",
+                 true}};
+      }
+
+      if (layers_settings.count(layer_id) != 0u) {
+        continue;
+      }
+
+      auto layer_settings_response = catalog_settings_.GetLayerSettings(
+          context, request.GetBillingTag(), layer_id);
+      if (!layer_settings_response.IsSuccessful()) {
+        return layer_settings_response.GetError();
+      }
+
+      auto layer_settings = layer_settings_response.MoveResult();
+      if (layer_settings.content_type.empty()) {
+        auto errmsg = boost::format(
+                          "Unable to find the Layer ID (%1%) "
+                          "provided in the request in the "
+                          "Catalog specified when creating "
+                          "this VersionedLayerClient instance.") %
+                      layer_id;
+        return {{client::ErrorCode::InvalidArgument, errmsg.str()}};
+      }
+
+      layers_settings.emplace(layer_id, std::move(layer_settings));
+    }
+
+    auto blob_client_response = ApiClientLookup::LookupApiClient(
+        catalog_, context, "blob", "v1", settings_);
+    if (!blob_client_response.IsSuccessful()) {
+      return blob_client_response.GetError();
+    }
+
+    auto publish_client_response = ApiClientLookup::LookupApiClient(
+        catalog_, context, "publish", "v2", settings_);
+    if (!publish_client_response.IsSuccessful()) {
+      return publish_client_response.GetError();
+    }
+
+    return UploadPartitions(pub.GetId().get(), requests, layers_settings,
+                            blob_client_response.GetResult(),
+                            publish_client_response.GetResult(), context);
+  };
+
+  return AddTask(settings_.task_scheduler, pending_requests_,
+                 std::move(publish_task), std::move(callback));
+}
+
+PublishPartitionsDataResponse VersionedLayerClientImpl::UploadPartitions(
+    const std::string& publication_id,
+    const std::vector<model::PublishPartitionDataRequest>& requests,
+    const LayerSettingsMap& layers_settings,
+    const client::OlpClient& blob_client,
+    const client::OlpClient& publish_client,
+    client::CancellationContext context) {
+  // The blobs to upload. The deduplicated requests with the same data in the
+  // same layer share one blob, which is uploaded only if it does not exist.
+  struct BlobUpload {
+    model::PublishPartitionDataRequest request;
+    CatalogSettings::LayerSettings layer_settings;
+    std::string data_handle;
+    bool deduplicated;
+    std::vector<model::PublishPartition> partitions;
+  };
+
+  // The state shared with the blob upload callbacks, which are called from
+  // the network threads. The callbacks own it, so it outlives the upload
+  // when a callback is still running after the last upload is finished.
+  struct UploadState {
+    std::vector<BlobUpload> blobs;
+    std::mutex mutex;
+    std::condition_variable condition;
+    size_t uploads_in_flight = 0u;
+    std::unordered_map<size_t, client::CancellationToken> uploads;
+    // The partitions with uploaded blobs, grouped by the layer ID
+    std::unordered_map<std::string, std::vector<model::PublishPartition>>
+        uploaded_partitions;
+    boost::optional<client::ApiError> error;
+    bool cancelled = false;
+  };
+
+  auto state = std::make_shared<UploadState>();
+
+  // The metadata uploads run in the task thread, so they get their own
+  // context to be cancelled together with the blob uploads.
+  client::CancellationContext metadata_context;
+
+  const bool executed = context.ExecuteOrCancelled([=]() {
+    return client::CancellationToken([=]() mutable {
+      std::vector<client::CancellationToken> uploads;
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->cancelled = true;
+        for (auto& upload : state->uploads) {
+          uploads.emplace_back(std::move(upload.second));
+        }
+        state->uploads.clear();
+      }
+
+      metadata_context.CancelOperation();
+      for (auto& upload : uploads) {
+        upload.Cancel();
+      }
+      state->condition.notify_all();
+    });
+  });
+
+  if (!executed) {
+    return {{client::ErrorCode::Cancelled, "Operation cancelled.", true}};
+  }
+
+  // Takes the metadata chunk that is ready to be uploaded. A chunk is ready
+  // when it is full, or when all the blobs are uploaded.
+  auto take_metadata_chunk =
+      [&](bool blobs_uploaded, std::string& layer_id,
+          std::vector<model::PublishPartition>& partitions) {
+        for (auto& layer : state->uploaded_partitions) {
+          auto& uploaded = layer.second;
+          if (uploaded.empty() ||
+              (!blobs_uploaded && uploaded.size() < kMaxPartitionsPerUpload)) {
+            continue;
+          }
+
+          const auto count = std::min(uploaded.size(), kMaxPartitionsPerUpload);
+          layer_id = layer.first;
+          partitions.assign(std::make_move_iterator(uploaded.end() - count),
+                            std::make_move_iterator(uploaded.end()));
+          uploaded.resize(uploaded.size() - count);
+          return true;
+        }
+        return false;
+      };
+
+  // The blobs are not modified after the uploads are started
+  auto& blobs = state->blobs;
+  blobs.reserve(requests.size());
+  std::unordered_map<std::string, size_t> deduplicated_blobs;
+  for (const auto& request : requests) {
+    const bool deduplicated = request.GetDeduplication();
+    const auto data_handle = deduplicated
+                                 ? ContentDataHandle(request.GetData())
+                                 : GenerateUuid();
+
+    model::PublishPartition partition;
+    partition.SetPartition(request.GetPartitionId().value_or(""));
+    partition.SetDataHandle(data_handle);
+
+    if (deduplicated) {
+      auto result = deduplicated_blobs.emplace(
+          request.GetLayerId() + "::" + data_handle, blobs.size());
+      if (!result.second) {
+        blobs[result.first->second].partitions.push_back(std::move(partition));
+        continue;
+      }
+    }
+
+    blobs.push_back({request, layers_settings.at(request.GetLayerId()),
+                     data_handle, deduplicated, {partition}});
+  }
+
+  // Called when the blob is uploaded, or when it already exists
+  auto finish_upload = [state](size_t index,
+                               boost::optional<client::ApiError> error) {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    --state->uploads_in_flight;
+    state->uploads.erase(index);
+    if (error) {
+      if (!state->error) {
+        state->error = std::move(error);
+      }
+    } else {
+      const auto& blob = state->blobs[index];
+      auto& uploaded = state->uploaded_partitions[blob.request.GetLayerId()];
+      uploaded.insert(uploaded.end(), blob.partitions.begin(),
+                      blob.partitions.end());
+    }
+    state->condition.notify_one();
+  };
+
+  auto put_blob = [state, blob_client, finish_upload](size_t index) {
+    const auto& blob = state->blobs[index];
+    const auto& request = blob.request;
+    return BlobApi::PutBlob(
+        blob_client, request.GetLayerId(), blob.layer_settings.content_type,
+        blob.layer_settings.content_encoding, blob.data_handle,
+        request.GetData(), request.GetBillingTag(),
+        [=](PutBlobResponse response) {
+          finish_upload(index, response.IsSuccessful()
+                                   ? boost::none
+                                   : boost::make_optional(response.GetError()));
+        });
+  };
+
+  // Replaces the token of the upload, unless the upload is finished
+  auto track_upload = [state](size_t index, client::CancellationToken token) {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    if (state->cancelled) {
+      lock.unlock();
+      token.Cancel();
+      return;
+    }
+
+    auto upload_it = state->uploads.find(index);
+    if (upload_it != state->uploads.end()) {
+      upload_it->second = std::move(token);
+    }
+  };
+
+  // The existence of the deduplicated blob is checked before the upload
+  auto check_blob = [state, blob_client, finish_upload, put_blob,
+                     track_upload](size_t index) {
+    const auto& blob = state->blobs[index];
+    return BlobApi::checkBlobExists(
+        blob_client, blob.request.GetLayerId(), blob.data_handle,
+        blob.request.GetBillingTag(), [=](CheckBlobRespone response) {
+          if (!response.IsSuccessful()) {
+            finish_upload(index, response.GetError());
+            return;
+          }
+
+          if (response.GetResult() == http::HttpStatusCode::OK) {
+            finish_upload(index, boost::none);
+            return;
+          }
+
+          // The blob does not exist, upload it unless the publish failed
+          bool failed = false;
+          {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            failed = state->error || state->cancelled;
+          }
+
+          if (failed) {
+            finish_upload(index, client::ApiError(client::ErrorCode::Cancelled,
+                                                  "Operation cancelled."));
+            return;
+          }
+          track_upload(index, put_blob(index));
+        });
+  };
+
+  size_t next_blob = 0u;
+  std::unique_lock<std::mutex> lock(state->mutex);
+  while (true) {
+    const bool failed = state->error || state->cancelled;
+    const bool blobs_uploaded =
+        next_blob == blobs.size() && state->uploads_in_flight == 0u;
+
+    std::string chunk_layer_id;
+    std::vector<model::PublishPartition> partitions;
+    if (!failed &&
+        take_metadata_chunk(blobs_uploaded, chunk_layer_id, partitions)) {
+      model::PublishPartitions chunk;
+      chunk.GetMutablePartitions() = std::move(partitions);
+      lock.unlock();
+      auto response =
+          PublishApi::UploadPartitions(publish_client, chunk, publication_id,
+                                       chunk_layer_id, boost::none,
+                                       metadata_context);
+      lock.lock();
+      if (!response.IsSuccessful() && !state->error) {
+        state->error = response.GetError();
+      }
+      continue;
+    }
+
+    if (failed || blobs_uploaded) {
+      if (state->uploads_in_flight == 0u) {
+        break;
+      }
+      state->condition.wait(lock);
+      continue;
+    }
+
+    if (next_blob == blobs.size() ||
+        state->uploads_in_flight >= kMaxConcurrentBlobUploads) {
+      state->condition.wait(lock);
+      continue;
+    }
+
+    const auto index = next_blob++;
+    ++state->uploads_in_flight;
+    state->uploads.emplace(index, client::CancellationToken());
+    lock.unlock();
+
+    auto token =
+        blobs[index].deduplicated ? check_blob(index) : put_blob(index);
+    track_upload(index, std::move(token));
+
+    lock.lock();
+  }
+
+  if (state->cancelled) {
+    return {{client::ErrorCode::Cancelled, "Operation cancelled.", true}};
+  }
+
+  if (state->error) {
+    return *state->error;
+  }
+
+  std::vector<std::string> partition_ids;
+  partition_ids.reserve(requests.size());
+  for (const auto& request : requests) {
+    partition_ids.push_back(request.GetPartitionId().value_or(""));
+  }
+
+  model::TraceID trace_id;
+  trace_id.SetParentID(publication_id);
+  trace_id.SetGeneratedIDs(partition_ids);
+
+  model::ResponseOk result;
+  result.SetTraceID(trace_id);
+  return result;
+}
+
 UploadPartitionResponse VersionedLayerClientImpl::UploadPartition(
     const std::string& publication_id, const model::PublishPartition& partition,
     const std::string& layer_id, client::CancellationContext context) {
@@ -534,6 +932,217 @@ UploadBlobResponse VersionedLayerClientImpl::UploadBlob(
                           context);
 }
 
+BlobExistsResponse VersionedLayerClientImpl::CheckBlobExists(
+    const std::string& layer_id, const std::string& data_handle,
+    BillingTag billing_tag, client::CancellationContext context) {
+  auto olp_client_response = ApiClientLookup::LookupApiClient(
+      catalog_, context, "blob", "v1", settings_);
+  if (!olp_client_response.IsSuccessful()) {
+    return olp_client_response.GetError();
+  }
+
+  auto blob_client = olp_client_response.MoveResult();
+  auto check_blob_response = BlobApi::checkBlobExists(
+      blob_client, layer_id, data_handle, billing_tag, context);
+  if (!check_blob_response.IsSuccessful()) {
+    return check_blob_response.GetError();
+  }
+
+  return check_blob_response.GetResult() == http::HttpStatusCode::OK;
+}
+
+UploadBlobResponse VersionedLayerClientImpl::UploadBlobMultipart(
+    const model::PublishPartitionDataRequest& request,
+    const std::string& data_handle, const std::string& content_type,
+    const std::string& content_encoding, client::CancellationContext context) {
+  const auto& layer_id = request.GetLayerId();
+  const auto& billing_tag = request.GetBillingTag();
+  const auto& reader = request.GetDataReader();
+  const auto part_size = std::max<size_t>(request.GetPartSize(), 1u);
+  const auto parallel_parts = std::max<size_t>(request.GetParallelParts(), 1u);
+
+  auto olp_client_response = ApiClientLookup::LookupApiClient(
+      catalog_, context, "blob", "v1", settings_);
+  if (!olp_client_response.IsSuccessful()) {
+    return olp_client_response.GetError();
+  }
+
+  auto blob_client = olp_client_response.MoveResult();
+  auto start_response = BlobApi::StartMultipartUpload(
+      blob_client, layer_id, content_type, content_encoding, data_handle,
+      billing_tag, context);
+  if (!start_response.IsSuccessful()) {
+    return start_response.GetError();
+  }
+
+  const auto upload = start_response.MoveResult();
+
+  // The state shared with the part upload callbacks, which are called from
+  // the network threads.
+  struct UploadState {
+    std::mutex mutex;
+    std::condition_variable condition;
+    size_t parts_in_flight = 0u;
+    std::unordered_map<int64_t, client::CancellationToken> uploads;
+    std::vector<model::MultipartUploadPart> parts;
+    boost::optional<client::ApiError> error;
+    bool cancelled = false;
+  };
+
+  auto state = std::make_shared<UploadState>();
+
+  // The multipart upload requests run in the task thread, so they get their
+  // own context to be cancelled together with the part uploads.
+  client::CancellationContext upload_context;
+
+  const bool executed = context.ExecuteOrCancelled([=]() {
+    return client::CancellationToken([=]() mutable {
+      std::vector<client::CancellationToken> uploads;
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->cancelled = true;
+        for (auto& upload : state->uploads) {
+          uploads.emplace_back(std::move(upload.second));
+        }
+        state->uploads.clear();
+      }
+
+      upload_context.CancelOperation();
+      for (auto& upload : uploads) {
+        upload.Cancel();
+      }
+      state->condition.notify_all();
+    });
+  });
+
+  if (!executed) {
+    BlobApi::CancelMultipartUpload(blob_client, upload, billing_tag,
+                                   client::CancellationContext());
+    return {{client::ErrorCode::Cancelled, "Operation cancelled.", true}};
+  }
+
+  // Reads the parts one after another, while up to parallel_parts of the
+  // previous parts are uploaded. The blob has at least one part, even when
+  // the data is empty.
+  int64_t part_number = 0;
+  bool data_read = false;
+  std::unique_lock<std::mutex> lock(state->mutex);
+  while (true) {
+    if (state->error || state->cancelled || data_read) {
+      if (state->parts_in_flight == 0u) {
+        break;
+      }
+      state->condition.wait(lock);
+      continue;
+    }
+
+    if (state->parts_in_flight >= parallel_parts) {
+      state->condition.wait(lock);
+      continue;
+    }
+
+    lock.unlock();
+
+    auto data = std::make_shared<std::vector<unsigned char>>(part_size);
+    size_t size = 0u;
+    bool read_failed = false;
+    while (size < part_size) {
+      const auto read = reader ? reader(data->data() + size, part_size - size)
+                               : int64_t{0};
+      if (read < 0) {
+        read_failed = true;
+        break;
+      }
+      if (read == 0) {
+        data_read = true;
+        break;
+      }
+      size += static_cast<size_t>(read);
+    }
+    data->resize(size);
+
+    lock.lock();
+    if (state->cancelled) {
+      continue;
+    }
+
+    if (read_failed) {
+      if (!state->error) {
+        state->error = client::ApiError(client::ErrorCode::Unknown,
+                                        "Failed to read the data");
+      }
+      continue;
+    }
+
+    if (size == 0u && part_number > 0) {
+      continue;
+    }
+
+    const auto number = ++part_number;
+    ++state->parts_in_flight;
+    state->uploads.emplace(number, client::CancellationToken());
+    lock.unlock();
+
+    auto token = BlobApi::UploadPart(
+        blob_client, upload, number, data, billing_tag,
+        [=](UploadPartResponse response) {
+          std::lock_guard<std::mutex> lock(state->mutex);
+          --state->parts_in_flight;
+          state->uploads.erase(number);
+          if (!response.IsSuccessful()) {
+            if (!state->error) {
+              state->error = response.GetError();
+            }
+          } else {
+            model::MultipartUploadPart part;
+            part.SetEtag(response.GetResult());
+            part.SetNumber(number);
+            state->parts.push_back(std::move(part));
+          }
+          state->condition.notify_one();
+        });
+
+    lock.lock();
+    // The callback might be already called, then the upload is not tracked
+    auto upload_it = state->uploads.find(number);
+    if (upload_it != state->uploads.end()) {
+      upload_it->second = std::move(token);
+    }
+  }
+
+  const bool cancelled = state->cancelled;
+  const auto error = state->error;
+  model::MultipartUploadParts parts;
+  parts.GetMutableParts().swap(state->parts);
+  lock.unlock();
+
+  if (cancelled || error) {
+    // Do not keep the uploaded parts in the storage. The upload context might
+    // be cancelled already, so the request gets its own.
+    BlobApi::CancelMultipartUpload(blob_client, upload, billing_tag,
+                                   client::CancellationContext());
+    if (cancelled) {
+      return {{client::ErrorCode::Cancelled, "Operation cancelled.", true}};
+    }
+    return *error;
+  }
+
+  auto& uploaded_parts = parts.GetMutableParts();
+  std::sort(uploaded_parts.begin(), uploaded_parts.end(),
+            [](const model::MultipartUploadPart& lhs,
+               const model::MultipartUploadPart& rhs) {
+              return lhs.GetNumber() < rhs.GetNumber();
+            });
+
+  auto complete_response = BlobApi::CompleteMultipartUpload(
+      blob_client, upload, parts, billing_tag, upload_context);
+  if (!complete_response.IsSuccessful()) {
+    return complete_response.GetError();
+  }
+
+  return UploadBlobResult{};
+}
+
 client::CancellableFuture<CheckDataExistsResponse>
 VersionedLayerClientImpl::CheckDataExists(
     const model::CheckDataExistsRequest& request) {
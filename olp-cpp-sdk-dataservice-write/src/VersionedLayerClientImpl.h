@@ -33,6 +33,9 @@
 #include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace olp {
 namespace dataservice {
@@ -54,6 +57,8 @@ using UploadBlobResponse =
     client::ApiResponse<UploadBlobResult, client::ApiError>;
 using UploadBlobCallback = std::function<void(UploadBlobResponse response)>;
 
+using BlobExistsResponse = client::ApiResponse<bool, client::ApiError>;
+
 class VersionedLayerClientImpl
     : public std::enable_shared_from_this<VersionedLayerClientImpl> {
  public:
@@ -101,6 +106,15 @@ class VersionedLayerClientImpl
       const model::PublishPartitionDataRequest& request,
       PublishPartitionDataCallback callback);
 
+  client::CancellableFuture<PublishPartitionsDataResponse> PublishToBatch(
+      const model::Publication& pub,
+      std::vector<model::PublishPartitionDataRequest> requests);
+
+  client::CancellationToken PublishToBatch(
+      const model::Publication& pub,
+      std::vector<model::PublishPartitionDataRequest> requests,
+      PublishPartitionsDataCallback callback);
+
   client::CancellableFuture<CheckDataExistsResponse> CheckDataExists(
       const model::CheckDataExistsRequest& request);
 
@@ -123,11 +137,32 @@ class VersionedLayerClientImpl
                                 BillingTag billing_tag,
                                 client::CancellationContext context);
 
+  BlobExistsResponse CheckBlobExists(const std::string& layer_id,
+                                     const std::string& data_handle,
+                                     BillingTag billing_tag,
+                                     client::CancellationContext context);
+
+  UploadBlobResponse UploadBlobMultipart(
+      const model::PublishPartitionDataRequest& request,
+      const std::string& data_handle, const std::string& content_type,
+      const std::string& content_encoding, client::CancellationContext context);
+
   UploadPartitionResponse UploadPartition(
       const std::string& publication_id,
       const model::PublishPartition& partition, const std::string& layer_id,
       client::CancellationContext context);
 
+  using LayerSettingsMap =
+      std::unordered_map<std::string, CatalogSettings::LayerSettings>;
+
+  PublishPartitionsDataResponse UploadPartitions(
+      const std::string& publication_id,
+      const std::vector<model::PublishPartitionDataRequest>& requests,
+      const LayerSettingsMap& layers_settings,
+      const client::OlpClient& blob_client,
+      const client::OlpClient& publish_client,
+      client::CancellationContext context);
+
   client::HRN catalog_;
   client::OlpClientSettings settings_;
 
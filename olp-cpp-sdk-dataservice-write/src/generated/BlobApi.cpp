@@ -27,11 +27,38 @@
 
 #include <olp/core/client/HttpResponse.h>
 #include <olp/core/http/HttpStatusCode.h>
+#include <olp/core/http/NetworkConstants.h>
+#include <olp/core/http/NetworkUtils.h>
+
+// clang-format off
+#include "generated/parser/MultipartUploadParser.h"
+#include "JsonResultParser.h"
+#include "generated/serializer/MultipartUploadSerializer.h"
+#include "generated/serializer/JsonSerializer.h"
+// clang-format on
 
 namespace client = olp::client;
 
 namespace {
 const std::string kQueryParamBillingTag = "billingTag";
+const std::string kQueryParamPartNumber = "partNumber";
+
+// The links of a multipart upload are absolute URLs, while the client calls
+// the paths relative to the blob API base URL.
+bool GetRelativePath(const client::OlpClient& client, const std::string& url,
+                     std::string& path) {
+  const auto base_url = client.GetBaseUrl();
+  if (url.empty() || url.compare(0, base_url.size(), base_url) != 0) {
+    return false;
+  }
+  path = url.substr(base_url.size());
+  return true;
+}
+
+client::ApiError InvalidUploadUrlError(const std::string& url) {
+  return client::ApiError(client::ErrorCode::Unknown,
+                          "Unexpected multipart upload URL: " + url);
+}
 }  // namespace
 
 namespace olp {
@@ -177,6 +204,212 @@ client::CancellationToken BlobApi::checkBlobExists(
   return cancel_token;
 }
 
+CheckBlobRespone BlobApi::checkBlobExists(
+    const client::OlpClient& client, const std::string& layer_id,
+    const std::string& data_handle,
+    const boost::optional<std::string>& billing_tag,
+    client::CancellationContext context) {
+  std::multimap<std::string, std::string> header_params;
+  std::multimap<std::string, std::string> query_params;
+  std::multimap<std::string, std::string> form_params;
+
+  header_params.insert(std::make_pair("Accept", "application/json"));
+
+  if (billing_tag) {
+    query_params.insert(
+        std::make_pair(kQueryParamBillingTag, billing_tag.get()));
+  }
+
+  std::string check_blob_uri = "/layers/" + layer_id + "/data/" + data_handle;
+  auto http_response = client.CallApi(
+      std::move(check_blob_uri), "HEAD", std::move(query_params),
+      std::move(header_params), std::move(form_params), nullptr, "", context);
+  if (http_response.GetStatus() != http::HttpStatusCode::OK &&
+      http_response.GetStatus() != http::HttpStatusCode::NOT_FOUND) {
+    return CheckBlobRespone(client::ApiError(
+        http_response.GetStatus(), http_response.GetResponseAsString()));
+  }
+
+  return CheckBlobRespone(http_response.GetStatus());
+}
+
+StartMultipartUploadResponse BlobApi::StartMultipartUpload(
+    const client::OlpClient& client, const std::string& layer_id,
+    const std::string& content_type, const std::string& content_encoding,
+    const std::string& data_handle,
+    const boost::optional<std::string>& billing_tag,
+    client::CancellationContext context) {
+  std::multimap<std::string, std::string> header_params;
+  std::multimap<std::string, std::string> query_params;
+  std::multimap<std::string, std::string> form_params;
+
+  header_params.insert(std::make_pair("Accept", "application/json"));
+
+  if (billing_tag) {
+    query_params.insert(
+        std::make_pair(kQueryParamBillingTag, billing_tag.get()));
+  }
+
+  std::string start_multipart_uri =
+      "/layers/" + layer_id + "/data/" + data_handle + "/multiparts";
+
+  model::MultipartUploadContent content;
+  content.SetContentType(content_type);
+  content.SetContentEncoding(content_encoding);
+
+  auto serialized_content = serializer::serialize(content);
+  auto data = std::make_shared<std::vector<unsigned char>>(
+      serialized_content.begin(), serialized_content.end());
+
+  auto http_response = client.CallApi(
+      std::move(start_multipart_uri), "POST", std::move(query_params),
+      std::move(header_params), std::move(form_params), std::move(data),
+      "application/json", context);
+  if (http_response.GetStatus() != http::HttpStatusCode::OK &&
+      http_response.GetStatus() != http::HttpStatusCode::CREATED &&
+      http_response.GetStatus() != http::HttpStatusCode::ACCEPTED) {
+    return StartMultipartUploadResponse(client::ApiError(
+        http_response.GetStatus(), http_response.GetResponseAsString()));
+  }
+
+  auto response = parser::parse_result<StartMultipartUploadResponse>(
+      http_response.GetRawResponse());
+  if (response.IsSuccessful()) {
+    const auto& upload = response.GetResult();
+    std::string path;
+    if (!GetRelativePath(client, upload.GetUploadPartUrl(), path)) {
+      return InvalidUploadUrlError(upload.GetUploadPartUrl());
+    }
+    if (!GetRelativePath(client, upload.GetCompleteUrl(), path)) {
+      return InvalidUploadUrlError(upload.GetCompleteUrl());
+    }
+  }
+
+  return response;
+}
+
+client::CancellationToken BlobApi::UploadPart(
+    const client::OlpClient& client, const model::MultipartUpload& upload,
+    int64_t part_number,
+    const std::shared_ptr<std::vector<unsigned char>>& data,
+    const boost::optional<std::string>& billing_tag,
+    UploadPartCallback callback) {
+  std::multimap<std::string, std::string> header_params;
+  std::multimap<std::string, std::string> query_params;
+  std::multimap<std::string, std::string> form_params;
+
+  header_params.insert(std::make_pair("Accept", "application/json"));
+
+  query_params.insert(
+      std::make_pair(kQueryParamPartNumber, std::to_string(part_number)));
+  if (billing_tag) {
+    query_params.insert(
+        std::make_pair(kQueryParamBillingTag, billing_tag.get()));
+  }
+
+  std::string upload_part_uri;
+  if (!GetRelativePath(client, upload.GetUploadPartUrl(), upload_part_uri)) {
+    callback(InvalidUploadUrlError(upload.GetUploadPartUrl()));
+    return client::CancellationToken();
+  }
+
+  return client.CallApi(
+      upload_part_uri, "POST", query_params, header_params, form_params, data,
+      "application/octet-stream",
+      [callback](client::HttpResponse http_response) {
+        if (http_response.GetStatus() != http::HttpStatusCode::OK &&
+            http_response.GetStatus() != http::HttpStatusCode::NO_CONTENT) {
+          callback(UploadPartResponse(client::ApiError(
+              http_response.GetStatus(), http_response.GetResponseAsString())));
+          return;
+        }
+
+        for (const auto& header : http_response.GetHeaders()) {
+          if (http::NetworkUtils::CaseInsensitiveCompare(header.first,
+                                                         http::kETagHeader)) {
+            callback(UploadPartResponse(header.second));
+            return;
+          }
+        }
+
+        callback(UploadPartResponse(client::ApiError(
+            client::ErrorCode::Unknown, "Part uploaded without ETag header")));
+      });
+}
+
+CompleteMultipartUploadResponse BlobApi::CompleteMultipartUpload(
+    const client::OlpClient& client, const model::MultipartUpload& upload,
+    const model::MultipartUploadParts& parts,
+    const boost::optional<std::string>& billing_tag,
+    client::CancellationContext context) {
+  std::multimap<std::string, std::string> header_params;
+  std::multimap<std::string, std::string> query_params;
+  std::multimap<std::string, std::string> form_params;
+
+  header_params.insert(std::make_pair("Accept", "application/json"));
+
+  if (billing_tag) {
+    query_params.insert(
+        std::make_pair(kQueryParamBillingTag, billing_tag.get()));
+  }
+
+  std::string complete_uri;
+  if (!GetRelativePath(client, upload.GetCompleteUrl(), complete_uri)) {
+    return InvalidUploadUrlError(upload.GetCompleteUrl());
+  }
+
+  auto serialized_parts = serializer::serialize(parts);
+  auto data = std::make_shared<std::vector<unsigned char>>(
+      serialized_parts.begin(), serialized_parts.end());
+
+  auto http_response = client.CallApi(
+      std::move(complete_uri), "PUT", std::move(query_params),
+      std::move(header_params), std::move(form_params), std::move(data),
+      "application/json", context);
+  if (http_response.GetStatus() != http::HttpStatusCode::OK &&
+      http_response.GetStatus() != http::HttpStatusCode::NO_CONTENT) {
+    return CompleteMultipartUploadResponse(client::ApiError(
+        http_response.GetStatus(), http_response.GetResponseAsString()));
+  }
+
+  return CompleteMultipartUploadResponse(client::ApiNoResult());
+}
+
+CancelMultipartUploadResponse BlobApi::CancelMultipartUpload(
+    const client::OlpClient& client, const model::MultipartUpload& upload,
+    const boost::optional<std::string>& billing_tag,
+    client::CancellationContext context) {
+  std::multimap<std::string, std::string> header_params;
+  std::multimap<std::string, std::string> query_params;
+  std::multimap<std::string, std::string> form_params;
+
+  header_params.insert(std::make_pair("Accept", "application/json"));
+
+  if (billing_tag) {
+    query_params.insert(
+        std::make_pair(kQueryParamBillingTag, billing_tag.get()));
+  }
+
+  // Without the delete link the parts are removed by the service, when the
+  // upload expires.
+  std::string delete_uri;
+  if (!GetRelativePath(client, upload.GetDeleteUrl(), delete_uri)) {
+    return InvalidUploadUrlError(upload.GetDeleteUrl());
+  }
+
+  auto http_response = client.CallApi(
+      std::move(delete_uri), "DELETE", std::move(query_params),
+      std::move(header_params), std::move(form_params), nullptr, "", context);
+  if (http_response.GetStatus() != http::HttpStatusCode::OK &&
+      http_response.GetStatus() != http::HttpStatusCode::ACCEPTED &&
+      http_response.GetStatus() != http::HttpStatusCode::NO_CONTENT) {
+    return CancelMultipartUploadResponse(client::ApiError(
+        http_response.GetStatus(), http_response.GetResponseAsString()));
+  }
+
+  return CancelMultipartUploadResponse(client::ApiNoResult());
+}
+
 }  // namespace write
 }  // namespace dataservice
 }  // namespace olp
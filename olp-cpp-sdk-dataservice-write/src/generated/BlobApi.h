@@ -27,6 +27,7 @@
 #include <olp/core/client/ApiResponse.h>
 #include <olp/core/client/CancellationContext.h>
 #include <olp/core/client/OlpClient.h>
+#include "generated/model/MultipartUpload.h"
 
 namespace olp {
 namespace dataservice {
@@ -40,6 +41,15 @@ using DeleteBlobRespone =
 using DeleteBlobCallback = std::function<void(DeleteBlobRespone)>;
 using CheckBlobRespone = client::ApiResponse<int, client::ApiError>;
 using CheckBlobCallback = std::function<void(CheckBlobRespone)>;
+using StartMultipartUploadResponse =
+    client::ApiResponse<model::MultipartUpload, client::ApiError>;
+/// The response of a part upload contains the ETag of the uploaded part.
+using UploadPartResponse = client::ApiResponse<std::string, client::ApiError>;
+using UploadPartCallback = std::function<void(UploadPartResponse)>;
+using CompleteMultipartUploadResponse =
+    client::ApiResponse<client::ApiNoResult, client::ApiError>;
+using CancelMultipartUploadResponse =
+    client::ApiResponse<client::ApiNoResult, client::ApiError>;
 
 /**
  * @brief The blob service supports the upload and retrieval of large volumes of
@@ -140,6 +150,103 @@ class BlobApi {
       const std::string& data_handle,
       const boost::optional<std::string>& billing_tag,
       const CheckBlobCallback& callback);
+
+  /**
+   * @brief Checks if a data handle exists
+   * Checks if a blob exists for the requested data handle.
+   * @param client Instance of OlpClient used to make REST request.
+   * @param layer_id The ID of the layer that the data blob belongs to.
+   * @param data_handle The data handle (ID) represents an identifier for the
+   * data blob.
+   * @param billing_tag Optional. An optional free-form tag which is used for
+   * grouping billing records together. If supplied, it must be between 4 - 16
+   * characters, contain only alpha/numeric ASCII characters [A-Za-z0-9].
+   * @param context The CancellationContext used to cancel the request.
+   * @return The HTTP status code, 200 if the blob exists and 404 if not.
+   */
+  static CheckBlobRespone checkBlobExists(
+      const client::OlpClient& client, const std::string& layer_id,
+      const std::string& data_handle,
+      const boost::optional<std::string>& billing_tag,
+      client::CancellationContext context);
+
+  /**
+   * @brief Starts a multipart upload of a data blob
+   * Use this upload mechanism for blobs larger than 50 MB. The data is uploaded
+   * in parts with \c UploadPart, and the blob is created from the uploaded
+   * parts with \c CompleteMultipartUpload. All the parts except the last one
+   * must be at least 5 MB, and there can be at most 10000 parts.
+   * @param client Instance of OlpClient used to make REST request.
+   * @param layer_id The ID of the layer that the data blob belongs to.
+   * @param content_type The content type configured for the target layer.
+   * @param content_encoding The content encoding configured for the target
+   * layer.
+   * @param data_handle The data handle (ID) represents an identifier for the
+   * data blob.
+   * @param billing_tag Optional. An optional free-form tag which is used for
+   * grouping billing records together. If supplied, it must be between 4 - 16
+   * characters, contain only alpha/numeric ASCII characters [A-Za-z0-9].
+   * @param context The CancellationContext used to cancel the request.
+   * @return The links of the multipart upload.
+   */
+  static StartMultipartUploadResponse StartMultipartUpload(
+      const client::OlpClient& client, const std::string& layer_id,
+      const std::string& content_type, const std::string& content_encoding,
+      const std::string& data_handle,
+      const boost::optional<std::string>& billing_tag,
+      client::CancellationContext context);
+
+  /**
+   * @brief Uploads a part of a multipart upload
+   * The parts are independent, so they can be uploaded in parallel and
+   * retried one by one.
+   * @param client Instance of OlpClient used to make REST request.
+   * @param upload The started multipart upload.
+   * @param part_number The number of the part, starts with 1.
+   * @param data Content of the part.
+   * @param billing_tag Optional. An optional free-form tag which is used for
+   * grouping billing records together.
+   * @param callback UploadPartCallback which will be called with the ETag of
+   * the uploaded part when the operation completes.
+   * @return A CancellationToken which can be used to cancel the ongoing
+   * request.
+   */
+  static client::CancellationToken UploadPart(
+      const client::OlpClient& client, const model::MultipartUpload& upload,
+      int64_t part_number,
+      const std::shared_ptr<std::vector<unsigned char>>& data,
+      const boost::optional<std::string>& billing_tag,
+      UploadPartCallback callback);
+
+  /**
+   * @brief Completes a multipart upload
+   * Creates the data blob from the uploaded parts.
+   * @param client Instance of OlpClient used to make REST request.
+   * @param upload The started multipart upload.
+   * @param parts The uploaded parts, ordered by the part number.
+   * @param billing_tag Optional. An optional free-form tag which is used for
+   * grouping billing records together.
+   * @param context The CancellationContext used to cancel the request.
+   */
+  static CompleteMultipartUploadResponse CompleteMultipartUpload(
+      const client::OlpClient& client, const model::MultipartUpload& upload,
+      const model::MultipartUploadParts& parts,
+      const boost::optional<std::string>& billing_tag,
+      client::CancellationContext context);
+
+  /**
+   * @brief Cancels a multipart upload
+   * Deletes the uploaded parts of a multipart upload that is not completed.
+   * @param client Instance of OlpClient used to make REST request.
+   * @param upload The started multipart upload.
+   * @param billing_tag Optional. An optional free-form tag which is used for
+   * grouping billing records together.
+   * @param context The CancellationContext used to cancel the request.
+   */
+  static CancelMultipartUploadResponse CancelMultipartUpload(
+      const client::OlpClient& client, const model::MultipartUpload& upload,
+      const boost::optional<std::string>& billing_tag,
+      client::CancellationContext context);
 };
 
 }  // namespace write
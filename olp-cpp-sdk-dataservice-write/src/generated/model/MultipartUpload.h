@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace olp {
+namespace dataservice {
+namespace write {
+namespace model {
+
+/// The content settings of a blob uploaded in parts.
+class MultipartUploadContent {
+ public:
+  MultipartUploadContent() = default;
+  MultipartUploadContent(const MultipartUploadContent&) = default;
+  MultipartUploadContent(MultipartUploadContent&&) = default;
+  MultipartUploadContent& operator=(const MultipartUploadContent&) = default;
+  MultipartUploadContent& operator=(MultipartUploadContent&&) = default;
+  virtual ~MultipartUploadContent() = default;
+
+ private:
+  std::string content_type_;
+  std::string content_encoding_;
+
+ public:
+  const std::string& GetContentType() const { return content_type_; }
+  std::string& GetMutableContentType() { return content_type_; }
+  void SetContentType(const std::string& value) {
+    this->content_type_ = value;
+  }
+
+  const std::string& GetContentEncoding() const { return content_encoding_; }
+  std::string& GetMutableContentEncoding() { return content_encoding_; }
+  void SetContentEncoding(const std::string& value) {
+    this->content_encoding_ = value;
+  }
+};
+
+/// The links of a started multipart upload.
+class MultipartUpload {
+ public:
+  MultipartUpload() = default;
+  MultipartUpload(const MultipartUpload&) = default;
+  MultipartUpload(MultipartUpload&&) = default;
+  MultipartUpload& operator=(const MultipartUpload&) = default;
+  MultipartUpload& operator=(MultipartUpload&&) = default;
+  virtual ~MultipartUpload() = default;
+
+ private:
+  std::string upload_part_url_;
+  std::string complete_url_;
+  std::string delete_url_;
+  std::string status_url_;
+
+ public:
+  const std::string& GetUploadPartUrl() const { return upload_part_url_; }
+  std::string& GetMutableUploadPartUrl() { return upload_part_url_; }
+  void SetUploadPartUrl(const std::string& value) {
+    this->upload_part_url_ = value;
+  }
+
+  const std::string& GetCompleteUrl() const { return complete_url_; }
+  std::string& GetMutableCompleteUrl() { return complete_url_; }
+  void SetCompleteUrl(const std::string& value) { this->complete_url_ = value; }
+
+  const std::string& GetDeleteUrl() const { return delete_url_; }
+  std::string& GetMutableDeleteUrl() { return delete_url_; }
+  void SetDeleteUrl(const std::string& value) { this->delete_url_ = value; }
+
+  const std::string& GetStatusUrl() const { return status_url_; }
+  std::string& GetMutableStatusUrl() { return status_url_; }
+  void SetStatusUrl(const std::string& value) { this->status_url_ = value; }
+};
+
+/// An uploaded part of a multipart upload.
+class MultipartUploadPart {
+ public:
+  MultipartUploadPart() = default;
+  MultipartUploadPart(const MultipartUploadPart&) = default;
+  MultipartUploadPart(MultipartUploadPart&&) = default;
+  MultipartUploadPart& operator=(const MultipartUploadPart&) = default;
+  MultipartUploadPart& operator=(MultipartUploadPart&&) = default;
+  virtual ~MultipartUploadPart() = default;
+
+ private:
+  std::string etag_;
+  int64_t number_{0};
+
+ public:
+  const std::string& GetEtag() const { return etag_; }
+  std::string& GetMutableEtag() { return etag_; }
+  void SetEtag(const std::string& value) { this->etag_ = value; }
+
+  int64_t GetNumber() const { return number_; }
+  int64_t& GetMutableNumber() { return number_; }
+  void SetNumber(int64_t value) { this->number_ = value; }
+};
+
+/// The uploaded parts that complete a multipart upload.
+class MultipartUploadParts {
+ public:
+  MultipartUploadParts() = default;
+  MultipartUploadParts(const MultipartUploadParts&) = default;
+  MultipartUploadParts(MultipartUploadParts&&) = default;
+  MultipartUploadParts& operator=(const MultipartUploadParts&) = default;
+  MultipartUploadParts& operator=(MultipartUploadParts&&) = default;
+  virtual ~MultipartUploadParts() = default;
+
+ private:
+  std::vector<MultipartUploadPart> parts_;
+
+ public:
+  const std::vector<MultipartUploadPart>& GetParts() const { return parts_; }
+  std::vector<MultipartUploadPart>& GetMutableParts() { return parts_; }
+  void SetParts(const std::vector<MultipartUploadPart>& value) {
+    this->parts_ = value;
+  }
+};
+
+}  // namespace model
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "MultipartUploadParser.h"
+
+#include <olp/core/generated/parser/ParserWrapper.h>
+
+namespace olp {
+namespace parser {
+namespace {
+std::string ParseLink(const rapidjson::Value& links, const char* name) {
+  auto link = links.FindMember(name);
+  if (link == links.MemberEnd() || !link->value.IsObject()) {
+    return {};
+  }
+  return parse<std::string>(link->value, "href");
+}
+}  // namespace
+
+void from_json(const rapidjson::Value& value,
+               dataservice::write::model::MultipartUpload& x) {
+  auto links = value.FindMember("links");
+  if (links == value.MemberEnd() || !links->value.IsObject()) {
+    return;
+  }
+
+  x.SetUploadPartUrl(ParseLink(links->value, "uploadPart"));
+  x.SetCompleteUrl(ParseLink(links->value, "complete"));
+  x.SetDeleteUrl(ParseLink(links->value, "delete"));
+  x.SetStatusUrl(ParseLink(links->value, "status"));
+}
+
+}  // namespace parser
+}  // namespace olp
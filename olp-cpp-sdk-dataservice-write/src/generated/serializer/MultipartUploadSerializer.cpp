@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "MultipartUploadSerializer.h"
+
+namespace olp {
+namespace serializer {
+void to_json(const dataservice::write::model::MultipartUploadContent& x,
+             rapidjson::Value& value,
+             rapidjson::Document::AllocatorType& allocator) {
+  value.AddMember("contentType",
+                  rapidjson::StringRef(x.GetContentType().c_str()), allocator);
+
+  if (!x.GetContentEncoding().empty()) {
+    value.AddMember("contentEncoding",
+                    rapidjson::StringRef(x.GetContentEncoding().c_str()),
+                    allocator);
+  }
+}
+
+void to_json(const dataservice::write::model::MultipartUploadParts& x,
+             rapidjson::Value& value,
+             rapidjson::Document::AllocatorType& allocator) {
+  rapidjson::Value parts(rapidjson::kArrayType);
+  for (const auto& part : x.GetParts()) {
+    rapidjson::Value part_value(rapidjson::kObjectType);
+    part_value.AddMember("etag", rapidjson::StringRef(part.GetEtag().c_str()),
+                         allocator);
+    part_value.AddMember("number", part.GetNumber(), allocator);
+    parts.PushBack(part_value, allocator);
+  }
+  value.AddMember("parts", parts, allocator);
+}
+
+}  // namespace serializer
+}  // namespace olp
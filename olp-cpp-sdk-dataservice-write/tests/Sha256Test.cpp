@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "Sha256.h"
+
+namespace {
+
+using olp::dataservice::write::Sha256;
+
+std::string Hash(const std::string& data) {
+  Sha256 hash;
+  hash.Update(reinterpret_cast<const unsigned char*>(data.data()),
+              data.size());
+  return hash.FinalizeHex();
+}
+
+TEST(Sha256Test, Digest) {
+  {
+    SCOPED_TRACE("Empty data");
+    EXPECT_EQ(
+        Hash(""),
+        "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+  }
+
+  {
+    SCOPED_TRACE("One block");
+    EXPECT_EQ(
+        Hash("abc"),
+        "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+  }
+
+  {
+    SCOPED_TRACE("Two blocks");
+    EXPECT_EQ(
+        Hash("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+        "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+  }
+
+  {
+    SCOPED_TRACE("Incremental updates");
+    const std::vector<unsigned char> data(1000000u, 'a');
+
+    Sha256 hash;
+    for (auto offset = 0u; offset < data.size(); offset += 999u) {
+      const auto size = std::min<size_t>(999u, data.size() - offset);
+      hash.Update(data.data() + offset, size);
+    }
+    EXPECT_EQ(
+        hash.FinalizeHex(),
+        "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+  }
+}
+
+}  // namespace
@@ -23,8 +23,20 @@
 #include <mocks/NetworkMock.h>
 #include <olp/core/cache/CacheSettings.h>
 #include <olp/core/client/OlpClientSettingsFactory.h>
+#include <olp/core/utils/Dir.h>
+#include <olp/dataservice/write/DefaultFlushEventListener.h>
 #include <boost/optional/optional_io.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
 #include <unordered_set>
+#include <generated/serializer/PublishDataRequestSerializer.h>
+#include <generated/serializer/JsonSerializer.h>
 #include "StreamLayerClientImpl.h"
 
 namespace {
@@ -126,6 +138,23 @@ class MockStreamLayerClientImpl : public write::StreamLayerClientImpl {
   MOCK_METHOD(std::string, GenerateUuid, (), (const, override));
 };
 
+class FlushListenerMock : public write::DefaultFlushEventListener<
+                              const write::StreamLayerClient::FlushResponse&> {
+ public:
+  void NotifyFlushMetricsHasChanged(write::FlushMetrics metrics) override {
+    if (metrics.num_total_flush_events > 0u) {
+      promise_.set_value(metrics);
+    }
+  }
+
+  std::future<write::FlushMetrics> GetFuture() {
+    return promise_.get_future();
+  }
+
+ private:
+  std::promise<write::FlushMetrics> promise_;
+};
+
 class StreamLayerClientImplTest : public ::testing::Test {
  protected:
   void SetUp() override {
@@ -735,7 +764,6 @@ TEST_F(StreamLayerClientImplTest, QueueAndFlush) {
   auto client = std::make_shared<MockStreamLayerClientImpl>(
       kHrn, write::StreamLayerClientSettings{}, settings_);
 
-  size_t uuid_call_count = 1;
   // Forward trace ID from request to response
   ON_CALL(*client, PublishDataTask(_, _))
       .WillByDefault([](model::PublishDataRequest request,
@@ -745,13 +773,10 @@ TEST_F(StreamLayerClientImplTest, QueueAndFlush) {
         result.SetTraceID(request.GetTraceId().get());
         return write::PublishDataResponse{result};
       });
-  ON_CALL(*client, GenerateUuid)
-      .WillByDefault([&uuid_call_count]() -> std::string {
-        return std::to_string(uuid_call_count++);
-      });
 
   EXPECT_CALL(*client, PublishDataTask(_, _)).Times(kBatchSize);
-  EXPECT_CALL(*client, GenerateUuid()).Times(kBatchSize);
+  // The queued requests are stored with the sequence keys
+  EXPECT_CALL(*client, GenerateUuid()).Times(0);
 
   // queues all  requests:
   for (size_t i = 0; i < kBatchSize; ++i) {
@@ -779,4 +804,487 @@ TEST_F(StreamLayerClientImplTest, QueueAndFlush) {
   EXPECT_EQ(kBatchSize, trace_ids.size());
 }
 
+TEST_F(StreamLayerClientImplTest, ParallelFlush) {
+  const size_t kBatchSize = 20;
+  const size_t kParallelRequests = 4;
+  const std::vector<std::string> kLayers = {"layer-1", "layer-2"};
+  settings_.cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+
+  write::StreamLayerClientSettings stream_settings;
+  stream_settings.flush_parallel_requests = kParallelRequests;
+  stream_settings.flush_preserve_layer_order = true;
+
+  auto client = std::make_shared<MockStreamLayerClientImpl>(
+      kHrn, stream_settings, settings_);
+
+  std::mutex mutex;
+  std::map<std::string, size_t> layers_in_flight;
+  std::map<std::string, std::vector<size_t>> published;
+  size_t max_layer_in_flight = 0u;
+
+  // Forward trace ID from request to response
+  ON_CALL(*client, PublishDataTask(_, _))
+      .WillByDefault([&](model::PublishDataRequest request,
+                         client::CancellationContext /*context*/)
+                         -> write::PublishDataResponse {
+        const auto& layer = request.GetLayerId();
+        const auto& trace_id = request.GetTraceId().get();
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          auto& in_flight = ++layers_in_flight[layer];
+          max_layer_in_flight = std::max(max_layer_in_flight, in_flight);
+          published[layer].push_back(std::stoul(trace_id));
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          --layers_in_flight[layer];
+        }
+
+        write::PublishDataResult result;
+        result.SetTraceID(trace_id);
+        return write::PublishDataResponse{result};
+      });
+
+  EXPECT_CALL(*client, PublishDataTask(_, _)).Times(kBatchSize);
+
+  for (size_t i = 0; i < kBatchSize; ++i) {
+    auto error = client->Queue(
+        model::PublishDataRequest()
+            .WithTraceId(std::to_string(i))
+            .WithData(std::make_shared<std::vector<unsigned char>>(1, 'z'))
+            .WithLayerId(kLayers[i % kLayers.size()]));
+    EXPECT_EQ(boost::none, error) << *error;
+  }
+
+  {
+    SCOPED_TRACE("Flush limited number of requests");
+
+    auto response =
+        client->Flush(model::FlushRequest().WithNumberOfRequestsToFlush(6))
+            .GetFuture()
+            .get();
+    ASSERT_EQ(response.size(), 6u);
+    EXPECT_EQ(client->QueueSize(), kBatchSize - 6u);
+  }
+
+  {
+    SCOPED_TRACE("Flush the rest of requests");
+
+    auto response = client->Flush(model::FlushRequest()).GetFuture().get();
+    ASSERT_EQ(response.size(), kBatchSize - 6u);
+    EXPECT_EQ(client->QueueSize(), 0u);
+
+    // Responses are in the queue order
+    for (size_t i = 0; i < response.size(); ++i) {
+      ASSERT_TRUE(response[i].IsSuccessful());
+      EXPECT_EQ(std::to_string(i + 6u), response[i].GetResult().GetTraceID());
+    }
+  }
+
+  // Requests to the same layer are published one by one in the queue order
+  EXPECT_EQ(max_layer_in_flight, 1u);
+  for (const auto& layer : published) {
+    EXPECT_TRUE(std::is_sorted(layer.second.begin(), layer.second.end()));
+    EXPECT_EQ(layer.second.size(), kBatchSize / kLayers.size());
+  }
+}
+
+TEST_F(StreamLayerClientImplTest, FlushRequeuesFailedRequests) {
+  const size_t kBatchSize = 6;
+  const std::vector<std::string> kLayers = {"layer-1", "layer-2"};
+  const std::set<std::string> kFailedTraceIds = {"1", "4"};
+  const std::string kBadTraceId = "2";
+  settings_.cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+
+  write::StreamLayerClientSettings stream_settings;
+  stream_settings.flush_parallel_requests = 2;
+  stream_settings.flush_preserve_layer_order = true;
+
+  auto client = std::make_shared<MockStreamLayerClientImpl>(
+      kHrn, stream_settings, settings_);
+
+  std::mutex mutex;
+  bool fail = true;
+
+  ON_CALL(*client, PublishDataTask(_, _))
+      .WillByDefault([&](model::PublishDataRequest request,
+                         client::CancellationContext /*context*/)
+                         -> write::PublishDataResponse {
+        const auto& trace_id = request.GetTraceId().get();
+        std::lock_guard<std::mutex> lock(mutex);
+        if (fail && kFailedTraceIds.count(trace_id) != 0u) {
+          return client::ApiError(
+              olp::http::HttpStatusCode::SERVICE_UNAVAILABLE,
+              "Service unavailable");
+        }
+        if (trace_id == kBadTraceId) {
+          return client::ApiError(olp::http::HttpStatusCode::BAD_REQUEST,
+                                  "Bad request");
+        }
+
+        write::PublishDataResult result;
+        result.SetTraceID(trace_id);
+        return write::PublishDataResponse{result};
+      });
+
+  EXPECT_CALL(*client, PublishDataTask(_, _)).Times(kBatchSize + 3u);
+
+  for (size_t i = 0; i < kBatchSize; ++i) {
+    auto error = client->Queue(
+        model::PublishDataRequest()
+            .WithTraceId(std::to_string(i))
+            .WithData(std::make_shared<std::vector<unsigned char>>(1, 'z'))
+            .WithLayerId(kLayers[i % kLayers.size()]));
+    EXPECT_EQ(boost::none, error) << *error;
+  }
+
+  {
+    SCOPED_TRACE("Requests failed with retryable errors are queued back");
+
+    auto response = client->Flush(model::FlushRequest()).GetFuture().get();
+    ASSERT_EQ(response.size(), kBatchSize);
+    EXPECT_FALSE(response[1].IsSuccessful());
+    EXPECT_FALSE(response[4].IsSuccessful());
+    // Not retryable, so dropped
+    EXPECT_FALSE(response[2].IsSuccessful());
+    EXPECT_EQ(client->QueueSize(), kFailedTraceIds.size());
+  }
+
+  {
+    SCOPED_TRACE("Failed requests are flushed before the new ones");
+
+    auto error = client->Queue(
+        model::PublishDataRequest()
+            .WithTraceId(std::to_string(kBatchSize))
+            .WithData(std::make_shared<std::vector<unsigned char>>(1, 'z'))
+            .WithLayerId(kLayers[0]));
+    EXPECT_EQ(boost::none, error) << *error;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      fail = false;
+    }
+
+    auto response = client->Flush(model::FlushRequest()).GetFuture().get();
+    ASSERT_EQ(response.size(), 3u);
+    EXPECT_EQ(response[0].GetResult().GetTraceID(), "1");
+    EXPECT_EQ(response[1].GetResult().GetTraceID(), "4");
+    EXPECT_EQ(response[2].GetResult().GetTraceID(), "6");
+    EXPECT_EQ(client->QueueSize(), 0u);
+  }
+}
+
+TEST_F(StreamLayerClientImplTest, FlushRequeuesAtTailWhenHeadIsReset) {
+  settings_.cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+  auto cache = settings_.cache;
+
+  auto client = std::make_shared<MockStreamLayerClientImpl>(
+      kHrn, write::StreamLayerClientSettings{}, settings_);
+
+  // The queue counters are removed while the request is published
+  EXPECT_CALL(*client, PublishDataTask(_, _))
+      .WillOnce([&](model::PublishDataRequest /*request*/,
+                    client::CancellationContext /*context*/)
+                    -> write::PublishDataResponse {
+        cache->RemoveKeysWithPrefix(kHrn.ToCatalogHRNString() +
+                                    "-stream-queue-cache");
+        return client::ApiError(olp::http::HttpStatusCode::SERVICE_UNAVAILABLE,
+                                "Service unavailable");
+      });
+
+  auto error = client->Queue(
+      model::PublishDataRequest()
+          .WithTraceId("0")
+          .WithData(std::make_shared<std::vector<unsigned char>>(1, 'z'))
+          .WithLayerId(kLayerName));
+  EXPECT_EQ(boost::none, error) << *error;
+
+  auto response = client->Flush(model::FlushRequest()).GetFuture().get();
+  ASSERT_EQ(response.size(), 1u);
+  EXPECT_FALSE(response[0].IsSuccessful());
+
+  // The failed request is not lost
+  EXPECT_EQ(client->QueueSize(), 1u);
+  EXPECT_EQ(client->QueuedDataSize(), 1u);
+  auto request = client->PopFromQueue();
+  ASSERT_TRUE(request);
+  EXPECT_EQ(request->GetTraceId().get(), "0");
+}
+
+TEST_F(StreamLayerClientImplTest, AutoFlush) {
+  const size_t kBatchSize = 3;
+  settings_.cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+
+  auto queue_requests = [&](write::StreamLayerClientImpl& client) {
+    for (size_t i = 0; i < kBatchSize; ++i) {
+      auto error = client.Queue(
+          model::PublishDataRequest()
+              .WithData(std::make_shared<std::vector<unsigned char>>(10, 'z'))
+              .WithLayerId(kLayerName));
+      EXPECT_EQ(boost::none, error) << *error;
+    }
+  };
+
+  auto publish_response = [](model::PublishDataRequest /*request*/,
+                             client::CancellationContext /*context*/) {
+    return write::PublishDataResponse{write::PublishDataResult{}};
+  };
+
+  {
+    SCOPED_TRACE("Flush on the number of requests");
+
+    auto client = std::make_shared<MockStreamLayerClientImpl>(
+        kHrn, write::StreamLayerClientSettings{}, settings_);
+    EXPECT_CALL(*client, PublishDataTask(_, _))
+        .Times(kBatchSize)
+        .WillRepeatedly(publish_response);
+
+    auto listener = std::make_shared<FlushListenerMock>();
+    auto future = listener->GetFuture();
+
+    write::AutoFlushSettings flush_settings;
+    flush_settings.auto_flush_num_events = kBatchSize;
+    client->EnableAutoFlush(flush_settings, listener);
+
+    queue_requests(*client);
+    ASSERT_EQ(std::future_status::ready,
+              future.wait_for(std::chrono::seconds(5)));
+
+    const auto metrics = future.get();
+    EXPECT_EQ(1u, metrics.num_attempted_flush_events);
+    EXPECT_EQ(kBatchSize, metrics.num_total_flushed_requests);
+    EXPECT_EQ(0u, metrics.num_failed_flushed_requests);
+    EXPECT_EQ(0u, client->QueueSize());
+    EXPECT_EQ(0u, client->QueuedDataSize());
+    client->DisableAutoFlush().wait();
+  }
+
+  {
+    SCOPED_TRACE("Flush on the queued data size");
+
+    auto client = std::make_shared<MockStreamLayerClientImpl>(
+        kHrn, write::StreamLayerClientSettings{}, settings_);
+    EXPECT_CALL(*client, PublishDataTask(_, _))
+        .Times(kBatchSize)
+        .WillRepeatedly(publish_response);
+
+    auto listener = std::make_shared<FlushListenerMock>();
+    auto future = listener->GetFuture();
+
+    write::AutoFlushSettings flush_settings;
+    flush_settings.auto_flush_num_events = 0;
+    flush_settings.auto_flush_data_size = kBatchSize * 10u;
+    client->EnableAutoFlush(flush_settings, listener);
+
+    queue_requests(*client);
+    ASSERT_EQ(std::future_status::ready,
+              future.wait_for(std::chrono::seconds(5)));
+    EXPECT_EQ(kBatchSize, future.get().num_total_flushed_requests);
+    client->DisableAutoFlush().wait();
+  }
+
+  {
+    SCOPED_TRACE("One flush at a time");
+
+    auto client = std::make_shared<MockStreamLayerClientImpl>(
+        kHrn, write::StreamLayerClientSettings{}, settings_);
+
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::atomic<int> publishing{0};
+    std::atomic<int> max_publishing{0};
+    EXPECT_CALL(*client, PublishDataTask(_, _))
+        .Times(kBatchSize)
+        .WillRepeatedly([&](model::PublishDataRequest request,
+                            client::CancellationContext context) {
+          const int current = ++publishing;
+          int expected = max_publishing.load();
+          while (current > expected &&
+                 !max_publishing.compare_exchange_weak(expected, current)) {
+          }
+          released.wait();
+          --publishing;
+          return publish_response(std::move(request), std::move(context));
+        });
+
+    write::AutoFlushSettings flush_settings;
+    flush_settings.auto_flush_num_events = 1;
+    client->EnableAutoFlush(flush_settings, nullptr);
+
+    // Every queued request is past the threshold, while the first flush runs
+    queue_requests(*client);
+    release.set_value();
+
+    client->DisableAutoFlush().wait();
+    EXPECT_EQ(1, max_publishing.load());
+    EXPECT_EQ(0u, client->QueueSize());
+  }
+
+  {
+    SCOPED_TRACE("Disabled");
+
+    auto client = std::make_shared<MockStreamLayerClientImpl>(
+        kHrn, write::StreamLayerClientSettings{}, settings_);
+    EXPECT_CALL(*client, PublishDataTask(_, _)).Times(0);
+
+    write::AutoFlushSettings flush_settings;
+    flush_settings.auto_flush_num_events = kBatchSize;
+    client->EnableAutoFlush(flush_settings, nullptr);
+    client->DisableAutoFlush().wait();
+
+    queue_requests(*client);
+    EXPECT_EQ(kBatchSize, client->QueueSize());
+    EXPECT_EQ(kBatchSize * 10u, client->QueuedDataSize());
+  }
+}
+
+TEST_F(StreamLayerClientImplTest, QueueOrderPersisted) {
+  const size_t kBatchSize = 10;
+  settings_.cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+
+  auto create_request = [](size_t index) {
+    return model::PublishDataRequest()
+        .WithTraceId(std::to_string(index))
+        .WithData(std::make_shared<std::vector<unsigned char>>(1, 'z'))
+        .WithLayerId("layer");
+  };
+
+  {
+    SCOPED_TRACE("Queue with one client");
+
+    write::StreamLayerClientImpl client(
+        kHrn, write::StreamLayerClientSettings{}, settings_);
+    for (size_t i = 0; i < kBatchSize; ++i) {
+      EXPECT_EQ(boost::none, client.Queue(create_request(i)));
+    }
+    EXPECT_EQ(kBatchSize, client.QueueSize());
+  }
+
+  {
+    SCOPED_TRACE("Pop with another client in the queue order");
+
+    write::StreamLayerClientImpl client(
+        kHrn, write::StreamLayerClientSettings{}, settings_);
+    ASSERT_EQ(kBatchSize, client.QueueSize());
+
+    for (size_t i = 0; i < kBatchSize; ++i) {
+      auto request = client.PopFromQueue();
+      ASSERT_TRUE(request);
+      EXPECT_EQ(std::to_string(i), request->GetTraceId().get());
+      EXPECT_EQ(kBatchSize - i - 1, client.QueueSize());
+    }
+
+    EXPECT_FALSE(client.PopFromQueue());
+    EXPECT_EQ(boost::none, client.Queue(create_request(kBatchSize)));
+    EXPECT_EQ(1u, client.QueueSize());
+  }
+
+  {
+    SCOPED_TRACE("Maximum number of requests");
+
+    write::StreamLayerClientSettings stream_settings;
+    stream_settings.maximum_requests = 1u;
+    write::StreamLayerClientImpl client(kHrn, stream_settings, settings_);
+    EXPECT_NE(boost::none, client.Queue(create_request(0)));
+    EXPECT_EQ(1u, client.QueueSize());
+  }
+}
+
+TEST_F(StreamLayerClientImplTest, QueueMigratedFromUuidList) {
+  const auto cache_path = olp::utils::Dir::TempDirectory() + "/unittest";
+  olp::utils::Dir::Remove(cache_path);
+
+  olp::cache::CacheSettings cache_settings;
+  cache_settings.disk_path_mutable = cache_path;
+
+  // The key and the format of the queue used by the previous SDK versions
+  const auto uuid_list_key =
+      kHrn.ToCatalogHRNString() + "-stream-queue-cache";
+  const std::vector<std::string> uuids = {"uuid-0", "uuid-1", "uuid-lost",
+                                          "uuid-2"};
+
+  auto create_request = [](size_t index) {
+    return model::PublishDataRequest()
+        .WithTraceId(std::to_string(index))
+        .WithData(std::make_shared<std::vector<unsigned char>>(10, 'z'))
+        .WithLayerId("layer");
+  };
+
+  {
+    SCOPED_TRACE("Queue in the previous format");
+
+    auto cache = olp::client::OlpClientSettingsFactory::CreateDefaultCache(
+        cache_settings);
+    ASSERT_TRUE(cache);
+
+    std::string uuid_list;
+    size_t index = 0u;
+    for (const auto& uuid : uuids) {
+      uuid_list += uuid + ",";
+      if (uuid == "uuid-lost") {
+        continue;
+      }
+
+      const auto request = create_request(index++);
+      ASSERT_TRUE(cache->Put(uuid, request, [&request]() {
+        return olp::serializer::serialize<model::PublishDataRequest>(request);
+      }));
+    }
+    ASSERT_TRUE(cache->Put(uuid_list_key, uuid_list,
+                           [&uuid_list]() { return uuid_list; }));
+  }
+
+  {
+    SCOPED_TRACE("Migrate and queue after reopening the cache");
+
+    settings_.cache = olp::client::OlpClientSettingsFactory::CreateDefaultCache(
+        cache_settings);
+    ASSERT_TRUE(settings_.cache);
+
+    write::StreamLayerClientImpl client(
+        kHrn, write::StreamLayerClientSettings{}, settings_);
+    EXPECT_EQ(3u, client.QueueSize());
+    EXPECT_EQ(30u, client.QueuedDataSize());
+    EXPECT_EQ(boost::none, client.Queue(create_request(3)));
+    EXPECT_EQ(4u, client.QueueSize());
+
+    EXPECT_FALSE(settings_.cache->Contains(uuid_list_key));
+    for (const auto& uuid : uuids) {
+      EXPECT_FALSE(settings_.cache->Contains(uuid));
+    }
+  }
+
+  {
+    SCOPED_TRACE("Pop in the queue order after reopening the cache");
+
+    settings_.cache = olp::client::OlpClientSettingsFactory::CreateDefaultCache(
+        cache_settings);
+    ASSERT_TRUE(settings_.cache);
+
+    write::StreamLayerClientImpl client(
+        kHrn, write::StreamLayerClientSettings{}, settings_);
+    ASSERT_EQ(4u, client.QueueSize());
+    EXPECT_EQ(40u, client.QueuedDataSize());
+
+    for (size_t i = 0; i < 4u; ++i) {
+      auto request = client.PopFromQueue();
+      ASSERT_TRUE(request);
+      EXPECT_EQ(std::to_string(i), request->GetTraceId().get());
+    }
+    EXPECT_FALSE(client.PopFromQueue());
+    EXPECT_EQ(0u, client.QueuedDataSize());
+  }
+
+  settings_.cache.reset();
+  olp::utils::Dir::Remove(cache_path);
+}
+
 }  // namespace
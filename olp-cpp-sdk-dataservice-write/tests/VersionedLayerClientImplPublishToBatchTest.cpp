@@ -17,6 +17,8 @@
  * License-Filename: LICENSE
  */
 
+#include <future>
+
 #include <gmock/gmock.h>
 #include <matchers/NetworkUrlMatchers.h>
 #include <mocks/CacheMock.h>
@@ -39,6 +41,8 @@
 namespace {
 
 using testing::_;
+using testing::AllOf;
+using testing::Between;
 using testing::Mock;
 using testing::Return;
 namespace client = olp::client;
@@ -390,6 +394,420 @@ TEST_F(VersionedLayerClientImplPublishToBatchTest, PublishToBatch) {
   }
 }
 
+TEST_F(VersionedLayerClientImplPublishToBatchTest, PublishMultipart) {
+  const auto publication =
+      mockserver::DefaultResponses::GeneratePublicationResponse({kLayer}, {});
+  const std::string partition = "132";
+  const std::string data = "0123456789abcdefghijABCDE";
+
+  // The parts are 10, 10 and 5 bytes
+  auto make_request = [&]() {
+    auto offset = std::make_shared<size_t>(0u);
+    return model::PublishPartitionDataRequest()
+        .WithDataReader([=](unsigned char* buffer, size_t size) -> int64_t {
+          const auto count = std::min(size, data.size() - *offset);
+          std::copy(data.begin() + *offset, data.begin() + *offset + count,
+                    buffer);
+          *offset += count;
+          return static_cast<int64_t>(count);
+        })
+        .WithPartSize(10u)
+        .WithParallelParts(2u)
+        .WithLayerId(kLayer)
+        .WithPartitionId(partition);
+  };
+
+  auto mock_start_upload = [&](const std::string& blob_url) {
+    const auto upload_url = blob_url + "/layers/" + kLayer +
+                            "/data/handle/multiparts/token";
+    const auto links =
+        R"JSON({"links":{"uploadPart":{"href":")JSON" + upload_url +
+        R"JSON(/parts","method":"POST"},"complete":{"href":")JSON" +
+        upload_url + R"JSON(","method":"PUT"},"delete":{"href":")JSON" +
+        upload_url + R"JSON(","method":"DELETE"}}})JSON";
+
+    EXPECT_CALL(*network_,
+                Send(IsPostRequestPrefix(blob_url + "/layers/" + kLayer +
+                                         "/data/"),
+                     _, _, _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::CREATED),
+                                     links));
+    return upload_url;
+  };
+
+  {
+    SCOPED_TRACE("Parts uploaded and completed");
+
+    MockConfigRequest(kLayer);
+    const auto blob_url = MockApiRequest("blob").GetBaseUrl();
+    const auto upload_url = mock_start_upload(blob_url);
+
+    for (auto part = 1u; part <= 3u; ++part) {
+      const auto offset = (part - 1u) * 10u;
+      EXPECT_CALL(
+          *network_,
+          Send(AllOf(IsPostRequest(upload_url + "/parts?partNumber=" +
+                                   std::to_string(part)),
+                     BodyEq(data.substr(offset, 10u))),
+               _, _, _, _))
+          .WillOnce(ReturnHttpResponse(
+              olp::http::NetworkResponse().WithStatus(
+                  olp::http::HttpStatusCode::NO_CONTENT),
+              {}, {{"ETag", "etag" + std::to_string(part)}}));
+    }
+
+    const std::string parts =
+        R"JSON({"parts":[{"etag":"etag1","number":1},)JSON"
+        R"JSON({"etag":"etag2","number":2},)JSON"
+        R"JSON({"etag":"etag3","number":3}]})JSON";
+    EXPECT_CALL(*network_, Send(AllOf(IsPutRequest(upload_url), BodyEq(parts)),
+                                _, _, _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::NO_CONTENT),
+                                     {}));
+
+    MockPublishPartitionRequest(publication, kLayer);
+
+    EXPECT_CALL(*cache_, Get(_, _)).Times(3);
+    EXPECT_CALL(*cache_, Contains(_)).Times(1);
+    EXPECT_CALL(*cache_, Put(_, _, _, _))
+        .WillRepeatedly([](const std::string& /*key*/,
+                           const boost::any& /*value*/,
+                           const olp::cache::Encoder& /*encoder*/,
+                           time_t /*expiry*/) { return true; });
+
+    write::VersionedLayerClientImpl client(kHrn, settings_);
+    auto future =
+        client.PublishToBatch(publication, make_request()).GetFuture();
+
+    const auto response = future.get();
+
+    EXPECT_TRUE(response.IsSuccessful());
+    EXPECT_EQ(response.GetResult().GetTraceID(), partition);
+    Mock::VerifyAndClearExpectations(network_.get());
+    Mock::VerifyAndClearExpectations(cache_.get());
+  }
+
+  {
+    SCOPED_TRACE("Part upload fails, upload cancelled");
+
+    MockConfigRequest(kLayer);
+    const auto blob_url = MockApiRequest("blob").GetBaseUrl();
+    const auto upload_url = mock_start_upload(blob_url);
+
+    EXPECT_CALL(*network_,
+                Send(IsPostRequestPrefix(upload_url + "/parts"), _, _, _, _))
+        .Times(Between(1, 3))
+        .WillRepeatedly(ReturnHttpResponse(
+            olp::http::NetworkResponse().WithStatus(
+                olp::http::HttpStatusCode::BAD_REQUEST),
+            {}));
+
+    EXPECT_CALL(*network_, Send(IsDeleteRequest(upload_url), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::NO_CONTENT),
+                                     {}));
+
+    EXPECT_CALL(*cache_, Get(_, _)).Times(2);
+    EXPECT_CALL(*cache_, Contains(_)).Times(1);
+    EXPECT_CALL(*cache_, Put(_, _, _, _))
+        .WillRepeatedly([](const std::string& /*key*/,
+                           const boost::any& /*value*/,
+                           const olp::cache::Encoder& /*encoder*/,
+                           time_t /*expiry*/) { return true; });
+
+    write::VersionedLayerClientImpl client(kHrn, settings_);
+    auto future =
+        client.PublishToBatch(publication, make_request()).GetFuture();
+
+    const auto response = future.get();
+
+    EXPECT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(response.GetError().GetHttpStatusCode(),
+              olp::http::HttpStatusCode::BAD_REQUEST);
+    Mock::VerifyAndClearExpectations(network_.get());
+    Mock::VerifyAndClearExpectations(cache_.get());
+  }
+
+  {
+    SCOPED_TRACE("Publish cancelled, upload cancelled");
+
+    MockConfigRequest(kLayer);
+    const auto blob_url = MockApiRequest("blob").GetBaseUrl();
+    const auto upload_url = mock_start_upload(blob_url);
+
+    EXPECT_CALL(*network_,
+                Send(IsPostRequestPrefix(upload_url + "/parts"), _, _, _, _))
+        .Times(0);
+
+    EXPECT_CALL(*network_, Send(IsDeleteRequest(upload_url), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::NO_CONTENT),
+                                     {}));
+
+    EXPECT_CALL(*cache_, Get(_, _)).Times(2);
+    EXPECT_CALL(*cache_, Contains(_)).Times(1);
+    EXPECT_CALL(*cache_, Put(_, _, _, _))
+        .WillRepeatedly([](const std::string& /*key*/,
+                           const boost::any& /*value*/,
+                           const olp::cache::Encoder& /*encoder*/,
+                           time_t /*expiry*/) { return true; });
+
+    // The first part is read after the publish is cancelled
+    std::promise<void> reading;
+    std::promise<void> cancelled;
+    auto cancelled_future = cancelled.get_future().share();
+    auto request = make_request();
+    auto reader = request.GetDataReader();
+    request.WithDataReader(
+        [&, reader](unsigned char* buffer, size_t size) -> int64_t {
+          reading.set_value();
+          cancelled_future.wait();
+          return reader(buffer, size);
+        });
+
+    write::VersionedLayerClientImpl client(kHrn, settings_);
+    auto cancellable = client.PublishToBatch(publication, request);
+
+    reading.get_future().wait();
+    cancellable.GetCancellationToken().Cancel();
+    cancelled.set_value();
+
+    const auto response = cancellable.GetFuture().get();
+
+    EXPECT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(response.GetError().GetErrorCode(),
+              client::ErrorCode::Cancelled);
+    Mock::VerifyAndClearExpectations(network_.get());
+    Mock::VerifyAndClearExpectations(cache_.get());
+  }
+}
+
+TEST_F(VersionedLayerClientImplPublishToBatchTest, PublishPartitions) {
+  const auto publication =
+      mockserver::DefaultResponses::GeneratePublicationResponse({kLayer}, {});
+  const std::vector<std::string> partitions = {"1", "2", "3"};
+
+  std::vector<model::PublishPartitionDataRequest> requests;
+  for (const auto& partition : partitions) {
+    requests.emplace_back(
+        model::PublishPartitionDataRequest()
+            .WithData(std::make_shared<std::vector<unsigned char>>(20, 0x30))
+            .WithLayerId(kLayer)
+            .WithPartitionId(partition));
+  }
+
+  {
+    SCOPED_TRACE("Blobs uploaded, metadata uploaded in one request");
+
+    MockConfigRequest(kLayer);
+
+    auto blob_api = MockApiRequest("blob");
+    EXPECT_CALL(*network_,
+                Send(IsPutRequestPrefix(blob_api.GetBaseUrl() + "/layers/" +
+                                        kLayer + "/data/"),
+                     _, _, _, _))
+        .Times(static_cast<int>(partitions.size()))
+        .WillRepeatedly(ReturnHttpResponse(
+            olp::http::NetworkResponse().WithStatus(
+                olp::http::HttpStatusCode::NO_CONTENT),
+            {}));
+
+    MockPublishPartitionRequest(publication, kLayer);
+
+    EXPECT_CALL(*cache_, Get(_, _)).Times(3);
+    EXPECT_CALL(*cache_, Contains(_)).Times(1);
+    EXPECT_CALL(*cache_, Put(_, _, _, _))
+        .WillRepeatedly([](const std::string& /*key*/,
+                           const boost::any& /*value*/,
+                           const olp::cache::Encoder& /*encoder*/,
+                           time_t /*expiry*/) { return true; });
+
+    write::VersionedLayerClientImpl client(kHrn, settings_);
+    auto future = client.PublishToBatch(publication, requests).GetFuture();
+
+    const auto response = future.get();
+    const auto& result = response.GetResult();
+
+    EXPECT_TRUE(response.IsSuccessful());
+    EXPECT_EQ(result.GetTraceID().GetParentID(), publication.GetId().get());
+    EXPECT_EQ(result.GetTraceID().GetGeneratedIDs(), partitions);
+    Mock::VerifyAndClearExpectations(network_.get());
+    Mock::VerifyAndClearExpectations(cache_.get());
+  }
+
+  {
+    SCOPED_TRACE("Blob upload fails, no metadata uploaded");
+
+    // No new uploads are started after the first failed one
+
+    MockConfigRequest(kLayer);
+
+    auto blob_api = MockApiRequest("blob");
+    EXPECT_CALL(*network_,
+                Send(IsPutRequestPrefix(blob_api.GetBaseUrl() + "/layers/" +
+                                        kLayer + "/data/"),
+                     _, _, _, _))
+        .Times(Between(1, static_cast<int>(partitions.size())))
+        .WillRepeatedly(ReturnHttpResponse(
+            olp::http::NetworkResponse().WithStatus(
+                olp::http::HttpStatusCode::BAD_REQUEST),
+            {}));
+
+    // The publish API is looked up, but no partitions are uploaded
+    MockApiRequest("publish");
+
+    EXPECT_CALL(*cache_, Get(_, _)).Times(3);
+    EXPECT_CALL(*cache_, Contains(_)).Times(1);
+    EXPECT_CALL(*cache_, Put(_, _, _, _))
+        .WillRepeatedly([](const std::string& /*key*/,
+                           const boost::any& /*value*/,
+                           const olp::cache::Encoder& /*encoder*/,
+                           time_t /*expiry*/) { return true; });
+
+    write::VersionedLayerClientImpl client(kHrn, settings_);
+    auto future = client.PublishToBatch(publication, requests).GetFuture();
+
+    const auto response = future.get();
+
+    EXPECT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(response.GetError().GetHttpStatusCode(),
+              olp::http::HttpStatusCode::BAD_REQUEST);
+    Mock::VerifyAndClearExpectations(network_.get());
+    Mock::VerifyAndClearExpectations(cache_.get());
+  }
+
+  {
+    SCOPED_TRACE("No requests");
+
+    write::VersionedLayerClientImpl client(kHrn, settings_);
+    auto future =
+        client
+            .PublishToBatch(publication,
+                            std::vector<model::PublishPartitionDataRequest>{})
+            .GetFuture();
+
+    const auto response = future.get();
+
+    EXPECT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(response.GetError().GetErrorCode(),
+              client::ErrorCode::InvalidArgument);
+    Mock::VerifyAndClearExpectations(network_.get());
+    Mock::VerifyAndClearExpectations(cache_.get());
+  }
+}
+
+TEST_F(VersionedLayerClientImplPublishToBatchTest, PublishDeduplicated) {
+  const auto publication =
+      mockserver::DefaultResponses::GeneratePublicationResponse({kLayer}, {});
+  const auto data = std::make_shared<std::vector<unsigned char>>(20, 0x30);
+  // SHA-256 of the data
+  const std::string data_handle =
+      "a7d351f3de399c746064a53c69959ab10312a003ec63985bcd86fb6dc1c402d5";
+
+  {
+    SCOPED_TRACE("Existing blob is not uploaded");
+
+    MockConfigRequest(kLayer);
+
+    auto blob_api = MockApiRequest("blob");
+    const std::string blob_url =
+        blob_api.GetBaseUrl() + "/layers/" + kLayer + "/data/" + data_handle;
+    EXPECT_CALL(*network_, Send(IsHeadRequest(blob_url), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(
+            olp::http::NetworkResponse().WithStatus(
+                olp::http::HttpStatusCode::OK),
+            {}));
+    EXPECT_CALL(*network_, Send(IsPutRequest(blob_url), _, _, _, _)).Times(0);
+
+    auto publish_api = MockApiRequest("publish");
+    EXPECT_CALL(*network_,
+                Send(AllOf(IsPostRequestPrefix(publish_api.GetBaseUrl()),
+                           BodyContains(data_handle)),
+                     _, _, _, _))
+        .WillOnce(ReturnHttpResponse(
+            olp::http::NetworkResponse().WithStatus(
+                olp::http::HttpStatusCode::NO_CONTENT),
+            {}));
+
+    EXPECT_CALL(*cache_, Get(_, _)).Times(3);
+    EXPECT_CALL(*cache_, Contains(_)).Times(1);
+    EXPECT_CALL(*cache_, Put(_, _, _, _))
+        .WillRepeatedly([](const std::string& /*key*/,
+                           const boost::any& /*value*/,
+                           const olp::cache::Encoder& /*encoder*/,
+                           time_t /*expiry*/) { return true; });
+
+    write::VersionedLayerClientImpl client(kHrn, settings_);
+    auto future = client
+                      .PublishToBatch(publication,
+                                      model::PublishPartitionDataRequest()
+                                          .WithData(data)
+                                          .WithLayerId(kLayer)
+                                          .WithPartitionId("1")
+                                          .WithDeduplication(true))
+                      .GetFuture();
+
+    const auto response = future.get();
+
+    EXPECT_TRUE(response.IsSuccessful());
+    Mock::VerifyAndClearExpectations(network_.get());
+    Mock::VerifyAndClearExpectations(cache_.get());
+  }
+
+  {
+    SCOPED_TRACE("Same data is uploaded once");
+
+    const std::vector<std::string> partitions = {"1", "2", "3"};
+    std::vector<model::PublishPartitionDataRequest> requests;
+    for (const auto& partition : partitions) {
+      requests.emplace_back(model::PublishPartitionDataRequest()
+                                .WithData(data)
+                                .WithLayerId(kLayer)
+                                .WithPartitionId(partition)
+                                .WithDeduplication(true));
+    }
+
+    MockConfigRequest(kLayer);
+
+    auto blob_api = MockApiRequest("blob");
+    const std::string blob_url =
+        blob_api.GetBaseUrl() + "/layers/" + kLayer + "/data/" + data_handle;
+    EXPECT_CALL(*network_, Send(IsHeadRequest(blob_url), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(
+            olp::http::NetworkResponse().WithStatus(
+                olp::http::HttpStatusCode::NOT_FOUND),
+            {}));
+    EXPECT_CALL(*network_, Send(IsPutRequest(blob_url), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(
+            olp::http::NetworkResponse().WithStatus(
+                olp::http::HttpStatusCode::NO_CONTENT),
+            {}));
+
+    MockPublishPartitionRequest(publication, kLayer);
+
+    EXPECT_CALL(*cache_, Get(_, _)).Times(3);
+    EXPECT_CALL(*cache_, Contains(_)).Times(1);
+    EXPECT_CALL(*cache_, Put(_, _, _, _))
+        .WillRepeatedly([](const std::string& /*key*/,
+                           const boost::any& /*value*/,
+                           const olp::cache::Encoder& /*encoder*/,
+                           time_t /*expiry*/) { return true; });
+
+    write::VersionedLayerClientImpl client(kHrn, settings_);
+    auto future = client.PublishToBatch(publication, requests).GetFuture();
+
+    const auto response = future.get();
+    const auto& result = response.GetResult();
+
+    EXPECT_TRUE(response.IsSuccessful());
+    EXPECT_EQ(result.GetTraceID().GetGeneratedIDs(), partitions);
+    Mock::VerifyAndClearExpectations(network_.get());
+    Mock::VerifyAndClearExpectations(cache_.get());
+  }
+}
+
 TEST_F(VersionedLayerClientImplPublishToBatchTest, NetworkErrors) {
   const auto catalog = kHrn.ToCatalogHRNString();
   const auto mock_error = olp::http::HttpStatusCode::BAD_REQUEST;
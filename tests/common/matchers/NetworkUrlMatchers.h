@@ -67,6 +67,18 @@ MATCHER_P(IsPostRequest, url, "") {
          url == arg.GetUrl();
 }
 
+MATCHER_P(IsPostRequestPrefix, url, "") {
+  if (olp::http::NetworkRequest::HttpVerb::POST != arg.GetVerb()) {
+    return false;
+  }
+
+  std::string url_string(url);
+  auto res =
+      std::mismatch(url_string.begin(), url_string.end(), arg.GetUrl().begin());
+
+  return (res.first == url_string.end());
+}
+
 MATCHER_P(IsDeleteRequest, url, "") {
   return olp::http::NetworkRequest::HttpVerb::DEL == arg.GetVerb() &&
          url == arg.GetUrl();
@@ -84,6 +96,11 @@ MATCHER_P(IsDeleteRequestPrefix, url, "") {
   return (res.first == url_string.end());
 }
 
+MATCHER_P(IsHeadRequest, url, "") {
+  return olp::http::NetworkRequest::HttpVerb::HEAD == arg.GetVerb() &&
+         url == arg.GetUrl();
+}
+
 MATCHER_P(BodyEq, expected_body, "") {
   std::string expected_body_str(expected_body);
 
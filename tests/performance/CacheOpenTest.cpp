@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <chrono>
+#include <cinttypes>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <olp/core/cache/DefaultCache.h>
+#include <olp/core/logging/Log.h>
+#include <olp/core/utils/Dir.h>
+#include <testutils/CustomParameters.hpp>
+
+namespace {
+namespace cache = olp::cache;
+
+constexpr auto kLogTag = "CacheOpenTest";
+
+struct TestConfiguration {
+  std::string configuration_name;
+  std::uint32_t keys_count = 1000000u;
+  std::uint32_t value_size = 1024u;
+};
+
+std::ostream& operator<<(std::ostream& os, const TestConfiguration& config) {
+  return os << "TestConfiguration("
+            << ".configuration_name=" << config.configuration_name
+            << ", .keys_count=" << config.keys_count
+            << ", .value_size=" << config.value_size << ")";
+}
+
+std::string GetCachePath() {
+  auto location = CustomParameters::getArgument("cache_location");
+  if (location.empty()) {
+    location = olp::utils::Dir::TempDirectory() + "/cache_open_test";
+  }
+  return location;
+}
+
+class CacheOpenTest : public ::testing::TestWithParam<TestConfiguration> {
+ public:
+  void SetUp() override { olp::utils::Dir::Remove(GetCachePath()); }
+  void TearDown() override { olp::utils::Dir::Remove(GetCachePath()); }
+
+ protected:
+  cache::CacheSettings CreateSettings() const {
+    const auto& parameter = GetParam();
+
+    cache::CacheSettings settings;
+    settings.disk_path_mutable = GetCachePath();
+    settings.max_disk_storage =
+        2ull * parameter.keys_count * (parameter.value_size + 64u);
+    settings.max_memory_cache_size = 0u;
+    settings.enforce_immediate_flush = false;
+    return settings;
+  }
+
+  int64_t MeasureOpen(const cache::CacheSettings& settings,
+                      uint64_t& cache_size) const {
+    cache::DefaultCache cache(settings);
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(cache.Open(), cache::DefaultCache::StorageOpenResult::Success);
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+
+    cache_size = cache.Size(cache::DefaultCache::CacheType::kMutable);
+    cache.Close();
+    return elapsed;
+  }
+};
+
+/*
+ * Measures the cold open time of a mutable cache with LRU eviction. The cache
+ * is filled without LRU, so it has no LRU metadata, same as a cache written by
+ * an older SDK version. The first open in r/o mode does only the full scan
+ * (the behavior before the LRU metadata was introduced), the second one does
+ * the full scan and stores the metadata, the last one restores LRU from the
+ * metadata only.
+ */
+TEST_P(CacheOpenTest, ColdOpen) {
+  olp::logging::Log::setLevel(olp::logging::Level::Warning);
+
+  const auto& parameter = GetParam();
+
+  {
+    auto settings = CreateSettings();
+    settings.eviction_policy = cache::EvictionPolicy::kNone;
+
+    cache::DefaultCache cache(settings);
+    ASSERT_EQ(cache.Open(), cache::DefaultCache::StorageOpenResult::Success);
+
+    const auto value = std::make_shared<cache::KeyValueCache::ValueType>(
+        parameter.value_size, 'a');
+    for (auto i = 0u; i < parameter.keys_count; ++i) {
+      ASSERT_TRUE(cache.Put("hrn:here:data::olp-here-test:catalog::layer::" +
+                                std::to_string(i) + "::Data",
+                            value, cache::KeyValueCache::kDefaultExpiry));
+    }
+
+    // Read-only open fails when the compaction is not finished
+    cache.Compact();
+    cache.Close();
+  }
+
+  uint64_t full_scan_size = 0u;
+  auto settings = CreateSettings();
+  settings.openOptions = cache::OpenOptions::ReadOnly;
+  const auto full_scan_time = MeasureOpen(settings, full_scan_size);
+
+  uint64_t migration_size = 0u;
+  settings.openOptions = cache::OpenOptions::Default;
+  const auto migration_time = MeasureOpen(settings, migration_size);
+
+  uint64_t metadata_size = 0u;
+  const auto metadata_time = MeasureOpen(settings, metadata_size);
+
+  // The migration adds the LRU metadata records, which count in the size
+  EXPECT_LT(full_scan_size, migration_size);
+  EXPECT_EQ(migration_size, metadata_size);
+
+  OLP_SDK_LOG_CRITICAL_INFO_F(
+      kLogTag,
+      "Cold open, keys=%u, full scan=%" PRId64 "ms, full scan with metadata "
+      "store=%" PRId64 "ms, metadata=%" PRId64 "ms",
+      parameter.keys_count, full_scan_time, migration_time, metadata_time);
+
+  RecordProperty("full_scan_open_ms", std::to_string(full_scan_time));
+  RecordProperty("metadata_store_open_ms", std::to_string(migration_time));
+  RecordProperty("metadata_open_ms", std::to_string(metadata_time));
+}
+
+std::vector<TestConfiguration> Configurations() {
+  std::vector<TestConfiguration> configurations;
+
+  TestConfiguration configuration;
+  configuration.configuration_name = "1m_keys";
+  configurations.emplace_back(configuration);
+
+  return configurations;
+}
+
+std::string TestName(const testing::TestParamInfo<TestConfiguration>& info) {
+  return info.param.configuration_name;
+}
+
+INSTANTIATE_TEST_SUITE_P(CacheStartup, CacheOpenTest,
+                         ::testing::ValuesIn(Configurations()), TestName);
+}  // namespace
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+
+#include <chrono>
+#include <cinttypes>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <olp/core/cache/DefaultCache.h>
+#include <olp/core/logging/Log.h>
+#include <olp/core/utils/Dir.h>
+#include <testutils/CustomParameters.hpp>
+
+namespace {
+namespace cache = olp::cache;
+
+constexpr auto kLogTag = "CacheThroughputTest";
+
+struct TestConfiguration {
+  std::string configuration_name;
+  std::uint32_t threads_count = 1u;
+  std::uint32_t memory_cache_shards = 1u;
+  std::uint32_t keys_count = 10000u;
+  std::uint32_t value_size = 1024u;
+  std::uint32_t reads_per_thread = 200000u;
+};
+
+std::ostream& operator<<(std::ostream& os, const TestConfiguration& config) {
+  return os << "TestConfiguration("
+            << ".configuration_name=" << config.configuration_name
+            << ", .threads_count=" << config.threads_count
+            << ", .memory_cache_shards=" << config.memory_cache_shards
+            << ", .keys_count=" << config.keys_count
+            << ", .value_size=" << config.value_size
+            << ", .reads_per_thread=" << config.reads_per_thread << ")";
+}
+
+std::string GetCachePath() {
+  auto location = CustomParameters::getArgument("cache_location");
+  if (location.empty()) {
+    location = olp::utils::Dir::TempDirectory() + "/cache_throughput_test";
+  }
+  return location;
+}
+
+std::string Key(std::uint32_t index) {
+  return "hrn:here:data::olp-here-test:catalog::layer::" +
+         std::to_string(index) + "::Data";
+}
+
+class CacheThroughputTest : public ::testing::TestWithParam<TestConfiguration> {
+ public:
+  void SetUp() override { olp::utils::Dir::Remove(GetCachePath()); }
+  void TearDown() override { olp::utils::Dir::Remove(GetCachePath()); }
+};
+
+/*
+ * Measures the throughput of concurrent memory cache hits. All the keys fit
+ * into the memory cache, so every read is served from memory and the
+ * throughput is limited only by the locking in the cache.
+ */
+TEST_P(CacheThroughputTest, ConcurrentReads) {
+  olp::logging::Log::setLevel(olp::logging::Level::Warning);
+
+  const auto& parameter = GetParam();
+
+  cache::CacheSettings settings;
+  settings.disk_path_mutable = GetCachePath();
+  settings.max_memory_cache_size =
+      4u * parameter.keys_count * parameter.value_size;
+  settings.memory_cache_shards = parameter.memory_cache_shards;
+  settings.max_disk_storage =
+      4ull * parameter.keys_count * parameter.value_size;
+  settings.enforce_immediate_flush = false;
+
+  cache::DefaultCache cache(settings);
+  ASSERT_EQ(cache.Open(), cache::DefaultCache::StorageOpenResult::Success);
+
+  std::vector<std::string> keys;
+  keys.reserve(parameter.keys_count);
+  const auto value = std::make_shared<cache::KeyValueCache::ValueType>(
+      parameter.value_size, 'a');
+  for (auto i = 0u; i < parameter.keys_count; ++i) {
+    keys.emplace_back(Key(i));
+    ASSERT_TRUE(cache.Put(keys.back(), value,
+                          cache::KeyValueCache::kDefaultExpiry));
+  }
+
+  std::vector<std::uint32_t> misses(parameter.threads_count, 0u);
+  std::vector<std::thread> threads;
+  threads.reserve(parameter.threads_count);
+
+  const auto start = std::chrono::steady_clock::now();
+  for (auto thread_index = 0u; thread_index < parameter.threads_count;
+       ++thread_index) {
+    threads.emplace_back([&, thread_index]() {
+      // Every thread walks the keys with a different stride
+      const auto stride = 2u * thread_index + 1u;
+      auto index = thread_index;
+      for (auto i = 0u; i < parameter.reads_per_thread; ++i) {
+        index = (index + stride) % parameter.keys_count;
+        if (!cache.Get(keys[index])) {
+          ++misses[thread_index];
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+  cache.Close();
+
+  for (const auto thread_misses : misses) {
+    EXPECT_EQ(thread_misses, 0u);
+  }
+
+  const auto total_reads =
+      static_cast<std::uint64_t>(parameter.reads_per_thread) *
+      parameter.threads_count;
+  const auto reads_per_second =
+      elapsed > 0 ? total_reads * 1000u / elapsed : total_reads * 1000u;
+
+  OLP_SDK_LOG_CRITICAL_INFO_F(
+      kLogTag,
+      "Concurrent reads, threads=%u, shards=%u, reads=%" PRIu64
+      ", time=%" PRId64 "ms, reads/s=%" PRIu64,
+      parameter.threads_count, parameter.memory_cache_shards, total_reads,
+      static_cast<int64_t>(elapsed), reads_per_second);
+
+  RecordProperty("time_ms", std::to_string(elapsed));
+  RecordProperty("reads_per_second", std::to_string(reads_per_second));
+}
+
+std::vector<TestConfiguration> Configurations() {
+  std::vector<TestConfiguration> configurations;
+
+  for (const auto shards : {1u, 32u}) {
+    for (const auto threads : {1u, 2u, 4u, 8u, 16u, 32u}) {
+      TestConfiguration configuration;
+      configuration.configuration_name = std::to_string(threads) +
+                                         "_threads_" + std::to_string(shards) +
+                                         "_shards";
+      configuration.threads_count = threads;
+      configuration.memory_cache_shards = shards;
+      configurations.emplace_back(configuration);
+    }
+  }
+
+  return configurations;
+}
+
+std::string TestName(const testing::TestParamInfo<TestConfiguration>& info) {
+  return info.param.configuration_name;
+}
+
+INSTANTIATE_TEST_SUITE_P(CacheConcurrency, CacheThroughputTest,
+                         ::testing::ValuesIn(Configurations()), TestName);
+}  // namespace
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <chrono>
+#include <cinttypes>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <olp/core/logging/Log.h>
+#include <olp/core/utils/HashLruCache.h>
+#include <olp/core/utils/LruCache.h>
+
+namespace {
+constexpr auto kLogTag = "LruCacheTest";
+
+struct TestConfiguration {
+  std::string configuration_name;
+  std::uint32_t keys_count = 1000000u;
+  // The capacity in keys, smaller than the keys count causes the evictions
+  std::uint32_t capacity = 1000000u;
+  std::uint32_t lookups_count = 2000000u;
+};
+
+std::ostream& operator<<(std::ostream& os, const TestConfiguration& config) {
+  return os << "TestConfiguration("
+            << ".configuration_name=" << config.configuration_name
+            << ", .keys_count=" << config.keys_count
+            << ", .capacity=" << config.capacity
+            << ", .lookups_count=" << config.lookups_count << ")";
+}
+
+struct Measurement {
+  int64_t insert_ms;
+  int64_t lookup_ms;
+  std::uint32_t hits;
+};
+
+int64_t ElapsedMs(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// Same values as the disk cache LRU stores for every key
+struct ValueProperties {
+  uint64_t size;
+  time_t expiry;
+  uint64_t tick;
+};
+
+template <typename Cache>
+Measurement Measure(const TestConfiguration& parameter,
+                    const std::vector<std::string>& keys,
+                    const std::vector<std::uint32_t>& lookups) {
+  Cache cache(parameter.capacity);
+  Measurement measurement{0, 0, 0u};
+
+  auto start = std::chrono::steady_clock::now();
+  for (const auto& key : keys) {
+    cache.InsertOrAssign(key, ValueProperties{1024u, 0, 0u});
+  }
+  measurement.insert_ms = ElapsedMs(start);
+
+  start = std::chrono::steady_clock::now();
+  for (const auto index : lookups) {
+    if (cache.Find(keys[index]) != cache.end()) {
+      ++measurement.hits;
+    }
+  }
+  measurement.lookup_ms = ElapsedMs(start);
+
+  return measurement;
+}
+
+using LruCacheTest = ::testing::TestWithParam<TestConfiguration>;
+
+/*
+ * Compares the map based `LruCache` with the `HashLruCache` on the keys
+ * of the disk cache. The keys are inserted first, followed by the random
+ * lookups that promote the found keys.
+ */
+TEST_P(LruCacheTest, InsertAndFind) {
+  olp::logging::Log::setLevel(olp::logging::Level::Warning);
+
+  const auto& parameter = GetParam();
+
+  std::vector<std::string> keys;
+  keys.reserve(parameter.keys_count);
+  for (auto i = 0u; i < parameter.keys_count; ++i) {
+    keys.emplace_back("hrn:here:data::olp-here-test:catalog::layer::" +
+                      std::to_string(i) + "::Data");
+  }
+
+  std::mt19937 generator(parameter.keys_count);
+  std::uniform_int_distribution<std::uint32_t> distribution(
+      0u, parameter.keys_count - 1u);
+  std::vector<std::uint32_t> lookups(parameter.lookups_count);
+  for (auto& index : lookups) {
+    index = distribution(generator);
+  }
+
+  const auto map_result =
+      Measure<olp::utils::LruCache<std::string, ValueProperties>>(
+          parameter, keys, lookups);
+  const auto hash_result =
+      Measure<olp::utils::HashLruCache<std::string, ValueProperties>>(
+          parameter, keys, lookups);
+
+  EXPECT_EQ(map_result.hits, hash_result.hits);
+
+  OLP_SDK_LOG_CRITICAL_INFO_F(
+      kLogTag,
+      "Insert and find, keys=%u, capacity=%u, lookups=%u, map insert=%" PRId64
+      "ms, map find=%" PRId64 "ms, hash insert=%" PRId64
+      "ms, hash find=%" PRId64 "ms",
+      parameter.keys_count, parameter.capacity, parameter.lookups_count,
+      map_result.insert_ms, map_result.lookup_ms, hash_result.insert_ms,
+      hash_result.lookup_ms);
+
+  RecordProperty("map_insert_ms", std::to_string(map_result.insert_ms));
+  RecordProperty("map_find_ms", std::to_string(map_result.lookup_ms));
+  RecordProperty("hash_insert_ms", std::to_string(hash_result.insert_ms));
+  RecordProperty("hash_find_ms", std::to_string(hash_result.lookup_ms));
+}
+
+std::vector<TestConfiguration> Configurations() {
+  std::vector<TestConfiguration> configurations;
+
+  TestConfiguration configuration;
+  configuration.configuration_name = "1m_keys";
+  configurations.emplace_back(configuration);
+
+  configuration.configuration_name = "1m_keys_with_eviction";
+  configuration.capacity = configuration.keys_count / 2u;
+  configurations.emplace_back(configuration);
+
+  return configurations;
+}
+
+std::string TestName(const testing::TestParamInfo<TestConfiguration>& info) {
+  return info.param.configuration_name;
+}
+
+INSTANTIATE_TEST_SUITE_P(LruCacheWorkload, LruCacheTest,
+                         ::testing::ValuesIn(Configurations()), TestName);
+}  // namespace
@@ -36,6 +36,7 @@ struct TestBaseConfiguration {
   CacheFactory cache_factory{nullptr};
   bool with_http_errors{false};
   bool with_network_timeouts{false};
+  bool with_http2{false};
 };
 
 template <typename Param>
@@ -63,7 +64,8 @@ class MemoryTestBase : public ::testing::TestWithParam<Param> {
               parameter.task_scheduler_capacity);
     }
 
-    auto network = std::make_shared<Http2HttpNetworkWrapper>();
+    auto network =
+        std::make_shared<Http2HttpNetworkWrapper>(parameter.with_http2);
     network->WithErrors(parameter.with_http_errors);
     network->WithTimeouts(parameter.with_network_timeouts);
 
@@ -76,7 +78,9 @@ class MemoryTestBase : public ::testing::TestWithParam<Param> {
     client_settings.authentication_settings = auth_settings;
     client_settings.task_scheduler = task_scheduler;
     client_settings.network_request_handler = std::move(network);
-    client_settings.proxy_settings = GetLocalhostProxySettings();
+    if (!parameter.with_http2) {
+      client_settings.proxy_settings = GetLocalhostProxySettings();
+    }
     client_settings.cache =
         parameter.cache_factory ? parameter.cache_factory() : nullptr;
     client_settings.retry_settings.timeout = 1;
@@ -26,15 +26,50 @@
 #include "olp/core/http/Network.h"
 #include "olp/core/http/NetworkInitializationSettings.h"
 
+/*
+ * The self-signed certificate of the HTTP/2 port of the node test server,
+ * tests/utils/olp_server/localhost-cert.pem.
+ */
+constexpr auto kLocalhostCertificate = R"(-----BEGIN CERTIFICATE-----
+MIIDJzCCAg+gAwIBAgIUMWb06x0YEtiuPBPRym9ZQ5AmPXswDQYJKoZIhvcNAQEL
+BQAwFDESMBAGA1UEAwwJbG9jYWxob3N0MCAXDTI2MTAxNzAxNDcxMloYDzIxMjYw
+OTIzMDE0NzEyWjAUMRIwEAYDVQQDDAlsb2NhbGhvc3QwggEiMA0GCSqGSIb3DQEB
+AQUAA4IBDwAwggEKAoIBAQDNuj9aA1ymg4mB9xJLDQsi0G0IVmFolhEk04ALuVac
+Tv0dDZJqnqDo7MmXY9E8/ODe0sq7cpztuSdsesfVsiMlz4Afn19w/DOYXng8dTet
+JTMWIXU/RoVIX66SnsExmPRXBw0dgej17FyGvc2NfITXLLbf1CioNG1LifMxswLR
+Ecee7miZFpR4f0p++N2gfa7pzmTxFUglOV/2lZLI8EJ2+UeYPjC2kYdgXaB7QOFp
+MV6I3Lv0vtPafOTjz5hHfsOXDEzGPikHiBnGyn2gqf/R2BbaWhoXwOPJGScTUIWy
+Ugg1JZ7tVVOOI2Wo21wIzv4tUMUog+sbw2xcfN3IPDV9AgMBAAGjbzBtMB0GA1Ud
+DgQWBBR/T+29uj1gCW/TUZCQyznuNs9hJDAfBgNVHSMEGDAWgBR/T+29uj1gCW/T
+UZCQyznuNs9hJDAPBgNVHRMBAf8EBTADAQH/MBoGA1UdEQQTMBGCCWxvY2FsaG9z
+dIcEfwAAATANBgkqhkiG9w0BAQsFAAOCAQEAR0KMbQf1MlzWHw5MS11/zDSEdqFu
+3pFUUHxAktt4LF+H3bTXJEZ0sPJtHblfgCoPJeioJxu1j1PxK10jA3UdPRN828fA
+nAI9aNdwRzHIv+3cKxJD3ZB1AGKWzbEWEFCJjdZwsbDgnh4DuSdY5g+AjIG/hP+D
+nxO08S/rC0g7WhxQcnKldqQlyQhKF1SfzV3Hl2vrmlGsVI6UAbQYm74kdM13+DqW
+UwJBWe8u3HlNeWb8SGbN9JwheYJl64uFiWFCDzAyZJilBL1gu+r0t9iY4HTUDWnV
+12k9c2FPpZQawOJ1eYB4eKDtFfi3bicLGcdyXy0lbRC3xhmgKCsXEO0l6w==
+-----END CERTIFICATE-----
+)";
+
 /*
  * Node test server is limited to http proxy. Wrapper alters ongoing requests
- * from https to http.
+ * from https to http. With HTTP/2, the requests are sent to the HTTPS port
+ * of the server directly, with the service host as the first path segment.
  */
 class Http2HttpNetworkWrapper : public olp::http::Network {
  public:
-  Http2HttpNetworkWrapper() {
+  explicit Http2HttpNetworkWrapper(bool with_http2 = false)
+      : with_http2_(with_http2) {
     olp::http::NetworkInitializationSettings network_initialization_settings;
     network_initialization_settings.max_requests_count = 32u;
+    if (with_http2_) {
+      // Hundreds of streams share two connections
+      network_initialization_settings.max_requests_count = 256u;
+      network_initialization_settings.http2_multiplexing = true;
+      network_initialization_settings.max_host_connections = 2u;
+      network_initialization_settings.certificate_settings.cert_file_blob =
+          kLocalhostCertificate;
+    }
     network_ = olp::http::CreateDefaultNetwork(
         std::move(network_initialization_settings));
   }
@@ -43,7 +78,11 @@ class Http2HttpNetworkWrapper : public olp::http::Network {
                               Payload payload, Callback callback,
                               HeaderCallback header_callback = nullptr,
                               DataCallback data_callback = nullptr) override {
-    ReplaceHttps2Http(request);
+    if (with_http2_) {
+      ReplaceHost2LocalHttp2Server(request);
+    } else {
+      ReplaceHttps2Http(request);
+    }
     InsertDebugHeaders(request);
 
     return network_->Send(std::move(request), std::move(payload),
@@ -75,6 +114,15 @@ class Http2HttpNetworkWrapper : public olp::http::Network {
     }
   }
 
+  static void ReplaceHost2LocalHttp2Server(olp::http::NetworkRequest &request) {
+    auto url = request.GetUrl();
+    auto pos = url.find("://");
+    if (pos != std::string::npos) {
+      url.replace(0, pos + 3, "https://localhost:3001/");
+      request.WithUrl(url);
+    }
+  }
+
   /*
    * Note: headers with empty values are optimized out.
    */
@@ -88,6 +136,7 @@ class Http2HttpNetworkWrapper : public olp::http::Network {
     }
   }
 
+  bool with_http2_ = false;
   bool with_timeouts_ = false;
   bool with_errors_ = false;
   std::shared_ptr<olp::http::Network> network_;
@@ -18,6 +18,7 @@
  */
 
 #include <chrono>
+#include <cinttypes>
 #include <memory>
 
 #include <gtest/gtest.h>
@@ -70,6 +71,8 @@ class PrefetchTest : public MemoryTestBase<TestConfiguration> {
 
   std::mutex errors_mutex_;
   std::map<int, int> errors_;
+
+  std::chrono::steady_clock::time_point start_;
 };
 
 void PrefetchTest::SetUp() {
@@ -79,6 +82,7 @@ void PrefetchTest::SetUp() {
   success_responses_.store(0);
   failed_responses_.store(0);
   errors_.clear();
+  start_ = std::chrono::steady_clock::now();
 }
 
 void PrefetchTest::TearDown() {
@@ -87,11 +91,17 @@ void PrefetchTest::TearDown() {
   }
   client_threads_.clear();
 
-  OLP_SDK_LOG_CRITICAL_INFO_F(kLogTag,
-                              "Test finished, total requests %zu, succeed "
-                              "responses %zu, failed responses %zu",
-                              total_requests_.load(), success_responses_.load(),
-                              failed_responses_.load());
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - start_)
+                           .count();
+
+  OLP_SDK_LOG_CRITICAL_INFO_F(
+      kLogTag,
+      "Test finished, total requests %zu, succeed responses %zu, failed "
+      "responses %zu, time=%" PRId64 "ms",
+      total_requests_.load(), success_responses_.load(),
+      failed_responses_.load(), static_cast<int64_t>(elapsed));
+  RecordProperty("time_ms", std::to_string(elapsed));
 
   for (const auto& error : errors_) {
     OLP_SDK_LOG_CRITICAL_INFO_F(kLogTag, "error %d - count %d", error.first,
@@ -189,10 +199,26 @@ TestConfiguration ShortRunningTestWithMutableCache() {
   return configuration;
 }
 
+/*
+ * Test to compare the prefetch throughput of HTTP/1.1 and HTTP/2, many tasks
+ * download the tiles concurrently.
+ */
+TestConfiguration ThroughputTest(bool with_http2) {
+  TestConfiguration configuration;
+  SetDefaultCacheConfiguration(configuration);
+  configuration.task_scheduler_capacity = 64;
+  configuration.with_http2 = with_http2;
+  configuration.configuration_name =
+      with_http2 ? "throughput_test_http2" : "throughput_test_http1";
+  return configuration;
+}
+
 std::vector<TestConfiguration> Configurations() {
   std::vector<TestConfiguration> configurations;
   configurations.emplace_back(ShortRunningTestWithMemoryCache());
   configurations.emplace_back(ShortRunningTestWithMutableCache());
+  configurations.emplace_back(ThroughputTest(false));
+  configurations.emplace_back(ThroughputTest(true));
   return configurations;
 }
 
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <chrono>
+#include <cinttypes>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <olp/core/client/HRN.h>
+#include <olp/core/logging/Log.h>
+#include <olp/dataservice/write/VersionedLayerClient.h>
+#include <olp/dataservice/write/model/PublishPartitionDataRequest.h>
+#include "MemoryTestBase.h"
+
+namespace {
+namespace client = olp::client;
+namespace write = olp::dataservice::write;
+
+constexpr auto kLogTag = "PublishToBatchTest";
+const client::HRN kCatalog("hrn:here:data::olp-here-test:testhrn");
+constexpr auto kLayerId = "versioned_test_layer";
+
+struct TestConfiguration : public TestBaseConfiguration {
+  std::string configuration_name;
+  std::uint32_t partitions_count = 2000u;
+  std::uint32_t partition_size = 1024u;
+  bool bulk = false;
+};
+
+std::ostream& operator<<(std::ostream& os, const TestConfiguration& config) {
+  return os << "TestConfiguration("
+            << ".configuration_name=" << config.configuration_name
+            << ", .partitions_count=" << config.partitions_count
+            << ", .partition_size=" << config.partition_size
+            << ", .bulk=" << config.bulk << ")";
+}
+
+using PublishToBatchTest = MemoryTestBase<TestConfiguration>;
+
+/*
+ * Publishes the partitions to the local OLP server, either one partition per
+ * PublishToBatch call, or all of them with one bulk call. A single call costs
+ * one blob upload and one metadata upload, the bulk call uploads the blobs
+ * concurrently and the metadata in chunks.
+ */
+TEST_P(PublishToBatchTest, PublishThroughput) {
+  olp::logging::Log::setLevel(olp::logging::Level::Warning);
+
+  const auto& parameter = GetParam();
+
+  write::VersionedLayerClient client(kCatalog, CreateCatalogClientSettings());
+
+  write::model::Publication publication;
+  publication.SetId("publication");
+
+  const auto data = std::make_shared<std::vector<unsigned char>>(
+      parameter.partition_size, 'p');
+  std::vector<write::model::PublishPartitionDataRequest> requests;
+  requests.reserve(parameter.partitions_count);
+  for (auto i = 0u; i < parameter.partitions_count; ++i) {
+    requests.emplace_back(write::model::PublishPartitionDataRequest()
+                              .WithData(data)
+                              .WithLayerId(kLayerId)
+                              .WithPartitionId(std::to_string(i)));
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  if (parameter.bulk) {
+    const auto response =
+        client.PublishToBatch(publication, requests).GetFuture().get();
+    EXPECT_TRUE(response.IsSuccessful()) << response.GetError().GetMessage();
+  } else {
+    std::vector<std::future<write::PublishPartitionDataResponse>> futures;
+    futures.reserve(requests.size());
+    for (const auto& request : requests) {
+      futures.emplace_back(
+          client.PublishToBatch(publication, request).GetFuture());
+    }
+    for (auto& future : futures) {
+      const auto response = future.get();
+      EXPECT_TRUE(response.IsSuccessful())
+          << response.GetError().GetMessage();
+    }
+  }
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+
+  const auto partitions_per_second =
+      elapsed > 0 ? parameter.partitions_count * 1000u / elapsed
+                  : parameter.partitions_count * 1000u;
+
+  OLP_SDK_LOG_CRITICAL_INFO_F(
+      kLogTag,
+      "Publish to batch, partitions=%u, bulk=%d, time=%" PRId64
+      "ms, partitions/s=%" PRId64,
+      parameter.partitions_count, parameter.bulk ? 1 : 0,
+      static_cast<int64_t>(elapsed),
+      static_cast<int64_t>(partitions_per_second));
+
+  RecordProperty("time_ms", std::to_string(elapsed));
+  RecordProperty("partitions_per_second",
+                 std::to_string(partitions_per_second));
+}
+
+std::vector<TestConfiguration> Configurations() {
+  std::vector<TestConfiguration> configurations;
+
+  for (const auto bulk : {false, true}) {
+    TestConfiguration configuration;
+    configuration.configuration_name = bulk ? "bulk" : "single";
+    configuration.bulk = bulk;
+    SetDefaultCacheConfiguration(configuration);
+    configurations.emplace_back(configuration);
+  }
+
+  return configurations;
+}
+
+std::string TestName(const testing::TestParamInfo<TestConfiguration>& info) {
+  return info.param.configuration_name;
+}
+
+INSTANTIATE_TEST_SUITE_P(PublishToBatch, PublishToBatchTest,
+                         ::testing::ValuesIn(Configurations()), TestName);
+}  // namespace
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <olp/core/client/OlpClient.h>
+#include <olp/core/http/Network.h>
+#include <olp/core/http/NetworkConstants.h>
+#include <olp/core/logging/Log.h>
+
+namespace {
+namespace client = olp::client;
+namespace http = olp::http;
+
+constexpr auto kLogTag = "ResponseBodyTest";
+
+struct TestConfiguration {
+  std::string configuration_name;
+  std::uint32_t requests_count = 200u;
+  std::uint32_t body_size = 1024u * 1024u;
+  std::uint32_t chunk_size = 16u * 1024u;
+};
+
+std::ostream& operator<<(std::ostream& os, const TestConfiguration& config) {
+  return os << "TestConfiguration("
+            << ".configuration_name=" << config.configuration_name
+            << ", .requests_count=" << config.requests_count
+            << ", .body_size=" << config.body_size
+            << ", .chunk_size=" << config.chunk_size << ")";
+}
+
+/*
+ * Serves the body synchronously in chunks, same as the network does, so only
+ * the cost of the response body handling is measured.
+ */
+class ChunkedBodyNetwork : public http::Network {
+ public:
+  ChunkedBodyNetwork(std::uint32_t body_size, std::uint32_t chunk_size)
+      : body_(body_size, 'b'), chunk_size_(chunk_size) {}
+
+  http::SendOutcome Send(http::NetworkRequest /*request*/, Payload payload,
+                         Callback callback, HeaderCallback header_callback,
+                         DataCallback /*data_callback*/) override {
+    const auto request_id = ++request_id_;
+    header_callback(http::kContentLengthHeader, std::to_string(body_.size()));
+
+    for (size_t offset = 0u; offset < body_.size(); offset += chunk_size_) {
+      const auto length = std::min<size_t>(chunk_size_, body_.size() - offset);
+      payload->write(body_.data() + offset, length);
+    }
+
+    callback(http::NetworkResponse()
+                 .WithStatus(http::HttpStatusCode::OK)
+                 .WithRequestId(request_id));
+    return http::SendOutcome(request_id);
+  }
+
+  void Cancel(http::RequestId /*id*/) override {}
+
+ private:
+  std::string body_;
+  std::uint32_t chunk_size_;
+  http::RequestId request_id_{0u};
+};
+
+class ResponseBodyTest : public ::testing::TestWithParam<TestConfiguration> {
+ protected:
+  client::OlpClient CreateClient() const {
+    const auto& parameter = GetParam();
+
+    client::OlpClientSettings settings;
+    settings.network_request_handler = std::make_shared<ChunkedBodyNetwork>(
+        parameter.body_size, parameter.chunk_size);
+    return client::OlpClient(settings, "https://here.com");
+  }
+};
+
+/*
+ * Compares the response body received into a `std::stringstream` and copied
+ * into a vector with the body received into a contiguous buffer pre-sized
+ * from `Content-Length` and moved out. The buffer mode does no copies after
+ * the data is received and no reallocations while receiving it.
+ */
+TEST_P(ResponseBodyTest, ReceiveBody) {
+  olp::logging::Log::setLevel(olp::logging::Level::Warning);
+
+  const auto& parameter = GetParam();
+  const auto client = CreateClient();
+
+  std::uint64_t stream_copied_bytes = 0u;
+  auto start = std::chrono::steady_clock::now();
+  for (auto i = 0u; i < parameter.requests_count; ++i) {
+    auto response = client.CallApi({}, "GET", {}, {}, {}, nullptr, {},
+                                   client::CancellationContext{});
+    ASSERT_EQ(response.GetStatus(), http::HttpStatusCode::OK);
+
+    std::vector<unsigned char> bytes;
+    response.GetResponse(bytes);
+    ASSERT_EQ(bytes.size(), parameter.body_size);
+    stream_copied_bytes += bytes.size();
+  }
+  const auto stream_time =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+
+  std::uint64_t buffer_copied_bytes = 0u;
+  std::uint32_t buffer_reallocations = 0u;
+  start = std::chrono::steady_clock::now();
+  for (auto i = 0u; i < parameter.requests_count; ++i) {
+    auto response = client.CallApiBytes({}, "GET", {}, {}, nullptr, {}, {});
+    ASSERT_EQ(response.GetStatus(), http::HttpStatusCode::OK);
+
+    const auto bytes = response.MoveResponseAsBytes();
+    ASSERT_EQ(bytes.size(), parameter.body_size);
+    if (bytes.capacity() != bytes.size()) {
+      // The buffer grew while receiving, so the pre-sizing did not work
+      ++buffer_reallocations;
+      buffer_copied_bytes += bytes.size();
+    }
+  }
+  const auto buffer_time =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+
+  EXPECT_EQ(buffer_reallocations, 0u);
+
+  OLP_SDK_LOG_CRITICAL_INFO_F(
+      kLogTag,
+      "Receive body, requests=%u, body=%u, stream=%" PRId64
+      "ms, stream copied=%" PRIu64 " bytes, buffer=%" PRId64
+      "ms, buffer copied=%" PRIu64 " bytes",
+      parameter.requests_count, parameter.body_size,
+      static_cast<int64_t>(stream_time), stream_copied_bytes,
+      static_cast<int64_t>(buffer_time), buffer_copied_bytes);
+
+  RecordProperty("stream_time_ms", std::to_string(stream_time));
+  RecordProperty("stream_copied_bytes", std::to_string(stream_copied_bytes));
+  RecordProperty("buffer_time_ms", std::to_string(buffer_time));
+  RecordProperty("buffer_copied_bytes", std::to_string(buffer_copied_bytes));
+}
+
+std::vector<TestConfiguration> Configurations() {
+  std::vector<TestConfiguration> configurations;
+
+  TestConfiguration configuration;
+  configuration.configuration_name = "64kb_body";
+  configuration.body_size = 64u * 1024u;
+  configuration.requests_count = 2000u;
+  configurations.emplace_back(configuration);
+
+  configuration.configuration_name = "1mb_body";
+  configuration.body_size = 1024u * 1024u;
+  configuration.requests_count = 200u;
+  configurations.emplace_back(configuration);
+
+  configuration.configuration_name = "8mb_body";
+  configuration.body_size = 8u * 1024u * 1024u;
+  configuration.requests_count = 25u;
+  configurations.emplace_back(configuration);
+
+  return configurations;
+}
+
+std::string TestName(const testing::TestParamInfo<TestConfiguration>& info) {
+  return info.param.configuration_name;
+}
+
+INSTANTIATE_TEST_SUITE_P(NetworkResponse, ResponseBodyTest,
+                         ::testing::ValuesIn(Configurations()), TestName);
+}  // namespace
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <chrono>
+#include <cinttypes>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <olp/core/client/HRN.h>
+#include <olp/core/logging/Log.h>
+#include <olp/dataservice/write/StreamLayerClient.h>
+#include <olp/dataservice/write/model/FlushRequest.h>
+#include <olp/dataservice/write/model/PublishDataRequest.h>
+#include "MemoryTestBase.h"
+
+namespace {
+namespace client = olp::client;
+namespace write = olp::dataservice::write;
+
+constexpr auto kLogTag = "StreamFlushTest";
+const client::HRN kCatalog("hrn:here:data::olp-here-test:testhrn");
+constexpr auto kLayerId = "stream_test_layer";
+
+struct TestConfiguration : public TestBaseConfiguration {
+  std::string configuration_name;
+  std::uint32_t messages_count = 2000u;
+  std::uint32_t message_size = 1024u;
+  std::uint32_t parallel_requests = 1u;
+};
+
+std::ostream& operator<<(std::ostream& os, const TestConfiguration& config) {
+  return os << "TestConfiguration("
+            << ".configuration_name=" << config.configuration_name
+            << ", .messages_count=" << config.messages_count
+            << ", .message_size=" << config.message_size
+            << ", .parallel_requests=" << config.parallel_requests << ")";
+}
+
+using StreamFlushTest = MemoryTestBase<TestConfiguration>;
+
+/*
+ * Queues the messages and flushes them to the local OLP server with the
+ * configured number of parallel requests. The throughput should grow with the
+ * number of requests in flight, until the network is saturated.
+ */
+TEST_P(StreamFlushTest, FlushThroughput) {
+  olp::logging::Log::setLevel(olp::logging::Level::Warning);
+
+  const auto& parameter = GetParam();
+
+  write::StreamLayerClientSettings stream_settings;
+  stream_settings.flush_parallel_requests = parameter.parallel_requests;
+
+  write::StreamLayerClient stream_client(kCatalog, stream_settings,
+                                         CreateCatalogClientSettings());
+
+  const auto data = std::make_shared<std::vector<unsigned char>>(
+      parameter.message_size, 's');
+  for (auto i = 0u; i < parameter.messages_count; ++i) {
+    auto error = stream_client.Queue(write::model::PublishDataRequest()
+                                         .WithData(data)
+                                         .WithLayerId(kLayerId));
+    ASSERT_FALSE(error) << *error;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto responses =
+      stream_client.Flush(write::model::FlushRequest()).GetFuture().get();
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+
+  ASSERT_EQ(responses.size(), parameter.messages_count);
+  for (const auto& response : responses) {
+    EXPECT_TRUE(response.IsSuccessful())
+        << response.GetError().GetMessage();
+  }
+
+  const auto messages_per_second =
+      elapsed > 0 ? parameter.messages_count * 1000u / elapsed
+                  : parameter.messages_count * 1000u;
+
+  OLP_SDK_LOG_CRITICAL_INFO_F(
+      kLogTag,
+      "Stream flush, messages=%u, parallel requests=%u, time=%" PRId64
+      "ms, messages/s=%" PRId64,
+      parameter.messages_count, parameter.parallel_requests,
+      static_cast<int64_t>(elapsed),
+      static_cast<int64_t>(messages_per_second));
+
+  RecordProperty("time_ms", std::to_string(elapsed));
+  RecordProperty("messages_per_second", std::to_string(messages_per_second));
+}
+
+std::vector<TestConfiguration> Configurations() {
+  std::vector<TestConfiguration> configurations;
+
+  for (const auto parallel_requests : {1u, 8u, 32u}) {
+    TestConfiguration configuration;
+    configuration.configuration_name =
+        std::to_string(parallel_requests) + "_parallel_requests";
+    configuration.parallel_requests = parallel_requests;
+    configuration.cache_factory = []() {
+      return olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+    };
+    configurations.emplace_back(configuration);
+  }
+
+  return configurations;
+}
+
+std::string TestName(const testing::TestParamInfo<TestConfiguration>& info) {
+  return info.param.configuration_name;
+}
+
+INSTANTIATE_TEST_SUITE_P(StreamFlush, StreamFlushTest,
+                         ::testing::ValuesIn(Configurations()), TestName);
+}  // namespace
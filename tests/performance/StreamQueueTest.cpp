@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+
+#include <chrono>
+#include <cinttypes>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <olp/core/cache/CacheSettings.h>
+#include <olp/core/cache/KeyValueCache.h>
+#include <olp/core/client/HRN.h>
+#include <olp/core/client/OlpClientSettingsFactory.h>
+#include <olp/core/http/Network.h>
+#include <olp/core/logging/Log.h>
+#include <olp/dataservice/write/StreamLayerClient.h>
+#include <olp/dataservice/write/model/FlushRequest.h>
+#include <olp/dataservice/write/model/PublishDataRequest.h>
+
+namespace {
+namespace client = olp::client;
+namespace write = olp::dataservice::write;
+
+constexpr auto kLogTag = "StreamQueueTest";
+const client::HRN kCatalog("hrn:here:data::olp-here-test:testhrn");
+constexpr auto kLayerId = "sdii_test_layer";
+
+struct TestConfiguration {
+  std::string configuration_name;
+  std::uint32_t messages_count = 100000u;
+  std::uint32_t message_size = 1024u;
+};
+
+std::ostream& operator<<(std::ostream& os, const TestConfiguration& config) {
+  return os << "TestConfiguration("
+            << ".configuration_name=" << config.configuration_name
+            << ", .messages_count=" << config.messages_count
+            << ", .message_size=" << config.message_size << ")";
+}
+
+/*
+ * Fails every request immediately, so the flush measures only the queue
+ * overhead and not the network.
+ */
+class OfflineNetwork : public olp::http::Network {
+ public:
+  olp::http::SendOutcome Send(olp::http::NetworkRequest /*request*/,
+                              Payload /*payload*/, Callback /*callback*/,
+                              HeaderCallback /*header_callback*/,
+                              DataCallback /*data_callback*/) override {
+    return olp::http::SendOutcome(olp::http::ErrorCode::OFFLINE_ERROR);
+  }
+
+  void Cancel(olp::http::RequestId /*id*/) override {}
+};
+
+class StreamQueueTest : public ::testing::TestWithParam<TestConfiguration> {};
+
+/*
+ * Queues the SDII messages and flushes all of them. Each queue operation
+ * should take constant time, so the total time should grow linearly with the
+ * number of messages.
+ */
+TEST_P(StreamQueueTest, QueueAndFlush) {
+  olp::logging::Log::setLevel(olp::logging::Level::Off);
+
+  const auto& parameter = GetParam();
+
+  client::OlpClientSettings settings;
+  settings.network_request_handler = std::make_shared<OfflineNetwork>();
+  settings.cache = client::OlpClientSettingsFactory::CreateDefaultCache({});
+  settings.retry_settings.max_attempts = 0;
+
+  write::StreamLayerClient stream_client(
+      kCatalog, write::StreamLayerClientSettings{}, settings);
+
+  const auto data = std::make_shared<std::vector<unsigned char>>(
+      parameter.message_size, 's');
+
+  const auto queue_start = std::chrono::steady_clock::now();
+  for (auto i = 0u; i < parameter.messages_count; ++i) {
+    auto error = stream_client.Queue(write::model::PublishDataRequest()
+                                         .WithData(data)
+                                         .WithLayerId(kLayerId));
+    ASSERT_FALSE(error) << *error;
+  }
+  const auto queue_time =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - queue_start)
+          .count();
+
+  const auto flush_start = std::chrono::steady_clock::now();
+  const auto responses =
+      stream_client.Flush(write::model::FlushRequest()).GetFuture().get();
+  const auto flush_time =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - flush_start)
+          .count();
+
+  EXPECT_EQ(responses.size(), parameter.messages_count);
+
+  olp::logging::Log::setLevel(olp::logging::Level::Info);
+  OLP_SDK_LOG_CRITICAL_INFO_F(
+      kLogTag,
+      "Stream queue, messages=%u, queue=%" PRId64 "ms, flush=%" PRId64 "ms",
+      parameter.messages_count, static_cast<int64_t>(queue_time),
+      static_cast<int64_t>(flush_time));
+
+  RecordProperty("queue_ms", std::to_string(queue_time));
+  RecordProperty("flush_ms", std::to_string(flush_time));
+}
+
+std::vector<TestConfiguration> Configurations() {
+  std::vector<TestConfiguration> configurations;
+
+  TestConfiguration configuration;
+  configuration.configuration_name = "100k_messages";
+  configurations.emplace_back(configuration);
+
+  return configurations;
+}
+
+std::string TestName(const testing::TestParamInfo<TestConfiguration>& info) {
+  return info.param.configuration_name;
+}
+
+INSTANTIATE_TEST_SUITE_P(StreamQueue, StreamQueueTest,
+                         ::testing::ValuesIn(Configurations()), TestName);
+}  // namespace
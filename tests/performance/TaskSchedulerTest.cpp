@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <olp/core/logging/Log.h>
+#include <olp/core/thread/ThreadPoolTaskScheduler.h>
+#include <olp/core/thread/WorkStealingTaskScheduler.h>
+
+namespace {
+namespace thread = olp::thread;
+
+constexpr auto kLogTag = "TaskSchedulerTest";
+
+enum class SchedulerType { kThreadPool, kWorkStealing };
+
+struct TestConfiguration {
+  std::string configuration_name;
+  SchedulerType scheduler_type = SchedulerType::kThreadPool;
+  std::uint32_t threads_count = 4u;
+  std::uint32_t root_tasks_count = 10000u;
+  std::uint32_t child_tasks_count = 100u;
+};
+
+std::ostream& operator<<(std::ostream& os, const TestConfiguration& config) {
+  return os << "TestConfiguration("
+            << ".configuration_name=" << config.configuration_name
+            << ", .threads_count=" << config.threads_count
+            << ", .root_tasks_count=" << config.root_tasks_count
+            << ", .child_tasks_count=" << config.child_tasks_count << ")";
+}
+
+std::shared_ptr<thread::TaskScheduler> CreateScheduler(
+    const TestConfiguration& configuration) {
+  if (configuration.scheduler_type == SchedulerType::kWorkStealing) {
+    return std::make_shared<thread::WorkStealingTaskScheduler>(
+        configuration.threads_count);
+  }
+  return std::make_shared<thread::ThreadPoolTaskScheduler>(
+      configuration.threads_count);
+}
+
+using TaskSchedulerTest = ::testing::TestWithParam<TestConfiguration>;
+
+/*
+ * Measures the enqueue/dequeue throughput of tiny tasks. The root tasks are
+ * scheduled from the test thread and every root task fans out into the child
+ * tasks, same as the prefetch does, so both the tasks scheduled from outside
+ * and from inside of the pool are measured.
+ */
+TEST_P(TaskSchedulerTest, TinyTasksThroughput) {
+  olp::logging::Log::setLevel(olp::logging::Level::Warning);
+
+  const auto& parameter = GetParam();
+  auto scheduler = CreateScheduler(parameter);
+
+  const auto total_tasks = static_cast<std::uint64_t>(
+                               parameter.root_tasks_count) *
+                           (parameter.child_tasks_count + 1u);
+  std::atomic<std::uint64_t> executed_tasks(0u);
+  std::promise<void> promise;
+
+  auto complete_task = [&]() {
+    if (++executed_tasks == total_tasks) {
+      promise.set_value();
+    }
+  };
+
+  const auto start = std::chrono::steady_clock::now();
+  for (auto i = 0u; i < parameter.root_tasks_count; ++i) {
+    scheduler->ScheduleTask([&]() {
+      for (auto child = 0u; child < parameter.child_tasks_count; ++child) {
+        scheduler->ScheduleTask(complete_task);
+      }
+      complete_task();
+    });
+  }
+
+  ASSERT_EQ(promise.get_future().wait_for(std::chrono::minutes(5)),
+            std::future_status::ready);
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+  scheduler.reset();
+
+  const auto tasks_per_second =
+      elapsed > 0 ? total_tasks * 1000u / elapsed : total_tasks * 1000u;
+
+  OLP_SDK_LOG_CRITICAL_INFO_F(
+      kLogTag,
+      "Tiny tasks, scheduler=%s, threads=%u, tasks=%" PRIu64
+      ", time=%" PRId64 "ms, tasks/s=%" PRIu64,
+      parameter.scheduler_type == SchedulerType::kWorkStealing
+          ? "work_stealing"
+          : "thread_pool",
+      parameter.threads_count, total_tasks, static_cast<int64_t>(elapsed),
+      tasks_per_second);
+
+  RecordProperty("time_ms", std::to_string(elapsed));
+  RecordProperty("tasks_per_second", std::to_string(tasks_per_second));
+}
+
+std::vector<TestConfiguration> Configurations() {
+  std::vector<TestConfiguration> configurations;
+
+  for (const auto type :
+       {SchedulerType::kThreadPool, SchedulerType::kWorkStealing}) {
+    for (const auto threads : {4u, 8u, 16u, 32u, 64u}) {
+      TestConfiguration configuration;
+      configuration.configuration_name =
+          (type == SchedulerType::kWorkStealing ? "work_stealing_"
+                                                : "thread_pool_") +
+          std::to_string(threads) + "_threads";
+      configuration.scheduler_type = type;
+      configuration.threads_count = threads;
+      configurations.emplace_back(configuration);
+    }
+  }
+
+  return configurations;
+}
+
+std::string TestName(const testing::TestParamInfo<TestConfiguration>& info) {
+  return info.param.configuration_name;
+}
+
+INSTANTIATE_TEST_SUITE_P(TaskScheduling, TaskSchedulerTest,
+                         ::testing::ValuesIn(Configurations()), TestName);
+}  // namespace
@@ -52,4 +52,16 @@ function blob_handler(pathname, query) {
     return { status: 404, text: "Not Found" }
 }
 
-exports.handler = blob_handler
\ No newline at end of file
+exports.handler = blob_handler
+
+function blob_upload_handler(pathname, query) {
+    for (method of methods) {
+        if (pathname.match(method.regex)) {
+            return { status: 204, text: "", headers : {} }
+        }
+    }
+    console.log("Not handled", pathname)
+    return { status: 404, text: "Not Found" }
+}
+
+exports.upload_handler = blob_upload_handler
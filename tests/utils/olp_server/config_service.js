@@ -32,6 +32,7 @@ function generateCatalogApiResponse(request) {
         {
             id: "versioned_test_layer",
             description: loremIpsum(),
+            contentType: "application/x-protobuf",
             schema: {
                 hrn: "hrn:here:schema:::com:here-tile-schema_v1:1.0.0"
             },
@@ -44,6 +45,12 @@ function generateCatalogApiResponse(request) {
                 hrn: "hrn:here:schema:::com:here-tile-schema_v1:1.0.0"
             },
             layerType: "volatile"
+        },
+        {
+            id: "stream_test_layer",
+            description: loremIpsum(),
+            contentType: "application/x-protobuf",
+            layerType: "stream"
         }
         ],
         marketplaceReady: false,
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2024 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+function generateTraceId() {
+    const characters = 'abcdef0123456789'
+    var trace_id = ""
+    for (var i = 0; i < 32; i++) {
+        trace_id += characters.charAt(Math.floor(Math.random() * characters.length))
+    }
+    return trace_id
+}
+
+function generateIngestDataResponse(request) {
+    const layer = request[1] // ignored
+    return { TraceID: generateTraceId() }
+}
+
+const methods = [
+{
+    regex: /layers\/([^\/]+)$/,
+    handler: generateIngestDataResponse
+}
+]
+
+function ingest_handler(pathname, query) {
+    for (method of methods) {
+        const match = pathname.match(method.regex)
+        if (match) {
+            return { status: 200, text: JSON.stringify(method.handler(match)), headers : {"Content-Type": "application/json"} }
+        }
+    }
+    console.log("Not handled", pathname)
+    return { status: 404, text: "Not Found" }
+}
+
+exports.handler = ingest_handler
@@ -19,6 +19,9 @@
 
 const cluster = require('cluster');
 const http = require('http')
+const http2 = require('http2')
+const fs = require('fs')
+const path = require('path')
 const URL = require('url')
 const services = require('./urls.js')
 const numCPUs = require('os').cpus().length;
@@ -28,9 +31,12 @@ const config_service_handler = require('./config_service.js')
 const metadata_service_handler = require('./metadata_service.js')
 const query_service_handler = require('./query_service.js')
 const blob_service_handler = require('./blob_service.js')
+const ingest_service_handler = require('./ingest_service.js')
+const publish_service_handler = require('./publish_service.js')
 const errors_generator = require('./errors_generator.js')
 
 const port = 3000
+const http2_port = 3001
 
 function sleep(milliseconds) {
   var waitTill = new Date(new Date().getTime() + milliseconds);
@@ -69,6 +75,13 @@ handlers[services.config] = config_service_handler.handler
 handlers[services.metadata] = metadata_service_handler.handler
 handlers[services.query] = query_service_handler.handler
 handlers[services.blob] = blob_service_handler.handler
+handlers[services.ingest] = ingest_service_handler.handler
+
+// The handlers of the requests that upload data, by the method and the host
+const upload_handlers = {};
+upload_handlers['POST ' + services.ingest] = ingest_service_handler.handler
+upload_handlers['POST ' + services.publish] = publish_service_handler.handler
+upload_handlers['PUT ' + services.blob] = blob_service_handler.upload_handler
 
 const requestHandler = async (request, response) => {
 
@@ -81,9 +94,12 @@ const requestHandler = async (request, response) => {
   });
 
   const { headers, method, url } = request;
+  const { host, query, pathname } = URL.parse(url, true)
 
-  // Currently we support only read operations
-  if (method != 'GET') {
+  // Currently we support only read operations, the stream data ingestion and
+  // the versioned data publishing
+  const upload_handler = upload_handlers[method + ' ' + host]
+  if (method != 'GET' && !upload_handler) {
     response.writeHead(404, {})
     response.end('Not Found')
     return
@@ -104,7 +120,12 @@ const requestHandler = async (request, response) => {
     processor = timeoutDecorator(processor)
   }
 
-  const { host, query, pathname } = URL.parse(url, true)
+  if (upload_handler) {
+    // Respond when the uploaded data is received
+    request.on('end', () => processor(response, pathname, query, upload_handler))
+    request.resume()
+    return
+  }
 
   const handler = handlers[host]
   if (handler) {
@@ -116,6 +137,12 @@ const requestHandler = async (request, response) => {
   response.end('Not implemented')
 }
 
+// HTTP/2 requests are sent to the server directly, without a proxy, so the
+// service host is the first segment of the path
+const http2RequestHandler = (request, response) => {
+  request.url = 'http:/' + request.url
+  requestHandler(request, response)
+}
 
 if (cluster.isMaster) {
   console.log(`Master ${process.pid} is running`);
@@ -140,9 +167,26 @@ if (cluster.isMaster) {
   
     console.log(`server is listening on ${port}`)
   })
+
+  // HTTP/2 is negotiated during the TLS handshake, the certificate is
+  // self-signed for localhost
+  const http2_server = http2.createSecureServer({
+    key: fs.readFileSync(path.join(__dirname, 'localhost-key.pem')),
+    cert: fs.readFileSync(path.join(__dirname, 'localhost-cert.pem')),
+    allowHTTP1: true
+  }, http2RequestHandler)
+
+  http2_server.listen(http2_port, (err) => {
+    if (err) {
+      return console.log('something bad happened', err)
+    }
+
+    console.log(`HTTP/2 server is listening on ${http2_port}`)
+  })
   
   // Handle termination by Travis
   process.on('SIGTERM', function () {
+    http2_server.close();
     server.close(function () {
       console.log(`Graceful shutdown`)
       process.exit(0);
@@ -22,3 +22,5 @@ exports.config = "config_service.com"
 exports.metadata = "metadata_service.com"
 exports.query = "query_service.com"
 exports.blob = "blob_service.com"
+exports.ingest = "ingest_service.com"
+exports.publish = "publish_service.com"